@@ -11,12 +11,14 @@ from contextlib import asynccontextmanager
 # Adiciona path para importar database
 sys.path.append(str(Path(__file__).parent.parent.parent / "database"))
 
-from fastapi import FastAPI, HTTPException, Depends, status, WebSocket, WebSocketDisconnect, Query
+from fastapi import FastAPI, HTTPException, Depends, status, WebSocket, WebSocketDisconnect, Query, Header, Response
+from fastapi.encoders import jsonable_encoder
 from fastapi.middleware.cors import CORSMiddleware
 from fastapi.responses import JSONResponse
 from pydantic import BaseModel, Field
 from datetime import datetime
 import asyncio
+import json
 import os
 import logging
 from dotenv import load_dotenv
@@ -51,6 +53,7 @@ from utils.normalizers import (
     compare_item_types,
     enum_to_str
 )
+from utils.config_etag import config_etag
 
 # ====================================
 # CONFIGURAÇÃO
@@ -1485,12 +1488,16 @@ def get_preview_configuration():
 @app.get("/api/config/full", tags=["Config"])
 async def get_full_configuration(
     device_uuid: Optional[str] = None, 
-    preview: bool = Query(False, description="Modo preview para visualizador")
+    preview: bool = Query(False, description="Modo preview para visualizador"),
+    if_none_match: Optional[str] = Header(None)
 ):
     """
     Retorna configuração completa para um dispositivo ESP32 ou modo preview
     Endpoint otimizado para reduzir número de requisições no ESP32
     Suporta modo preview para visualizador frontend
+    
+    Envia ETag da configuração; com If-None-Match igual responde 304 sem
+    corpo e o ESP32 usa a cópia que já tem no flash.
     """
     try:
         # Validações de entrada
@@ -1757,7 +1764,13 @@ async def get_full_configuration(
             logger.warning(f"Erro ao buscar telemetria para device {device.uuid}: {e}")
             config_data["telemetry"] = {}
         
-        return config_data
+        # Horário, status/IP e telemetria ficam fora do ETag (ver utils/config_etag.py)
+        content = jsonable_encoder(config_data)
+        etag = config_etag(content)
+        
+        if if_none_match == etag:
+            return Response(status_code=304, headers={"ETag": etag})
+        return JSONResponse(content=content, headers={"ETag": etag})
         
     except HTTPException:
         raise
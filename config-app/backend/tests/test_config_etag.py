@@ -0,0 +1,72 @@
+"""
+Testes do ETag de /api/config/full
+Duas gerações da mesma configuração precisam dar o mesmo ETag (304)
+"""
+
+import sys
+from pathlib import Path
+
+# Adicionar paths necessários
+backend_path = Path(__file__).parent.parent
+sys.path.append(str(backend_path))
+
+from utils.config_etag import config_etag
+
+
+def build_config(timestamp, status, ip, telemetry, screen_name="Luzes"):
+    """Formato da resposta de get_full_configuration"""
+    return {
+        "version": "2.0.0",
+        "protocol_version": "2.2.0",
+        "timestamp": timestamp,
+        "device": {
+            "id": 1,
+            "uuid": "esp32-display-001",
+            "type": "esp32_display",
+            "name": "Display",
+            "status": status,
+            "ip_address": ip,
+            "mac_address": "AA:BB:CC:DD:EE:FF"
+        },
+        "screens": [
+            {
+                "id": 2,
+                "name": screen_name,
+                "items": [
+                    {
+                        "id": 10,
+                        "label": "Farol",
+                        "relay_board": {"id": 1, "device_uuid": "esp32-relay-001", "device_ip": ip},
+                        "relay_channel": {"id": 5, "channel_number": 1}
+                    }
+                ]
+            }
+        ],
+        "devices": [
+            {"id": 2, "uuid": "esp32-relay-001", "name": "Relé", "type": "esp32_relay",
+             "status": status, "ip_address": ip, "is_active": True}
+        ],
+        "telemetry": telemetry
+    }
+
+
+class TestConfigEtag:
+    """ETag estável entre requisições"""
+
+    def test_identical_requests_share_etag(self):
+        """Duas GETs seguidas: só horário, status, IP e telemetria mudam"""
+        first = build_config("2025-08-20T10:00:00.000001", "online", "10.0.0.5", {"rpm": 800})
+        second = build_config("2025-08-20T10:00:01.500000", "offline", "10.0.0.9", {"rpm": 3200})
+        assert config_etag(first) == config_etag(second)
+
+    def test_layout_change_changes_etag(self):
+        """Mudança na tela invalida o cache do display"""
+        before = build_config("2025-08-20T10:00:00", "online", "10.0.0.5", {})
+        after = build_config("2025-08-20T10:00:00", "online", "10.0.0.5", {}, screen_name="Faróis")
+        assert config_etag(before) != config_etag(after)
+
+    def test_etag_is_quoted(self):
+        """Formato de ETag forte aceito pelo If-None-Match do ESP32"""
+        etag = config_etag(build_config("2025-08-20T10:00:00", "online", "10.0.0.5", {}))
+        assert etag.startswith('"') and etag.endswith('"')
+        assert len(etag) == 18
@@ -0,0 +1,68 @@
+"""
+ETag da configuração completa (/api/config/full).
+
+Só entra no hash o que muda a UI do display. Horário da geração, status e
+IP dos dispositivos e telemetria mudam a cada requisição (ou chegam ao vivo
+por MQTT); com eles no hash o If-None-Match nunca casaria e o 304 não sairia.
+"""
+
+import hashlib
+import json
+
+# Campos de topo que não versionam a configuração
+VOLATILE_TOP_LEVEL = ("timestamp", "telemetry")
+
+# Estado de rede dos dispositivos (device, devices[], relay_board dos itens)
+VOLATILE_DEVICE_FIELDS = ("status", "ip_address")
+VOLATILE_RELAY_BOARD_FIELDS = ("device_ip",)
+
+
+def _without(data, fields):
+    if not isinstance(data, dict):
+        return data
+    return {key: value for key, value in data.items() if key not in fields}
+
+
+def versioned_config(content: dict) -> dict:
+    """
+    Cópia rasa da configuração sem os campos voláteis.
+
+    Args:
+        content: Configuração já serializável (saída do jsonable_encoder)
+
+    Returns:
+        dict: Apenas o que deve mudar o ETag
+    """
+    versioned = _without(content, VOLATILE_TOP_LEVEL)
+
+    if "device" in versioned:
+        versioned["device"] = _without(versioned["device"], VOLATILE_DEVICE_FIELDS)
+
+    if isinstance(versioned.get("devices"), list):
+        versioned["devices"] = [_without(d, VOLATILE_DEVICE_FIELDS) for d in versioned["devices"]]
+
+    if isinstance(versioned.get("screens"), list):
+        screens = []
+        for screen in versioned["screens"]:
+            if isinstance(screen, dict) and isinstance(screen.get("items"), list):
+                items = []
+                for item in screen["items"]:
+                    if isinstance(item, dict) and "relay_board" in item:
+                        item = dict(item, relay_board=_without(item["relay_board"], VOLATILE_RELAY_BOARD_FIELDS))
+                    items.append(item)
+                screen = dict(screen, items=items)
+            screens.append(screen)
+        versioned["screens"] = screens
+
+    return versioned
+
+
+def config_etag(content: dict) -> str:
+    """
+    ETag forte da configuração.
+
+    Returns:
+        str: 16 hex do SHA-1 entre aspas (ex.: '"1b0c4f3e9a2d7c65"')
+    """
+    digest = hashlib.sha1(json.dumps(versioned_config(content), sort_keys=True).encode()).hexdigest()
+    return f'"{digest[:16]}"'
@@ -0,0 +1,118 @@
+/**
+ * @file runtime_stats.h
+ * @brief Coletor de CPU, pilhas e tempos de execução (display e relé)
+ *
+ * Componente C compartilhado: componente ESP-IDF no relé (CMakeLists.txt)
+ * e biblioteca PlatformIO no display (library.json). Tudo em buffers fixos;
+ * nada é alocado depois de runtime_stats_init().
+ *
+ * - CPU por core: contadores de run-time do FreeRTOS (tarefas IDLE) quando
+ *   configGENERATE_RUN_TIME_STATS está ligado; senão um idle hook conta os
+ *   ticks em que o core chegou a ficar ocioso. Isso é só uma estimativa: um
+ *   core ocupado em rajadas menores que um tick passa pelo IDLE em todo
+ *   tick e aparece quase livre. Fica marcada (cpu_estimated) e fora de
+ *   runtime_stats_cpu_pct().
+ * - Por tarefa: fatia de CPU na janela (só com run-time stats) e menor
+ *   pilha livre desde o boot (precisa de configUSE_TRACE_FACILITY).
+ * - Tempos (ex.: iteração do loop, frame do LVGL) e medidores (ex.: fila
+ *   MQTT) registrados pela aplicação; min/médio/máximo por janela.
+ *
+ * runtime_stats_record()/runtime_stats_set() podem ser chamados de qualquer
+ * tarefa; sample(), get() e to_json() só da tarefa que publica.
+ * Fora do ESP32 (build nativo) só tempos e medidores funcionam.
+ */
+
+#ifndef RUNTIME_STATS_H
+#define RUNTIME_STATS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RUNTIME_STATS_MAX_TASKS    24
+#define RUNTIME_STATS_MAX_TIMINGS  8
+#define RUNTIME_STATS_MAX_GAUGES   8
+#define RUNTIME_STATS_MAX_CORES    2
+#define RUNTIME_STATS_NAME_LEN     16
+#define RUNTIME_STATS_JSON_SIZE    2048   // Cabe MAX_TASKS tarefas + tempos + medidores
+
+#define RUNTIME_STATS_UNKNOWN      (-1)
+
+typedef struct {
+    char name[RUNTIME_STATS_NAME_LEN];
+    int8_t core;                // RUNTIME_STATS_UNKNOWN = sem afinidade
+    uint8_t priority;
+    int16_t cpu_pct;            // % de um core na janela (UNKNOWN sem run-time stats)
+    uint32_t stack_free_min;    // Bytes livres no pior momento desde o boot
+} runtime_task_stat_t;
+
+typedef struct {
+    const char* name;           // Literal / estático
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t avg_us;
+    uint32_t max_us;
+} runtime_timing_t;
+
+typedef struct {
+    const char* name;           // Literal / estático
+    uint32_t value;             // Último valor
+    uint32_t max;               // Pico na janela
+} runtime_gauge_t;
+
+/// Janela fechada pelo último runtime_stats_sample()
+typedef struct {
+    uint32_t window_ms;
+    uint8_t cores;
+    int16_t cpu_pct[RUNTIME_STATS_MAX_CORES];   // UNKNOWN sem fonte de CPU
+    bool cpu_estimated;                         // cpu_pct do idle hook (pode subestimar muito)
+    bool per_task_cpu;                          // Run-time stats disponíveis
+    uint16_t tasks_total;                       // Tarefas existentes (pode passar de MAX_TASKS)
+    uint8_t task_count;
+    runtime_task_stat_t tasks[RUNTIME_STATS_MAX_TASKS];
+    uint8_t timing_count;
+    runtime_timing_t timings[RUNTIME_STATS_MAX_TIMINGS];
+    uint8_t gauge_count;
+    runtime_gauge_t gauges[RUNTIME_STATS_MAX_GAUGES];
+} runtime_stats_snapshot_t;
+
+/// Abre a primeira janela e instala os idle hooks (se não houver run-time stats)
+void runtime_stats_init(void);
+
+/**
+ * @brief Registra (ou encontra) um tempo pelo nome
+ * @return slot para runtime_stats_record(), ou -1 com a tabela cheia
+ */
+int runtime_stats_timing(const char* name);
+void runtime_stats_record(int slot, uint32_t us);
+
+/// Idem para medidores de profundidade/quantidade
+int runtime_stats_gauge(const char* name);
+void runtime_stats_set(int slot, uint32_t value);
+
+/// Fecha a janela: CPU desde o último sample, pilhas, tempos e medidores
+void runtime_stats_sample(void);
+
+/// Última janela fechada
+const runtime_stats_snapshot_t* runtime_stats_get(void);
+
+/// CPU média dos cores na última janela (UNKNOWN sem run-time stats; a estimativa só vai no JSON)
+int runtime_stats_cpu_pct(void);
+
+/**
+ * @brief Última janela em JSON:
+ *        {"window_ms","cpu":[..],"cpu_estimated"?,"tasks_total","tasks":[{"name","core","prio","cpu","stack_free"}],
+ *         "timings":{"nome":{"count","min_us","avg_us","max_us"}},"gauges":{"nome":{"value","max"}}}
+ * @return Bytes escritos (sem o '\0'), ou -1 se não coube em len
+ */
+int runtime_stats_to_json(char* buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RUNTIME_STATS_H
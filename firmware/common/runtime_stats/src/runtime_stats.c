@@ -0,0 +1,422 @@
+/**
+ * @file runtime_stats.c
+ * @brief Coletor de CPU, pilhas e tempos de execução
+ */
+
+#include "runtime_stats.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "esp_idf_version.h"
+#if !configGENERATE_RUN_TIME_STATS
+#include "esp_freertos_hooks.h"
+#endif
+
+static portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+#define STATS_LOCK()    portENTER_CRITICAL(&lock)
+#define STATS_UNLOCK()  portEXIT_CRITICAL(&lock)
+#else
+#include <time.h>
+
+#define STATS_LOCK()
+#define STATS_UNLOCK()
+#endif
+
+typedef struct {
+    const char* name;
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t total_us;
+} timing_acc_t;
+
+static timing_acc_t timings[RUNTIME_STATS_MAX_TIMINGS];
+static uint8_t timing_count = 0;
+static runtime_gauge_t gauges[RUNTIME_STATS_MAX_GAUGES];
+static uint8_t gauge_count = 0;
+
+static runtime_stats_snapshot_t snapshot;
+static int64_t window_start_us = 0;
+static bool initialized = false;
+
+static int64_t now_us(void) {
+#ifdef ESP_PLATFORM
+    return esp_timer_get_time();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
+// ============================================================================
+// CPU e tarefas (FreeRTOS)
+// ============================================================================
+
+#ifdef ESP_PLATFORM
+
+#define CORES (portNUM_PROCESSORS < RUNTIME_STATS_MAX_CORES ? portNUM_PROCESSORS : RUNTIME_STATS_MAX_CORES)
+
+#ifdef configRUN_TIME_COUNTER_TYPE
+typedef configRUN_TIME_COUNTER_TYPE run_counter_t;
+#else
+typedef uint32_t run_counter_t;
+#endif
+
+#if configUSE_TRACE_FACILITY
+static TaskStatus_t status[RUNTIME_STATS_MAX_TASKS];
+
+static int8_t task_core(TaskHandle_t task) {
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+    BaseType_t core = xTaskGetCoreID(task);
+#else
+    BaseType_t core = xTaskGetAffinity(task);
+#endif
+    return (core < 0 || core >= RUNTIME_STATS_MAX_CORES) ? RUNTIME_STATS_UNKNOWN : (int8_t)core;
+}
+
+// Nome vai direto para o JSON: sem aspas, barras ou controle
+static void copy_name(char* dst, const char* src) {
+    size_t i = 0;
+    for (; src && src[i] && i < RUNTIME_STATS_NAME_LEN - 1; i++) {
+        char c = src[i];
+        dst[i] = (c == '"' || c == '\\' || (unsigned char)c < 0x20) ? '_' : c;
+    }
+    dst[i] = '\0';
+}
+#endif
+
+#if configGENERATE_RUN_TIME_STATS
+// Contadores do sample anterior, para a fatia de cada tarefa na janela
+typedef struct {
+    TaskHandle_t handle;
+    uint32_t run_time;
+} run_mark_t;
+
+static run_mark_t last_run[RUNTIME_STATS_MAX_TASKS];
+static uint8_t last_run_count = 0;
+static uint32_t last_total = 0;
+
+static uint32_t previous_run(TaskHandle_t handle) {
+    for (uint8_t i = 0; i < last_run_count; i++) {
+        if (last_run[i].handle == handle) return last_run[i].run_time;
+    }
+    return 0;   // Tarefa nova: todo o contador é da janela
+}
+
+static int16_t share(uint32_t part, uint32_t total) {
+    if (total == 0) return RUNTIME_STATS_UNKNOWN;
+    uint64_t pct = (uint64_t)part * 100 / total;
+    return pct > 100 ? 100 : (int16_t)pct;
+}
+#else
+// Sem run-time stats: ticks em que o core chegou a rodar a tarefa IDLE
+// (cota superior do ocioso: basta um instante no IDLE para o tick contar)
+static volatile uint32_t idle_ticks[RUNTIME_STATS_MAX_CORES];
+static TickType_t idle_last_tick[RUNTIME_STATS_MAX_CORES];
+static uint32_t idle_mark[RUNTIME_STATS_MAX_CORES];
+static TickType_t window_start_tick = 0;
+
+static bool count_idle(int core) {
+    TickType_t tick = xTaskGetTickCount();
+    if (tick != idle_last_tick[core]) {
+        idle_last_tick[core] = tick;
+        idle_ticks[core]++;
+    }
+    return true;    // Segue para o WAITI até a próxima interrupção
+}
+
+static bool idle_hook_core0(void) { return count_idle(0); }
+static bool idle_hook_core1(void) { return count_idle(1); }
+#endif
+
+static void install_cpu_source(void) {
+#if !configGENERATE_RUN_TIME_STATS
+    static const esp_freertos_idle_cb_t hooks[RUNTIME_STATS_MAX_CORES] = {idle_hook_core0, idle_hook_core1};
+    window_start_tick = xTaskGetTickCount();
+    for (int core = 0; core < CORES; core++) {
+        esp_register_freertos_idle_hook_for_cpu(hooks[core], core);
+    }
+#endif
+}
+
+static void sample_tasks(void) {
+    snapshot.cores = CORES;
+    snapshot.per_task_cpu = configGENERATE_RUN_TIME_STATS;
+    snapshot.cpu_estimated = !configGENERATE_RUN_TIME_STATS;
+    snapshot.tasks_total = (uint16_t)uxTaskGetNumberOfTasks();
+    snapshot.task_count = 0;
+    for (int core = 0; core < RUNTIME_STATS_MAX_CORES; core++) {
+        snapshot.cpu_pct[core] = RUNTIME_STATS_UNKNOWN;
+    }
+
+#if configUSE_TRACE_FACILITY
+    run_counter_t total = 0;
+    // 0 se houver mais tarefas que o buffer: janela sem lista (tasks_total mostra)
+    UBaseType_t count = uxTaskGetSystemState(status, RUNTIME_STATS_MAX_TASKS, &total);
+    (void) total;
+
+#if configGENERATE_RUN_TIME_STATS
+    uint32_t total_delta = (uint32_t)total - last_total;
+#endif
+
+    for (UBaseType_t i = 0; i < count; i++) {
+        const TaskStatus_t* task = &status[i];
+        runtime_task_stat_t* out = &snapshot.tasks[i];
+        copy_name(out->name, task->pcTaskName);
+        out->core = task_core(task->xHandle);
+        out->priority = (uint8_t)task->uxCurrentPriority;
+        out->stack_free_min = (uint32_t)task->usStackHighWaterMark;  // ESP-IDF: pilha em bytes
+        out->cpu_pct = RUNTIME_STATS_UNKNOWN;
+
+#if configGENERATE_RUN_TIME_STATS
+        uint32_t run_delta = (uint32_t)task->ulRunTimeCounter - previous_run(task->xHandle);
+        out->cpu_pct = share(run_delta, total_delta);
+
+        // IDLE<n> fixada no core n: o que sobra é a carga do core
+        if (strncmp(task->pcTaskName, "IDLE", 4) == 0 && out->core >= 0 && out->cpu_pct >= 0) {
+            snapshot.cpu_pct[out->core] = 100 - out->cpu_pct;
+        }
+#endif
+    }
+    snapshot.task_count = (uint8_t)count;
+
+#if configGENERATE_RUN_TIME_STATS
+    for (UBaseType_t i = 0; i < count; i++) {
+        last_run[i].handle = status[i].xHandle;
+        last_run[i].run_time = (uint32_t)status[i].ulRunTimeCounter;
+    }
+    last_run_count = (uint8_t)count;
+    last_total = (uint32_t)total;
+#endif
+#endif
+
+#if !configGENERATE_RUN_TIME_STATS
+    TickType_t now = xTaskGetTickCount();
+    uint32_t window_ticks = (uint32_t)(now - window_start_tick);
+    window_start_tick = now;
+    for (int core = 0; core < CORES; core++) {
+        uint32_t ticks = idle_ticks[core];
+        uint32_t idle = ticks - idle_mark[core];
+        idle_mark[core] = ticks;
+        if (window_ticks == 0) continue;
+        snapshot.cpu_pct[core] = idle >= window_ticks ? 0 : (int16_t)(100 - (uint64_t)idle * 100 / window_ticks);
+    }
+#endif
+}
+
+#else   // Build nativo: sem escalonador para medir
+
+static void install_cpu_source(void) {}
+
+static void sample_tasks(void) {
+    snapshot.cores = 0;
+    snapshot.per_task_cpu = false;
+    snapshot.cpu_estimated = false;
+    snapshot.tasks_total = 0;
+    snapshot.task_count = 0;
+    for (int core = 0; core < RUNTIME_STATS_MAX_CORES; core++) {
+        snapshot.cpu_pct[core] = RUNTIME_STATS_UNKNOWN;
+    }
+}
+
+#endif
+
+// ============================================================================
+// API
+// ============================================================================
+
+void runtime_stats_init(void) {
+    if (initialized) return;
+    initialized = true;
+
+    for (int core = 0; core < RUNTIME_STATS_MAX_CORES; core++) {
+        snapshot.cpu_pct[core] = RUNTIME_STATS_UNKNOWN;
+    }
+    window_start_us = now_us();
+    install_cpu_source();
+}
+
+int runtime_stats_timing(const char* name) {
+    int slot = -1;
+    STATS_LOCK();
+    for (uint8_t i = 0; i < timing_count && slot < 0; i++) {
+        if (strcmp(timings[i].name, name) == 0) slot = i;
+    }
+    if (slot < 0 && timing_count < RUNTIME_STATS_MAX_TIMINGS) {
+        timing_acc_t* acc = &timings[timing_count];
+        acc->name = name;
+        acc->count = 0;
+        acc->min_us = UINT32_MAX;
+        acc->max_us = 0;
+        acc->total_us = 0;
+        slot = timing_count++;
+    }
+    STATS_UNLOCK();
+    return slot;
+}
+
+void runtime_stats_record(int slot, uint32_t us) {
+    if (slot < 0 || slot >= timing_count) return;
+
+    STATS_LOCK();
+    timing_acc_t* acc = &timings[slot];
+    acc->count++;
+    acc->total_us += us;
+    if (us < acc->min_us) acc->min_us = us;
+    if (us > acc->max_us) acc->max_us = us;
+    STATS_UNLOCK();
+}
+
+int runtime_stats_gauge(const char* name) {
+    int slot = -1;
+    STATS_LOCK();
+    for (uint8_t i = 0; i < gauge_count && slot < 0; i++) {
+        if (strcmp(gauges[i].name, name) == 0) slot = i;
+    }
+    if (slot < 0 && gauge_count < RUNTIME_STATS_MAX_GAUGES) {
+        gauges[gauge_count].name = name;
+        gauges[gauge_count].value = 0;
+        gauges[gauge_count].max = 0;
+        slot = gauge_count++;
+    }
+    STATS_UNLOCK();
+    return slot;
+}
+
+void runtime_stats_set(int slot, uint32_t value) {
+    if (slot < 0 || slot >= gauge_count) return;
+
+    STATS_LOCK();
+    gauges[slot].value = value;
+    if (value > gauges[slot].max) gauges[slot].max = value;
+    STATS_UNLOCK();
+}
+
+void runtime_stats_sample(void) {
+    int64_t now = now_us();
+    snapshot.window_ms = (uint32_t)((now - window_start_us) / 1000);
+    window_start_us = now;
+
+    sample_tasks();
+
+    // Cópia curta sob o lock; acumuladores recomeçam para a próxima janela
+    STATS_LOCK();
+    for (uint8_t i = 0; i < timing_count; i++) {
+        timing_acc_t* acc = &timings[i];
+        runtime_timing_t* out = &snapshot.timings[i];
+        out->name = acc->name;
+        out->count = acc->count;
+        out->min_us = acc->count ? acc->min_us : 0;
+        out->avg_us = acc->count ? (uint32_t)(acc->total_us / acc->count) : 0;
+        out->max_us = acc->max_us;
+
+        acc->count = 0;
+        acc->min_us = UINT32_MAX;
+        acc->max_us = 0;
+        acc->total_us = 0;
+    }
+    snapshot.timing_count = timing_count;
+
+    for (uint8_t i = 0; i < gauge_count; i++) {
+        snapshot.gauges[i] = gauges[i];
+        gauges[i].max = gauges[i].value;    // Pico da próxima janela parte do valor atual
+    }
+    snapshot.gauge_count = gauge_count;
+    STATS_UNLOCK();
+}
+
+const runtime_stats_snapshot_t* runtime_stats_get(void) {
+    return &snapshot;
+}
+
+int runtime_stats_cpu_pct(void) {
+    // Idle hook não vê rajadas menores que um tick: não vira cpu_usage
+    if (snapshot.cpu_estimated) return RUNTIME_STATS_UNKNOWN;
+
+    int sum = 0;
+    int known = 0;
+    for (uint8_t core = 0; core < snapshot.cores; core++) {
+        if (snapshot.cpu_pct[core] == RUNTIME_STATS_UNKNOWN) continue;
+        sum += snapshot.cpu_pct[core];
+        known++;
+    }
+    return known ? sum / known : RUNTIME_STATS_UNKNOWN;
+}
+
+// ============================================================================
+// JSON (snprintf num buffer do chamador)
+// ============================================================================
+
+typedef struct {
+    char* buf;
+    size_t len;
+    size_t pos;
+    bool overflow;
+} json_out_t;
+
+static void emit(json_out_t* out, const char* fmt, ...) {
+    if (out->overflow) return;
+
+    va_list args;
+    va_start(args, fmt);
+    int written = vsnprintf(out->buf + out->pos, out->len - out->pos, fmt, args);
+    va_end(args);
+
+    if (written < 0 || (size_t)written >= out->len - out->pos) {
+        out->overflow = true;
+        return;
+    }
+    out->pos += (size_t)written;
+}
+
+int runtime_stats_to_json(char* buf, size_t len) {
+    if (!buf || len == 0) return -1;
+
+    json_out_t out = {buf, len, 0, false};
+    const runtime_stats_snapshot_t* s = &snapshot;
+
+    emit(&out, "{\"window_ms\":%lu,\"cpu\":[", (unsigned long)s->window_ms);
+    for (uint8_t core = 0; core < s->cores; core++) {
+        emit(&out, core ? ",%d" : "%d", s->cpu_pct[core]);
+    }
+    emit(&out, "]");
+    if (s->cpu_estimated) {
+        emit(&out, ",\"cpu_estimated\":true");
+    }
+    emit(&out, ",\"tasks_total\":%u,\"tasks\":[", (unsigned)s->tasks_total);
+    for (uint8_t i = 0; i < s->task_count; i++) {
+        const runtime_task_stat_t* task = &s->tasks[i];
+        emit(&out, "%s{\"name\":\"%s\",\"core\":%d,\"prio\":%u", i ? "," : "",
+             task->name, task->core, (unsigned)task->priority);
+        if (task->cpu_pct != RUNTIME_STATS_UNKNOWN) {
+            emit(&out, ",\"cpu\":%d", task->cpu_pct);
+        }
+        emit(&out, ",\"stack_free\":%lu}", (unsigned long)task->stack_free_min);
+    }
+    emit(&out, "],\"timings\":{");
+    for (uint8_t i = 0; i < s->timing_count; i++) {
+        const runtime_timing_t* t = &s->timings[i];
+        emit(&out, "%s\"%s\":{\"count\":%lu,\"min_us\":%lu,\"avg_us\":%lu,\"max_us\":%lu}", i ? "," : "",
+             t->name, (unsigned long)t->count, (unsigned long)t->min_us,
+             (unsigned long)t->avg_us, (unsigned long)t->max_us);
+    }
+    emit(&out, "},\"gauges\":{");
+    for (uint8_t i = 0; i < s->gauge_count; i++) {
+        const runtime_gauge_t* g = &s->gauges[i];
+        emit(&out, "%s\"%s\":{\"value\":%lu,\"max\":%lu}", i ? "," : "",
+             g->name, (unsigned long)g->value, (unsigned long)g->max);
+    }
+    emit(&out, "}}");
+
+    if (out.overflow) {
+        buf[0] = '\0';
+        return -1;
+    }
+    return (int)out.pos;
+}
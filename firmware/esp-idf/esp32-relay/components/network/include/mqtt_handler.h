@@ -86,6 +86,12 @@ esp_err_t mqtt_client_stop(void);
  */
 bool mqtt_client_is_connected(void);
 
+/**
+ * Bytes waiting in the MQTT outbox (QoS 1 not yet acknowledged)
+ * @return Outbox size, 0 if the client is not initialized
+ */
+int mqtt_client_get_outbox_size(void);
+
 /**
  * Get current MQTT state
  * @return Current MQTT state
@@ -40,7 +40,8 @@ typedef enum {
     RELAY_CMD_ON,       // Ligar
     RELAY_CMD_OFF,      // Desligar
     RELAY_CMD_TOGGLE,   // Alternar
-    RELAY_CMD_ALL       // Todos os relés
+    RELAY_CMD_ALL,      // Todos os relés
+    RELAY_CMD_GROUP     // Vários canais com estados próprios, aplicados juntos
 } relay_cmd_t;
 
 // Comandos gerais
@@ -56,11 +57,14 @@ typedef struct {
     mqtt_cmd_type_t type;
     union {
         struct {
-            int channel;           // 1-16 ou -1 para "all"
-            relay_cmd_t cmd;       // ON, OFF, TOGGLE
+            int channel;           // 1-16, -1 para "all" ou 0 em grupo
+            relay_cmd_t cmd;       // ON, OFF, TOGGLE, GROUP
+            uint32_t group_mask;   // GROUP: bit (canal - 1) = canal afetado
+            uint32_t group_states; // GROUP: bit (canal - 1) = ligar
             bool is_momentary;     // Relé momentâneo
             char source[32];       // Origem do comando
             char user[32];         // Usuário que executou (opcional)
+            char trace_id[64];     // Id do comando no display (ecoado no status e em /response)
         } relay;
         struct {
             general_cmd_t cmd;     // RESET, STATUS, REBOOT, OTA
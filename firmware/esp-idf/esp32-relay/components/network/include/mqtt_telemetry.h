@@ -12,6 +12,9 @@ esp_err_t mqtt_publish_telemetry_event(telemetry_event_t* event);
 esp_err_t mqtt_publish_relay_telemetry(int channel, bool state, const char* trigger, const char* source);
 esp_err_t mqtt_publish_safety_shutoff(int channel, const char* reason, float timeout);
 
+// Fecha a janela do runtime_stats e publica como evento "runtime"
+esp_err_t mqtt_publish_runtime_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include "esp_log.h"
 #include "esp_system.h"
 #include "esp_timer.h"
+#include "esp_random.h"
 #include "esp_http_client.h"
 #include "cJSON.h"
 #include <mqtt_client.h>
@@ -24,9 +25,13 @@
 #include "config_manager.h"
 #include "wifi_manager.h"
 #include "relay_control.h"
+#include "runtime_stats.h"
 
 static const char *TAG = "MQTT_CLIENT";
 
+// Tempo de processamento de cada mensagem recebida (runtime_stats)
+static int command_timing = -1;
+
 // Macro para MIN se não estiver definido
 #ifndef MIN
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
@@ -50,11 +55,20 @@ static mqtt_connected_cb_t mqtt_connected_callback = NULL;
 static mqtt_disconnected_cb_t mqtt_disconnected_callback = NULL;
 static mqtt_command_cb_t mqtt_command_callback = NULL;
 
+// Ordem dos ecos por canal: displays descartam status com seq já vista.
+// boot muda a cada reinício, para a contagem recomeçada não parecer antiga
+static uint32_t echo_boot_id = 0;
+static uint32_t echo_seq[RELAY_MAX_CHANNELS];
+
 // Forward declarations
 static void mqtt_event_handler(void *handler_args, esp_event_base_t base, int32_t event_id, void *event_data);
 static void telemetry_timer_callback(TimerHandle_t xTimer);
 static esp_err_t parse_mqtt_command(const char* data, size_t data_len, mqtt_cmd_data_t* cmd_data);
 static void execute_mqtt_command(mqtt_cmd_data_t* cmd_data);
+static esp_err_t execute_relay_command(const mqtt_command_struct_t* cmd, int64_t rx_us, int64_t parsed_us);
+static esp_err_t publish_relay_echo(int channel, bool state, const mqtt_command_struct_t* cmd,
+                                    int64_t rx_us, int64_t parsed_us, int64_t exec_start_us, int64_t exec_end_us);
+static esp_err_t publish_command_response(const mqtt_command_struct_t* cmd, esp_err_t result, const char* error);
 
 /**
  * MQTT event handler
@@ -121,7 +135,11 @@ static void mqtt_event_handler(void *handler_args, esp_event_base_t base, int32_
             ESP_LOGI(TAG, "Data: %.*s", event->data_len, event->data);
             
             // Process received command
-            mqtt_process_command(event->topic, event->data, event->data_len);
+            {
+                int64_t start_us = esp_timer_get_time();
+                mqtt_process_command(event->topic, event->data, event->data_len);
+                runtime_stats_record(command_timing, (uint32_t)(esp_timer_get_time() - start_us));
+            }
             break;
             
         case MQTT_EVENT_ERROR:
@@ -150,6 +168,8 @@ esp_err_t mqtt_client_init(void) {
         return ESP_OK;
     }
     
+    command_timing = runtime_stats_timing("mqtt_rx");
+    
     device_config_t* config = config_get();
     mqtt_config_t mqtt_config = {0};
     
@@ -316,6 +336,16 @@ bool mqtt_client_is_connected(void) {
     return (current_mqtt_state == MQTT_STATE_CONNECTED);
 }
 
+/**
+ * Get MQTT outbox size
+ */
+int mqtt_client_get_outbox_size(void) {
+    if (mqtt_client_handle == NULL) {
+        return 0;
+    }
+    return esp_mqtt_client_get_outbox_size(mqtt_client_handle);
+}
+
 /**
  * Get current MQTT state
  */
@@ -551,6 +581,9 @@ esp_err_t mqtt_process_command(const char* topic, const char* data, size_t data_
         return ESP_ERR_INVALID_ARG;
     }
     
+    // Início do rastreio no relé (stages ecoados ao display no status)
+    int64_t rx_us = esp_timer_get_time();
+    
     // Criar string null-terminated para o payload
     char payload[MQTT_MAX_PAYLOAD_LEN];
     size_t copy_len = MIN(data_len, sizeof(payload) - 1);
@@ -581,9 +614,20 @@ esp_err_t mqtt_process_command(const char* topic, const char* data, size_t data_
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to process MQTT command: %s", esp_err_to_name(ret));
         mqtt_publish_error(MQTT_ERR_COMMAND_FAILED, "command execution failed");
+        publish_command_response(&command, ret, "invalid command");
         return ret;
     }
     
+    // mqtt_process_command_struct só valida; o acionamento é feito aqui
+    if (command.type == MQTT_CMD_RELAY) {
+        ret = execute_relay_command(&command, rx_us, esp_timer_get_time());
+        publish_command_response(&command, ret, ret == ESP_OK ? NULL : "relay actuation failed");
+        if (ret != ESP_OK) {
+            mqtt_publish_error(MQTT_ERR_HARDWARE_FAULT, "relay actuation failed");
+            return ret;
+        }
+    }
+    
     // Manter compatibilidade com callback antigo se definido
     if (mqtt_command_callback) {
         mqtt_cmd_data_t legacy_cmd = {0};
@@ -594,6 +638,169 @@ esp_err_t mqtt_process_command(const char* topic, const char* data, size_t data_
     return ESP_OK;
 }
 
+/**
+ * Execute relay command from /relays/set and echo the result
+ */
+static esp_err_t execute_relay_command(const mqtt_command_struct_t* cmd, int64_t rx_us, int64_t parsed_us) {
+    // Grupo: uma única atualização de GPIO, depois o eco de cada canal
+    if (cmd->data.relay.cmd == RELAY_CMD_GROUP) {
+        uint32_t mask = cmd->data.relay.group_mask;
+        uint32_t states = cmd->data.relay.group_states;
+        
+        int64_t exec_start_us = esp_timer_get_time();
+        esp_err_t ret = relay_set_group(mask, states);
+        int64_t exec_end_us = esp_timer_get_time();
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        
+        for (int channel = 1; channel <= RELAY_MAX_CHANNELS; channel++) {
+            if (!(mask & (1UL << (channel - 1)))) continue;
+            publish_relay_echo(channel, (states & (1UL << (channel - 1))) != 0, cmd,
+                               rx_us, parsed_us, exec_start_us, exec_end_us);
+        }
+        return ESP_OK;
+    }
+    
+    int first = cmd->data.relay.channel == -1 ? 1 : cmd->data.relay.channel;
+    int last = cmd->data.relay.channel == -1 ? RELAY_MAX_CHANNELS : cmd->data.relay.channel;
+    esp_err_t result = ESP_OK;
+    
+    for (int channel = first; channel <= last; channel++) {
+        uint8_t index = channel - 1;  // relay_control usa índice 0-based
+        if (!relay_is_valid_channel(index)) {
+            ESP_LOGE(TAG, "Invalid relay channel: %d", channel);
+            result = ESP_ERR_INVALID_ARG;
+            continue;
+        }
+        
+        uint8_t state;
+        if (cmd->data.relay.cmd == RELAY_CMD_TOGGLE) {
+            state = relay_get_state(index) == RELAY_STATE_ON ? RELAY_STATE_OFF : RELAY_STATE_ON;
+        } else {
+            state = cmd->data.relay.cmd == RELAY_CMD_ON ? RELAY_STATE_ON : RELAY_STATE_OFF;
+        }
+        
+        int64_t exec_start_us = esp_timer_get_time();
+        esp_err_t ret = relay_set_state(index, state);
+        int64_t exec_end_us = esp_timer_get_time();
+        if (ret != ESP_OK) {
+            result = ret;
+            continue;
+        }
+        
+        // Soltar momentâneo encerra o monitor de heartbeat do canal
+        if (cmd->data.relay.is_momentary && state == RELAY_STATE_OFF) {
+            mqtt_momentary_stop(channel);
+        }
+        
+        publish_relay_echo(channel, state == RELAY_STATE_ON, cmd, rx_us, parsed_us, exec_start_us, exec_end_us);
+    }
+    
+    return result;
+}
+
+/**
+ * Publish per-channel echo: autocore/devices/{uuid}/relays/status
+ * Carries the command trace_id and the relay-side stage durations (us)
+ */
+static esp_err_t publish_relay_echo(int channel, bool state, const mqtt_command_struct_t* cmd,
+                                    int64_t rx_us, int64_t parsed_us, int64_t exec_start_us, int64_t exec_end_us) {
+    device_config_t* config = config_get();
+    if (!config || !mqtt_client_is_connected()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    mqtt_base_message_t msg;
+    mqtt_init_base_message(&msg, config->device_id);
+    cJSON *json = mqtt_create_base_json(&msg);
+    if (!json) {
+        return ESP_ERR_NO_MEM;
+    }
+    
+    if (echo_boot_id == 0) {
+        echo_boot_id = esp_random() | 1;
+    }
+    
+    cJSON_AddNumberToObject(json, "channel", channel);
+    cJSON_AddStringToObject(json, "state", state ? "ON" : "OFF");
+    cJSON_AddStringToObject(json, "device_id", config->device_id);
+    cJSON_AddNumberToObject(json, "boot", echo_boot_id);
+    cJSON_AddNumberToObject(json, "seq", ++echo_seq[channel - 1]);
+    if (cmd->data.relay.source[0] != '\0') {
+        cJSON_AddStringToObject(json, "source", cmd->data.relay.source);
+    }
+    
+    if (cmd->data.relay.trace_id[0] != '\0') {
+        cJSON_AddStringToObject(json, "trace_id", cmd->data.relay.trace_id);
+        cJSON_AddNumberToObject(json, "relay_parse_us", (double)(parsed_us - rx_us));
+        cJSON_AddNumberToObject(json, "relay_exec_us", (double)(exec_end_us - exec_start_us));
+        cJSON_AddNumberToObject(json, "relay_total_us", (double)(esp_timer_get_time() - rx_us));
+    }
+    
+    char topic[MQTT_MAX_TOPIC_LEN];
+    snprintf(topic, sizeof(topic), "autocore/devices/%s/relays/status", config->device_id);
+    
+    char *json_string = cJSON_PrintUnformatted(json);
+    cJSON_Delete(json);
+    if (!json_string) {
+        return ESP_ERR_NO_MEM;
+    }
+    
+    int msg_id = esp_mqtt_client_publish(mqtt_client_handle, topic, json_string, strlen(json_string), QOS_STATUS, 0);
+    free(json_string);
+    return (msg_id >= 0) ? ESP_OK : ESP_FAIL;
+}
+
+/**
+ * Publish command acknowledgement: autocore/devices/{uuid}/response
+ * Only for commands carrying a request id; retries from the display
+ * with the same id get the same answer (ON/OFF are absolute states)
+ */
+static esp_err_t publish_command_response(const mqtt_command_struct_t* cmd, esp_err_t result, const char* error) {
+    if (cmd->type != MQTT_CMD_RELAY || cmd->data.relay.trace_id[0] == '\0') {
+        return ESP_OK;
+    }
+    
+    device_config_t* config = config_get();
+    if (!config || !mqtt_client_is_connected()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    mqtt_base_message_t msg;
+    mqtt_init_base_message(&msg, config->device_id);
+    cJSON *json = mqtt_create_base_json(&msg);
+    if (!json) {
+        return ESP_ERR_NO_MEM;
+    }
+    
+    cJSON_AddStringToObject(json, "request_id", cmd->data.relay.trace_id);
+    if (cmd->data.relay.cmd == RELAY_CMD_GROUP) {
+        cJSON_AddStringToObject(json, "command", "relay_group");
+        cJSON_AddNumberToObject(json, "mask", cmd->data.relay.group_mask);
+    } else {
+        cJSON_AddStringToObject(json, "command", "relay_set");
+        cJSON_AddNumberToObject(json, "channel", cmd->data.relay.channel);
+    }
+    cJSON_AddBoolToObject(json, "success", result == ESP_OK);
+    if (result != ESP_OK) {
+        cJSON_AddStringToObject(json, "error", error ? error : esp_err_to_name(result));
+    }
+    
+    char topic[MQTT_MAX_TOPIC_LEN];
+    snprintf(topic, sizeof(topic), "autocore/devices/%s/response", config->device_id);
+    
+    char *json_string = cJSON_PrintUnformatted(json);
+    cJSON_Delete(json);
+    if (!json_string) {
+        return ESP_ERR_NO_MEM;
+    }
+    
+    int msg_id = esp_mqtt_client_publish(mqtt_client_handle, topic, json_string, strlen(json_string), QOS_COMMANDS, 0);
+    free(json_string);
+    return (msg_id >= 0) ? ESP_OK : ESP_FAIL;
+}
+
 /**
  * Parse MQTT command JSON
  */
@@ -32,6 +32,8 @@ static esp_timer_handle_t timeout_timer = NULL;
 // Forward declarations
 static void timeout_check_callback(void *arg);
 static void momentary_check_timer_cb(void* arg);
+static void refresh_channel(const cJSON *channel_json, const cJSON *sequence_json,
+                            const char *source_uuid);
 
 // Inicializa sistema de heartbeat momentâneo v2.2.0
 void mqtt_momentary_init(void)
@@ -69,6 +71,54 @@ void mqtt_momentary_init(void)
     }
 }
 
+// Renova o monitor de um canal (chamado com momentary_mutex adquirido)
+static void refresh_channel(const cJSON *channel_json, const cJSON *sequence_json,
+                            const char *source_uuid)
+{
+    if (!channel_json || !cJSON_IsNumber(channel_json) ||
+        !sequence_json || !cJSON_IsNumber(sequence_json)) {
+        ESP_LOGE(TAG, "Missing required heartbeat fields");
+        mqtt_publish_invalid_command_error("heartbeat", "missing required fields");
+        return;
+    }
+    
+    int channel = channel_json->valueint;
+    int sequence = sequence_json->valueint;
+    
+    // Validar canal
+    if (channel < 1 || channel > 16) {
+        ESP_LOGE(TAG, "Invalid channel: %d", channel);
+        mqtt_publish_invalid_channel_error(channel);
+        return;
+    }
+    
+    heartbeat_monitor_t *monitor = &monitors[channel - 1];
+    
+    if (!monitor->active || strcmp(monitor->source_uuid, source_uuid) != 0) {
+        // Novo heartbeat ou nova fonte
+        monitor->active = true;
+        monitor->channel = channel;
+        monitor->sequence = 0;
+        strncpy(monitor->source_uuid, source_uuid, sizeof(monitor->source_uuid) - 1);
+        monitor->source_uuid[sizeof(monitor->source_uuid) - 1] = '\0';
+        ESP_LOGI(TAG, "Started heartbeat monitoring for channel %d from %s", 
+                 channel, source_uuid);
+    }
+    
+    // Verificar sequência
+    if (monitor->sequence > 0 && sequence != monitor->sequence + 1) {
+        ESP_LOGW(TAG, "Heartbeat sequence gap on channel %d. Expected %" PRIu32 ", got %d", 
+                 channel, monitor->sequence + 1, sequence);
+    }
+    
+    monitor->sequence = sequence;
+    monitor->last_received = esp_timer_get_time() / 1000; // Converter para ms
+    
+    // Manter relé ligado se for momentâneo
+    // TODO: Verificar se é relé momentâneo via relay_control
+    relay_turn_on(channel - 1); // relay_control usa índice 0-based
+}
+
 // Processa heartbeat recebido conforme v2.2.0
 void mqtt_momentary_handle_heartbeat(const char *payload)
 {
@@ -94,58 +144,34 @@ void mqtt_momentary_handle_heartbeat(const char *payload)
     }
     
     // Extrair campos obrigatórios
-    cJSON *channel_json = cJSON_GetObjectItem(root, "channel");
+    // Formato em lote: {"source_uuid", "channels":[{"channel","sequence"}, ...]}
+    // Formato de canal único (legado): {"source_uuid", "channel", "sequence"}
     cJSON *source_json = cJSON_GetObjectItem(root, "source_uuid");
-    cJSON *sequence_json = cJSON_GetObjectItem(root, "sequence");
+    cJSON *channels_json = cJSON_GetObjectItem(root, "channels");
     
-    if (!channel_json || !cJSON_IsNumber(channel_json) ||
-        !source_json || !cJSON_IsString(source_json) ||
-        !sequence_json || !cJSON_IsNumber(sequence_json)) {
+    if (!source_json || !cJSON_IsString(source_json) ||
+        (channels_json && !cJSON_IsArray(channels_json))) {
         ESP_LOGE(TAG, "Missing required heartbeat fields");
         mqtt_publish_invalid_command_error("heartbeat", "missing required fields");
         cJSON_Delete(root);
         return;
     }
     
-    int channel = channel_json->valueint;
     const char *source_uuid = source_json->valuestring;
-    int sequence = sequence_json->valueint;
     
-    // Validar canal
-    if (channel < 1 || channel > 16) {
-        ESP_LOGE(TAG, "Invalid channel: %d", channel);
-        mqtt_publish_invalid_channel_error(channel);
-        cJSON_Delete(root);
-        return;
-    }
-    
-    // Processar heartbeat
+    // Processar heartbeat: um mutex para o lote inteiro
     if (xSemaphoreTake(momentary_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        heartbeat_monitor_t *monitor = &monitors[channel - 1];
-        
-        if (!monitor->active || strcmp(monitor->source_uuid, source_uuid) != 0) {
-            // Novo heartbeat ou nova fonte
-            monitor->active = true;
-            monitor->channel = channel;
-            strncpy(monitor->source_uuid, source_uuid, sizeof(monitor->source_uuid) - 1);
-            monitor->source_uuid[sizeof(monitor->source_uuid) - 1] = '\0';
-            ESP_LOGI(TAG, "Started heartbeat monitoring for channel %d from %s", 
-                     channel, source_uuid);
-        }
-        
-        // Verificar sequência
-        if (monitor->sequence > 0 && sequence != monitor->sequence + 1) {
-            ESP_LOGW(TAG, "Heartbeat sequence gap. Expected %" PRIu32 ", got %d", 
-                     monitor->sequence + 1, sequence);
+        if (channels_json) {
+            cJSON *entry = NULL;
+            cJSON_ArrayForEach(entry, channels_json) {
+                refresh_channel(cJSON_GetObjectItem(entry, "channel"),
+                                cJSON_GetObjectItem(entry, "sequence"), source_uuid);
+            }
+        } else {
+            refresh_channel(cJSON_GetObjectItem(root, "channel"),
+                            cJSON_GetObjectItem(root, "sequence"), source_uuid);
         }
         
-        monitor->sequence = sequence;
-        monitor->last_received = esp_timer_get_time() / 1000; // Converter para ms
-        
-        // Manter relé ligado se for momentâneo
-        // TODO: Verificar se é relé momentâneo via relay_control
-        relay_turn_on(channel - 1); // relay_control usa índice 0-based
-        
         xSemaphoreGive(momentary_mutex);
     } else {
         ESP_LOGE(TAG, "Failed to acquire mutex for heartbeat processing");
@@ -10,6 +10,8 @@
 
 static const char *TAG = "MQTT_PROTOCOL";
 
+static esp_err_t parse_relay_options(cJSON* json, mqtt_command_struct_t* cmd);
+
 #define MQTT_PROTOCOL_VERSION "2.2.0"
 
 // QoS Levels conforme v2.2.0
@@ -267,12 +269,60 @@ esp_err_t mqtt_parse_command(const char* topic, const char* payload, mqtt_comman
     return ret;
 }
 
+/**
+ * Lista "channels":[{"channel":N,"state":bool}] de um comando de grupo
+ */
+static esp_err_t parse_relay_group(cJSON* channels_json, mqtt_command_struct_t* cmd) {
+    cmd->data.relay.channel = 0;
+    cmd->data.relay.cmd = RELAY_CMD_GROUP;
+    
+    cJSON *entry;
+    cJSON_ArrayForEach(entry, channels_json) {
+        cJSON *channel_json = cJSON_GetObjectItem(entry, "channel");
+        cJSON *state_json = cJSON_GetObjectItem(entry, "state");
+        if (!cJSON_IsNumber(channel_json) || !cJSON_IsBool(state_json)) {
+            ESP_LOGE(TAG, "Invalid group entry");
+            return ESP_ERR_INVALID_ARG;
+        }
+        
+        int channel = channel_json->valueint;
+        if (channel < 1 || channel > 32) {
+            ESP_LOGE(TAG, "Invalid group channel: %d", channel);
+            return ESP_ERR_INVALID_ARG;
+        }
+        
+        // Canal repetido: vale o último
+        uint32_t bit = 1UL << (channel - 1);
+        cmd->data.relay.group_mask |= bit;
+        if (cJSON_IsTrue(state_json)) {
+            cmd->data.relay.group_states |= bit;
+        } else {
+            cmd->data.relay.group_states &= ~bit;
+        }
+    }
+    
+    if (cmd->data.relay.group_mask == 0) {
+        ESP_LOGE(TAG, "Empty group command");
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    return ESP_OK;
+}
+
 /**
  * Parser de comandos de relé
  */
 esp_err_t mqtt_parse_relay_command(cJSON* json, mqtt_command_struct_t* cmd) {
     if (!json || !cmd) return ESP_ERR_INVALID_ARG;
     
+    // Grupo (cenas, "todas as luzes"): lista de canais no lugar de channel/state
+    cJSON *channels_json = cJSON_GetObjectItem(json, "channels");
+    if (cJSON_IsArray(channels_json)) {
+        esp_err_t ret = parse_relay_group(channels_json, cmd);
+        if (ret != ESP_OK) return ret;
+        return parse_relay_options(json, cmd);
+    }
+    
     // Extrair channel
     cJSON *channel_json = cJSON_GetObjectItem(json, "channel");
     if (!channel_json) {
@@ -289,32 +339,61 @@ esp_err_t mqtt_parse_relay_command(cJSON* json, mqtt_command_struct_t* cmd) {
         return ESP_ERR_INVALID_ARG;
     }
     
-    // Extrair command
+    // Extrair command ("on"/"off"/"toggle"); o display envia "state" booleano
     cJSON *command_json = cJSON_GetObjectItem(json, "command");
-    if (!command_json || !cJSON_IsString(command_json)) {
-        ESP_LOGE(TAG, "Missing or invalid command field");
-        return ESP_ERR_INVALID_ARG;
-    }
-    
-    const char *cmd_str = command_json->valuestring;
-    if (strcmp(cmd_str, "on") == 0) {
-        cmd->data.relay.cmd = RELAY_CMD_ON;
-    } else if (strcmp(cmd_str, "off") == 0) {
-        cmd->data.relay.cmd = RELAY_CMD_OFF;
-    } else if (strcmp(cmd_str, "toggle") == 0) {
-        cmd->data.relay.cmd = RELAY_CMD_TOGGLE;
+    cJSON *state_json = cJSON_GetObjectItem(json, "state");
+    if (!cJSON_IsString(command_json)) {
+        if (!cJSON_IsBool(state_json)) {
+            ESP_LOGE(TAG, "Missing or invalid command field");
+            return ESP_ERR_INVALID_ARG;
+        }
+        cmd->data.relay.cmd = cJSON_IsTrue(state_json) ? RELAY_CMD_ON : RELAY_CMD_OFF;
     } else {
-        ESP_LOGE(TAG, "Unknown relay command: %s", cmd_str);
-        return ESP_ERR_INVALID_ARG;
+        const char *cmd_str = command_json->valuestring;
+        if (strcmp(cmd_str, "on") == 0) {
+            cmd->data.relay.cmd = RELAY_CMD_ON;
+        } else if (strcmp(cmd_str, "off") == 0) {
+            cmd->data.relay.cmd = RELAY_CMD_OFF;
+        } else if (strcmp(cmd_str, "toggle") == 0) {
+            cmd->data.relay.cmd = RELAY_CMD_TOGGLE;
+        } else {
+            ESP_LOGE(TAG, "Unknown relay command: %s", cmd_str);
+            return ESP_ERR_INVALID_ARG;
+        }
     }
     
+    return parse_relay_options(json, cmd);
+}
+
+/**
+ * Campos opcionais comuns a comandos de canal e de grupo
+ */
+static esp_err_t parse_relay_options(cJSON* json, mqtt_command_struct_t* cmd) {
     // Extrair campos opcionais
     cJSON *momentary_json = cJSON_GetObjectItem(json, "momentary");
     if (momentary_json && cJSON_IsBool(momentary_json)) {
         cmd->data.relay.is_momentary = cJSON_IsTrue(momentary_json);
     }
     
+    cJSON *function_json = cJSON_GetObjectItem(json, "function_type");
+    if (function_json && cJSON_IsString(function_json) &&
+        strcmp(function_json->valuestring, "momentary") == 0) {
+        cmd->data.relay.is_momentary = true;
+    }
+    
+    // request_id: id do comando no display; responde em /response com ele
+    cJSON *trace_json = cJSON_GetObjectItem(json, "trace_id");
+    if (!trace_json || !cJSON_IsString(trace_json)) {
+        trace_json = cJSON_GetObjectItem(json, "request_id");
+    }
+    if (trace_json && cJSON_IsString(trace_json)) {
+        strncpy(cmd->data.relay.trace_id, trace_json->valuestring, sizeof(cmd->data.relay.trace_id) - 1);
+    }
+    
     cJSON *source_json = cJSON_GetObjectItem(json, "source");
+    if (!source_json || !cJSON_IsString(source_json)) {
+        source_json = cJSON_GetObjectItem(json, "source_uuid");
+    }
     if (source_json && cJSON_IsString(source_json)) {
         strncpy(cmd->data.relay.source, source_json->valuestring, sizeof(cmd->data.relay.source) - 1);
     }
@@ -382,6 +461,7 @@ const char* relay_cmd_to_string(relay_cmd_t cmd) {
         case RELAY_CMD_OFF: return "off";
         case RELAY_CMD_TOGGLE: return "toggle";
         case RELAY_CMD_ALL: return "all";
+        case RELAY_CMD_GROUP: return "group";
         default: return "unknown";
     }
 }
@@ -396,6 +476,7 @@ relay_cmd_t string_to_relay_cmd(const char* str) {
     if (strcmp(str, "off") == 0) return RELAY_CMD_OFF;
     if (strcmp(str, "toggle") == 0) return RELAY_CMD_TOGGLE;
     if (strcmp(str, "all") == 0) return RELAY_CMD_ALL;
+    if (strcmp(str, "group") == 0) return RELAY_CMD_GROUP;
     
     return RELAY_CMD_OFF;
 }
@@ -464,6 +545,18 @@ esp_err_t mqtt_process_relay_command(mqtt_command_struct_t* cmd) {
              relay_cmd_to_string(cmd->data.relay.cmd),
              cmd->data.relay.is_momentary ? "yes" : "no");
     
+    // Grupo: canais já validados no parser, limitados às saídas da placa
+    if (cmd->data.relay.cmd == RELAY_CMD_GROUP) {
+        if (cmd->data.relay.group_mask == 0 || (cmd->data.relay.group_mask >> 16)) {
+            ESP_LOGE(TAG, "Invalid relay group mask: 0x%08lx", (unsigned long)cmd->data.relay.group_mask);
+            return ESP_ERR_INVALID_ARG;
+        }
+        ESP_LOGI(TAG, "Relay group: mask=0x%04lx states=0x%04lx",
+                 (unsigned long)cmd->data.relay.group_mask,
+                 (unsigned long)(cmd->data.relay.group_states & cmd->data.relay.group_mask));
+        return ESP_OK;
+    }
+    
     // Validar canal
     if (cmd->data.relay.channel != -1 && 
         (cmd->data.relay.channel < 1 || cmd->data.relay.channel > 16)) {
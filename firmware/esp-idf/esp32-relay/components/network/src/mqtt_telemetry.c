@@ -1,6 +1,7 @@
 #include "mqtt_protocol.h"
 #include "mqtt_handler.h"
 #include "config_manager.h"
+#include "runtime_stats.h"
 #include "esp_log.h"
 #include <string.h>
 #include <time.h>
@@ -196,4 +197,68 @@ esp_err_t mqtt_publish_safety_shutoff(int channel, const char* reason, float tim
     cJSON_Delete(json);
     
     return ret;
-}
\ No newline at end of file
+}
+
+// Publicar janela do runtime_stats (CPU, pilhas, tempos, outbox MQTT)
+esp_err_t mqtt_publish_runtime_stats(void)
+{
+    // Buffer fixo: o coletor escreve o JSON, o cJSON só o embute
+    static char runtime_json[RUNTIME_STATS_JSON_SIZE];
+    static int outbox_gauge = -1;
+
+    if (outbox_gauge < 0) {
+        outbox_gauge = runtime_stats_gauge("mqtt_outbox");
+    }
+    runtime_stats_set(outbox_gauge, (uint32_t)mqtt_client_get_outbox_size());
+    runtime_stats_sample();
+
+    device_config_t* config = config_get();
+    if (!config) {
+        ESP_LOGE(TAG, "Configuração não disponível");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (runtime_stats_to_json(runtime_json, sizeof(runtime_json)) < 0) {
+        ESP_LOGE(TAG, "Runtime stats não couberam no buffer");
+        return ESP_ERR_NO_MEM;
+    }
+
+    // Tópico de telemetria conforme v2.2.0 (UUID no payload, não no tópico)
+    const char *topic = "autocore/telemetry/relays/data";
+
+    mqtt_base_message_t msg;
+    mqtt_init_base_message(&msg, config->device_id);
+
+    cJSON *json = mqtt_create_base_json(&msg);
+    if (!json) {
+        ESP_LOGE(TAG, "Erro criando JSON base de runtime stats");
+        return ESP_ERR_NO_MEM;
+    }
+
+    cJSON_AddNumberToObject(json, "board_id", 1);
+    cJSON_AddStringToObject(json, "event", "runtime");
+    int cpu = runtime_stats_cpu_pct();
+    if (cpu != RUNTIME_STATS_UNKNOWN) {
+        cJSON_AddNumberToObject(json, "cpu_usage", cpu);
+    }
+    cJSON_AddRawToObject(json, "runtime", runtime_json);
+
+    char *json_string = cJSON_PrintUnformatted(json);
+    if (!json_string) {
+        ESP_LOGE(TAG, "Erro convertendo runtime stats para string");
+        cJSON_Delete(json);
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_err_t ret = mqtt_publish(topic, json_string, QOS_TELEMETRY, false);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Erro publicando runtime stats: %s", esp_err_to_name(ret));
+    } else {
+        ESP_LOGD(TAG, "Runtime stats publicados: %s", json_string);
+    }
+
+    free(json_string);
+    cJSON_Delete(json);
+
+    return ret;
+}
@@ -105,6 +105,16 @@ esp_err_t relay_get_all_states(uint8_t* states);
  */
 esp_err_t relay_set_all_states(const uint8_t* states, uint8_t count);
 
+/**
+ * Set a group of relays atomically
+ * Validates every channel first, then drives all changed GPIOs with one
+ * set/clear register write, so a scene switches in a single update
+ * @param mask Channels to set (bit N = channel N, 0-based)
+ * @param states Desired states (bit N = channel N on)
+ * @return ESP_OK on success; nothing is applied on error
+ */
+esp_err_t relay_set_group(uint32_t mask, uint32_t states);
+
 /**
  * Get relay status information
  * Returns detailed status including GPIO info
@@ -11,6 +11,8 @@
 #include "esp_system.h"
 #include "esp_timer.h"
 #include "driver/gpio.h"
+#include "soc/gpio_reg.h"
+#include "soc/soc.h"
 
 #include "relay_control.h"
 #include "config_manager.h"
@@ -25,6 +27,9 @@ static relay_status_t relay_status[RELAY_MAX_CHANNELS];
 static bool relay_control_initialized = false;
 static uint32_t total_switch_count = 0;
 
+// Escrita dos registradores de saída em grupo (relay_set_group)
+static portMUX_TYPE relay_group_mux = portMUX_INITIALIZER_UNLOCKED;
+
 // Forward declarations
 static esp_err_t relay_configure_gpio(uint8_t channel);
 static void relay_update_switch_count(uint8_t channel);
@@ -241,6 +246,70 @@ esp_err_t relay_set_all_states(const uint8_t* states, uint8_t count) {
     return ret;
 }
 
+/**
+ * Set a group of relays atomically
+ */
+esp_err_t relay_set_group(uint32_t mask, uint32_t states) {
+    if (!relay_control_initialized) {
+        ESP_LOGE(TAG, "Relay control not initialized");
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (mask == 0 || (RELAY_MAX_CHANNELS < 32 && (mask >> RELAY_MAX_CHANNELS))) {
+        ESP_LOGE(TAG, "Invalid relay group mask: 0x%08lx", (unsigned long)mask);
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    // Tudo ou nada: nenhum canal muda se algum GPIO estiver inativo
+    uint32_t set_low = 0, clear_low = 0, set_high = 0, clear_high = 0;
+    uint32_t changed = 0;
+    for (int i = 0; i < RELAY_MAX_CHANNELS; i++) {
+        if (!(mask & (1UL << i))) continue;
+        
+        if (!relay_status[i].gpio_active) {
+            ESP_LOGE(TAG, "GPIO not active for channel %d", i);
+            return ESP_ERR_INVALID_STATE;
+        }
+        
+        uint8_t state = (states & (1UL << i)) ? RELAY_STATE_ON : RELAY_STATE_OFF;
+        if (relay_status[i].state == state) continue;
+        
+        gpio_num_t pin = relay_gpio_pins[i];
+        if (pin < 32) {
+            if (state) set_low |= (1UL << pin); else clear_low |= (1UL << pin);
+        } else {
+            if (state) set_high |= (1UL << (pin - 32)); else clear_high |= (1UL << (pin - 32));
+        }
+        changed |= (1UL << i);
+    }
+    
+    if (changed == 0) {
+        ESP_LOGD(TAG, "Relay group 0x%08lx already in requested state", (unsigned long)mask);
+        return ESP_OK;
+    }
+    
+    // W1TS/W1TC só tocam os bits pedidos: os demais GPIOs não são afetados
+    portENTER_CRITICAL(&relay_group_mux);
+    if (set_low) REG_WRITE(GPIO_OUT_W1TS_REG, set_low);
+    if (clear_low) REG_WRITE(GPIO_OUT_W1TC_REG, clear_low);
+    if (set_high) REG_WRITE(GPIO_OUT1_W1TS_REG, set_high);
+    if (clear_high) REG_WRITE(GPIO_OUT1_W1TC_REG, clear_high);
+    portEXIT_CRITICAL(&relay_group_mux);
+    
+    for (int i = 0; i < RELAY_MAX_CHANNELS; i++) {
+        if (!(changed & (1UL << i))) continue;
+        
+        uint8_t state = (states & (1UL << i)) ? RELAY_STATE_ON : RELAY_STATE_OFF;
+        relay_status[i].state = state;
+        relay_update_switch_count(i);
+        config_set_relay_state(i, state);
+    }
+    
+    ESP_LOGI(TAG, "🔌 Group 0x%08lx: states 0x%08lx (changed 0x%08lx)",
+            (unsigned long)mask, (unsigned long)(states & mask), (unsigned long)changed);
+    return ESP_OK;
+}
+
 /**
  * Get relay status information
  */
@@ -34,6 +34,8 @@
 #include "mqtt_registration.h"
 #include "mqtt_momentary.h"
 #include "relay_control.h"
+#include "mqtt_telemetry.h"
+#include "runtime_stats.h"
 
 // Logging tag
 static const char *TAG = "ESP32_RELAY_MAIN";
@@ -203,9 +205,12 @@ static void mqtt_task(void *pvParameters) {
     
     // MQTT task main loop
     uint32_t telemetry_counter = 0;
+    uint32_t runtime_stats_elapsed_s = 0;
+    int loop_timing = runtime_stats_timing("mqtt_loop");
     while (1) {
         // Task runs every 5 seconds
         vTaskDelay(pdMS_TO_TICKS(5000));
+        int64_t loop_start_us = esp_timer_get_time();
         
         // Check MQTT connection status after delay
         if (mqtt_client_is_connected()) {
@@ -216,6 +221,14 @@ static void mqtt_task(void *pvParameters) {
                 ESP_LOGD(TAG, "📊 Publishing telemetry status");
                 mqtt_publish_status();
             }
+            
+            // CPU, stacks and timings (window = CONFIG_MQTT_RUNTIME_STATS_INTERVAL_S)
+            runtime_stats_elapsed_s += 5;
+            if (runtime_stats_elapsed_s >= CONFIG_MQTT_RUNTIME_STATS_INTERVAL_S) {
+                runtime_stats_elapsed_s = 0;
+                mqtt_publish_runtime_stats();
+            }
+            runtime_stats_record(loop_timing, (uint32_t)(esp_timer_get_time() - loop_start_us));
         } else {
             ESP_LOGW(TAG, "⚠️ MQTT disconnected, attempting reconnection");
             mqtt_client_reconnect();
@@ -235,6 +248,9 @@ void app_main(void) {
     
     ESP_LOGI(TAG, "🚀 ESP32 Relay ESP-IDF v2.0 Starting...");
     
+    // Runtime stats (CPU per core/task, stacks): first window opens at boot
+    runtime_stats_init();
+    
     // Initialize NVS (required for WiFi and config storage)
     ret = nvs_flash_init();
     if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
@@ -45,6 +45,7 @@ show_menu() {
     echo -e "${GREEN}│${NC}  ${WHITE}6.${NC} ℹ️  ${CYAN}Info do Sistema${NC} (Status do ESP32)                   ${GREEN}│${NC}"
     echo -e "${GREEN}│${NC}  ${WHITE}7.${NC} 🔍 ${CYAN}Listar Portas${NC} (Ver portas disponíveis)              ${GREEN}│${NC}"
     echo -e "${GREEN}│${NC}  ${WHITE}8.${NC} ⚙️  ${CYAN}Configurações${NC} (Alterar porta/velocidade)           ${GREEN}│${NC}"
+    echo -e "${GREEN}│${NC}  ${WHITE}9.${NC} ✅ ${CYAN}Verificar${NC} (Firmware + native + testes)            ${GREEN}│${NC}"
     echo -e "${GREEN}│${NC}  ${WHITE}0.${NC} 🚪 ${RED}Sair${NC}                                                 ${GREEN}│${NC}"
     echo -e "${GREEN}└───────────────────────────────────────────────────────────────────┘${NC}"
     echo ""
@@ -147,6 +148,31 @@ compile_only() {
     read -p "Pressione Enter para continuar..."
 }
 
+# Função para verificar antes do PR: firmware, build nativo e testes no host
+verify_all() {
+    local falhas=0
+    local passo
+    
+    for passo in "run -e esp32-tft-display" "run -e native" "test -e native"; do
+        echo -e "${CYAN}🔧 pio $passo${NC}"
+        if pio $passo; then
+            echo -e "${GREEN}✅ pio $passo${NC}"
+        else
+            echo -e "${RED}❌ pio $passo${NC}"
+            falhas=$((falhas + 1))
+        fi
+        echo ""
+    done
+    
+    if [ $falhas -eq 0 ]; then
+        echo -e "${GREEN}✅ Verificação completa sem falhas!${NC}"
+    else
+        echo -e "${RED}❌ $falhas etapa(s) falharam!${NC}"
+    fi
+    
+    read -p "Pressione Enter para continuar..."
+}
+
 # Função para limpar build
 clean_build() {
     echo -e "${CYAN}🧹 Limpando arquivos de build...${NC}"
@@ -318,6 +344,10 @@ main() {
             8)
                 configure_settings
                 ;;
+            9)
+                clear_screen
+                verify_all
+                ;;
             0)
                 echo -e "${GREEN}👋 Até logo!${NC}"
                 exit 0
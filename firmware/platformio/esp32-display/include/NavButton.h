@@ -4,7 +4,15 @@
 #include <lvgl.h>
 #include <Arduino.h>
 #include <functional>
+#include "ui/ScreenArena.h"
 
+/**
+ * Botão da grade de conteúdo. Criado sempre na ScreenArena da tela dona:
+ * o objeto e todas as suas strings vivem na arena e são liberados juntos
+ * quando a página é reconstruída ou a tela destruída. Chaves que outros
+ * módulos guardam além da tela (estado, comandos, bindings) são internadas
+ * por eles no StringPool.
+ */
 class NavButton {
 public:
     enum ButtonType {
@@ -21,30 +29,31 @@ private:
     lv_obj_t* button;
     lv_obj_t* icon;
     lv_obj_t* label;
-    String id;
-    String target;
+    ScreenArena& arena;     // Dona do objeto e das strings abaixo
+    const char* id;
+    const char* target = "";
     bool isOn = false;
     std::function<void(NavButton*)> clickCallback;
     
     // Configurações para comandos
     ButtonType buttonType = TYPE_NAVIGATION;
-    String deviceId;        // Device alvo (ex: "relay_board_1")
-    int channel = 0;        // Canal do relé
-    String mode;            // "toggle" ou "momentary"
-    String actionType;      // Para botões de ação
-    String preset;          // Para presets
-    String modeValue;       // Para modos 4x4
+    const char* deviceId = "";      // Device alvo (ex: "relay_board_1")
+    int channel = 0;                // Canal do relé
+    const char* mode = "";          // "toggle" ou "momentary"
+    const char* actionType = "";    // Para botões de ação
+    const char* preset = "";        // Para presets
+    const char* modeValue = "";     // Para modos 4x4
     
     // For momentary buttons
     bool isPressed = false;          // Estado atual do botão momentâneo
     unsigned long pressStartTime = 0; // Quando o botão foi pressionado
-    String targetDevice;             // UUID do dispositivo alvo
-    String functionType = "toggle";  // "toggle" ou "momentary"
+    const char* targetDevice = "";        // UUID do dispositivo alvo
+    const char* functionType = "toggle";  // "toggle" ou "momentary"
     
     // Para display items
-    String dataSource;      // Fonte dos dados (can, sensors, etc)
-    String dataPath;        // Caminho dos dados
-    String dataUnit;        // Unidade dos dados
+    const char* dataSource = "";    // Fonte dos dados (can, sensors, etc)
+    const char* dataPath = "";      // Caminho dos dados
+    const char* dataUnit = "";      // Unidade dos dados
     
     // Para widgets nativos LVGL (switches, gauges)
     lv_obj_t* lvglWidget = nullptr;  // Widget LVGL nativo (switch, meter, etc)
@@ -52,23 +61,25 @@ private:
     
     // Controle de debounce para comandos
     unsigned long lastCommandTime = 0;
-    static const unsigned long COMMAND_DEBOUNCE_MS = 800; // 800ms entre comandos para evitar múltiplos
+    static const unsigned long COMMAND_DEBOUNCE_MS = 100; // Só filtra clique duplicado; rajadas vão para o CommandCoalescer
     
     void createLayout(const String& text, const String& iconId);
     void applyTheme();
+    bool isMomentary() const { return strcmp(functionType, "momentary") == 0; }
     
 public:
-    NavButton(lv_obj_t* parent, const String& text, const String& iconId, const String& buttonId = "");
+    // Use arena.make<NavButton>(arena, parent, ...) — nunca new/delete
+    NavButton(ScreenArena& arena, lv_obj_t* parent, const String& text, const String& iconId, const String& buttonId = "");
     ~NavButton();
     
-    void setTarget(const String& targetScreen) { target = targetScreen; }
+    void setTarget(const String& targetScreen) { target = arena.copy(targetScreen); }
     String getTarget() const { return target; }
     
-    void setId(const String& buttonId) { id = buttonId; }
+    void setId(const String& buttonId) { id = arena.copy(buttonId); }
     String getId() const { return id; }
     
     void setClickCallback(std::function<void(NavButton*)> callback) {
-        Serial.printf("[NavButton] setClickCallback called for button: %s\n", id.c_str());
+        Serial.printf("[NavButton] setClickCallback called for button: %s\n", id);
         clickCallback = callback;
         Serial.printf("[NavButton] Callback set successfully! Has callback: %s\n", 
                      clickCallback ? "YES" : "NO");
@@ -77,6 +88,14 @@ public:
     void setState(bool on);
     bool getState() const { return isOn; }
     
+    // Comando não confirmado pela placa (LV_STATE_USER_1, cor de erro do tema)
+    void setCommandFailed(bool failed);
+    bool hasCommandFailed() const { return lv_obj_has_state(button, LV_STATE_USER_1); }
+    
+    // Estado otimista aguardando o eco da placa (LV_STATE_USER_2, cor de aviso do tema)
+    void setPending(bool pending);
+    bool isPending() const { return lv_obj_has_state(button, LV_STATE_USER_2); }
+    
     lv_obj_t* getObject() { return button; }
     
     void updateStyle();
@@ -87,36 +106,36 @@ public:
     
     // Configuração para relés
     void setRelayConfig(const String& device, int ch, const String& m) {
-        deviceId = device;
+        deviceId = arena.copy(device);
         channel = ch;
-        mode = m;
-        functionType = m;  // Garantir que functionType também é setado
+        mode = arena.copy(m);
+        functionType = mode;  // Garantir que functionType também é setado
     }
     
     // Configuração para ações/presets
     void setActionConfig(const String& action, const String& p) {
-        actionType = action;
-        preset = p;
+        actionType = arena.copy(action);
+        preset = arena.copy(p);
     }
     
     // Configuração para modos
     void setModeConfig(const String& m) {
-        modeValue = m;
+        modeValue = arena.copy(m);
     }
     
     // Configuração para display items
     void setDisplayConfig(const String& source, const String& path, const String& unit) {
-        dataSource = source;
-        dataPath = path;
-        dataUnit = unit;
+        dataSource = arena.copy(source);
+        dataPath = arena.copy(path);
+        dataUnit = arena.copy(unit);
     }
     
     // Configuração para botões momentâneos
     void setMomentaryConfig(const String& device, int ch, const String& funcType) {
-        targetDevice = device;
+        targetDevice = arena.copy(device);
         channel = ch;
-        functionType = funcType;
-        mode = funcType; // Backward compatibility
+        functionType = arena.copy(funcType);
+        mode = functionType; // Backward compatibility
     }
     
     // Getters
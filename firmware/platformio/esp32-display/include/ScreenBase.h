@@ -6,6 +6,7 @@
 #include "Header.h"
 #include "GridContainer.h"
 #include "NavigationBar.h"
+#include "ui/ScreenArena.h"
 
 struct NavigationState {
     String currentScreenId;
@@ -22,6 +23,9 @@ protected:
     Header* header;
     GridContainer* content;
     NavigationBar* navBar;
+    
+    // Dona dos NavButtons/estruturas do conteúdo atual (liberados por página)
+    ScreenArena arena;
 
 public:
     NavigationState navState;
@@ -44,8 +48,13 @@ public:
     GridContainer* getContent() { return content; }
     NavigationBar* getNavBar() { return navBar; }
     
+    const ScreenArena& getArena() const { return arena; }
+    
 protected:
     virtual void createLayout();
+    
+    /// Apaga os widgets do conteúdo e libera a arena (antes de reconstruir)
+    void releaseContent();
 };
 
 #endif
\ No newline at end of file
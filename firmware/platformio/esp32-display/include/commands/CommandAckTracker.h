@@ -0,0 +1,119 @@
+/**
+ * @file CommandAckTracker.h
+ * @brief Tabela de comandos em voo: confirmação, timeout e reenvio
+ *
+ * O publish() do CommandSender só diz se a mensagem saiu do display.
+ * Cada comando de relé fica aqui, pelo request id, até a placa confirmar
+ * em autocore/devices/{uuid}/response (ou ecoar o id no status do canal).
+ * Sem confirmação em COMMAND_ACK_TIMEOUT o mesmo payload é reenviado, com
+ * o mesmo id, até COMMAND_ACK_RETRIES vezes; ON/OFF são estados absolutos,
+ * então repetir não inverte o relé. Esgotadas as tentativas, ou se a placa
+ * responder com erro, o botão que originou o comando é marcado com falha.
+ * Um comando novo do mesmo botão substitui o que ainda esperava: o antigo
+ * não é mais reenviado (nem um pressionar momentâneo depois do soltar).
+ *
+ * O tempo até a confirmação (desde o primeiro envio, reenvios incluídos)
+ * vai para um histograma publicado junto com o perfil de latência.
+ *
+ * Uso só na tarefa de UI (as respostas chegam via Scheduler::ui().dispatch).
+ */
+
+#ifndef COMMAND_ACK_TRACKER_H
+#define COMMAND_ACK_TRACKER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "core/Scheduler.h"
+#include "utils/Histogram.h"
+
+class MQTTClient;
+
+class CommandAckTracker {
+public:
+    static const uint8_t MAX_PENDING = 8;
+    static const uint8_t ID_LENGTH = 64;
+    static const uint32_t NO_DEADLINE = 0xFFFFFFFF;
+
+    static CommandAckTracker& getInstance();
+
+    /// Cliente usado nos reenvios
+    void setClient(MQTTClient* client) { mqttClient = client; }
+
+    /// Job do Scheduler que chama process() (acordado a cada comando novo)
+    void setJob(Scheduler::JobId job) { ackJob = job; }
+
+    /**
+     * @brief Passa a acompanhar um comando já publicado
+     * @param buttonKey Id do botão no ButtonStateManager (ex.: "uuid:canal"), para sinalizar
+     *        falha; comandos em voo com a mesma chave deixam de ser acompanhados
+     */
+    void track(const String& requestId, const String& topic, const String& payload, const String& buttonKey);
+
+    /**
+     * @brief Confirmação da placa (response ou eco com o id)
+     * @return false se o id não está em voo (outro display, já confirmado...)
+     */
+    bool acknowledge(const char* requestId, bool success, const char* error = nullptr);
+
+    /// Publicação não saiu do display: falha no botão, sem reenvio
+    bool abandon(const char* requestId);
+
+    /// Payload de autocore/devices/{uuid}/response
+    void handleResponse(const JsonDocument& response);
+
+    /// Reenvia/expira os vencidos; retorna ms até o próximo deadline (NO_DEADLINE se vazio)
+    uint32_t process();
+
+    /// Comando ainda aguardando confirmação (nem confirmado, nem expirado)
+    bool isPending(const char* requestId) const;
+
+    uint8_t getPending() const;
+    uint32_t getAcked() const { return acked; }
+    uint32_t getRejected() const { return rejected; }
+    uint32_t getTimedOut() const { return timedOut; }
+    uint32_t getRetries() const { return retries; }
+    uint32_t getSuperseded() const { return superseded; }
+    const Histogram& getLatency() const { return latencyMs; }
+
+    /// {"pending","acked","rejected","timed_out","retries","dropped","superseded","latency_ms":{histograma}}
+    void toJson(JsonObject obj) const;
+
+    /// Zera contadores e histograma (comandos em voo continuam)
+    void reset();
+
+    /// Esquece os comandos em voo sem sinalizar falha
+    void clear();
+
+private:
+    struct Pending {
+        char id[ID_LENGTH];
+        bool active;
+        uint8_t attempts;       // Publicações feitas (1 = só o envio original)
+        uint32_t firstSentAt;   // ms
+        uint32_t deadline;      // ms
+        const char* buttonKey;  // StringPool
+        String topic;
+        String payload;
+    };
+
+    CommandAckTracker();
+    CommandAckTracker(const CommandAckTracker&) = delete;
+    CommandAckTracker& operator=(const CommandAckTracker&) = delete;
+
+    Pending* find(const char* requestId);
+    void finish(Pending& entry, bool success);
+
+    Pending pending[MAX_PENDING];
+    MQTTClient* mqttClient = nullptr;
+    Scheduler::JobId ackJob = Scheduler::INVALID_JOB;
+
+    Histogram latencyMs;
+    uint32_t acked = 0;
+    uint32_t rejected = 0;
+    uint32_t timedOut = 0;
+    uint32_t retries = 0;
+    uint32_t dropped = 0;
+    uint32_t superseded = 0;
+};
+
+#endif // COMMAND_ACK_TRACKER_H
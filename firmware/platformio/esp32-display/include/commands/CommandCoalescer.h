@@ -0,0 +1,129 @@
+/**
+ * @file CommandCoalescer.h
+ * @brief Coalescência de comandos por alvo e limite global de mensagens
+ *
+ * Todo comando do CommandSender passa por aqui antes do MQTT:
+ *
+ * - Coalescência: comandos com a mesma chave (ex.: "uuid:canal") dentro de
+ *   COMMAND_COALESCE_MS do último envio não saem na hora; o mais recente
+ *   substitui o que estava esperando. Se o estado pedido for o mesmo que já
+ *   foi enviado (toggle-toggle-toggle), nada mais sai: o pedido é absorvido
+ *   pelo comando em voo. O primeiro comando de uma rajada sai sem atraso.
+ *
+ * - Token bucket: no máximo COMMAND_RATE_BURST mensagens de uma vez,
+ *   repostas a MAX_MESSAGES_PER_SECOND. Sem token o comando espera na fila
+ *   (nunca é descartado); com chave, só o último estado pedido sai.
+ *   Heartbeats e reenvios não esperam, mas gastam token via charge().
+ *
+ * Comandos sem chave (presets) não são coalescidos, só enfileirados em
+ * ordem. Urgentes (pressionar/soltar de momentâneos) não esperam janela
+ * nem token: saem na hora e só gastam token, como os heartbeats.
+ * Uso só na tarefa de UI.
+ */
+
+#ifndef COMMAND_COALESCER_H
+#define COMMAND_COALESCER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "core/Scheduler.h"
+
+class MQTTClient;
+
+class CommandCoalescer {
+public:
+    static const uint8_t MAX_QUEUED = 16;
+    static const uint32_t NO_DEADLINE = 0xFFFFFFFF;
+
+    enum Result : uint8_t {
+        SENT,       // Publicado agora
+        QUEUED,     // Espera janela/token (pode ainda ser substituído)
+        MERGED,     // Mesmo estado do comando já enviado: nada a publicar
+        FAILED      // Publish falhou ou fila cheia
+    };
+    // SENT/QUEUED ainda podem falhar no socket (tarefa de rede): o botão
+    // recebe processCommandResult(false) depois, na tarefa de UI
+
+    struct Command {
+        String key;                 // Alvo (ex.: "uuid:canal"); vazio = não coalescível
+        String value;               // Estado pedido; valores iguais têm o mesmo efeito
+        String topic;
+        String payload;
+        String requestId;           // Vazio = sem rastreio/confirmação
+        String ackKey;              // Botão no ButtonStateManager (vazio = sem botão)
+        bool urgent = false;        // Fora do limite (momentâneo): nunca QUEUED
+    };
+
+    static CommandCoalescer& getInstance();
+
+    void setClient(MQTTClient* client) { mqttClient = client; }
+
+    /// Job do Scheduler que chama process() (acordado quando algo fica na fila)
+    void setJob(Scheduler::JobId job) { queueJob = job; }
+
+    /**
+     * @brief Envia ou enfileira um comando
+     * @param effectiveId request id que vai levar este estado à placa (em MERGED,
+     *        o do comando já enviado), para o estado otimista do botão
+     */
+    Result submit(const Command& command, String& effectiveId);
+
+    /// Mensagem fora da fila (heartbeat, reenvio): consome um token se houver
+    void charge();
+
+    /// Publica o que venceu; retorna ms até o próximo envio (NO_DEADLINE se vazio)
+    uint32_t process();
+
+    uint8_t getQueued() const;
+    uint32_t getSuperseded() const { return superseded; }
+    uint32_t getMerged() const { return merged; }
+    uint32_t getThrottled() const { return throttled; }
+
+    /// {"queued","superseded","merged","throttled","tokens"}
+    void toJson(JsonObject obj) const;
+
+    /// Zera os contadores
+    void reset();
+
+    /// Esquece fila, histórico de envios e tokens gastos
+    void clear();
+
+private:
+    struct Slot {
+        String key;             // Vazio em comando sem chave
+        bool held;              // Há comando esperando
+        uint32_t order;         // Ordem de chegada (FIFO entre os prontos)
+        uint32_t readyAt;       // ms; fim da janela de coalescência
+        Command command;
+        bool sent;              // Histórico da chave (janela ainda aberta)
+        uint32_t sentAt;
+        String sentValue;
+        String sentRequestId;
+    };
+
+    CommandCoalescer();
+    CommandCoalescer(const CommandCoalescer&) = delete;
+    CommandCoalescer& operator=(const CommandCoalescer&) = delete;
+
+    Slot* findSlot(const String& key, uint32_t now);
+    void refill(uint32_t now);
+    bool takeToken(uint32_t now);
+    bool publish(Slot& slot, uint32_t now);
+    void onPublished(const String& key, const String& requestId, const String& ackKey, bool ok);
+    void discard(const Command& command);
+    uint32_t dueIn(uint32_t now);   // ms até o próximo da fila poder sair
+
+    Slot slots[MAX_QUEUED];
+    MQTTClient* mqttClient = nullptr;
+    Scheduler::JobId queueJob = Scheduler::INVALID_JOB;
+
+    uint32_t tokens;            // Milésimos de mensagem
+    uint32_t lastRefill = 0;
+    uint32_t nextOrder = 0;
+
+    uint32_t superseded = 0;
+    uint32_t merged = 0;
+    uint32_t throttled = 0;
+};
+
+#endif // COMMAND_COALESCER_H
@@ -11,6 +11,7 @@
 #include "core/MQTTClient.h"
 #include "core/MQTTProtocol.h"
 #include "core/Logger.h"
+#include "core/Scheduler.h"
 #include "NavButton.h"
 #include "../models/DeviceModels.h"
 
@@ -20,17 +21,28 @@ private:
     Logger* logger;
     String deviceId;  // ID deste display
     unsigned long commandCounter;
+    String lastRequestId;  // Do último sendRelayCommand aceito (o que leva o estado à placa)
     
-    // Heartbeat management for momentary buttons
-    uint32_t heartbeatSequence[MAX_CHANNELS];
-    unsigned long lastHeartbeat[MAX_CHANNELS];
-    bool heartbeatActive[MAX_CHANNELS];
-    String heartbeatTargetDevice[MAX_CHANNELS];
+    // Heartbeat dos botões momentâneos, por placa de destino: todos os
+    // canais pressionados de uma placa vão numa única mensagem por intervalo
+    struct HeartbeatTarget {
+        const char* device;                 // UUID do StringPool (nullptr = livre)
+        uint32_t channels;                  // Bit (canal - 1) = canal pressionado
+        uint32_t sequence[MAX_CHANNELS];    // Sequência por canal (relé detecta perdas)
+        unsigned long lastSent;
+    };
+    HeartbeatTarget heartbeatTargets[MAX_HEARTBEAT_TARGETS];
+    Scheduler::JobId heartbeatJob = Scheduler::INVALID_JOB;
     
     String generateRequestId();
     String getCurrentTimestamp();
+    HeartbeatTarget* findHeartbeatTarget(const String& targetUuid, bool create);
+    // Um heartbeat com todos os canais ativos da placa ({"channels":[{channel,sequence}]})
+    void sendHeartbeat(HeartbeatTarget& target);
     
 public:
+    static const uint32_t NO_HEARTBEAT = 0xFFFFFFFF;
+    
     CommandSender(MQTTClient* mqtt, Logger* log, const String& devId);
     
     // Enviar comando baseado no botão
@@ -38,15 +50,24 @@ public:
     
     // Comandos específicos v2.2.0 compliant
     bool sendRelayCommand(const String& targetUuid, int channel, const String& state, const String& functionType = "toggle");
+    // Cena/"todas as luzes": vários canais da mesma placa numa mensagem, aplicados juntos
+    // no relé. Bit (canal - 1) de channelMask = canal afetado; de stateMask = ligado
+    bool sendRelayGroupCommand(const String& targetUuid, uint32_t channelMask, uint32_t stateMask);
     bool sendPresetCommand(const String& preset);
     bool sendModeCommand(const String& mode);
     bool sendActionCommand(const String& action, JsonObject& params);
     
-    // Heartbeat management for momentary buttons
+    // request id do último comando de relé aceito (para o estado otimista)
+    const String& getLastRequestId() const { return lastRequestId; }
+    
+    // Heartbeat management for momentary buttons (chave: placa + canal)
     void startHeartbeat(const String& targetUuid, int channel);
-    void stopHeartbeat(int channel);
-    void sendHeartbeat(const String& targetUuid, int channel);
-    void processHeartbeats();
+    void stopHeartbeat(const String& targetUuid, int channel);
+    uint8_t getActiveHeartbeatCount() const;
+    // Envia os heartbeats vencidos; retorna ms até o próximo (NO_HEARTBEAT se nenhum ativo)
+    uint32_t processHeartbeats();
+    // Job do Scheduler que chama processHeartbeats (acordado ao iniciar heartbeat)
+    void setHeartbeatJob(Scheduler::JobId job) { heartbeatJob = job; }
     
     // Display events
     void sendDisplayEvent(const String& eventType, const JsonObject& eventData);
@@ -4,6 +4,13 @@
  * 
  * Mantém o estado real de todos os botões (relés, modos, presets, etc)
  * baseado em mensagens MQTT e atualiza a interface conforme feedback
+ *
+ * Toggle de relé é otimista: o botão mostra o estado pedido na hora,
+ * marcado como pendente, e o estado confirmado pela placa fica guardado
+ * à parte. O eco com o mesmo request id (ou a confirmação do comando)
+ * confirma; falha ou timeout voltam ao estado confirmado. Ecos de outros
+ * displays atualizam o estado confirmado sem desfazer o pendente, e ecos
+ * com seq já vista (mesmo boot da placa) são descartados.
  */
 
 #ifndef BUTTON_STATE_MANAGER_H
@@ -22,10 +29,26 @@ class ScreenManager;
  * @brief Estrutura para armazenar estado de um botão
  */
 struct ButtonState {
-    bool isActive;              // Estado atual (ON/OFF, ativo/inativo)
-    String currentValue;        // Valor atual (para modos, presets, etc)
-    unsigned long lastUpdate;   // Timestamp da última atualização
-    String lastSource;          // Quem atualizou (device_id)
+    bool isActive = false;          // Estado confirmado (ON/OFF, ativo/inativo)
+    const char* currentValue = "";  // Valor atual (para modos, presets, etc) - StringPool
+    unsigned long lastUpdate = 0;   // Timestamp da última atualização
+    const char* lastSource = "";    // Quem atualizou (device_id) - StringPool
+    uint32_t boot = 0;              // "boot" da placa no último eco com seq
+    uint32_t sequence = 0;          // "seq" do último eco aplicado (0 = placa sem seq)
+    bool pending = false;           // Comando otimista em voo
+    bool pendingActive = false;     // Estado exibido enquanto pendente
+    String pendingRequest;          // request id do comando otimista
+    
+    bool shownActive() const { return pending ? pendingActive : isActive; }
+};
+
+/**
+ * @brief Origem de um status: comando que o causou e ordem na placa
+ */
+struct StatusStamp {
+    const char* requestId = nullptr;  // trace/request id ecoado (nullptr = sem)
+    uint32_t boot = 0;
+    uint32_t sequence = 0;            // 0 = status sem ordem (aceito sempre)
 };
 
 /**
@@ -39,11 +62,16 @@ private:
     MQTTClient* mqttClient;
     ScreenManager* screenManager;
     
+    // Chaves são ponteiros do StringPool: mesmo id => mesmo ponteiro, então
+    // o mapa compara endereços em vez de strings
+    
     // Mapa genérico: button_id -> state
-    std::map<String, ButtonState> buttonStates;
+    std::map<const char*, ButtonState> buttonStates;
     
     // Callbacks registrados por botão
-    std::map<String, NavButton*> buttonCallbacks; // key: button unique ID
+    std::map<const char*, NavButton*> buttonCallbacks; // key: button unique ID
+    
+    uint32_t staleResults = 0;      // Resultados de pedidos que não eram mais o pendente
     
     static ButtonStateManager* instance;
     
@@ -57,14 +85,25 @@ public:
     void begin();
     
     // Processar diferentes tipos de mensagens de status
-    void processRelayStatus(const String& boardId, int channel, const String& state, const String& source);
+    void processRelayStatus(const String& boardId, int channel, const String& state, const String& source,
+                            const StatusStamp& stamp = StatusStamp());
     void processModeStatus(const String& mode, bool active, const String& source);
     void processPresetStatus(const String& preset, bool active, const String& source);
     void processGenericStatus(const String& buttonId, bool active, const String& value, const String& source);
     
+    // Toggle enviado: mostra o estado pedido já, pendente até o eco/confirmação
+    void beginPending(NavButton* button, bool active, const String& requestId);
+    
+    // Resultado da confirmação de um comando (key internada, ex.: "uuid:canal");
+    // falha marca o botão e volta ao último estado confirmado. Só o pedido
+    // pendente do botão conta; resultado de outro id é apenas contado
+    void processCommandResult(const char* key, const char* requestId, bool success);
+    uint32_t getStaleResults() const { return staleResults; }
+    
     // Registrar botão para receber atualizações
     void registerButton(NavButton* button);
     void unregisterButton(const String& buttonId);
+    void unregisterButton(NavButton* button);  // Remove todas as entradas que apontam para o botão
     
     // Obter estado atual
     ButtonState getButtonState(const String& buttonId);
@@ -73,15 +112,17 @@ public:
     // Gerar ID único para cada tipo de botão
     static String makeButtonId(NavButton* button);
     
-    // Handler MQTT genérico (público para ser chamado pelo MQTTClient)
-    void handleMQTTMessage(const String& topic, JsonDocument& payload);
+    // Handler MQTT genérico (público para ser chamado pelo MQTTClient, na tarefa de UI)
+    // receivedUs: chegada na tarefa de rede (0 = agora)
+    void handleMQTTMessage(const String& topic, JsonDocument& payload, uint32_t receivedUs = 0);
     
 private:
     // Atualizar estado e notificar
-    void updateButtonState(const String& buttonId, bool active, const String& value, const String& source);
+    void updateButtonState(const String& buttonId, bool active, const String& value, const String& source,
+                           const StatusStamp& stamp = StatusStamp());
     
-    // Notificar botão sobre mudança de estado
-    void notifyButton(const String& buttonId);
+    // Notificar botão sobre mudança de estado (key já internada)
+    void notifyButton(const char* key);
 };
 
 #endif
\ No newline at end of file
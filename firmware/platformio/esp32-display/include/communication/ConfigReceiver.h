@@ -17,6 +17,7 @@
 #include "core/MQTTClient.h"
 #include "core/ConfigManager.h"
 #include "network/ScreenApiClient.h"
+#include "core/AsyncFetch.h"
 
 class ConfigReceiver {
 private:
@@ -31,9 +32,15 @@ private:
     bool useApi;
     bool configReceived;
     
+    // Pedido MQTT em andamento (0 = nenhum); respondido pelo callback
+    unsigned long mqttRequestedAt;
+    
     // Hot reload callback
     std::function<void()> onConfigUpdateCallback;
     
+    // Comando "reload": carga em segundo plano (sem handler, síncrona)
+    std::function<void()> onReloadRequested;
+    
     // Static callbacks
     static ConfigReceiver* instance;
     static void onConfigReceived(const String& topic, const String& payload);
@@ -52,15 +59,29 @@ public:
     bool testApiConnection();
     
     // MQTT Configuration Methods (FALLBACK)
-    bool loadFromMqtt();
+    void beginMqttRequest();     // Assina as respostas e envia o pedido
+    void cancelLoad();           // Desiste do pedido MQTT pendente
     void requestConfigMqtt();
     
     // Combined Methods
-    bool loadConfiguration(); // Try API first, fallback to MQTT
+    
+    /**
+     * @brief Um passo da carga para AsyncFetch (tarefa de rede, sem delay)
+     *
+     * Uma tentativa pela API; se falhar, envia o pedido MQTT e devolve
+     * PENDING até a resposta chegar (DONE) ou CONFIG_REQUEST_INTERVAL
+     * passar (RETRY).
+     */
+    AsyncFetch::Step loadStep();
+    
+    bool loadConfiguration(); // Um passo: true se a API respondeu (MQTT fica pendente)
     
     // Enable hot reload
     void enableHotReload(std::function<void()> callback);
     
+    // Quem atende o comando "reload" (ex.: inicia a AsyncFetch da config)
+    void setReloadHandler(std::function<void()> handler) { onReloadRequested = handler; }
+    
     // Status methods
     bool hasConfig() const { return configReceived; }
     bool isUsingApi() const { return useApi; }
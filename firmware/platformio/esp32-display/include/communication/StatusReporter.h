@@ -10,6 +10,7 @@
 #include <ArduinoJson.h>
 #include <vector>
 #include "core/MQTTClient.h"
+#include "utils/MemoryMonitor.h"
 
 class StatusReporter {
 private:
@@ -21,6 +22,8 @@ private:
     unsigned long lastHealthStatus;
     unsigned long lastOperationalStatus;
     unsigned long lastPerformanceTelemetry;
+    unsigned long lastRenderProfile;
+    unsigned long lastLatencyProfile;
     unsigned long lastConfigUpdate;
     unsigned long lastTouchTime;
     unsigned long lastButtonTime;
@@ -43,9 +46,12 @@ public:
     // ========== V2.2.0 COMPLIANT METHODS ==========
     
     // Status publishing (intervals enforced internally)
-    void publishHealthStatus();         // Every 30 seconds
+    void publishHealthStatus();         // Every RUNTIME_STATS_INTERVAL (CPU, loops, frames, filas)
     void publishOperationalStatus();    // Every 10 seconds  
     void publishPerformanceTelemetry(); // Every 60 seconds
+    void publishRenderProfile();        // Every RENDER_PROFILE_INTERVAL
+    void publishLatencyProfile();       // Every LATENCY_PROFILE_INTERVAL (commands traced)
+    void publishMemoryWarning(const MemoryMonitor::Snapshot& snapshot, uint8_t reasons);  // On MemoryMonitor event
     void publishErrorTelemetry(int code, const String& message, const String& severity = "error");
     
     // Event reporting
@@ -77,7 +83,6 @@ public:
 private:
     String getUptime();
     int getFreeHeap();
-    float getCpuUsage();
 };
 
 #endif // STATUS_REPORTER_H
\ No newline at end of file
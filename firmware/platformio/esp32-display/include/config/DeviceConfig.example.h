@@ -100,7 +100,8 @@
 #define MQTT_BUFFER_SIZE 4096          // Buffer maior
 #define JSON_DOCUMENT_SIZE 8192        // JSON maior
 #define MAX_SCREENS 50                 // Mais telas
-#define LVGL_BUFFER_SIZE (320 * 40)    // Buffer maior
+#define LVGL_BUFFER_LINES 40           // Linhas por buffer (2 buffers)
+#define LVGL_BUFFER_SIZE (320 * LVGL_BUFFER_LINES)    // Buffer maior
 #define LVGL_TICK_PERIOD 2             // Update mais rápido
 */
 
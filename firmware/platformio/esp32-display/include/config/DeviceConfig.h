@@ -49,8 +49,11 @@
 #define API_BASE_PATH "/api"                   // Path base da API
 #define API_TIMEOUT 10000                      // Timeout das requisições API (ms)
 #define API_RETRY_COUNT 3                      // Número de tentativas em caso de falha
-#define API_RETRY_DELAY 2000                   // Delay entre tentativas (ms)
-#define API_CACHE_TTL 300000                   // Tempo de vida do cache (5 minutos em ms)
+#define API_RETRY_DELAY 2000                   // Espera antes da 2a tentativa; dobra a cada falha (ms)
+#define API_RETRY_MAX_DELAY 30000              // Teto do backoff entre tentativas (ms)
+#define API_CACHE_TTL 300000                   // Sem revalidar a cópia no flash (5 minutos em ms)
+#define API_CONFIG_CACHE_PATH "/api_config.json"    // Config da API chaveada pelo ETag (1a linha)
+#define API_CONFIG_CACHE_TMP_PATH "/api_config.tmp"
 #define API_USE_AUTH false                     // Usar autenticação na API
 #define API_AUTH_TOKEN ""                      // Token de autenticação (se API_USE_AUTH = true)
 
@@ -92,14 +95,25 @@
 // Timings
 #define CONFIG_REQUEST_INTERVAL 10000          // Intervalo entre requests de config (ms)
 #define STATUS_REPORT_INTERVAL 30000           // Intervalo de relatório de status (ms)
+#define PERFORMANCE_TELEMETRY_INTERVAL 60000   // Telemetria de desempenho (ms)
+#define NETWORK_BRINGUP_POLL 250               // Acompanhamento da conexão WiFi no boot (ms)
+#define ASYNC_FETCH_POLL 100                   // Consulta de uma resposta pendente (ex.: config via MQTT) (ms)
+#define PROGRESS_UPDATE_INTERVAL 250           // Atualização do indicador de progresso da rede (ms)
 #define HEARTBEAT_INTERVAL 60000               // Intervalo de heartbeat (ms)
+#define MQTT_POLL_INTERVAL 10                  // Leitura do socket MQTT no loop (ms)
+#define SCHEDULER_MAX_SLEEP 50                 // Sono máximo do loop entre deadlines (ms)
 #define BUTTON_DEBOUNCE_DELAY 50               // Debounce dos botões (ms)
 #define BUTTON_LONG_PRESS_TIME 1000            // Tempo para long press (ms)
+#define BUTTON_EVENT_QUEUE_SIZE 16             // Eventos press/release pendentes entre iterações do loop
 
-// Touch Screen - Configurações melhoradas
-#define TOUCH_MIN_PRESSURE 400          // Threshold maior para evitar ruído
-#define TOUCH_DEBOUNCE_TIME 100         // Debounce maior
-#define TOUCH_STATE_CONFIRM_TIME 150    // Tempo para confirmar mudança de estado
+// Touch Screen - amostrado só enquanto o IRQ indica toque (ver TouchFilter)
+#define TOUCH_MIN_PRESSURE 400          // Pressão para confirmar toque
+#define TOUCH_RELEASE_PRESSURE 250      // Abaixo disso conta como soltando (histerese)
+#define TOUCH_PRESS_SAMPLES 2           // Amostras seguidas acima do threshold para pressionar
+#define TOUCH_RELEASE_HOLD_MS 30        // Pressão baixa por este tempo solta o toque
+#define TOUCH_FAST_MOVE_DELTA 120       // Movimento raw acima disso: IIR segue rápido
+#define TOUCH_SAMPLE_PERIOD 10          // Período de leitura do LVGL enquanto tocado (ms)
+#define TOUCH_IDLE_TIMEOUT 100          // Sem IRQ por este tempo após soltar: para de amostrar (ms)
 
 // Recursos
 #define ENABLE_OTA true                        // Habilitar atualização OTA
@@ -118,10 +132,48 @@
 #define JSON_DOCUMENT_SIZE 20480               // Tamanho do documento JSON (20KB para suportar config grande)
 #define MAX_SCREENS 20                         // Número máximo de telas
 #define MAX_ITEMS_PER_SCREEN 50                // Máximo de itens por tela
+#define SCREEN_ARENA_CHUNK_SIZE 2048           // Bloco da arena de cada tela (NavButtons + strings)
+#define MEMORY_MONITOR_INTERVAL 5000           // Amostragem de heap/pool LVGL (ms)
+#define MEMORY_WARN_MIN_BLOCK 16384            // Aviso se o maior bloco livre do heap ficar abaixo (bytes)
+#define MEMORY_WARN_HEAP_FRAG_PCT 60           // Aviso acima desta fragmentação do heap (%)
+#define MEMORY_WARN_LVGL_FRAG_PCT 50           // Aviso acima desta fragmentação do pool LVGL (%)
+#define MEMORY_WARN_LVGL_USED_PCT 85           // Aviso acima deste uso do pool LVGL (%)
+
+// Tarefas (ver TaskTopology): UI/LVGL em um core, rede/parse JSON no outro
+#define UI_TASK_CORE 1                         // LVGL, touch, botões, widgets
+#define UI_TASK_STACK 8192                     // Pilha da tarefa de UI (bytes)
+#define UI_TASK_PRIORITY 2
+#define NET_TASK_CORE 0                        // MQTT, HTTP, parse de config (mesmo core do WiFi)
+#define NET_TASK_STACK 8192                    // Pilha da tarefa de rede (bytes)
+#define NET_TASK_PRIORITY 1
+#define LVGL_TICK_TASK_STACK 1024              // Pilha da tarefa de tick do LVGL (bytes)
+#define LVGL_TICK_TASK_PRIORITY 3              // Acima da UI para o tick não atrasar
+#define SCHEDULER_INBOX_SIZE 16                // Mensagens pendentes entre tarefas (por tarefa)
+#define TASK_STACK_WARN_FREE 512               // Aviso se a pilha livre mínima ficar abaixo (bytes)
+#define TASK_MONITOR_INTERVAL 10000            // Leitura dos high-water marks (ms)
+#define RUNTIME_STATS_INTERVAL 30000           // Janela do runtime_stats (CPU, loops, frames) e health status (ms)
+
+// Última config boa no LittleFS (boot sem esperar a rede)
+#define CONFIG_STORE_PATH "/last_good.json"
+#define CONFIG_STORE_TMP_PATH "/last_good.tmp"     // Escrita atômica: grava aqui e renomeia
 
 // LVGL
 #define LVGL_TICK_PERIOD 5                     // Período do tick LVGL (ms)
-#define LVGL_BUFFER_SIZE (SCREEN_WIDTH * 10)  // Tamanho do buffer LVGL
+#define LVGL_BUFFER_LINES 20                   // Linhas por buffer de renderização (2 buffers)
+#define LVGL_BUFFER_SIZE (SCREEN_WIDTH * LVGL_BUFFER_LINES)  // Tamanho de cada buffer LVGL
+#define DISPLAY_TRANSFER_TIMEOUT_MS 100        // Espera máxima por um flush em andamento (ms)
+#define RENDER_PROFILER_ENABLED true           // Perfil de render/invalidação do LVGL
+#define RENDER_PROFILE_INTERVAL 60000          // Publicação do resumo do perfil (ms)
+
+// Rastreio de latência dos comandos (toque -> relé -> eco na UI)
+#define COMMAND_TRACE_TIMEOUT 5000             // Rastreio sem eco é contado como perdido (ms)
+#define COMMAND_TRACE_TOUCH_WINDOW 1000        // Toque só é atribuído a comando até este tempo (ms)
+#define LATENCY_PROFILE_INTERVAL 60000         // Publicação dos histogramas de latência (ms)
+#define MAX_HEARTBEAT_TARGETS 4                // Placas com botão momentâneo pressionado ao mesmo tempo
+#define COMMAND_ACK_TIMEOUT 1500               // Espera pela resposta do relé antes de reenviar (ms)
+#define COMMAND_ACK_RETRIES 2                  // Reenvios antes de marcar o comando como falho
+#define COMMAND_COALESCE_MS 400                // Comandos ao mesmo alvo nesta janela viram um só (ms)
+#define COMMAND_RATE_BURST 10                  // Mensagens seguidas antes do limite MAX_MESSAGES_PER_SECOND
 
 // Tópicos MQTT personalizados (opcional)
 #define CUSTOM_STATUS_TOPIC ""                 // Deixe vazio para usar padrão
@@ -0,0 +1,78 @@
+/**
+ * @file AsyncFetch.h
+ * @brief Operação de rede em segundo plano com backoff sem bloqueio e cancelamento
+ *
+ * Substitui os laços "tenta; delay(API_RETRY_DELAY * attempt); tenta de
+ * novo" de registro e carga da config: cada tentativa é um passo curto
+ * executado por um job da tarefa de rede, e a espera entre tentativas é
+ * só o deadline do próximo passo. Durante o backoff MQTT, telemetria e
+ * o resto da rede continuam rodando; a UI nunca espera por HTTP.
+ *
+ * O passo devolve:
+ *   DONE    - concluído com sucesso
+ *   RETRY   - falhou; nova tentativa após API_RETRY_DELAY * 2^n (até o teto)
+ *   PENDING - aguardando resposta assíncrona (ex.: config via MQTT);
+ *             consultado de novo em ASYNC_FETCH_POLL sem gastar tentativa
+ *
+ * Ao terminar (sucesso, tentativas esgotadas ou cancel) o callback de
+ * conclusão roda na tarefa de UI. start() e cancel() podem ser chamados de
+ * qualquer tarefa; estado, tentativa e espera são lidos pela UI para o
+ * indicador de progresso.
+ */
+
+#ifndef ASYNC_FETCH_H
+#define ASYNC_FETCH_H
+
+#include <Arduino.h>
+#include <functional>
+#include "core/Scheduler.h"
+#include "config/DeviceConfig.h"
+
+class AsyncFetch {
+public:
+    enum Step : uint8_t { DONE, RETRY, PENDING };
+    enum State : uint8_t { IDLE, RUNNING, BACKOFF, SUCCEEDED, FAILED, CANCELLED };
+
+    typedef std::function<Step()> StepFunction;
+    typedef std::function<void(bool ok)> Completion;
+
+    explicit AsyncFetch(const char* name, uint8_t maxAttempts = API_RETRY_COUNT);
+    ~AsyncFetch();
+
+    AsyncFetch(const AsyncFetch&) = delete;
+    AsyncFetch& operator=(const AsyncFetch&) = delete;
+
+    /// Começa da 1a tentativa; ignorado se já estiver em andamento
+    void start(StepFunction step, Completion done = nullptr);
+
+    /// Interrompe entre dois passos; done(false) na UI
+    void cancel();
+
+    State getState() const { return state; }
+    bool isActive() const { return state == RUNNING || state == BACKOFF; }
+    uint8_t getAttempt() const { return attempt; }
+    uint8_t getMaxAttempts() const { return maxAttempts; }
+
+    /// ms até a próxima tentativa (0 fora do backoff)
+    uint32_t getRetryIn() const;
+
+    /// Espera depois da tentativa n (1 = primeira falha)
+    static uint32_t backoffDelay(uint8_t failedAttempt);
+
+private:
+    void run();
+    void finish(State result);
+
+    const char* name;
+    uint8_t maxAttempts;
+    StepFunction step;
+    Completion done;
+    Scheduler::JobId job = Scheduler::INVALID_JOB;
+
+    // Escritos na tarefa de rede, lidos pela UI
+    volatile State state = IDLE;
+    volatile uint8_t attempt = 0;
+    volatile uint32_t retryAt = 0;
+};
+
+#endif // ASYNC_FETCH_H
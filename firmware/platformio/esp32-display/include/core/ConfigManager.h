@@ -1,6 +1,13 @@
 /**
  * @file ConfigManager.h
  * @brief Gerenciador de configurações recebidas via MQTT
+ *
+ * A configuração é publicada como snapshots imutáveis com contagem de
+ * referências: quem lê pega um handle barato (snapshot()) e usa o
+ * documento enquanto o segurar, em qualquer tarefa. Um reload monta o
+ * documento novo à parte e troca o ponteiro atomicamente; o anterior é
+ * liberado quando o último leitor (ex.: a tela montada com ele) o solta.
+ * Nenhum caminho de leitura copia o documento.
  */
 
 #ifndef CONFIG_MANAGER_H
@@ -9,50 +16,82 @@
 #include <Arduino.h>
 #include <ArduinoJson.h>
 #include <functional>
+#include <memory>
 #include <vector>
 #include "config/DeviceConfig.h"
 
 typedef std::function<void()> ConfigChangeCallback;
 
+/**
+ * @brief Versão publicada da configuração (documento + metadados)
+ *
+ * Só é escrita antes de publicar; depois disso todo acesso é const.
+ */
+struct ConfigData {
+    JsonDocument doc;
+    String version;
+    uint32_t hash = 0;          // Hash da forma canônica do JSON
+    size_t trackedBytes = 0;    // Conta no MemoryMonitor até o último leitor soltar
+
+    ConfigData() = default;
+    ~ConfigData();
+    ConfigData(const ConfigData&) = delete;
+    ConfigData& operator=(const ConfigData&) = delete;
+};
+
+typedef std::shared_ptr<const ConfigData> ConfigSnapshot;
+
 class ConfigManager {
 private:
-    JsonDocument config;
-    bool hasValidConfig;
-    String configVersion;
+    ConfigSnapshot current;     // Só via std::atomic_load/atomic_store
+    volatile bool hasValidConfig;
+    volatile uint32_t contentHash;   // Hash do snapshot atual (0 = nenhum)
     unsigned long lastUpdate;
-    
+
     ConfigChangeCallback onChangeCallback;
-    
+
+    /// Adaptações de formato e defaults, ainda no documento privado
+    static void normalizeConfig(JsonDocument& doc);
+
+    /// Versão, hash e memória de um documento validado; troca o snapshot atual
+    void publish(std::shared_ptr<ConfigData> next);
+
 public:
     ConfigManager();
-    
+
     // Config management
     bool loadConfig(const String& jsonStr);
+
+    /// Assume um documento já parseado (ex.: direto do stream HTTP), sem cópia
+    bool adoptConfig(JsonDocument& doc);
     bool hasConfig() const { return hasValidConfig; }
-    JsonDocument& getConfig() { return config; }
-    
-    // Getters for common config sections
-    JsonArray getScreens();
-    JsonObject getScreen(const String& screenId);
-    JsonObject getTheme();
-    JsonObject getSettings();
-    
+
+    /// Handle da config atual (nullptr se nenhuma); válido enquanto for mantido
+    ConfigSnapshot snapshot() const { return std::atomic_load(&current); }
+
+    // Getters for common config sections (views dentro de config: segurar o snapshot)
+    static JsonArrayConst getScreens(const JsonDocument& config);
+    static JsonObjectConst getScreen(const JsonDocument& config, const String& screenId);
+    static JsonObjectConst getTheme(const JsonDocument& config);
+    static JsonObjectConst getSettings(const JsonDocument& config);
+
     // Get screen IDs when screens are in object format
     std::vector<String> getScreenIds();
     String getFirstScreenId();
-    
+
     // Config validation
     bool validateConfig(const JsonDocument& doc);
-    
+
     // Version control
-    String getVersion() const { return configVersion; }
+    String getVersion() const;
+    uint32_t getContentHash() const { return contentHash; }
     bool isNewerVersion(const String& version);
-    
+
     // Change notification
     void onChange(ConfigChangeCallback callback) { onChangeCallback = callback; }
-    
+
     // Debug
     void printConfig();
 };
 
-#endif // CONFIG_MANAGER_H
\ No newline at end of file
+#endif // CONFIG_MANAGER_H
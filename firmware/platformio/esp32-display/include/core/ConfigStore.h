@@ -0,0 +1,49 @@
+/**
+ * @file ConfigStore.h
+ * @brief Última configuração aplicada com sucesso, persistida no LittleFS
+ *
+ * No boot a UI é montada direto desta cópia, sem esperar WiFi, registro,
+ * MQTT e a carga HTTP; a configuração que chegar depois da rede só
+ * reconstrói a UI (pelo hot reload) se o conteúdo for diferente.
+ *
+ * Só é gravada depois que a UI foi montada com a config, então um JSON
+ * que não monta nunca vira o "último bom". A escrita vai para um arquivo
+ * temporário renomeado por cima do atual: queda de energia no meio deixa
+ * a cópia anterior intacta.
+ */
+
+#ifndef CONFIG_STORE_H
+#define CONFIG_STORE_H
+
+#include <Arduino.h>
+
+class ConfigStore {
+public:
+    static ConfigStore& getInstance();
+
+    /// Monta o LittleFS (formata se a partição estiver corrompida)
+    bool begin();
+    bool isMounted() const { return mounted; }
+
+    /// Lê a última config boa; false se não houver
+    bool load(String& json);
+
+    /// Grava json (hash = ConfigManager::getContentHash do mesmo conteúdo)
+    bool save(const String& json, uint32_t hash);
+
+    /// Apaga a cópia (ex.: config gravada não monta mais após atualização)
+    void clear();
+
+    /// Hash do conteúdo gravado/lido (0 = nenhum): evita regravar o mesmo
+    uint32_t getStoredHash() const { return storedHash; }
+
+private:
+    ConfigStore() = default;
+    ConfigStore(const ConfigStore&) = delete;
+    ConfigStore& operator=(const ConfigStore&) = delete;
+
+    bool mounted = false;
+    uint32_t storedHash = 0;
+};
+
+#endif // CONFIG_STORE_H
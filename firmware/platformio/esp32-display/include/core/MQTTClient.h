@@ -16,6 +16,7 @@
 #include "network/DeviceRegistration.h"
 
 typedef std::function<void(const String& topic, const String& payload)> MessageCallback;
+typedef std::function<void(bool ok)> PublishDone;
 
 class MQTTClient {
 private:
@@ -30,7 +31,7 @@ private:
     bool useDynamicCredentials;
     
     std::map<String, MessageCallback> callbacks;
-    bool connected;
+    volatile bool connected;    // Espelho do estado para outras tarefas
     unsigned long lastReconnectAttempt;
     unsigned long lastStatusPublish;
     static const unsigned long STATUS_PUBLISH_INTERVAL = 5000; // 5 segundos
@@ -46,6 +47,7 @@ public:
     MQTTClient(const String& deviceId, const String& broker, uint16_t port = 1883);
     ~MQTTClient();
     
+    // connect/loop/subscribe só na tarefa de rede (PubSubClient não é thread-safe)
     bool connect();
     void disconnect();
     bool isConnected();
@@ -53,9 +55,20 @@ public:
     void loop();
     
     // v2.2.0 compliant publish methods
+    // Fora da tarefa de rede a mensagem é copiada e enfileirada para ela
+    // (o retorno diz só se entrou na fila)
     bool publish(const String& topic, const String& payload, bool retained = false, uint8_t qos = 0);
     bool publish(const String& topic, const JsonDocument& doc, uint8_t qos = 0, bool retained = false);
     
+    /**
+     * @brief Publish com o resultado do socket, de qualquer tarefa
+     *
+     * done(ok) roda na tarefa de UI com o resultado real, também quando a
+     * mensagem foi enfileirada para a tarefa de rede.
+     * @return false se falhou já (desconectado, fila cheia): done não é chamado
+     */
+    bool publishAsync(const String& topic, const String& payload, PublishDone done);
+    
     // v2.2.0 compliant subscribe methods
     bool subscribe(const String& topic, uint8_t qos = 0, MessageCallback callback = nullptr);
     void unsubscribe(const String& topic);
@@ -0,0 +1,166 @@
+/**
+ * @file Scheduler.h
+ * @brief Escalonador cooperativo por deadline para o loop principal
+ *
+ * Jobs periódicos e one-shot ficam num min-heap ordenado pelo próximo
+ * deadline (millis). O loop executa os jobs vencidos e dorme até o
+ * próximo deadline ou até uma notificação (ISR dos botões, fila de
+ * eventos), em vez de acordar a cada 5ms para testar vários
+ * millis() - last > INTERVAL.
+ *
+ * Periódicos mantêm a fase (deadline += período), então o heartbeat não
+ * acumula o atraso de cada iteração. Um job pode mudar o próprio próximo
+ * deadline (reschedule) ou se suspender (pause) durante a execução.
+ *
+ * Há um escalonador por tarefa: ui() (LVGL, core 1) e network() (MQTT,
+ * HTTP, parse JSON, core 0). Jobs só são criados/reagendados na tarefa
+ * dona (ou no setup, antes das tarefas subirem); outra tarefa usa
+ * dispatch(), que passa a função pela caixa de entrada da dona. Antes de
+ * begin() tudo passa pela caixa e roda quando a dona começar.
+ *
+ * No native não há tarefas: até begin() tudo roda inline. Depois de begin()
+ * o host emula as duas tarefas num só thread: o código roda "na" tarefa do
+ * último enterTask() (ou dentro de runDue()), e dispatch() para a outra
+ * espera na caixa até o runDue() dela, como no dispositivo.
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <functional>
+
+class Scheduler {
+public:
+    typedef std::function<void()> JobFunction;
+    typedef uint8_t JobId;
+
+    // Setup registra 14 jobs de UI e 4 de rede; o resto é folga para AsyncFetch
+    static const uint8_t MAX_JOBS = 32;
+    static const JobId INVALID_JOB = 0xFF;
+
+    struct JobStats {
+        uint32_t runs;
+        uint32_t totalUs;
+        uint32_t maxUs;
+        uint32_t maxLateMs;    // Maior atraso do início em relação ao deadline
+    };
+
+    static Scheduler& ui();         // Tarefa de UI/LVGL
+    static Scheduler& network();    // Tarefa de rede
+
+    /// Tarefa dona, que dorme em waitNext() (nullptr = tarefa atual)
+    void begin(void* task = nullptr);
+
+    /// Chamador é a tarefa dona (false antes de begin; no native, true antes de begin)
+    bool isCurrentTask() const;
+
+#ifdef NATIVE_BUILD
+    /// Host: o código seguinte roda como a tarefa deste escalonador
+    void enterTask();
+
+    /// Host: volta a rodar tudo inline (descarta a caixa de entrada)
+    void end();
+#endif
+
+    /**
+     * @brief Executa fn na tarefa dona
+     *
+     * Direto se já estiver nela; senão enfileira e acorda a dona.
+     * @return false se a caixa de entrada estiver cheia (fn descartada)
+     */
+    bool dispatch(JobFunction fn);
+
+    /// Job periódico; primeira execução após firstDelayMs
+    JobId every(const char* name, uint32_t periodMs, JobFunction fn, uint32_t firstDelayMs = 0);
+
+    /// Periódico contado do fim da execução anterior (sem manter fase):
+    /// para rotinas com guarda interna now - last >= INTERVAL
+    JobId everyAfter(const char* name, uint32_t gapMs, JobFunction fn, uint32_t firstDelayMs = 0);
+
+    /// Job one-shot; o slot é liberado depois de executar
+    JobId after(const char* name, uint32_t delayMs, JobFunction fn);
+
+    /// Próxima execução daqui a delayMs (também retoma um job pausado)
+    void reschedule(JobId id, uint32_t delayMs);
+
+    /// Como reschedule, mas só antecipa: nunca adia um deadline mais próximo
+    void runWithin(JobId id, uint32_t delayMs);
+
+    /// Tira do heap até o próximo reschedule
+    void pause(JobId id);
+
+    void cancel(JobId id);
+
+    /**
+     * @brief Executa os jobs vencidos
+     * @return ms até o próximo deadline (limitado a maxSleepMs)
+     */
+    uint32_t runDue(uint32_t maxSleepMs = 1000);
+
+    /// Dorme até timeoutMs ou até notify()
+    void waitNext(uint32_t timeoutMs);
+
+    /// Acorda o loop antes do próximo deadline (tarefa / ISR)
+    void notify();
+    void IRAM_ATTR notifyFromISR();
+
+    const JobStats* getStats(JobId id) const;
+    uint32_t getWakeups() const { return wakeups; }
+    uint32_t getDroppedMessages() const { return droppedMessages; }
+
+    /// Mensagens de outras tarefas esperando na caixa de entrada
+    uint8_t getPendingMessages() const;
+    uint8_t getJobCount() const;
+
+    /// {"wakeups","messages","dropped","jobs":[{"name","runs","avg_us","max_us","max_late_ms"},...]}
+    void toJson(JsonObject obj) const;
+
+private:
+    struct Job {
+        const char* name = "";
+        JobFunction fn;
+        uint32_t deadline = 0;
+        uint32_t periodMs = 0;      // 0 = one-shot
+        bool fromEnd = false;       // Próximo deadline = fim da execução + período
+        int8_t heapIndex = -1;      // -1 = fora do heap (pausado ou livre)
+        bool used = false;
+        JobStats stats = {};
+    };
+
+    explicit Scheduler(const char* name);
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    JobId add(const char* name, uint32_t periodMs, uint32_t delayMs, JobFunction fn, bool fromEnd = false);
+    void run(JobId id, uint32_t now);
+    void setDeadline(JobId id, uint32_t deadline);
+    void drainInbox();
+
+    // Min-heap de índices de jobs, ordenado por deadline (com wrap do millis)
+    static bool before(uint32_t a, uint32_t b) { return (int32_t)(a - b) < 0; }
+    void heapPush(JobId id);
+    void heapRemove(JobId id);
+    void siftUp(uint8_t pos);
+    void siftDown(uint8_t pos);
+    void heapSwap(uint8_t a, uint8_t b);
+
+    Job jobs[MAX_JOBS];
+    JobId heap[MAX_JOBS] = {};
+    uint8_t heapSize = 0;
+
+    // Job em execução: reschedule/pause dele são aplicados ao terminar
+    JobId running = INVALID_JOB;
+    bool runningRescheduled = false;
+    bool runningPaused = false;
+
+    const char* name;
+    void* waitingTask = nullptr;
+    void* inbox = nullptr;          // Fila de JobFunction* vindas de outras tarefas
+    uint32_t wakeups = 0;
+    uint32_t messages = 0;
+    uint32_t droppedMessages = 0;
+};
+
+#endif // SCHEDULER_H
@@ -0,0 +1,63 @@
+/**
+ * @file TaskTopology.h
+ * @brief Tarefas FreeRTOS do display e relatório de uso de pilha
+ *
+ * O firmware roda em duas tarefas fixadas em cores diferentes:
+ * - ui (UI_TASK_CORE): LVGL, touch, botões, DataBinder, estado dos botões
+ * - network (NET_TASK_CORE): MQTT, HTTP da API e parse dos JSON recebidos
+ *
+ * Cada uma tem seu Scheduler; a comunicação entre elas é só por
+ * Scheduler::dispatch(). A pilha de cada tarefa vem do DeviceConfig e o
+ * high-water mark é acompanhado para ajustar o orçamento com dados reais.
+ */
+
+#ifndef TASK_TOPOLOGY_H
+#define TASK_TOPOLOGY_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+class TaskTopology {
+public:
+    static const uint8_t MAX_TASKS = 6;
+
+    typedef void (*TaskEntry)(void* arg);
+
+    struct TaskInfo {
+        const char* name;
+        void* handle;
+        uint8_t core;
+        uint8_t priority;
+        uint32_t stackBytes;        // Orçamento configurado
+        uint32_t minFreeBytes;      // High-water mark (menor pilha livre vista)
+        bool warned;
+    };
+
+    static TaskTopology& getInstance();
+
+    /**
+     * @brief Cria a tarefa fixada no core e registra no relatório
+     * @return Handle da tarefa (nullptr em falha ou no native)
+     */
+    void* spawn(const char* name, TaskEntry entry, uint32_t stackBytes,
+                uint8_t priority, uint8_t core, void* arg = nullptr);
+
+    /// Atualiza os high-water marks; avisa uma vez por tarefa abaixo de TASK_STACK_WARN_FREE
+    void check();
+
+    uint8_t getTaskCount() const { return taskCount; }
+    const TaskInfo* getTask(uint8_t index) const { return index < taskCount ? &tasks[index] : nullptr; }
+
+    /// [{"name","core","priority","stack","free_min","used_pct"},...]
+    void toJson(JsonArray list) const;
+
+private:
+    TaskTopology() = default;
+    TaskTopology(const TaskTopology&) = delete;
+    TaskTopology& operator=(const TaskTopology&) = delete;
+
+    TaskInfo tasks[MAX_TASKS] = {};
+    uint8_t taskCount = 0;
+};
+
+#endif // TASK_TOPOLOGY_H
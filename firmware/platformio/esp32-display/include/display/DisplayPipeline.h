@@ -0,0 +1,106 @@
+/**
+ * @file DisplayPipeline.h
+ * @brief Pipeline de flush assíncrono com buffer duplo para LVGL
+ *
+ * O LVGL renderiza a próxima faixa em um buffer enquanto o transporte
+ * envia a faixa anterior a partir do outro buffer.
+ */
+
+#ifndef DISPLAY_PIPELINE_H
+#define DISPLAY_PIPELINE_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include "display/DisplayTransport.h"
+
+class RenderProfiler;
+
+/**
+ * @brief Métricas do pipeline de display
+ */
+struct DisplayStats {
+    float fps = 0;                 // Frames por segundo (janela de ~1s)
+    uint32_t frames = 0;           // Frames renderizados desde o reset
+    uint32_t flushes = 0;          // Áreas enviadas ao transporte
+    uint32_t lastFlushUs = 0;      // Duração do último flush
+    uint32_t avgFlushUs = 0;       // Duração média dos flushes
+    uint32_t maxFlushUs = 0;       // Maior duração de flush
+    uint32_t lastFrameMs = 0;      // Tempo de render+flush do último frame (LVGL)
+    uint32_t maxFrameMs = 0;       // Maior tempo de frame
+    uint32_t renderStalls = 0;     // Vezes que o LVGL esperou um buffer livre
+    uint32_t lostFlushes = 0;      // Áreas perdidas pelo transporte (tela redesenhada)
+};
+
+class DisplayPipeline {
+public:
+    /**
+     * @param transport Transporte de pixels (não é liberado pelo pipeline)
+     * @param width Largura do display
+     * @param height Altura do display
+     * @param bufferLines Linhas por buffer de renderização
+     */
+    DisplayPipeline(DisplayTransport* transport, uint16_t width, uint16_t height, uint16_t bufferLines);
+    ~DisplayPipeline();
+
+    /**
+     * @brief Aloca os dois buffers e registra o driver LVGL
+     * @return true se registrado com sucesso
+     */
+    bool begin();
+
+    /**
+     * @brief Conclui um flush terminado; chamar no loop principal
+     */
+    void poll();
+
+    /// Flush em andamento (o loop não deve dormir até ele terminar)
+    bool isFlushing() const { return flushing; }
+
+    lv_disp_t* getDisplay() { return display; }
+    DisplayTransport* getTransport() { return transport; }
+    uint16_t getBufferLines() const { return bufferLines; }
+
+    const DisplayStats& getStats() const { return stats; }
+    void resetStats();
+
+    /// Encaminha início de render, flushes e fim de frame ao profiler (nullptr desliga)
+    void setProfiler(RenderProfiler* profiler) { this->profiler = profiler; }
+    RenderProfiler* getProfiler() { return profiler; }
+
+private:
+    static void flushCallback(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t* colors);
+    static void waitCallback(lv_disp_drv_t* drv);
+    static void monitorCallback(lv_disp_drv_t* drv, uint32_t timeMs, uint32_t pixels);
+    static void renderStartCallback(lv_disp_drv_t* drv);
+
+    void completeFlush();
+    lv_color_t* allocateBuffer(size_t pixels);
+
+    DisplayTransport* transport;
+    RenderProfiler* profiler = nullptr;
+    uint16_t width;
+    uint16_t height;
+    uint16_t bufferLines;
+
+    lv_disp_draw_buf_t drawBuf;
+    lv_disp_drv_t dispDrv;
+    lv_disp_t* display = nullptr;
+    lv_color_t* buf1 = nullptr;
+    lv_color_t* buf2 = nullptr;
+
+    // Flush em andamento
+    bool flushing = false;
+    bool redrawPending = false;     // Área perdida: invalidar a tela ao fim do frame
+    bool stalledThisFlush = false;
+    unsigned long flushStartUs = 0;
+    uint64_t totalFlushUs = 0;
+
+    // Janela de FPS
+    unsigned long fpsWindowStart = 0;
+    uint32_t fpsWindowFrames = 0;
+    int frameTiming = -1;           // Slot "lvgl_frame" do runtime_stats
+
+    DisplayStats stats;
+};
+
+#endif // DISPLAY_PIPELINE_H
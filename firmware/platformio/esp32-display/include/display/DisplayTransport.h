@@ -0,0 +1,56 @@
+/**
+ * @file DisplayTransport.h
+ * @brief Interface de transporte de pixels para o pipeline de display
+ *
+ * Separa o envio dos pixels (SPI/DMA, framebuffer em memória, etc) do
+ * driver LVGL. O transporte pode retornar de startFlush() antes de concluir
+ * a transferência; o pipeline consulta isBusy() para liberar o buffer.
+ * Esperas pelo fim de uma transferência usam waitIdle(): cede o core e
+ * desiste após um timeout, em vez de girar até o watchdog disparar.
+ */
+
+#ifndef DISPLAY_TRANSPORT_H
+#define DISPLAY_TRANSPORT_H
+
+#include <stdint.h>
+
+class DisplayTransport {
+public:
+    virtual ~DisplayTransport() {}
+
+    /**
+     * @brief Inicializa o transporte
+     * @return true se inicializado com sucesso
+     */
+    virtual bool begin() = 0;
+
+    /**
+     * @brief Inicia o envio de uma área (RGB565)
+     * @param x Coluna inicial
+     * @param y Linha inicial
+     * @param w Largura da área
+     * @param h Altura da área
+     * @param pixels Pixels da área; devem permanecer válidos até isBusy() == false
+     * @return false se uma área se perdeu (transferência anterior travada):
+     *         o que está na tela não corresponde mais ao que o LVGL desenhou
+     */
+    virtual bool startFlush(int32_t x, int32_t y, uint32_t w, uint32_t h, uint16_t* pixels) = 0;
+
+    /**
+     * @brief Indica se a última transferência ainda está em andamento
+     */
+    virtual bool isBusy() = 0;
+
+    /**
+     * @brief Espera a transferência atual terminar, cedendo o core a cada ms
+     * @return false se ainda estiver ocupado após timeoutMs (transferência travada; loga erro)
+     */
+    bool waitIdle(uint32_t timeoutMs);
+
+    /**
+     * @brief Nome do transporte (para logs/telemetria)
+     */
+    virtual const char* getName() const = 0;
+};
+
+#endif // DISPLAY_TRANSPORT_H
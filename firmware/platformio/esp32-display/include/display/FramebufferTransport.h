@@ -0,0 +1,63 @@
+/**
+ * @file FramebufferTransport.h
+ * @brief Transporte para framebuffer em memória com latência simulada
+ *
+ * Usado em testes no host: simula o tempo de transferência de um barramento
+ * SPI e só copia os pixels para o framebuffer quando a transferência
+ * "termina", expondo bugs de reuso prematuro do buffer de renderização.
+ */
+
+#ifndef FRAMEBUFFER_TRANSPORT_H
+#define FRAMEBUFFER_TRANSPORT_H
+
+#include <Arduino.h>
+#include "display/DisplayTransport.h"
+
+class FramebufferTransport : public DisplayTransport {
+public:
+    /**
+     * @param width Largura do framebuffer
+     * @param height Altura do framebuffer
+     * @param bytesPerSecond Vazão simulada (padrão ~ SPI 65MHz)
+     * @param setupUs Custo fixo por transferência
+     */
+    FramebufferTransport(uint16_t width, uint16_t height,
+                         uint32_t bytesPerSecond = 8000000, uint32_t setupUs = 50);
+    ~FramebufferTransport();
+
+    bool begin() override;
+    bool startFlush(int32_t x, int32_t y, uint32_t w, uint32_t h, uint16_t* pixels) override;
+    bool isBusy() override;
+    const char* getName() const override { return "framebuffer"; }
+
+    void setLatency(uint32_t bytesPerSecond, uint32_t setupUs);
+
+    const uint16_t* getFramebuffer() const { return framebuffer; }
+    uint16_t getPixel(uint16_t x, uint16_t y) const;
+    uint16_t getWidth() const { return width; }
+    uint16_t getHeight() const { return height; }
+    uint32_t getFlushCount() const { return flushCount; }
+
+private:
+    void commitPending();
+
+    uint16_t width;
+    uint16_t height;
+    uint16_t* framebuffer = nullptr;
+
+    uint32_t bytesPerSecond;
+    uint32_t setupUs;
+
+    // Transferência em andamento
+    bool pending = false;
+    unsigned long busyUntilUs = 0;
+    int32_t pendingX = 0;
+    int32_t pendingY = 0;
+    uint32_t pendingW = 0;
+    uint32_t pendingH = 0;
+    const uint16_t* pendingPixels = nullptr;
+
+    uint32_t flushCount = 0;
+};
+
+#endif // FRAMEBUFFER_TRANSPORT_H
@@ -0,0 +1,90 @@
+/**
+ * @file RenderProfiler.h
+ * @brief Perfil de renderização e invalidação do LVGL
+ *
+ * Alimentado pelos callbacks do driver registrados no DisplayPipeline:
+ * render_start (áreas invalidadas do frame), flush (área enviada) e
+ * monitor (fim do frame). Tudo fica em histogramas de tamanho fixo e
+ * numa tabela pequena dos objetos que mais invalidam, publicados
+ * periodicamente pelo StatusReporter e zerados a cada janela.
+ *
+ * A atribuição de uma área invalidada a um objeto é aproximada: o LVGL 8
+ * não informa quem invalidou, então cada área é associada ao objeto mais
+ * profundo da tela ativa que contém seu centro e cobre boa parte dela.
+ */
+
+#ifndef RENDER_PROFILER_H
+#define RENDER_PROFILER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <lvgl.h>
+#include "utils/Histogram.h"
+
+class RenderProfiler {
+public:
+    static const uint8_t TOP_OBJECTS = 8;
+    static const uint8_t NAME_LENGTH = 24;
+
+    struct ObjectEntry {
+        const lv_obj_t* obj = nullptr;
+        char name[NAME_LENGTH] = {0};
+        uint32_t count = 0;
+    };
+
+    RenderProfiler(uint16_t screenWidth, uint16_t screenHeight);
+
+    // ---- Ganchos chamados pelo DisplayPipeline ----
+    void onRenderStart(lv_disp_t* disp);
+    void onFlush(uint32_t w, uint32_t h);
+    void onFrameDone(uint32_t pixels);
+
+    /// Atribuição de áreas a objetos (percorre a árvore; desligar se pesar)
+    void setObjectTracking(bool enabled) { objectTracking = enabled; }
+    bool isObjectTracking() const { return objectTracking; }
+
+    /// Início da janela atual (millis)
+    unsigned long getWindowStart() const { return windowStart; }
+    uint32_t getFrames() const { return frameTimeUs.getCount(); }
+
+    const Histogram& getFrameTimeUs() const { return frameTimeUs; }
+    const Histogram& getFramePixels() const { return framePixels; }
+    const Histogram& getInvalidatedAreas() const { return invalidatedAreas; }
+    const Histogram& getFlushPixels() const { return flushPixels; }
+    const ObjectEntry* getTopObjects() const { return topObjects; }
+
+    /// Preenche o resumo da janela (histogramas, totais e top objetos)
+    void toJson(JsonObject obj) const;
+
+    /// Zera histogramas e tabela, iniciando nova janela
+    void reset();
+
+private:
+    void trackArea(const lv_area_t& area);
+    void countObject(const lv_obj_t* obj);
+    static lv_obj_t* findOwner(lv_obj_t* obj, const lv_area_t& area, uint32_t areaSize);
+    static void describe(const lv_obj_t* obj, char* out, size_t len);
+
+    uint32_t screenPixels;
+    bool objectTracking = true;
+
+    Histogram frameTimeUs;
+    Histogram framePixels;
+    Histogram invalidatedAreas;
+    Histogram flushPixels;
+
+    ObjectEntry topObjects[TOP_OBJECTS];
+
+    // Frame em andamento
+    unsigned long frameStartUs = 0;
+    bool frameOpen = false;
+
+    // Totais da janela
+    unsigned long windowStart = 0;
+    uint64_t totalFlushedPixels = 0;
+    uint64_t totalInvalidatedPixels = 0;
+    uint32_t totalFlushes = 0;
+    uint32_t fullScreenFrames = 0;
+};
+
+#endif // RENDER_PROFILER_H
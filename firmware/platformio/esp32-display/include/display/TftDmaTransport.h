@@ -0,0 +1,39 @@
+/**
+ * @file TftDmaTransport.h
+ * @brief Transporte TFT_eSPI com envio por DMA
+ */
+
+#ifndef TFT_DMA_TRANSPORT_H
+#define TFT_DMA_TRANSPORT_H
+
+#include <TFT_eSPI.h>
+#include "display/DisplayTransport.h"
+
+/**
+ * @class TftDmaTransport
+ * @brief Envia áreas para o TFT via DMA, sem bloquear a renderização
+ *
+ * Se o DMA não puder ser inicializado, cai para envio bloqueante
+ * (mesmo comportamento do flush original). O barramento SPI e a troca de
+ * bytes só valem durante cada envio: outros dispositivos no mesmo SPI e
+ * outros usuários do TFT_eSPI não são afetados entre as faixas.
+ */
+class TftDmaTransport : public DisplayTransport {
+public:
+    explicit TftDmaTransport(TFT_eSPI& display) : tft(display) {}
+    ~TftDmaTransport();
+
+    bool begin() override;
+    bool startFlush(int32_t x, int32_t y, uint32_t w, uint32_t h, uint16_t* pixels) override;
+    bool isBusy() override;
+    const char* getName() const override { return dmaEnabled ? "tft_dma" : "tft_blocking"; }
+
+    bool isDmaEnabled() const { return dmaEnabled; }
+
+private:
+    TFT_eSPI& tft;
+    bool dmaEnabled = false;
+    bool writing = false;   // startWrite() do envio DMA em andamento (endWrite no isBusy)
+};
+
+#endif // TFT_DMA_TRANSPORT_H
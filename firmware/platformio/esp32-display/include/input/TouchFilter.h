@@ -0,0 +1,86 @@
+/**
+ * @file TouchFilter.h
+ * @brief Filtro de amostras do touch resistivo: debounce por pressão,
+ *        mediana de 3 e IIR adaptativo nas coordenadas
+ *
+ * Independente do driver (XPT2046) para poder ser testado no host com
+ * traces gravados. O TouchHandler alimenta uma amostra por leitura do
+ * LVGL; o filtro decide pressionado/solto e entrega a coordenada filtrada.
+ *
+ * - Press: pressão >= pressThreshold em pressSamples amostras seguidas
+ *   (ruído isolado do resistivo não vira toque).
+ * - Release: pressão < releaseThreshold por releaseHoldMs (histerese;
+ *   quedas curtas de pressão no meio do arrasto não soltam o botão).
+ * - Coordenadas: mediana das 3 últimas amostras válidas elimina picos;
+ *   o IIR acompanha rápido movimentos grandes e suaviza o tremor parado.
+ */
+
+#ifndef TOUCH_FILTER_H
+#define TOUCH_FILTER_H
+
+#include <Arduino.h>
+
+struct TouchSample {
+    uint16_t x;         // Coordenada raw do ADC
+    uint16_t y;
+    uint16_t z;         // Pressão (0 = sem toque)
+    uint32_t timeMs;
+};
+
+class TouchFilter {
+public:
+    struct Config {
+        uint16_t pressThreshold;
+        uint16_t releaseThreshold;
+        uint8_t pressSamples;
+        uint32_t releaseHoldMs;
+        uint16_t fastMoveDelta;    // Acima disso (raw) a saída segue a mediana direto
+    };
+
+    TouchFilter();
+    explicit TouchFilter(const Config& config);
+
+    /// Processa uma amostra; retorna o estado pressionado após ela
+    bool feed(const TouchSample& sample);
+
+    bool isPressed() const { return pressed; }
+
+    /// Coordenada filtrada (raw do ADC), válida enquanto pressionado
+    uint16_t getX() const { return (uint16_t)(filteredX >> FIXED_SHIFT); }
+    uint16_t getY() const { return (uint16_t)(filteredY >> FIXED_SHIFT); }
+
+    /// Tempo da amostra que confirmou o toque atual
+    uint32_t getPressTime() const { return pressTime; }
+
+    void reset();
+
+    const Config& getConfig() const { return config; }
+
+private:
+    static const uint8_t FIXED_SHIFT = 4;   // Coordenadas em ponto fixo 12.4
+
+    void pushValid(const TouchSample& sample);
+    void applyIir(uint16_t x, uint16_t y);
+    uint16_t medianX() const;
+    uint16_t medianY() const;
+    static uint16_t median3(uint16_t a, uint16_t b, uint16_t c);
+
+    Config config;
+
+    bool pressed = false;
+    uint8_t strongCount = 0;        // Amostras seguidas acima de pressThreshold
+    bool releasing = false;         // Pressão abaixo de releaseThreshold
+    uint32_t weakSince = 0;         // Início da pressão baixa
+    uint32_t pressTime = 0;
+
+    // Últimas amostras válidas para a mediana
+    uint16_t histX[3] = {0, 0, 0};
+    uint16_t histY[3] = {0, 0, 0};
+    uint8_t histCount = 0;
+    uint8_t histPos = 0;
+
+    int32_t filteredX = 0;
+    int32_t filteredY = 0;
+};
+
+#endif // TOUCH_FILTER_H
@@ -1,6 +1,12 @@
 /**
  * @file TouchHandler.h
  * @brief Touch screen handler for XPT2046
+ *
+ * O IRQ do XPT2046 acorda a leitura: com o painel solto o timer de leitura
+ * do LVGL fica pausado e nenhuma transação SPI acontece. Enquanto tocado,
+ * as amostras (a cada TOUCH_SAMPLE_PERIOD) passam pelo TouchFilter, que
+ * confirma o toque em TOUCH_PRESS_SAMPLES leituras em vez de esperar um
+ * tempo fixo de estabilização.
  */
 
 #ifndef TOUCH_HANDLER_H
@@ -10,6 +16,7 @@
 #include <XPT2046_Touchscreen.h>
 #include <SPI.h>
 #include <lvgl.h>
+#include "input/TouchFilter.h"
 
 // Forward declaration
 class Logger;
@@ -25,6 +32,13 @@ public:
     // LVGL callback
     static void read(lv_indev_drv_t* indev_driver, lv_indev_data_t* data);
     
+    // Retoma a leitura quando o IRQ sinaliza toque (chamar no loop);
+    // true quando acabou de retomar (o LVGL deve rodar já)
+    bool update();
+    
+    // IRQ até toque confirmado no último toque (ms)
+    uint32_t getLastPressLatency() const { return lastPressLatency; }
+    
     // Get LVGL input device
     lv_indev_t* getInputDevice() { return indev; }
     
@@ -50,26 +64,22 @@ private:
     uint16_t touchMaxY = 3800;
     
     // Touch state
-    uint32_t lastTouchTime = 0;
+    TouchFilter filter;
+    lv_point_t lastPoint = {0, 0};     // Mantido no release (LVGL usa para o click)
+    uint32_t lastIrqTime = 0;          // Última leitura com IRQ ativo
+    uint32_t wakeTime = 0;             // Início do toque atual (IRQ, ou 1ª amostra forte após soltar)
+    bool released = false;             // Soltou sem parar a leitura: próximo toque recomeça wakeTime
+    uint32_t lastPressLatency = 0;
+    bool sampling = false;             // Timer de leitura do LVGL rodando
     uint32_t lastDebugTime = 0;
     bool debugEnabled = false;
     Logger* logger;
     
-    // Minimum pressure threshold
-    static const uint16_t MIN_PRESSURE = 400;
-    
-    // Filtro de estado para estabilização
-    bool touchState = false;           // Estado atual do touch
-    bool lastRawState = false;         // Último estado raw lido
-    uint32_t stateChangeTime = 0;      // Quando o estado mudou
-    static const uint32_t STATE_CONFIRM_TIME = 150;  // 150ms para confirmar
-    static const uint32_t IMPROVED_DEBOUNCE_TIME = 100;  // Debounce melhorado
-    
-    // Debounce time in ms
-    static const uint32_t DEBOUNCE_TIME = 50;
+    void startSampling(uint32_t now);
+    void stopSampling();
     
     // Debug interval in ms
-    static const uint32_t DEBUG_INTERVAL = 500;
+    static const uint32_t DEBUG_INTERVAL = 1000;
 };
 
 #endif // TOUCH_HANDLER_H
\ No newline at end of file
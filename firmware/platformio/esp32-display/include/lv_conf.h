@@ -35,7 +35,11 @@
 #define LV_MEM_CUSTOM 0
 #if LV_MEM_CUSTOM == 0
     /* Size of the memory available for `lv_mem_alloc()` in bytes (>= 2kB)*/
+    #ifdef NATIVE_BUILD
+    #define LV_MEM_SIZE (128U * 1024U)         /* Host 64 bits: ponteiros dobram o tamanho dos objetos */
+    #else
     #define LV_MEM_SIZE (64U * 1024U)          /* [bytes] */
+    #endif
 
     /* Set an address for the memory pool instead of allocating it as a normal array. Can be in external SRAM too. */
     #define LV_MEM_ADR 0     /*0: unused*/
@@ -4,17 +4,23 @@
 #include <Arduino.h>
 #include <vector>
 #include <map>
+#include "utils/StringPool.h"
 
 // Estrutura para armazenar informações do device
+// uuid e type vêm do StringPool: são os mesmos ponteiros usados pelos
+// NavButtons e pelo CommandSender para o mesmo device (só na tarefa de UI)
 struct DeviceInfo {
     uint8_t id;
-    String uuid;
-    String type;
+    const char* uuid;
+    const char* type;
     String name;
     
-    DeviceInfo() : id(0) {}
+    DeviceInfo() : id(0), uuid(""), type("") {}
     DeviceInfo(uint8_t _id, const String& _uuid, const String& _type = "", const String& _name = "") 
-        : id(_id), uuid(_uuid), type(_type), name(_name) {}
+        : id(_id),
+          uuid(StringPool::getInstance().intern(_uuid)),
+          type(StringPool::getInstance().intern(_type)),
+          name(_name) {}
 };
 
 // Estrutura para armazenar informações do relay board
@@ -29,7 +35,22 @@ struct RelayBoardInfo {
         : id(_id), device_id(_device_id), name(_name), total_channels(_channels) {}
 };
 
+// Devices e relay boards lidos da config, ainda sem internar: montado na
+// tarefa de rede e entregue inteiro ao registry na tarefa de UI
+struct DeviceList {
+    struct Device {
+        uint8_t id;
+        String uuid;
+        String type;
+        String name;
+    };
+    
+    std::vector<Device> devices;
+    std::vector<RelayBoardInfo> relayBoards;
+};
+
 // Classe para gerenciar mapeamento de devices e relay boards
+// Só a tarefa de UI lê e escreve (a rede entrega um DeviceList por dispatch)
 class DeviceRegistry {
 private:
     std::map<uint8_t, DeviceInfo> devices;           // device_id -> DeviceInfo
@@ -57,8 +78,19 @@ public:
         relayBoards[board.id] = board;
     }
     
-    // Resolve relay_board_id -> device uuid
-    String resolveRelayBoardToUuid(uint8_t relay_board_id) {
+    // Troca todo o conteúdo pela lista nova (interna uuid/type aqui)
+    void replace(const DeviceList& list) {
+        clear();
+        for (const DeviceList::Device& device : list.devices) {
+            addDevice(DeviceInfo(device.id, device.uuid, device.type, device.name));
+        }
+        for (const RelayBoardInfo& board : list.relayBoards) {
+            addRelayBoard(board);
+        }
+    }
+    
+    // Resolve relay_board_id -> device uuid (internado; "" se não encontrado)
+    const char* resolveRelayBoardToUuid(uint8_t relay_board_id) {
         Serial.printf("[DeviceRegistry] Resolving relay_board_id: %d\n", relay_board_id);
         Serial.printf("[DeviceRegistry] Total relay boards: %d\n", relayBoards.size());
         
@@ -83,12 +115,12 @@ public:
             Serial.println("[DeviceRegistry] Available devices:");
             for (auto& pair : devices) {
                 Serial.printf("  - Device ID: %d, UUID: %s, Type: %s\n", 
-                    pair.second.id, pair.second.uuid.c_str(), pair.second.type.c_str());
+                    pair.second.id, pair.second.uuid, pair.second.type);
             }
             return ""; // Device não encontrado
         }
         
-        Serial.printf("[DeviceRegistry] Resolved UUID: %s\n", deviceIt->second.uuid.c_str());
+        Serial.printf("[DeviceRegistry] Resolved UUID: %s\n", deviceIt->second.uuid);
         return deviceIt->second.uuid;
     }
     
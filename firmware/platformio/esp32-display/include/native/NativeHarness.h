@@ -0,0 +1,83 @@
+/**
+ * @file NativeHarness.h
+ * @brief Monta a pilha de UI/MQTT do display no host, sem hardware
+ *
+ * Reproduz o setup() do firmware sobre os substitutos do env:native:
+ * LVGL renderiza para um FramebufferTransport via DisplayPipeline, a
+ * configuração chega pelo ScreenApiClient real (respondida pelo
+ * FakeHttpServer) e o MQTTClient real fala com o FakeBroker. O tempo só
+ * avança em pump(), então cenários são determinísticos.
+ */
+
+#ifndef NATIVE_HARNESS_H
+#define NATIVE_HARNESS_H
+
+#ifdef NATIVE_BUILD
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include "display/FramebufferTransport.h"
+
+class NativeHarness {
+public:
+    NativeHarness(uint16_t width = 320, uint16_t height = 240);
+
+    /**
+     * @brief Inicializa LVGL, tema, display e todos os globais do firmware
+     * @return false se o pipeline de display não pôde ser criado
+     */
+    bool begin();
+
+    /**
+     * @brief Serve a resposta do endpoint /config/full e carrega via ConfigReceiver
+     * @param unifiedResponse JSON no formato da API (devices, relay_boards, screens...)
+     * @return true se a UI foi construída
+     */
+    bool loadConfig(const String& unifiedResponse);
+
+    /// Avança o relógio em passos de LVGL_TICK_PERIOD processando MQTT e LVGL
+    void pump(uint32_t ms);
+
+    /**
+     * @brief Emula as tarefas de UI e de rede do firmware
+     *
+     * Ligado, cada passo do pump() roda o MQTT e a caixa da rede como a
+     * tarefa de rede e o resto como a de UI: publishes da UI e respostas da
+     * rede passam pelas caixas de entrada, como no dispositivo. Desligado
+     * (padrão), tudo roda inline. Os testes rodam como a tarefa de UI.
+     */
+    void setSeparateTasks(bool enabled);
+
+    /// Pressiona e solta o ponteiro em (x, y)
+    void touch(int16_t x, int16_t y, uint32_t holdMs = 60);
+
+    /// Toca o centro de um objeto LVGL; false se não estiver visível
+    bool tap(lv_obj_t* obj);
+
+    /// Busca recursiva pelo primeiro label com o texto dado
+    lv_obj_t* findLabel(const char* text, lv_obj_t* root = nullptr);
+
+    /// Grava o framebuffer como PPM (P6)
+    bool dumpPpm(const char* path) const;
+
+    FramebufferTransport* getTransport() { return transport; }
+
+    /// Resposta de exemplo da API com uma placa de relés e uma tela de controles
+    static const char* defaultFixture();
+
+private:
+    static void pointerRead(lv_indev_drv_t* drv, lv_indev_data_t* data);
+
+    uint16_t width;
+    uint16_t height;
+    FramebufferTransport* transport = nullptr;
+    lv_indev_drv_t pointerDrv;
+    bool separateTasks = false;
+
+    static bool pointerPressed;
+    static lv_point_t pointerPoint;
+};
+
+#endif // NATIVE_BUILD
+
+#endif // NATIVE_HARNESS_H
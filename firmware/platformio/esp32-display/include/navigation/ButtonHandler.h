@@ -1,6 +1,15 @@
 /**
  * @file ButtonHandler.h
  * @brief Handler para os três botões de navegação
+ *
+ * Os pinos geram interrupção em qualquer borda; a ISR só anota o instante
+ * da primeira borda e rearma um timer one-shot do FreeRTOS. Quando os
+ * contatos ficam BUTTON_DEBOUNCE_DELAY sem bordas o timer lê o nível
+ * estável e enfileira um evento press/release com o instante da borda.
+ *
+ * O loop só drena a fila: nenhum digitalRead, e um clique completo durante
+ * uma operação longa (build de tela, HTTP) continua na fila em vez de se
+ * perder. Curto/longo é decidido pelos timestamps dos eventos.
  */
 
 #ifndef BUTTON_HANDLER_H
@@ -8,75 +17,82 @@
 
 #include <Arduino.h>
 #include <functional>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/timers.h>
 
 typedef std::function<void()> ButtonCallback;
 
 class ButtonHandler {
-private:
-    // Pin definitions
-    uint8_t pinPrev;
-    uint8_t pinSelect;
-    uint8_t pinNext;
-    
-    // Button states
-    bool prevState;
-    bool selectState;
-    bool nextState;
-    
-    // Debounce
-    unsigned long prevDebounce;
-    unsigned long selectDebounce;
-    unsigned long nextDebounce;
-    static const unsigned long DEBOUNCE_DELAY = 50;
-    
-    // Long press detection
-    unsigned long prevPressTime;
-    unsigned long selectPressTime;
-    unsigned long nextPressTime;
-    static const unsigned long LONG_PRESS_TIME = 1000;
-    
-    // Callbacks
-    ButtonCallback onPrevCallback;
-    ButtonCallback onSelectCallback;
-    ButtonCallback onNextCallback;
-    ButtonCallback onLongPrevCallback;
-    ButtonCallback onLongSelectCallback;
-    ButtonCallback onLongNextCallback;
-    
-    // Flags
-    bool prevLongPressed;
-    bool selectLongPressed;
-    bool nextLongPressed;
-    
 public:
+    enum ButtonId : uint8_t {
+        BUTTON_PREV = 0,
+        BUTTON_SELECT,
+        BUTTON_NEXT,
+        BUTTON_COUNT
+    };
+
+    struct ButtonEvent {
+        uint8_t button;     // ButtonId
+        bool pressed;       // true = press, false = release
+        uint32_t timeMs;    // Primeira borda da transição (antes do debounce)
+    };
+
     ButtonHandler(uint8_t prevPin, uint8_t selectPin, uint8_t nextPin);
-    
-    // Update button states (call in loop)
+    ~ButtonHandler();
+
+    // Processa os eventos enfileirados (chamar no loop)
     void update();
-    
+
     // Set callbacks
-    void onPrevious(ButtonCallback callback) { onPrevCallback = callback; }
-    void onSelect(ButtonCallback callback) { onSelectCallback = callback; }
-    void onNext(ButtonCallback callback) { onNextCallback = callback; }
-    
-    void onLongPrevious(ButtonCallback callback) { onLongPrevCallback = callback; }
-    void onLongSelect(ButtonCallback callback) { onLongSelectCallback = callback; }
-    void onLongNext(ButtonCallback callback) { onLongNextCallback = callback; }
-    
-    // Get current button states
-    bool isPrevPressed() const { return !prevState; }
-    bool isSelectPressed() const { return !selectState; }
-    bool isNextPressed() const { return !nextState; }
-    
+    void onPrevious(ButtonCallback callback) { buttons[BUTTON_PREV].onShort = callback; }
+    void onSelect(ButtonCallback callback) { buttons[BUTTON_SELECT].onShort = callback; }
+    void onNext(ButtonCallback callback) { buttons[BUTTON_NEXT].onShort = callback; }
+
+    void onLongPrevious(ButtonCallback callback) { buttons[BUTTON_PREV].onLong = callback; }
+    void onLongSelect(ButtonCallback callback) { buttons[BUTTON_SELECT].onLong = callback; }
+    void onLongNext(ButtonCallback callback) { buttons[BUTTON_NEXT].onLong = callback; }
+
+    // Estado debounced (mantido pelo timer, sem leitura de GPIO)
+    bool isPrevPressed() const { return buttons[BUTTON_PREV].stablePressed; }
+    bool isSelectPressed() const { return buttons[BUTTON_SELECT].stablePressed; }
+    bool isNextPressed() const { return buttons[BUTTON_NEXT].stablePressed; }
+
     // For LVGL integration
     uint32_t getPressedButton();
-    
+
+    // Eventos descartados com a fila cheia
+    uint32_t getDroppedEvents() const { return droppedEvents; }
+
 private:
-    bool readButton(uint8_t pin);
-    void handleButton(uint8_t pin, bool& state, unsigned long& debounce, 
-                     unsigned long& pressTime, bool& longPressed,
-                     ButtonCallback shortCallback, ButtonCallback longCallback,
-                     const String& buttonName);
+    struct Button {
+        uint8_t pin;
+        ButtonHandler* owner;
+
+        // Compartilhado ISR <-> timer
+        volatile bool bouncing;
+        volatile uint32_t edgeTime;
+        volatile bool stablePressed;
+
+        // Consumidor (loop)
+        bool held;
+        bool longFired;
+        uint32_t pressTime;
+        ButtonCallback onShort;
+        ButtonCallback onLong;
+    };
+
+    static void IRAM_ATTR onEdge(void* arg);
+    static void onDebounce(TimerHandle_t timer);
+    void handleEvent(const ButtonEvent& event);
+    void fire(Button& button, bool longPress, uint8_t index);
+    static const char* buttonName(uint8_t index);
+
+    Button buttons[BUTTON_COUNT];
+    QueueHandle_t events = nullptr;
+    TimerHandle_t debounceTimer = nullptr;
+    volatile uint32_t droppedEvents = 0;
+    uint8_t heldCount = 0;
 };
 
-#endif // BUTTON_HANDLER_H
\ No newline at end of file
+#endif // BUTTON_HANDLER_H
@@ -100,12 +100,12 @@ private:
     static String buildApiUrl(const String& endpoint);
     
     /**
-     * @brief Executa requisição HTTP com retry logic
-     * @param url URL da requisição
-     * @param method Método HTTP (GET, POST, PUT)
+     * @brief Executa requisição HTTP (uma tentativa; retry na AsyncFetch do registro)
+     * @param endpoint Endpoint relativo a API_BASE_PATH (sessão keep-alive compartilhada)
+     * @param method Método HTTP (GET, POST, PUT, PATCH)
      * @param payload Dados JSON para envio (vazio para GET)
      * @param response Resposta recebida da API
      * @return true se requisição foi bem-sucedida
      */
-    static bool makeHttpRequest(const String& url, const String& method, const String& payload, String& response);
+    static bool makeHttpRequest(const String& endpoint, const String& method, const String& payload, String& response);
 };
\ No newline at end of file
@@ -0,0 +1,79 @@
+/**
+ * @file HttpSession.h
+ * @brief Sessão HTTP/1.1 keep-alive com o backend, compartilhada pelos clientes da API
+ *
+ * ScreenApiClient e DeviceRegistration falam sempre com o mesmo servidor
+ * (API_SERVER:API_PORT). Em vez de um HTTPClient por chamada, todos usam
+ * um WiFiClient persistente com setReuse(true): a conexão TCP aberta na
+ * primeira requisição serve as seguintes enquanto o servidor mantiver o
+ * keep-alive, sem handshake e slow start a cada GET.
+ *
+ * Uso (tarefa de rede):
+ *   HTTPClient& http = session.open("/screens");
+ *   http.addHeader(...);              // opcional
+ *   int code = session.send("GET");
+ *   ... http.getString() / http.getStream() ...
+ *   session.close();                  // conexão continua aberta
+ */
+
+#ifndef HTTP_SESSION_H
+#define HTTP_SESSION_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <HTTPClient.h>
+#include <ArduinoJson.h>
+#include "utils/Histogram.h"
+
+class HttpSession {
+public:
+    static HttpSession& getInstance();
+
+    /**
+     * @brief Prepara uma requisição para API_BASE_PATH + path na conexão atual
+     * @return HTTPClient já com Accept/User-Agent/Authorization, para cabeçalhos extras
+     */
+    HTTPClient& open(const String& path);
+
+    /// Envia a requisição aberta; abre conexão TCP só se a anterior caiu
+    int send(const char* method, const String& payload = String());
+
+    /// Encerra a requisição e registra o tempo; a conexão fica para a próxima
+    void close();
+
+    /// open + send + corpo + close (corpo só em 2xx/4xx/5xx, vazio em erro de conexão)
+    int request(const char* method, const String& path, String& response, const String& payload = String());
+
+    /// Derruba a conexão (ex.: WiFi caiu); a próxima requisição reconecta
+    void reset();
+
+    void setTimeout(uint16_t timeoutMs);
+
+    uint32_t getRequestCount() const { return requests; }
+    uint32_t getConnectCount() const { return connects; }
+    uint32_t getFailureCount() const { return failures; }
+
+    /// Tempo de open() a close() por requisição (ms)
+    const Histogram& getLatency() const { return latencyMs; }
+
+    /// {"requests","connects","reused","failures","latency_ms":{histograma}}
+    void toJson(JsonObject obj) const;
+
+private:
+    HttpSession();
+    HttpSession(const HttpSession&) = delete;
+    HttpSession& operator=(const HttpSession&) = delete;
+
+    WiFiClient tcp;
+    HTTPClient http;
+    String baseUrl;
+
+    Histogram latencyMs;
+    uint32_t requests = 0;
+    uint32_t connects = 0;
+    uint32_t failures = 0;
+    uint32_t openedAt = 0;
+    bool active = false;
+};
+
+#endif // HTTP_SESSION_H
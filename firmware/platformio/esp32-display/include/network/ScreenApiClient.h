@@ -16,7 +16,9 @@
 #include <Arduino.h>
 #include <HTTPClient.h>
 #include <ArduinoJson.h>
+#include <memory>
 #include "../config/DeviceConfig.h"
+#include "../models/DeviceModels.h"
 
 /**
  * @class ScreenApiClient
@@ -24,16 +26,20 @@
  * 
  * Funcionalidades:
  * - Carregamento de configurações via HTTP
- * - Cache inteligente com TTL configurável
- * - Retry automático com backoff exponencial  
+ * - Cache da config completa no flash, revalidado por ETag (If-None-Match)
+ * - TTL configurável para pular até a revalidação
+ * - Uma tentativa por chamada; retry com backoff na AsyncFetch do chamador
+ * - Conexão keep-alive compartilhada (HttpSession)
  * - Suporte a autenticação Bearer Token
  * - Validação de conexão e error handling
  */
 class ScreenApiClient {
 private:
-    HTTPClient httpClient;
     String baseUrl;
-    String cachedConfig;
+    String cacheETag;           // Validador da cópia em flash ("" = sem cópia)
+    bool cacheETagLoaded;
+    String activeVersion;       // ETag da config já em memória no chamador
+    bool notModified;           // Última carga foi 304/cache, sem download
     unsigned long cacheTimestamp;
     unsigned long cacheTimeout;
     int lastHttpCode;
@@ -63,13 +69,38 @@ private:
     bool parseItemsResponse(const String& response, JsonArray& items);
     
     /**
-     * @brief Executa requisição HTTP com retry e error handling
+     * @brief Executa requisição HTTP com error handling (sem retry)
      * @param endpoint Endpoint para requisição
      * @param response String para armazenar resposta
      * @return true se requisição bem-sucedida
      */
     bool makeHttpRequest(const String& endpoint, String& response);
     
+    /**
+     * @brief GET condicional da config completa
+     * @param validator ETag enviado em If-None-Match ("" = incondicional)
+     * @param config Em 200, recebe o corpo parseado do stream com o filtro
+     *               (vazio se o JSON for inválido)
+     * @param etag ETag devolvido pelo servidor
+     * @return Código HTTP (304 não lê corpo)
+     */
+    int requestConfiguration(const String& endpoint, const String& validator, JsonDocument& config, String& etag);
+    
+    /// Filtro do ArduinoJson com os campos da config que o display usa
+    static void buildConfigFilter(JsonDocument& filter);
+    
+    /// Lê o validador da cópia em flash (uma vez por boot)
+    void loadCacheValidator();
+    
+    /// Config validada no flash -> config (sem rede)
+    bool readCachedConfiguration(JsonDocument& config);
+    
+    /// Grava a config processada no flash, chaveada pelo ETag
+    void writeCachedConfiguration(const JsonDocument& config, const String& etag);
+    
+    /// 304/TTL: o chamador que já tem a versão não recebe nada
+    bool useCachedConfiguration(JsonDocument& config, const String& validator);
+    
 public:
     /**
      * @brief Construtor da classe
@@ -122,10 +153,41 @@ public:
     bool isCacheValid();
     
     /**
-     * @brief Limpa o cache forçando nova requisição
+     * @brief Expira o TTL forçando nova requisição (condicional se houver cópia no flash)
      */
     void clearCache();
     
+    /**
+     * @brief Informa o ETag da config que o chamador já tem em memória
+     *
+     * Se o servidor responder 304 para ela, loadFullConfiguration retorna
+     * true sem tocar no documento (wasNotModified() == true, doc vazio).
+     */
+    void setActiveVersion(const String& etag) { activeVersion = etag; }
+    
+    /// A última carga veio de 304 ou do cache no flash
+    bool wasNotModified() const { return notModified; }
+    
+    /// ETag da cópia em flash ("" se não houver)
+    String getCachedVersion() { loadCacheValidator(); return cacheETag; }
+    
+    /**
+     * @brief Lê devices e relay boards de uma config processada
+     *
+     * Não toca no DeviceRegistry; serve a registerDevices e ao setup
+     * (boot pela última config boa, antes de as tarefas subirem).
+     */
+    static DeviceList parseDevices(const JsonDocument& config);
+    
+    /**
+     * @brief Troca o DeviceRegistry pelos devices da config
+     *
+     * Usado na resposta da API e quando a config vem do flash (304), que
+     * não passa por processUnifiedResponse. O parse roda aqui (rede); a
+     * troca vai para a tarefa de UI, única que lê o registry.
+     */
+    static void registerDevices(const JsonDocument& config);
+    
     /**
      * @brief Retorna último erro ocorrido
      * @return String com descrição do erro
@@ -187,12 +249,11 @@ public:
 
 private:
     /**
-     * @brief Processa resposta unificada do endpoint /api/config/full
-     * @param response JsonDocument com resposta unificada
-     * @param config JsonDocument para armazenar configuração processada
+     * @brief Valida e completa, no próprio documento, a resposta unificada
+     * @param config Resposta do endpoint /api/config/full já filtrada
      * @return true se processamento bem-sucedido
      */
-    bool processUnifiedResponse(const JsonDocument& response, JsonDocument& config);
+    bool processUnifiedResponse(JsonDocument& config);
 
     /**
      * @brief Carrega configuração usando múltiplas requisições (fallback)
@@ -200,6 +261,9 @@ private:
      * @return true se carregamento bem-sucedido
      */
     bool loadLegacyConfiguration(JsonDocument& config);
+
+    /// Entrega a lista à tarefa de UI, que troca o DeviceRegistry
+    static void installDevices(std::shared_ptr<DeviceList> list);
 };
 
 #endif // SCREEN_API_CLIENT_H
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include <lvgl.h>
 #include <vector>
 #include "NavButton.h"
+#include "utils/StringPool.h"
 
 /**
  * @brief Estrutura para armazenar binding de widgets com dados
@@ -18,10 +19,10 @@
 struct BoundWidget {
     lv_obj_t* widget;               // Widget LVGL principal
     NavButton* navButton;           // NavButton wrapper
-    String dataSource;              // Fonte dos dados (can_signal, telemetry, etc)
-    String dataPath;                // Caminho específico do dado
-    String dataUnit;                // Unidade de medida
-    JsonObject config;              // Configuração original do item
+    const char* dataSource;         // Fonte dos dados (can_signal, telemetry, etc) - StringPool
+    const char* dataPath;           // Caminho específico do dado - StringPool
+    const char* dataUnit;           // Unidade de medida - StringPool
+    JsonObjectConst config;         // Item dentro do snapshot da tela (vivo enquanto ela existir)
     float lastValue;                // Último valor aplicado
     unsigned long lastUpdate;       // Timestamp da última atualização
     unsigned long refreshInterval;  // Intervalo de refresh em ms
@@ -34,7 +35,6 @@ class DataBinder {
 private:
     std::vector<BoundWidget> boundWidgets;
     unsigned long lastGlobalUpdate = 0;
-    static const unsigned long GLOBAL_UPDATE_INTERVAL = 500; // 500ms entre atualizações globais
     
     // Intervalos por tipo de dado (ms)
     static const unsigned long REFRESH_CRITICAL = 500;   // Dados críticos (temp, pressure)
@@ -52,7 +52,7 @@ private:
      * @param path Caminho do dado
      * @return Valor float atual (ou simulado)
      */
-    float getDataValue(const String& source, const String& path);
+    float getDataValue(const char* source, const char* path);
     
     /**
      * @brief Determina intervalo de refresh baseado no tipo de dado
@@ -80,6 +80,8 @@ private:
     void applyBarColors(BoundWidget& binding, lv_obj_t* bar, float value);
 
 public:
+    static const unsigned long GLOBAL_UPDATE_INTERVAL = 500; // 500ms entre atualizações globais
+    
     DataBinder() = default;
     ~DataBinder() = default;
     
@@ -89,7 +91,7 @@ public:
      * @param navBtn NavButton wrapper
      * @param config Configuração JSON do item
      */
-    void bindWidget(lv_obj_t* widget, NavButton* navBtn, JsonObject& config);
+    void bindWidget(lv_obj_t* widget, NavButton* navBtn, JsonObjectConst config);
     
     /**
      * @brief Atualiza todos os widgets registrados (chamado no loop principal)
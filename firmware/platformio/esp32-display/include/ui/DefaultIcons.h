@@ -0,0 +1,173 @@
+/**
+ * @file DefaultIcons.h
+ * @brief Tabela padrão de ícones em flash com hash perfeito gerado em compilação
+ *
+ * Os ícones padrão ficam num array constexpr (rodata, mapeado da flash no
+ * ESP32) e são indexados por uma tabela de slots cujo seed de hash é
+ * procurado pelo próprio compilador até não haver colisões. A busca em
+ * tempo de execução é um hash + uma comparação de string, sem alocação e
+ * sem nada construído no boot.
+ *
+ * Para adicionar um ícone basta incluí-lo em ICONS; se o seed não for
+ * encontrado o static_assert abaixo falha e ICON_SLOT_BITS deve crescer.
+ */
+
+#ifndef DEFAULT_ICONS_H
+#define DEFAULT_ICONS_H
+
+#include <stdint.h>
+#include <string.h>
+#include <lvgl.h>
+
+namespace DefaultIcons {
+
+/**
+ * @struct IconEntry
+ * @brief Ícone padrão; lvglSymbol já é o glifo, não o nome da macro
+ */
+struct IconEntry {
+    uint8_t id;
+    const char* name;
+    const char* displayName;
+    const char* category;
+    const char* lvglSymbol;
+    const char* unicodeChar;
+    const char* emoji;
+    const char* fallbackIcon;
+};
+
+inline constexpr IconEntry ICONS[] = {
+    // Iluminação
+    { 1, "light",      "Luz",               "lighting",   LV_SYMBOL_CHARGE,       "\uf0eb", "💡", "" },
+    { 2, "light_high", "Farol Alto",        "lighting",   LV_SYMBOL_CHARGE,       "\uf0eb", "💡", "" },
+    { 3, "light_low",  "Farol Baixo",       "lighting",   LV_SYMBOL_CHARGE,       "\uf0eb", "💡", "" },
+    { 4, "fog_light",  "Luz de Neblina",    "lighting",   LV_SYMBOL_CHARGE,       "\uf0eb", "🌫️", "" },
+    { 5, "work_light", "Luz de Trabalho",   "lighting",   LV_SYMBOL_CHARGE,       "\uf0eb", "🔦", "" },
+    // Navegação
+    { 6, "home",       "Início",            "navigation", LV_SYMBOL_HOME,         "\uf015", "🏠", "" },
+    { 7, "back",       "Voltar",            "navigation", LV_SYMBOL_LEFT,         "\uf060", "⬅️", "" },
+    { 8, "forward",    "Avançar",           "navigation", LV_SYMBOL_RIGHT,        "\uf061", "➡️", "" },
+    { 9, "settings",   "Configurações",     "navigation", LV_SYMBOL_SETTINGS,     "\uf013", "⚙️", "" },
+    {10, "menu",       "Menu",              "navigation", LV_SYMBOL_LIST,         "\uf0c9", "☰", "" },
+    // Controle
+    {11, "power",      "Liga/Desliga",      "control",    LV_SYMBOL_POWER,        "\uf011", "⚡", "" },
+    {12, "play",       "Reproduzir",        "control",    LV_SYMBOL_PLAY,         "\uf04b", "▶️", "" },
+    {13, "stop",       "Parar",             "control",    LV_SYMBOL_STOP,         "\uf04d", "⏹️", "" },
+    {14, "pause",      "Pausar",            "control",    LV_SYMBOL_PAUSE,        "\uf04c", "⏸️", "" },
+    {15, "winch_in",   "Guincho Recolher",  "control",    LV_SYMBOL_UP,           "\uf062", "⬆️", "" },
+    {16, "winch_out",  "Guincho Estender",  "control",    LV_SYMBOL_DOWN,         "\uf063", "⬇️", "" },
+    {17, "aux",        "Auxiliar",          "control",    LV_SYMBOL_SETTINGS,     "\uf013", "🔧", "" },
+    {18, "compressor", "Compressor",        "control",    LV_SYMBOL_SETTINGS,     "\uf013", "🌪️", "" },
+    {19, "4x4_mode",   "Modo 4x4",          "control",    LV_SYMBOL_DRIVE,        "\uf1b9", "🚜", "" },
+    {20, "diff_lock",  "Trava Diferencial", "control",    LV_SYMBOL_CLOSE,        "\uf023", "🔒", "" },
+    // Status
+    {21, "ok",         "OK",                "status",     LV_SYMBOL_OK,           "\uf00c", "✅", "" },
+    {22, "warning",    "Atenção",           "status",     LV_SYMBOL_WARNING,      "\uf071", "⚠️", "" },
+    {23, "error",      "Erro",              "status",     LV_SYMBOL_CLOSE,        "\uf00d", "❌", "" },
+    {24, "wifi",       "WiFi",              "status",     LV_SYMBOL_WIFI,         "\uf1eb", "📶", "" },
+    {25, "battery",    "Bateria",           "status",     LV_SYMBOL_BATTERY_FULL, "\uf240", "🔋", "" },
+    {26, "bluetooth",  "Bluetooth",         "status",     LV_SYMBOL_BLUETOOTH,    "\uf293", "📘", "" },
+};
+
+inline constexpr uint8_t ICON_COUNT = sizeof(ICONS) / sizeof(ICONS[0]);
+
+// Categorias na ordem em que aparecem na tabela
+inline constexpr const char* CATEGORIES[] = { "lighting", "navigation", "control", "status" };
+inline constexpr uint8_t CATEGORY_COUNT = sizeof(CATEGORIES) / sizeof(CATEGORIES[0]);
+
+// ~2.5x o número de ícones: seed encontrado em poucas centenas de tentativas
+inline constexpr uint8_t ICON_SLOT_BITS = 6;
+inline constexpr uint8_t ICON_SLOT_COUNT = 1 << ICON_SLOT_BITS;
+inline constexpr uint8_t EMPTY_SLOT = 0xFF;
+
+static_assert(ICON_COUNT < EMPTY_SLOT, "Too many default icons for uint8_t slots");
+static_assert(ICON_COUNT <= ICON_SLOT_COUNT, "ICON_SLOT_BITS too small for ICONS");
+
+/// FNV-1a com base variável (o seed)
+constexpr uint32_t hash(const char* s, uint32_t seed) {
+    uint32_t h = seed;
+    while (*s) {
+        h ^= (uint8_t)*s++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/// Slot pelos bits altos: os baixos do FNV quase não dependem do seed
+constexpr uint8_t slotOf(const char* s, uint32_t seed) {
+    return (uint8_t)(hash(s, seed) >> (32 - ICON_SLOT_BITS));
+}
+
+constexpr bool equals(const char* a, const char* b) {
+    while (*a && *a == *b) {
+        a++;
+        b++;
+    }
+    return *a == *b;
+}
+
+struct SlotTable {
+    uint32_t seed;
+    uint8_t slots[ICON_SLOT_COUNT];
+};
+
+/// Procura um seed sem colisões; seed 0 indica que nenhum foi encontrado
+constexpr SlotTable buildSlotTable() {
+    for (uint32_t attempt = 0; attempt < 4096; attempt++) {
+        SlotTable table = { 2166136261u + attempt * 2654435761u, {} };
+        for (uint8_t s = 0; s < ICON_SLOT_COUNT; s++) {
+            table.slots[s] = EMPTY_SLOT;
+        }
+
+        bool collision = false;
+        for (uint8_t i = 0; i < ICON_COUNT && !collision; i++) {
+            uint8_t slot = slotOf(ICONS[i].name, table.seed);
+            if (table.slots[slot] != EMPTY_SLOT) {
+                collision = true;
+            } else {
+                table.slots[slot] = i;
+            }
+        }
+
+        if (!collision && table.seed != 0) {
+            return table;
+        }
+    }
+    return SlotTable{ 0, {} };
+}
+
+inline constexpr SlotTable SLOT_TABLE = buildSlotTable();
+static_assert(SLOT_TABLE.seed != 0, "No perfect hash seed for default icons; raise ICON_SLOT_BITS");
+
+/**
+ * @brief Busca O(1) de um ícone padrão
+ * @return Entrada na flash ou nullptr se o nome não for padrão
+ */
+constexpr const IconEntry* find(const char* name) {
+    uint8_t index = SLOT_TABLE.slots[slotOf(name, SLOT_TABLE.seed)];
+    if (index == EMPTY_SLOT || !equals(ICONS[index].name, name)) {
+        return nullptr;
+    }
+    return &ICONS[index];
+}
+
+/// Busca linear por id (fallback vindo da API referencia ícones por id)
+constexpr const IconEntry* findById(uint8_t id) {
+    for (uint8_t i = 0; i < ICON_COUNT; i++) {
+        if (ICONS[i].id == id) return &ICONS[i];
+    }
+    return nullptr;
+}
+
+// Toda entrada precisa ser encontrada pelo próprio nome
+constexpr bool allIconsReachable() {
+    for (uint8_t i = 0; i < ICON_COUNT; i++) {
+        if (find(ICONS[i].name) != &ICONS[i]) return false;
+    }
+    return true;
+}
+static_assert(allIconsReachable(), "Default icon slot table is inconsistent");
+
+} // namespace DefaultIcons
+
+#endif // DEFAULT_ICONS_H
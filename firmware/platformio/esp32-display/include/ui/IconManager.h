@@ -5,6 +5,9 @@
  * Esta classe gerencia o mapeamento entre nomes de ícones e símbolos LVGL,
  * com suporte a fallbacks e carregamento automático da API.
  * 
+ * Os ícones padrão vivem na flash (ui/DefaultIcons.h, hash perfeito gerado
+ * em compilação); em RAM fica apenas o delta recebido da API.
+ * 
  * @author Sistema AutoCore
  * @version 2.0.0
  * @date 2025-08-16
@@ -19,6 +22,8 @@
 #include <vector>
 #include <lvgl.h>
 
+namespace DefaultIcons { struct IconEntry; }
+
 /**
  * @struct IconMapping
  * @brief Estrutura para armazenar mapeamento de um ícone
@@ -27,7 +32,7 @@ struct IconMapping {
     String name;                // Nome do ícone (ex: "light", "power")
     String displayName;         // Nome para exibição (ex: "Luz", "Liga/Desliga")
     String category;            // Categoria (ex: "lighting", "control")
-    String lvglSymbol;          // Símbolo LVGL (ex: "LV_SYMBOL_POWER")
+    String lvglSymbol;          // Glifo LVGL já resolvido (ex: LV_SYMBOL_POWER)
     String unicodeChar;         // Caractere Unicode (ex: "\uf011")
     String emoji;               // Emoji fallback (ex: "💡")
     String fallbackIcon;        // Ícone fallback se outros falharem
@@ -52,34 +57,49 @@ struct IconMapping {
  * - Carregamento automático de ícones da API
  * - Mapeamento de nomes para símbolos LVGL
  * - Sistema de fallback: LVGL → Unicode → Emoji → Fallback Icon
- * - Cache local para performance
- * - Ícones padrão para casos de falha
+ * - Ícones padrão em flash com busca O(1) (hash perfeito)
+ * - Overrides da API guardados só como delta sobre os padrões
  */
 class IconManager {
 private:
-    std::map<String, IconMapping> iconMappings;
-    std::map<String, std::vector<String>> categorizedIcons;
+    static const uint8_t MAX_FALLBACK_DEPTH = 4;
+    
+    std::map<String, IconMapping> overrides;  // Apenas ícones que diferem do padrão
     bool iconsLoaded;
     String lastError;
+    uint32_t missCount;
+    size_t overrideBytes = 0;  // Estimativa reportada ao MemoryMonitor
     
     /**
-     * @brief Carrega ícones padrão (fallback se API falhar)
+     * @brief Processa o objeto de ícones da API ({nome: {...}})
+     * @param icons JsonObjectConst com os ícones
+     * @return true se processamento bem-sucedido
      */
-    void loadDefaultIcons();
+    bool processIconsResponse(JsonObjectConst icons);
     
     /**
-     * @brief Processa resposta da API de ícones
-     * @param response JsonDocument com resposta da API
-     * @return true se processamento bem-sucedido
+     * @brief Converte nome de símbolo LVGL para o glifo
+     * @param lvglSymbol String com símbolo LVGL (ex: "LV_SYMBOL_POWER")
+     * @return Glifo correspondente ou nullptr se desconhecido
      */
-    bool processIconsResponse(const JsonDocument& response);
+    static const char* convertLvglSymbol(const String& lvglSymbol);
     
     /**
-     * @brief Converte símbolo LVGL para caractere real
-     * @param lvglSymbol String com símbolo LVGL (ex: "LV_SYMBOL_POWER")
-     * @return Caractere Unicode correspondente
+     * @brief Resolve nome de ícone para símbolo seguindo a cadeia de fallback
+     */
+    String resolveSymbol(const String& iconName, bool preferLvgl, uint8_t depth);
+    
+    /**
+     * @brief Categoria de um ícone (override ou padrão), nullptr se não existe
      */
-    String convertLvglSymbol(const String& lvglSymbol);
+    const char* categoryOf(const String& iconName) const;
+    
+    static IconMapping fromEntry(const DefaultIcons::IconEntry& entry);
+    
+    /**
+     * @brief Descarta os overrides e devolve sua conta ao MemoryMonitor
+     */
+    void dropOverrides();
 
 public:
     /**
@@ -101,10 +121,10 @@ public:
     
     /**
      * @brief Carrega ícones de configuração JSON
-     * @param iconsConfig JsonObject com configuração de ícones
+     * @param iconsConfig JsonObjectConst com configuração de ícones (dentro do snapshot)
      * @return true se carregamento bem-sucedido
      */
-    bool loadFromConfig(const JsonObject& iconsConfig);
+    bool loadFromConfig(JsonObjectConst iconsConfig);
     
     /**
      * @brief Obtém símbolo para exibição por nome do ícone
@@ -142,7 +162,7 @@ public:
     std::vector<String> getCategories();
     
     /**
-     * @brief Limpa cache de ícones
+     * @brief Descarta overrides da API (os padrões da flash permanecem)
      */
     void clearCache();
     
@@ -162,7 +182,17 @@ public:
      * @brief Obtém número de ícones carregados
      * @return Número de ícones disponíveis
      */
-    size_t getIconCount() const { return iconMappings.size(); }
+    size_t getIconCount() const;
+    
+    /**
+     * @brief Obtém número de ícones vindos da API que diferem do padrão
+     */
+    size_t getOverrideCount() const { return overrides.size(); }
+    
+    /**
+     * @brief Buscas por ícones inexistentes desde o boot
+     */
+    uint32_t getMissCount() const { return missCount; }
     
     /**
      * @brief Cria símbolo composto para botões (ícone + texto)
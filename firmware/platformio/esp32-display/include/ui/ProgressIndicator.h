@@ -0,0 +1,33 @@
+/**
+ * @file ProgressIndicator.h
+ * @brief Faixa com spinner e texto no rodapé enquanto a rede trabalha
+ *
+ * Fica em lv_layer_top, acima de qualquer tela: sobrevive a rebuild e
+ * navegação e não recebe toques (a tela por baixo continua usável). A
+ * tarefa de UI chama show()/hide() com o estado lido das operações de
+ * rede; o texto só é trocado (e a área invalidada) quando muda.
+ */
+
+#ifndef PROGRESS_INDICATOR_H
+#define PROGRESS_INDICATOR_H
+
+#include <lvgl.h>
+
+class ProgressIndicator {
+public:
+    /// Mostra (criando na primeira vez) com o texto dado
+    void show(const char* text);
+
+    void hide();
+
+    bool isVisible() const { return visible; }
+
+private:
+    void create();
+
+    lv_obj_t* box = nullptr;
+    lv_obj_t* label = nullptr;
+    bool visible = false;
+};
+
+#endif // PROGRESS_INDICATOR_H
@@ -0,0 +1,86 @@
+/**
+ * @file ScreenArena.h
+ * @brief Arena (bump allocator) por tela para NavButtons, estruturas
+ *        auxiliares dos widgets e suas strings
+ *
+ * Cada tela aloca seus objetos em blocos de SCREEN_ARENA_CHUNK_SIZE e os
+ * libera de uma vez no rebuild ou na destruição: destrutores rodam em
+ * ordem inversa de criação e os blocos são reaproveitados na próxima
+ * página, então hot reloads repetidos não fragmentam o heap.
+ */
+
+#ifndef SCREEN_ARENA_H
+#define SCREEN_ARENA_H
+
+#include <Arduino.h>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+class ScreenArena {
+public:
+    explicit ScreenArena(size_t chunkSize);
+    ~ScreenArena();
+
+    ScreenArena(const ScreenArena&) = delete;
+    ScreenArena& operator=(const ScreenArena&) = delete;
+
+    /// Memória crua alinhada; válida até o próximo reset()
+    void* allocate(size_t size, size_t align = alignof(max_align_t));
+
+    /// Constrói T na arena; o destrutor roda no reset()
+    template <typename T, typename... Args>
+    T* make(Args&&... args) {
+        void* mem = allocate(sizeof(T), alignof(T));
+        if (!mem) return nullptr;
+        T* obj = new (mem) T(std::forward<Args>(args)...);
+        if (!std::is_trivially_destructible<T>::value) {
+            addDestructor(obj, [](void* p) { static_cast<T*>(p)->~T(); });
+        }
+        return obj;
+    }
+
+    /// Copia string para a arena (vazia não ocupa espaço)
+    const char* copy(const char* str);
+    const char* copy(const String& str) { return copy(str.c_str()); }
+
+    /// Destrói os objetos e rebobina os blocos (mantidos para reuso)
+    void reset();
+
+    /// Destrói os objetos e devolve todos os blocos ao heap
+    void release();
+
+    size_t getUsed() const { return used; }
+    size_t getPeak() const { return peak; }
+    size_t getCapacity() const;
+    uint16_t getChunkCount() const;
+    uint16_t getObjectCount() const { return objectCount; }
+
+private:
+    struct Chunk {
+        Chunk* next;
+        size_t size;    // Bytes úteis após o cabeçalho
+        size_t offset;
+        uint8_t* data() { return reinterpret_cast<uint8_t*>(this + 1); }
+    };
+
+    struct Destructor {
+        void (*fn)(void*);
+        void* obj;
+        Destructor* next;
+    };
+
+    void addDestructor(void* obj, void (*fn)(void*));
+    void runDestructors();
+    Chunk* newChunk(size_t minSize);
+
+    size_t chunkSize;
+    Chunk* head = nullptr;      // Primeiro bloco (lista em ordem de criação)
+    Chunk* current = nullptr;   // Bloco onde as alocações estão acontecendo
+    Destructor* destructors = nullptr;  // LIFO
+    size_t used = 0;
+    size_t peak = 0;
+    uint16_t objectCount = 0;
+};
+
+#endif // SCREEN_ARENA_H
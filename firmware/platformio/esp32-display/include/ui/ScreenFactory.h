@@ -11,61 +11,65 @@
 #include <ArduinoJson.h>
 #include "ScreenBase.h"
 #include "NavButton.h"
+#include "core/ConfigManager.h"
 #include <memory>
 
+// Itens de conteúdo (NavButtons e estruturas auxiliares) são alocados na
+// ScreenArena da tela e liberados com ela; não há delete individual.
 class ScreenFactory {
 public:
     // Create screen from JSON config using new layout system
-    static std::unique_ptr<ScreenBase> createScreen(JsonObject& config);
+    // (a tela guarda owner: seus itens são lidos do snapshot, sem cópia)
+    static std::unique_ptr<ScreenBase> createScreen(JsonObjectConst config, const ConfigSnapshot& owner);
     
     // Create navigation item (button that navigates to another screen)
-    static NavButton* createNavigationItem(lv_obj_t* parent, JsonObject& config);
+    static NavButton* createNavigationItem(lv_obj_t* parent, JsonObjectConst config, ScreenArena& arena);
     
     // Create relay control item
-    static NavButton* createRelayItem(lv_obj_t* parent, JsonObject& config);
+    static NavButton* createRelayItem(lv_obj_t* parent, JsonObjectConst config, ScreenArena& arena);
     
     // Create action item
-    static NavButton* createActionItem(lv_obj_t* parent, JsonObject& config);
+    static NavButton* createActionItem(lv_obj_t* parent, JsonObjectConst config, ScreenArena& arena);
     
     // Create mode selector item
-    static NavButton* createModeItem(lv_obj_t* parent, JsonObject& config);
+    static NavButton* createModeItem(lv_obj_t* parent, JsonObjectConst config, ScreenArena& arena);
     
     // Create display item (read-only information)
-    static NavButton* createDisplayItem(lv_obj_t* parent, JsonObject& config);
+    static NavButton* createDisplayItem(lv_obj_t* parent, JsonObjectConst config, ScreenArena& arena);
     
     // Novos métodos para widgets melhorados
-    static NavButton* createSwitchItem(lv_obj_t* parent, JsonObject& config);
-    static lv_obj_t* createSwitchDirectly(lv_obj_t* parent, JsonObject& config);
-    static NavButton* createGaugeItem(lv_obj_t* parent, JsonObject& config);
-    static lv_obj_t* createGaugeDirectly(lv_obj_t* parent, JsonObject& config);
+    static NavButton* createSwitchItem(lv_obj_t* parent, JsonObjectConst config);
+    static lv_obj_t* createSwitchDirectly(lv_obj_t* parent, JsonObjectConst config, ScreenArena& arena);
+    static NavButton* createGaugeItem(lv_obj_t* parent, JsonObjectConst config);
+    static lv_obj_t* createGaugeDirectly(lv_obj_t* parent, JsonObjectConst config);
     
     // Métodos auxiliares para gauges
-    static lv_obj_t* createCircularGauge(lv_obj_t* parent, JsonObject& config, float minVal, float maxVal);
-    static lv_obj_t* createLinearGauge(lv_obj_t* parent, JsonObject& config, float minVal, float maxVal);
+    static lv_obj_t* createCircularGauge(lv_obj_t* parent, JsonObjectConst config, float minVal, float maxVal);
+    static lv_obj_t* createLinearGauge(lv_obj_t* parent, JsonObjectConst config, float minVal, float maxVal);
     
     // Utilitários para formatting e cores
-    static String formatDisplayValue(float value, JsonObject& config);
-    static void applyDynamicColors(lv_obj_t* obj, JsonObject& config, float value);
+    static String formatDisplayValue(float value, JsonObjectConst config);
+    static void applyDynamicColors(lv_obj_t* obj, JsonObjectConst config, float value);
     static lv_coord_t calculateItemSize(const String& size, bool isWidth);
     
     // Parse action_payload JSON string (público para DataBinder)
-    static float parseActionPayload(JsonObject& config, const String& key, float defaultValue);
+    static float parseActionPayload(JsonObjectConst config, const String& key, float defaultValue);
     
     // Legacy methods (to be removed after full migration)
-    static lv_obj_t* createScreenLegacy(JsonObject& config);
-    static lv_obj_t* createButton(lv_obj_t* parent, JsonObject& config);
-    static lv_obj_t* createLabel(lv_obj_t* parent, JsonObject& config);
-    static lv_obj_t* createSwitch(lv_obj_t* parent, JsonObject& config);
-    static lv_obj_t* createSlider(lv_obj_t* parent, JsonObject& config);
-    static lv_obj_t* createGauge(lv_obj_t* parent, JsonObject& config);
-    static lv_obj_t* createList(lv_obj_t* parent, JsonObject& config);
+    static lv_obj_t* createScreenLegacy(JsonObjectConst config);
+    static lv_obj_t* createButton(lv_obj_t* parent, JsonObjectConst config);
+    static lv_obj_t* createLabel(lv_obj_t* parent, JsonObjectConst config);
+    static lv_obj_t* createSwitch(lv_obj_t* parent, JsonObjectConst config);
+    static lv_obj_t* createSlider(lv_obj_t* parent, JsonObjectConst config);
+    static lv_obj_t* createGauge(lv_obj_t* parent, JsonObjectConst config);
+    static lv_obj_t* createList(lv_obj_t* parent, JsonObjectConst config);
     
 private:
     // Apply common styles
-    static void applyCommonStyles(lv_obj_t* obj, JsonObject& config);
+    static void applyCommonStyles(lv_obj_t* obj, JsonObjectConst config);
     
     // Position element
-    static void positionElement(lv_obj_t* obj, JsonObject& config);
+    static void positionElement(lv_obj_t* obj, JsonObjectConst config);
     
     // Parse color from hex string
     static lv_color_t parseColor(const String& colorStr);
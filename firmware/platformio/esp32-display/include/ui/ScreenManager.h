@@ -13,6 +13,7 @@
 #include <map>
 #include <memory>
 #include "ScreenBase.h"
+#include "core/ConfigManager.h"
 
 class ScreenManager {
 private:
@@ -40,8 +41,8 @@ public:
     void addLegacyScreen(const String& screenId, lv_obj_t* screen);
     void setUseNewSystem(bool use) { useNewSystem = use; }
     
-    // Build screens from config
-    void buildFromConfig(JsonDocument& config);
+    // Build screens from config (cada tela segura o snapshot dos seus itens)
+    void buildFromConfig(const ConfigSnapshot& config);
     
     // Get screen info
     std::vector<String> getScreenIds();
@@ -53,7 +54,7 @@ public:
     void handleSelect(const String& screenId);
     
 private:
-    void createScreen(JsonObject& screenConfig);
+    void createScreen(JsonObjectConst screenConfig, const ConfigSnapshot& owner);
 };
 
 #endif // SCREEN_MANAGER_H
\ No newline at end of file
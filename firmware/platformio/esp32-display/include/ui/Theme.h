@@ -97,20 +97,149 @@
 #define FONT_LABEL          &lv_font_montserrat_14
 #define FONT_SMALL          &lv_font_montserrat_12
 
+// ============================================================================
+// ESTILOS COMPARTILHADOS
+// ============================================================================
+
+/**
+ * @brief Papéis de estilo compartilhados pelo tema
+ *
+ * Cada papel corresponde a um único lv_style_t pertencente ao tema e
+ * anexado por referência (lv_obj_add_style). Evita estilos locais por
+ * widget, economizando memória do pool LVGL.
+ */
+enum ThemeStyleRole {
+    THEME_STYLE_SCREEN = 0,
+    THEME_STYLE_CONTAINER,          // Container de conteúdo (Container/GridContainer)
+    THEME_STYLE_HEADER,             // Barra superior
+    THEME_STYLE_NAVBAR,             // Barra de navegação inferior
+    THEME_STYLE_TRANSPARENT,        // Containers auxiliares sem fundo/borda/padding
+    THEME_STYLE_BUTTON_OFF,
+    THEME_STYLE_BUTTON_ON,
+    THEME_STYLE_BUTTON_SELECTED,
+    THEME_STYLE_NAV_BUTTON,
+    THEME_STYLE_TILE,               // NavButton (estado normal)
+    THEME_STYLE_TILE_PRESSED,       // NavButton pressionado (LV_STATE_PRESSED)
+    THEME_STYLE_TILE_ON,            // NavButton ligado (LV_STATE_CHECKED)
+    THEME_STYLE_NAVBAR_BUTTON,
+    THEME_STYLE_NAVBAR_BUTTON_PRESSED,
+    THEME_STYLE_NAVBAR_BUTTON_DISABLED,
+    THEME_STYLE_TITLE,
+    THEME_STYLE_LABEL,
+    THEME_STYLE_LABEL_SMALL,
+    THEME_STYLE_ICON,
+    THEME_STYLE_CARD,
+    THEME_STYLE_STATUS_OK,
+    THEME_STYLE_STATUS_WARNING,
+    THEME_STYLE_STATUS_ERROR,
+    THEME_STYLE_GAUGE_VALUE,
+    THEME_STYLE_SWITCH,
+    THEME_STYLE_SWITCH_ON,
+    THEME_STYLE_SWITCH_KNOB,
+    THEME_STYLE_SWITCH_KNOB_ON,
+    THEME_STYLE_BAR,
+    THEME_STYLE_BAR_INDICATOR,
+    THEME_STYLE_LIST,
+    THEME_STYLE_LIST_BUTTON,
+    THEME_STYLE_COUNT
+};
+
+/**
+ * @brief Paleta de cores usada para preencher os estilos compartilhados
+ */
+struct ThemePalette {
+    lv_color_t background;
+    lv_color_t buttonOff;
+    lv_color_t buttonOn;
+    lv_color_t buttonSelected;
+    lv_color_t textOff;
+    lv_color_t textOn;
+    lv_color_t navBg;
+    lv_color_t border;
+    lv_color_t warning;
+    lv_color_t error;
+    lv_color_t cardBg;
+    lv_color_t textMuted;
+    lv_color_t gaugeNormal;
+    lv_color_t disabledBg;
+    lv_color_t disabledText;
+};
+
+/**
+ * @brief Retorna a paleta padrão (macros COLOR_* acima)
+ */
+ThemePalette theme_default_palette();
+
+/**
+ * @brief Inicializa os estilos compartilhados com a paleta padrão
+ *
+ * Deve ser chamado uma vez após lv_init(). Chamadas repetidas são ignoradas.
+ */
+void theme_init();
+
+/**
+ * @brief Retorna o estilo compartilhado de um papel
+ * @param role Papel do estilo
+ * @return Ponteiro estável para o lv_style_t do tema
+ */
+lv_style_t* theme_get_style(ThemeStyleRole role);
+
+/**
+ * @brief Retorna um estilo compartilhado contendo apenas a fonte informada
+ * @param font Fonte Montserrat habilitada em lv_conf.h
+ * @return Estilo compartilhado ou nullptr se a fonte não for conhecida
+ */
+lv_style_t* theme_get_font_style(const lv_font_t* font);
+
+/**
+ * @brief Retorna a paleta atualmente aplicada
+ */
+const ThemePalette& theme_get_palette();
+
+/**
+ * @brief Troca o tema atualizando os estilos compartilhados no lugar
+ *
+ * Todos os objetos que referenciam os estilos são notificados via
+ * lv_obj_report_style_change(), sem recriar telas.
+ * @param palette Nova paleta
+ */
+void theme_set_palette(const ThemePalette& palette);
+
 // ============================================================================
 // FUNÇÕES DE ESTILO
 // ============================================================================
 
+/**
+ * @brief Anexa um estilo compartilhado ao objeto
+ * @param obj Objeto LVGL
+ * @param role Papel do estilo
+ * @param selector Parte/estado (padrão: LV_PART_MAIN)
+ */
+static inline void theme_add_style(lv_obj_t* obj, ThemeStyleRole role, lv_style_selector_t selector = 0) {
+    lv_obj_add_style(obj, theme_get_style(role), selector);
+}
+
+/**
+ * @brief Aplica fonte compartilhada (cai para estilo local se desconhecida)
+ * @param obj Objeto LVGL
+ * @param font Fonte desejada
+ */
+static inline void theme_apply_font(lv_obj_t* obj, const lv_font_t* font) {
+    lv_style_t* style = theme_get_font_style(font);
+    if (style) {
+        lv_obj_add_style(obj, style, 0);
+    } else {
+        lv_obj_set_style_text_font(obj, font, 0);
+    }
+}
+
 /**
  * @brief Aplica o tema AutoCore na tela
  * @param screen Objeto da tela
  */
 static inline void theme_apply_screen(lv_obj_t* screen) {
     lv_obj_remove_style_all(screen);
-    lv_obj_set_style_bg_color(screen, COLOR_BACKGROUND, 0);
-    lv_obj_set_style_bg_opa(screen, LV_OPA_COVER, 0);
-    lv_obj_set_style_border_width(screen, 0, 0);
-    lv_obj_set_style_pad_all(screen, 0, 0);
+    theme_add_style(screen, THEME_STYLE_SCREEN);
 }
 
 /**
@@ -118,13 +247,9 @@ static inline void theme_apply_screen(lv_obj_t* screen) {
  * @param btn Objeto do botão
  */
 static inline void theme_apply_button_off(lv_obj_t* btn) {
-    lv_obj_set_style_bg_color(btn, COLOR_BUTTON_OFF, 0);
-    lv_obj_set_style_bg_opa(btn, LV_OPA_COVER, 0);
-    lv_obj_set_style_border_color(btn, COLOR_BUTTON_OFF, 0);
-    lv_obj_set_style_border_width(btn, BUTTON_BORDER, 0);
-    lv_obj_set_style_border_opa(btn, LV_OPA_50, 0);
-    lv_obj_set_style_text_color(btn, COLOR_TEXT_OFF, 0);
-    lv_obj_set_style_radius(btn, BUTTON_RADIUS, 0);
+    lv_obj_remove_style(btn, theme_get_style(THEME_STYLE_BUTTON_ON), 0);
+    lv_obj_remove_style(btn, theme_get_style(THEME_STYLE_BUTTON_SELECTED), 0);
+    theme_add_style(btn, THEME_STYLE_BUTTON_OFF);
 }
 
 /**
@@ -132,13 +257,9 @@ static inline void theme_apply_button_off(lv_obj_t* btn) {
  * @param btn Objeto do botão
  */
 static inline void theme_apply_button_on(lv_obj_t* btn) {
-    lv_obj_set_style_bg_color(btn, COLOR_BUTTON_ON, 0);
-    lv_obj_set_style_bg_opa(btn, LV_OPA_COVER, 0);
-    lv_obj_set_style_border_color(btn, COLOR_BUTTON_ON, 0);
-    lv_obj_set_style_border_width(btn, BUTTON_BORDER, 0);
-    lv_obj_set_style_border_opa(btn, LV_OPA_COVER, 0);
-    lv_obj_set_style_text_color(btn, COLOR_TEXT_ON, 0);
-    lv_obj_set_style_radius(btn, BUTTON_RADIUS, 0);
+    lv_obj_remove_style(btn, theme_get_style(THEME_STYLE_BUTTON_OFF), 0);
+    lv_obj_remove_style(btn, theme_get_style(THEME_STYLE_BUTTON_SELECTED), 0);
+    theme_add_style(btn, THEME_STYLE_BUTTON_ON);
 }
 
 /**
@@ -146,13 +267,9 @@ static inline void theme_apply_button_on(lv_obj_t* btn) {
  * @param btn Objeto do botão
  */
 static inline void theme_apply_button_selected(lv_obj_t* btn) {
-    lv_obj_set_style_bg_color(btn, COLOR_BUTTON_OFF, 0);
-    lv_obj_set_style_bg_opa(btn, LV_OPA_COVER, 0);
-    lv_obj_set_style_border_color(btn, COLOR_BUTTON_SEL, 0);
-    lv_obj_set_style_border_width(btn, BUTTON_BORDER + 1, 0);
-    lv_obj_set_style_border_opa(btn, LV_OPA_COVER, 0);
-    lv_obj_set_style_text_color(btn, COLOR_TEXT_ON, 0);
-    lv_obj_set_style_radius(btn, BUTTON_RADIUS, 0);
+    lv_obj_remove_style(btn, theme_get_style(THEME_STYLE_BUTTON_OFF), 0);
+    lv_obj_remove_style(btn, theme_get_style(THEME_STYLE_BUTTON_ON), 0);
+    theme_add_style(btn, THEME_STYLE_BUTTON_SELECTED);
 }
 
 /**
@@ -160,11 +277,7 @@ static inline void theme_apply_button_selected(lv_obj_t* btn) {
  * @param btn Objeto do botão
  */
 static inline void theme_apply_nav_button(lv_obj_t* btn) {
-    lv_obj_set_style_bg_color(btn, COLOR_NAV_BG, 0);
-    lv_obj_set_style_bg_opa(btn, LV_OPA_COVER, 0);
-    lv_obj_set_style_border_width(btn, 0, 0);
-    lv_obj_set_style_text_color(btn, COLOR_TEXT_ON, 0);
-    lv_obj_set_style_radius(btn, BUTTON_RADIUS, 0);
+    theme_add_style(btn, THEME_STYLE_NAV_BUTTON);
 }
 
 /**
@@ -172,8 +285,7 @@ static inline void theme_apply_nav_button(lv_obj_t* btn) {
  * @param label Objeto do label
  */
 static inline void theme_apply_title(lv_obj_t* label) {
-    lv_obj_set_style_text_color(label, COLOR_TEXT_ON, 0);
-    lv_obj_set_style_text_font(label, FONT_TITLE, 0);
+    theme_add_style(label, THEME_STYLE_TITLE);
 }
 
 /**
@@ -181,8 +293,7 @@ static inline void theme_apply_title(lv_obj_t* label) {
  * @param label Objeto do label
  */
 static inline void theme_apply_label(lv_obj_t* label) {
-    lv_obj_set_style_text_color(label, COLOR_TEXT_OFF, 0);
-    lv_obj_set_style_text_font(label, FONT_LABEL, 0);
+    theme_add_style(label, THEME_STYLE_LABEL);
 }
 
 /**
@@ -190,8 +301,7 @@ static inline void theme_apply_label(lv_obj_t* label) {
  * @param label Objeto do label
  */
 static inline void theme_apply_label_small(lv_obj_t* label) {
-    lv_obj_set_style_text_color(label, COLOR_TEXT_MUTED, 0);
-    lv_obj_set_style_text_font(label, FONT_SMALL, 0);
+    theme_add_style(label, THEME_STYLE_LABEL_SMALL);
 }
 
 /**
@@ -199,8 +309,7 @@ static inline void theme_apply_label_small(lv_obj_t* label) {
  * @param label Objeto do label de ícone
  */
 static inline void theme_apply_icon(lv_obj_t* label) {
-    lv_obj_set_style_text_color(label, COLOR_TEXT_OFF, 0);
-    lv_obj_set_style_text_font(label, FONT_LABEL, 0);
+    theme_add_style(label, THEME_STYLE_ICON);
 }
 
 /**
@@ -208,12 +317,27 @@ static inline void theme_apply_icon(lv_obj_t* label) {
  * @param card Objeto do card
  */
 static inline void theme_apply_card(lv_obj_t* card) {
-    lv_obj_set_style_bg_color(card, COLOR_CARD_BG, 0);
-    lv_obj_set_style_bg_opa(card, LV_OPA_COVER, 0);
-    lv_obj_set_style_border_color(card, COLOR_BORDER, 0);
-    lv_obj_set_style_border_width(card, 1, 0);
-    lv_obj_set_style_radius(card, CARD_RADIUS, 0);
-    lv_obj_set_style_pad_all(card, CARD_PADDING, 0);
+    theme_add_style(card, THEME_STYLE_CARD);
+}
+
+/**
+ * @brief Aplica estilo de container auxiliar transparente
+ * @param obj Objeto do container
+ */
+static inline void theme_apply_transparent(lv_obj_t* obj) {
+    theme_add_style(obj, THEME_STYLE_TRANSPARENT);
+}
+
+/**
+ * @brief Troca o estilo de status (ok/aviso/erro) de um ícone
+ * @param obj Label do ícone
+ * @param role THEME_STYLE_STATUS_OK, _WARNING ou _ERROR
+ */
+static inline void theme_apply_status(lv_obj_t* obj, ThemeStyleRole role) {
+    lv_obj_remove_style(obj, theme_get_style(THEME_STYLE_STATUS_OK), 0);
+    lv_obj_remove_style(obj, theme_get_style(THEME_STYLE_STATUS_WARNING), 0);
+    lv_obj_remove_style(obj, theme_get_style(THEME_STYLE_STATUS_ERROR), 0);
+    theme_add_style(obj, role);
 }
 
 #endif // THEME_H
\ No newline at end of file
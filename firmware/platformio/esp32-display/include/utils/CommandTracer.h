@@ -0,0 +1,107 @@
+/**
+ * @file CommandTracer.h
+ * @brief Rastreio de latência ponta a ponta dos comandos de relé
+ *
+ * Cada comando enviado pelo CommandSender leva um trace_id (o request id
+ * do display). A placa de relés ecoa o id no status do canal junto com o
+ * tempo gasto do lado dela, e o ButtonStateManager fecha o rastreio quando
+ * aplica o eco na UI. Os estágios ficam em histogramas (us), publicados
+ * periodicamente pelo StatusReporter e zerados a cada janela:
+ *
+ * - input:     toque (IRQ do touch) -> início do envio do comando
+ * - publish:   montagem do JSON + publish no MQTT
+ * - network:   ida e volta pelo broker (eco - envio - tempo no relé)
+ * - relay:     recepção -> eco publicado, medido no relé
+ * - relay_exec: relay_set_state, medido no relé
+ * - ui:        eco recebido -> estado aplicado no botão
+ * - total:     toque (ou início do envio) -> estado aplicado
+ *
+ * Os relógios das duas placas não são comparados: o relé só informa
+ * durações, então o tempo de rede é a diferença do ida e volta local.
+ */
+
+#ifndef COMMAND_TRACER_H
+#define COMMAND_TRACER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "utils/Histogram.h"
+
+class CommandTracer {
+public:
+    static const uint8_t MAX_IN_FLIGHT = 8;
+    static const uint8_t ID_LENGTH = 64;
+
+    enum Stage : uint8_t {
+        STAGE_INPUT = 0,
+        STAGE_PUBLISH,
+        STAGE_NETWORK,
+        STAGE_RELAY,
+        STAGE_RELAY_EXEC,
+        STAGE_UI,
+        STAGE_TOTAL,
+        STAGE_COUNT
+    };
+
+    /// Durações informadas pelo relé no eco (0 = ausente)
+    struct RelayTiming {
+        uint32_t totalUs;
+        uint32_t execUs;
+    };
+
+    static CommandTracer& getInstance();
+
+    /// Toque confirmado (micros do IRQ); atribuído ao próximo comando
+    void markTouch(uint32_t touchUs);
+
+    /// Abre o rastreio de um comando prestes a ser publicado
+    void begin(const String& traceId);
+
+    /// Publish concluído (ou falhou: descarta o rastreio)
+    void markSent(const String& traceId, bool ok);
+
+    /**
+     * @brief Fecha o rastreio com o eco do relé já aplicado na UI
+     * @param echoUs micros() de quando o eco chegou ao ButtonStateManager
+     * @return false se o id não está em voo (eco de outro display, expirado...)
+     */
+    bool complete(const char* traceId, uint32_t echoUs, const RelayTiming& relay);
+
+    const Histogram& getStage(Stage stage) const { return stages[stage]; }
+    uint32_t getCompleted() const { return stages[STAGE_TOTAL].getCount(); }
+    uint32_t getLost() const { return lost; }
+    uint8_t getInFlight() const;
+
+    static const char* stageName(Stage stage);
+
+    /// {"completed","lost","in_flight","stages":{"input":{...},...}}
+    void toJson(JsonObject obj) const;
+
+    /// Zera os histogramas (rastreios em voo continuam)
+    void reset();
+
+private:
+    struct Trace {
+        char id[ID_LENGTH];
+        bool active;
+        bool sent;
+        uint32_t touchUs;      // 0 = comando sem toque associado
+        uint32_t startUs;
+        uint32_t sentUs;
+    };
+
+    CommandTracer();
+    CommandTracer(const CommandTracer&) = delete;
+    CommandTracer& operator=(const CommandTracer&) = delete;
+
+    Trace* find(const char* traceId);
+    void expire(uint32_t nowUs);
+
+    Trace traces[MAX_IN_FLIGHT];
+    Histogram stages[STAGE_COUNT];
+    uint32_t pendingTouchUs = 0;
+    bool touchPending = false;
+    uint32_t lost = 0;
+};
+
+#endif // COMMAND_TRACER_H
@@ -0,0 +1,53 @@
+/**
+ * @file Histogram.h
+ * @brief Histograma de limites fixos, sem alocação, para métricas de tempo real
+ *
+ * Os limites superiores dos buckets são fornecidos pelo chamador (array
+ * estático); o último bucket acumula tudo acima do maior limite.
+ * Percentis são estimados pelo limite superior do bucket que os contém.
+ */
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+class Histogram {
+public:
+    static const uint8_t MAX_BUCKETS = 12;
+
+    /**
+     * @param upperBounds Limites superiores crescentes (devem viver mais que o histograma)
+     * @param boundCount Quantidade de limites (máximo MAX_BUCKETS - 1)
+     */
+    Histogram(const uint32_t* upperBounds, uint8_t boundCount);
+
+    void record(uint32_t value);
+    void reset();
+
+    uint32_t getCount() const { return count; }
+    uint32_t getMin() const { return count ? minValue : 0; }
+    uint32_t getMax() const { return maxValue; }
+    uint32_t getMean() const { return count ? (uint32_t)(sum / count) : 0; }
+
+    /// Estimativa do percentil p (0-100); retorna o máximo observado no bucket de overflow
+    uint32_t percentile(uint8_t p) const;
+
+    uint8_t getBucketCount() const { return boundCount + 1; }
+    uint32_t getBucket(uint8_t index) const { return index <= boundCount ? buckets[index] : 0; }
+
+    /// {"count","min","max","mean","p50","p95","p99","le":[limites],"counts":[...]}
+    void toJson(JsonObject obj) const;
+
+private:
+    const uint32_t* bounds;
+    uint8_t boundCount;
+    uint32_t buckets[MAX_BUCKETS];
+    uint32_t count;
+    uint32_t minValue;
+    uint32_t maxValue;
+    uint64_t sum;
+};
+
+#endif // HISTOGRAM_H
@@ -0,0 +1,130 @@
+/**
+ * @file MemoryMonitor.h
+ * @brief Monitor de fragmentação do heap e do pool do LVGL com contadores
+ *        de alocação por subsistema
+ *
+ * Amostra periodicamente o heap (livre, mínimo histórico, maior bloco) e o
+ * pool interno do LVGL (lv_mem_monitor) e dispara um aviso quando o maior
+ * bloco livre ou a fragmentação cruzam os limites de DeviceConfig, antes
+ * que uma alocação grande (buffer MQTT, documento de config, tela) falhe.
+ *
+ * Os contadores por subsistema são alimentados explicitamente nos pontos
+ * que possuem memória (blocos da ScreenArena, buffer do MQTT, documento de
+ * config, overrides de ícones), então funcionam igual no build nativo.
+ * UI e rede alimentam os mesmos contadores, por isso são atômicos.
+ */
+
+#ifndef MEMORY_MONITOR_H
+#define MEMORY_MONITOR_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <atomic>
+#include <functional>
+
+enum MemSubsystem : uint8_t {
+    MEM_MQTT = 0,   // Buffer do PubSubClient e mensagens recebidas
+    MEM_CONFIG,     // Documento de configuração e StringPool
+    MEM_SCREENS,    // Blocos das ScreenArenas
+    MEM_ICONS,      // Overrides de ícones vindos da API
+    MEM_SUBSYSTEM_COUNT
+};
+
+class MemoryMonitor {
+public:
+    struct Counters {
+        uint32_t allocs;
+        uint32_t frees;
+        uint32_t liveBytes;
+        uint32_t peakBytes;
+    };
+
+    struct Snapshot {
+        uint32_t freeHeap;
+        uint32_t minFreeHeap;      // Mínimo desde o boot
+        uint32_t largestBlock;     // Maior bloco alocável
+        uint8_t heapFragPct;       // 100 - maior bloco / livre
+        uint32_t lvglFree;
+        uint32_t lvglLargest;
+        uint8_t lvglFragPct;
+        uint8_t lvglUsedPct;
+    };
+
+    // Motivos do aviso (bitmask)
+    enum WarningReason : uint8_t {
+        WARN_HEAP_BLOCK = 0x01,    // Maior bloco abaixo de MEMORY_WARN_MIN_BLOCK
+        WARN_HEAP_FRAG  = 0x02,    // Fragmentação do heap acima do limite
+        WARN_LVGL_FRAG  = 0x04,    // Fragmentação do pool LVGL acima do limite
+        WARN_LVGL_USED  = 0x08     // Pool LVGL quase cheio
+    };
+
+    typedef std::function<void(const Snapshot&, uint8_t reasons)> WarningCallback;
+
+    static MemoryMonitor& getInstance();
+
+    // ---- Contadores (chamados pelos donos da memória) ----
+    static void onAlloc(MemSubsystem subsystem, size_t bytes);
+    static void onFree(MemSubsystem subsystem, size_t bytes);
+
+    /// Amostra a cada MEMORY_MONITOR_INTERVAL (chamar no loop)
+    void update();
+
+    /// Amostra agora e avalia os limites; true se um novo aviso foi disparado
+    bool sample();
+
+    void setWarningCallback(WarningCallback callback) { onWarning = callback; }
+
+    const Snapshot& getSnapshot() const { return snapshot; }
+    /// Cópia dos contadores (cada campo lido atomicamente)
+    Counters getCounters(MemSubsystem subsystem) const;
+    uint8_t getActiveWarnings() const { return activeWarnings; }
+    uint32_t getWarningCount() const { return warningCount; }
+
+    static const char* subsystemName(MemSubsystem subsystem);
+    static const char* reasonName(WarningReason reason);
+
+    /// {"free_heap",...,"lvgl":{...},"subsystems":{"mqtt":{...},...},"warnings":n}
+    void toJson(JsonObject obj) const;
+    void reasonsToJson(JsonArray arr, uint8_t reasons) const;
+
+private:
+    MemoryMonitor() = default;
+    MemoryMonitor(const MemoryMonitor&) = delete;
+    MemoryMonitor& operator=(const MemoryMonitor&) = delete;
+
+    struct AtomicCounters {
+        std::atomic<uint32_t> allocs{0};
+        std::atomic<uint32_t> frees{0};
+        std::atomic<uint32_t> liveBytes{0};
+        std::atomic<uint32_t> peakBytes{0};
+    };
+
+    uint8_t evaluate() const;
+
+    AtomicCounters counters[MEM_SUBSYSTEM_COUNT];
+    Snapshot snapshot = {};
+    uint8_t activeWarnings = 0;
+    uint32_t warningCount = 0;
+    unsigned long lastSample = 0;
+    WarningCallback onWarning;
+};
+
+/**
+ * @brief Carga temporária atribuída a um subsistema, liberada no fim do escopo
+ */
+class MemoryCharge {
+public:
+    MemoryCharge(MemSubsystem subsystem, size_t bytes) : subsystem(subsystem), bytes(bytes) {
+        MemoryMonitor::onAlloc(subsystem, bytes);
+    }
+    ~MemoryCharge() { MemoryMonitor::onFree(subsystem, bytes); }
+
+    MemoryCharge(const MemoryCharge&) = delete;
+    MemoryCharge& operator=(const MemoryCharge&) = delete;
+
+private:
+    MemSubsystem subsystem;
+    size_t bytes;
+};
+
+#endif // MEMORY_MONITOR_H
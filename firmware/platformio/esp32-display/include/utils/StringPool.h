@@ -0,0 +1,84 @@
+/**
+ * @file StringPool.h
+ * @brief Pool de strings internadas para identificadores repetidos
+ *
+ * UUIDs de devices, data paths, unidades e chaves de estado de botão
+ * aparecem em vários módulos (DataBinder, ButtonStateManager,
+ * CommandAckTracker, DeviceRegistry, CommandSender). Internados, cada
+ * valor distinto é guardado uma única vez e dois identificadores são
+ * iguais se e somente se os ponteiros são iguais. Strings de uma tela só
+ * (campos do NavButton) ficam na ScreenArena dela.
+ *
+ * As strings nunca são liberadas (o conjunto de identificadores é limitado
+ * pela configuração), por isso os ponteiros são estáveis por toda a vida
+ * do firmware.
+ *
+ * UI e rede usam o mesmo pool: intern()/find() passam por um mutex, já que
+ * o grow() realoca a tabela que uma sondagem no outro core estaria lendo.
+ */
+
+#ifndef STRING_POOL_H
+#define STRING_POOL_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <mutex>
+
+class StringPool {
+public:
+    struct Stats {
+        uint32_t entries;       // Valores distintos guardados
+        uint32_t bytesStored;   // Bytes das strings no pool (com terminador)
+        uint32_t bytesSaved;    // Bytes que cópias repetidas teriam ocupado
+        uint32_t lookups;       // Chamadas de intern()/find()
+        uint32_t hits;          // Lookups que encontraram valor existente
+    };
+
+    static StringPool& getInstance();
+
+    /// Retorna o ponteiro canônico (inserindo se necessário); "" para vazio
+    const char* intern(const char* str);
+    const char* intern(const String& str) { return intern(str.c_str()); }
+
+    /// Como intern(), mas sem inserir: nullptr se o valor nunca foi internado
+    const char* find(const char* str);
+    const char* find(const String& str) { return find(str.c_str()); }
+
+    Stats getStats() const;
+
+    /// {"entries","bytes_stored","bytes_saved","lookups","hits"}
+    void toJson(JsonObject obj) const;
+
+private:
+    StringPool() = default;
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    struct Slot {
+        const char* str;
+        uint32_t hash;
+    };
+
+    static const uint16_t INITIAL_SLOTS = 64;
+    static const size_t BLOCK_SIZE = 1024;
+
+    static uint32_t hashOf(const char* str, size_t& len);
+    Slot* findSlot(const char* str, uint32_t hash);
+    char* store(const char* str, size_t len);
+    bool grow();
+
+    Slot* slots = nullptr;
+    uint32_t capacity = 0;
+
+    // Bloco atual de armazenamento (blocos antigos ficam vivos, nunca liberados)
+    char* block = nullptr;
+    size_t blockUsed = 0;
+    size_t blockSize = 0;
+
+    Stats stats = {0, 0, 0, 0, 0};
+
+    // Tabela, bloco atual e stats; nunca segurado durante o uso do ponteiro
+    mutable std::mutex lock;
+};
+
+#endif // STRING_POOL_H
@@ -6,6 +6,35 @@
 class StringUtils {
 public:
     static String removeAccents(const String& text);
+    
+    // FNV-1a do conteúdo (identifica configs iguais sem guardar cópia)
+    static uint32_t hash(const char* data, size_t length);
+    static uint32_t hash(const String& text) { return hash(text.c_str(), text.length()); }
+};
+
+/**
+ * Destino do serializeJson que só acumula o FNV-1a e o tamanho:
+ * hash(serializeJson(doc)) sem montar a String
+ */
+class HashWriter {
+public:
+    size_t write(uint8_t c) {
+        h = (h ^ c) * 16777619u;
+        length++;
+        return 1;
+    }
+    
+    size_t write(const uint8_t* data, size_t size) {
+        for (size_t i = 0; i < size; i++) write(data[i]);
+        return size;
+    }
+    
+    uint32_t value() const { return h; }
+    size_t size() const { return length; }
+    
+private:
+    uint32_t h = 2166136261u;
+    size_t length = 0;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,128 @@
+/**
+ * @file Arduino.cpp
+ * @brief Implementação host do núcleo Arduino (env:native)
+ */
+
+#include "Arduino.h"
+#include <stdarg.h>
+#include <chrono>
+#include <random>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+// ============================================================================
+// String
+// ============================================================================
+
+std::string String::fromUnsigned(unsigned long long value, unsigned char base) {
+    if (base < 2 || base > 36) base = 10;
+    if (value == 0) return "0";
+    char buf[65];
+    int i = 64;
+    buf[i] = 0;
+    while (value > 0) {
+        unsigned digit = (unsigned)(value % base);
+        buf[--i] = (char)(digit < 10 ? '0' + digit : 'a' + digit - 10);
+        value /= base;
+    }
+    return std::string(&buf[i]);
+}
+
+std::string String::fromSigned(long long value, unsigned char base) {
+    // Como no ESP32: sinal só em decimal, demais bases mostram complemento de dois de 32 bits
+    if (base == 10 && value < 0) {
+        return "-" + fromUnsigned(0ULL - (unsigned long long)value, 10);
+    }
+    if (base != 10 && value < 0) {
+        return fromUnsigned((uint32_t)value, base);
+    }
+    return fromUnsigned((unsigned long long)value, base);
+}
+
+std::string String::fromDouble(double value, unsigned int decimalPlaces) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", (int)decimalPlaces, value);
+    return std::string(buf);
+}
+
+// ============================================================================
+// Tempo
+// ============================================================================
+
+static const auto clockEpoch = std::chrono::steady_clock::now();
+static unsigned long long virtualOffsetUs = 0;
+
+static unsigned long long nowUs() {
+    auto elapsed = std::chrono::steady_clock::now() - clockEpoch;
+    return (unsigned long long)std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()
+           + virtualOffsetUs;
+}
+
+unsigned long millis() {
+    return (unsigned long)(nowUs() / 1000ULL);
+}
+
+unsigned long micros() {
+    return (unsigned long)nowUs();
+}
+
+void delay(unsigned long ms) {
+    virtualOffsetUs += (unsigned long long)ms * 1000ULL;
+}
+
+void delayMicroseconds(unsigned int us) {
+    virtualOffsetUs += us;
+}
+
+void yield() {}
+
+namespace native {
+    void advanceClock(unsigned long ms) {
+        virtualOffsetUs += (unsigned long long)ms * 1000ULL;
+    }
+
+    void resetClock() {
+        virtualOffsetUs = 0;
+    }
+}
+
+// ============================================================================
+// Utilitários
+// ============================================================================
+
+// Semente fixa: execuções no host são reprodutíveis
+static std::mt19937 rng(0xA0C0);
+
+long random(long howbig) {
+    if (howbig <= 0) return 0;
+    return (long)(rng() % (unsigned long)howbig);
+}
+
+long random(long howsmall, long howbig) {
+    if (howsmall >= howbig) return howsmall;
+    return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed) {
+    if (seed != 0) rng.seed((std::mt19937::result_type)seed);
+}
+
+size_t HardwareSerial::printf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int n = vprintf(format, args);
+    va_end(args);
+    return n > 0 ? (size_t)n : 0;
+}
+
+// ============================================================================
+// Hora (NTP)
+// ============================================================================
+
+void configTime(long, int, const char*, const char*, const char*) {}
+
+bool getLocalTime(struct tm* info, uint32_t) {
+    time_t now = time(nullptr);
+    return gmtime_r(&now, info) != nullptr;
+}
@@ -0,0 +1,339 @@
+/**
+ * @file Arduino.h
+ * @brief Substituto host do núcleo Arduino para o build nativo (env:native)
+ *
+ * Cobre apenas a superfície usada pela pilha de UI/MQTT: String, relógio
+ * (millis/micros/delay), Serial, random, GPIO no-op e o objeto ESP.
+ *
+ * Relógio: tempo real monotônico mais um deslocamento virtual. delay()
+ * avança o deslocamento em vez de dormir, então backoffs e timeouts do
+ * firmware não deixam os testes lentos, mas esperas ativas em micros()
+ * (ex.: FramebufferTransport) continuam progredindo.
+ */
+
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+#include <string>
+
+using std::min;
+using std::max;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x01
+#define OUTPUT       0x03
+#define INPUT_PULLUP 0x05
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+// Atributo de seção do ESP32 (ISRs em IRAM): sem efeito no host
+#define IRAM_ATTR
+
+// ============================================================================
+// String
+// ============================================================================
+
+class String {
+public:
+    String() {}
+    String(const char* cstr) : s(cstr ? cstr : "") {}
+    String(const char* cstr, unsigned int length) : s(cstr ? std::string(cstr, length) : std::string()) {}
+    String(const String& other) = default;
+    String(String&& other) noexcept = default;
+    explicit String(char c) : s(1, c) {}
+    explicit String(unsigned char value, unsigned char base = 10) : s(fromUnsigned(value, base)) {}
+    explicit String(int value, unsigned char base = 10) : s(fromSigned(value, base)) {}
+    explicit String(unsigned int value, unsigned char base = 10) : s(fromUnsigned(value, base)) {}
+    explicit String(long value, unsigned char base = 10) : s(fromSigned(value, base)) {}
+    explicit String(unsigned long value, unsigned char base = 10) : s(fromUnsigned(value, base)) {}
+    explicit String(long long value, unsigned char base = 10) : s(fromSigned(value, base)) {}
+    explicit String(unsigned long long value, unsigned char base = 10) : s(fromUnsigned(value, base)) {}
+    explicit String(float value, unsigned int decimalPlaces = 2) : s(fromDouble(value, decimalPlaces)) {}
+    explicit String(double value, unsigned int decimalPlaces = 2) : s(fromDouble(value, decimalPlaces)) {}
+
+    String& operator=(const String& rhs) = default;
+    String& operator=(String&& rhs) noexcept = default;
+    String& operator=(const char* cstr) { s = cstr ? cstr : ""; return *this; }
+
+    // Acesso
+    const char* c_str() const { return s.c_str(); }
+    unsigned int length() const { return (unsigned int)s.size(); }
+    bool isEmpty() const { return s.empty(); }
+    bool reserve(unsigned int size) { s.reserve(size); return true; }
+    explicit operator bool() const { return true; }
+
+    char charAt(unsigned int index) const { return index < s.size() ? s[index] : 0; }
+    void setCharAt(unsigned int index, char c) { if (index < s.size()) s[index] = c; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    char& operator[](unsigned int index) { static char dummy; return index < s.size() ? s[index] : (dummy = 0); }
+
+    void toCharArray(char* buf, unsigned int bufsize, unsigned int index = 0) const {
+        getBytes((unsigned char*)buf, bufsize, index);
+    }
+    void getBytes(unsigned char* buf, unsigned int bufsize, unsigned int index = 0) const {
+        if (!bufsize || !buf) return;
+        if (index >= s.size()) { buf[0] = 0; return; }
+        unsigned int n = std::min<unsigned int>(bufsize - 1, (unsigned int)s.size() - index);
+        memcpy(buf, s.data() + index, n);
+        buf[n] = 0;
+    }
+
+    // Concatenação
+    bool concat(const String& str) { s += str.s; return true; }
+    bool concat(const char* cstr) { if (!cstr) return false; s += cstr; return true; }
+    bool concat(const char* cstr, unsigned int length) { if (!cstr) return false; s.append(cstr, length); return true; }
+    bool concat(char c) { s += c; return true; }
+    bool concat(unsigned char num) { return concat(String(num)); }
+    bool concat(int num) { return concat(String(num)); }
+    bool concat(unsigned int num) { return concat(String(num)); }
+    bool concat(long num) { return concat(String(num)); }
+    bool concat(unsigned long num) { return concat(String(num)); }
+    bool concat(long long num) { return concat(String(num)); }
+    bool concat(unsigned long long num) { return concat(String(num)); }
+    bool concat(float num) { return concat(String(num)); }
+    bool concat(double num) { return concat(String(num)); }
+
+    template <typename T>
+    String& operator+=(const T& rhs) { concat(rhs); return *this; }
+    String& operator+=(const char* cstr) { concat(cstr); return *this; }
+
+    // Comparação
+    int compareTo(const String& other) const { return s.compare(other.s); }
+    bool equals(const String& other) const { return s == other.s; }
+    bool equals(const char* cstr) const { return s == (cstr ? cstr : ""); }
+    bool equalsIgnoreCase(const String& other) const {
+        if (s.size() != other.s.size()) return false;
+        for (size_t i = 0; i < s.size(); i++) {
+            if (tolower((unsigned char)s[i]) != tolower((unsigned char)other.s[i])) return false;
+        }
+        return true;
+    }
+    bool operator==(const String& rhs) const { return s == rhs.s; }
+    bool operator==(const char* cstr) const { return equals(cstr); }
+    bool operator!=(const String& rhs) const { return s != rhs.s; }
+    bool operator!=(const char* cstr) const { return !equals(cstr); }
+    bool operator<(const String& rhs) const { return s < rhs.s; }
+    bool operator>(const String& rhs) const { return s > rhs.s; }
+    bool operator<=(const String& rhs) const { return s <= rhs.s; }
+    bool operator>=(const String& rhs) const { return s >= rhs.s; }
+
+    bool startsWith(const String& prefix) const { return startsWith(prefix, 0); }
+    bool startsWith(const String& prefix, unsigned int offset) const {
+        return offset <= s.size() && s.compare(offset, prefix.s.size(), prefix.s) == 0;
+    }
+    bool endsWith(const String& suffix) const {
+        return suffix.s.size() <= s.size() &&
+               s.compare(s.size() - suffix.s.size(), suffix.s.size(), suffix.s) == 0;
+    }
+
+    // Busca
+    int indexOf(char c, unsigned int from = 0) const { return npos(s.find(c, from)); }
+    int indexOf(const String& str, unsigned int from = 0) const { return npos(s.find(str.s, from)); }
+    int lastIndexOf(char c) const { return npos(s.rfind(c)); }
+    int lastIndexOf(char c, unsigned int from) const { return npos(s.rfind(c, from)); }
+    int lastIndexOf(const String& str) const { return npos(s.rfind(str.s)); }
+    int lastIndexOf(const String& str, unsigned int from) const { return npos(s.rfind(str.s, from)); }
+
+    String substring(unsigned int from) const { return substring(from, length()); }
+    String substring(unsigned int from, unsigned int to) const {
+        if (from > to) std::swap(from, to);
+        if (from >= s.size()) return String();
+        to = std::min<unsigned int>(to, (unsigned int)s.size());
+        return String(s.substr(from, to - from));
+    }
+
+    // Modificação
+    void replace(char find, char replaceWith) { std::replace(s.begin(), s.end(), find, replaceWith); }
+    void replace(const String& find, const String& replaceWith) {
+        if (find.s.empty()) return;
+        size_t pos = 0;
+        while ((pos = s.find(find.s, pos)) != std::string::npos) {
+            s.replace(pos, find.s.size(), replaceWith.s);
+            pos += replaceWith.s.size();
+        }
+    }
+    void remove(unsigned int index) { if (index < s.size()) s.erase(index); }
+    void remove(unsigned int index, unsigned int count) { if (index < s.size()) s.erase(index, count); }
+    void toLowerCase() { for (auto& c : s) c = (char)tolower((unsigned char)c); }
+    void toUpperCase() { for (auto& c : s) c = (char)toupper((unsigned char)c); }
+    void trim() {
+        size_t b = s.find_first_not_of(" \t\r\n\f\v");
+        if (b == std::string::npos) { s.clear(); return; }
+        size_t e = s.find_last_not_of(" \t\r\n\f\v");
+        s = s.substr(b, e - b + 1);
+    }
+
+    // Conversão
+    long toInt() const { return atol(s.c_str()); }
+    float toFloat() const { return (float)atof(s.c_str()); }
+    double toDouble() const { return atof(s.c_str()); }
+
+private:
+    explicit String(const std::string& str) : s(str) {}
+    static int npos(size_t pos) { return pos == std::string::npos ? -1 : (int)pos; }
+    static std::string fromUnsigned(unsigned long long value, unsigned char base);
+    static std::string fromSigned(long long value, unsigned char base);
+    static std::string fromDouble(double value, unsigned int decimalPlaces);
+
+    std::string s;
+};
+
+// Tipo intermediário de "a" + b, como no núcleo Arduino
+class StringSumHelper : public String {
+public:
+    StringSumHelper(const String& s) : String(s) {}
+    StringSumHelper(const char* p) : String(p) {}
+};
+
+inline StringSumHelper operator+(const String& lhs, const String& rhs) { StringSumHelper r(lhs); r.concat(rhs); return r; }
+inline StringSumHelper operator+(const String& lhs, const char* rhs) { StringSumHelper r(lhs); r.concat(rhs); return r; }
+inline StringSumHelper operator+(const char* lhs, const String& rhs) { StringSumHelper r(lhs); r.concat(rhs); return r; }
+inline StringSumHelper operator+(const String& lhs, char rhs) { StringSumHelper r(lhs); r.concat(rhs); return r; }
+inline StringSumHelper operator+(const String& lhs, int rhs) { StringSumHelper r(lhs); r.concat(rhs); return r; }
+inline StringSumHelper operator+(const String& lhs, unsigned int rhs) { StringSumHelper r(lhs); r.concat(rhs); return r; }
+inline StringSumHelper operator+(const String& lhs, long rhs) { StringSumHelper r(lhs); r.concat(rhs); return r; }
+inline StringSumHelper operator+(const String& lhs, unsigned long rhs) { StringSumHelper r(lhs); r.concat(rhs); return r; }
+inline StringSumHelper operator+(const String& lhs, long long rhs) { StringSumHelper r(lhs); r.concat(rhs); return r; }
+inline StringSumHelper operator+(const String& lhs, unsigned long long rhs) { StringSumHelper r(lhs); r.concat(rhs); return r; }
+inline StringSumHelper operator+(const String& lhs, float rhs) { StringSumHelper r(lhs); r.concat(rhs); return r; }
+inline StringSumHelper operator+(const String& lhs, double rhs) { StringSumHelper r(lhs); r.concat(rhs); return r; }
+inline bool operator==(const char* lhs, const String& rhs) { return rhs == lhs; }
+inline bool operator!=(const char* lhs, const String& rhs) { return rhs != lhs; }
+
+// ============================================================================
+// Tempo
+// ============================================================================
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+namespace native {
+    /// Avança o relógio virtual sem dormir (também usado por delay()).
+    void advanceClock(unsigned long ms);
+    /// Zera o deslocamento virtual do relógio.
+    void resetClock();
+}
+
+// ============================================================================
+// Utilitários
+// ============================================================================
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+template <typename T, typename L, typename H>
+inline T constrain(T amt, L low, H high) {
+    return amt < low ? (T)low : (amt > high ? (T)high : amt);
+}
+
+inline bool isAlphaNumeric(int c) { return isalnum(c) != 0; }
+inline bool isAlpha(int c) { return isalpha(c) != 0; }
+inline bool isDigit(int c) { return isdigit(c) != 0; }
+inline bool isSpace(int c) { return isspace(c) != 0; }
+inline bool isHexadecimalDigit(int c) { return isxdigit(c) != 0; }
+
+// GPIO: sem hardware no host, leituras retornam HIGH (botões com pull-up soltos)
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return HIGH; }
+inline int analogRead(uint8_t) { return 0; }
+
+// ============================================================================
+// Serial
+// ============================================================================
+
+class HardwareSerial {
+public:
+    void begin(unsigned long) {}
+    void end() {}
+    void flush() { fflush(stdout); }
+    int available() { return 0; }
+    int read() { return -1; }
+
+    size_t print(const String& s) { return fwrite(s.c_str(), 1, s.length(), stdout); }
+    size_t print(const char* s) { return fputs(s ? s : "", stdout) >= 0 ? strlen(s ? s : "") : 0; }
+    size_t print(char c) { return fputc(c, stdout) != EOF ? 1 : 0; }
+    template <typename T>
+    size_t print(T value) { return print(String(value)); }
+    template <typename T>
+    size_t print(T value, int format) { return print(String(value, format)); }
+
+    size_t println() { return print("\n"); }
+    template <typename T>
+    size_t println(const T& value) { size_t n = print(value); return n + println(); }
+    template <typename T>
+    size_t println(const T& value, int format) { size_t n = print(value, format); return n + println(); }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    size_t write(uint8_t c) { return print((char)c); }
+    size_t write(const uint8_t* buf, size_t size) { return fwrite(buf, 1, size, stdout); }
+};
+
+extern HardwareSerial Serial;
+
+// ============================================================================
+// ESP
+// ============================================================================
+
+class EspClass {
+public:
+    uint32_t getFreeHeap() { return freeHeap; }
+    uint32_t getHeapSize() { return heapSize; }
+    uint32_t getMinFreeHeap() { return minFreeHeap; }
+    uint32_t getMaxAllocHeap() { return maxAllocHeap; }
+    uint32_t getCpuFreqMHz() { return 240; }
+    uint32_t getFlashChipSize() { return 4 * 1024 * 1024; }
+    uint64_t getEfuseMac() { return efuseMac; }
+    const char* getChipModel() { return "native"; }
+    const char* getSdkVersion() { return "native"; }
+    void restart() { exit(0); }
+
+    // Valores injetáveis para testes de telemetria
+    uint32_t freeHeap = 200 * 1024;
+    uint32_t heapSize = 320 * 1024;
+    uint32_t minFreeHeap = 180 * 1024;
+    uint32_t maxAllocHeap = 110 * 1024;
+    uint64_t efuseMac = 0x0000AABBCCDDEEFFULL;
+};
+
+extern EspClass ESP;
+
+// ============================================================================
+// Hora (NTP)
+// ============================================================================
+
+void configTime(long gmtOffsetSec, int daylightOffsetSec, const char* server1,
+                const char* server2 = nullptr, const char* server3 = nullptr);
+bool getLocalTime(struct tm* info, uint32_t ms = 5000);
+
+#endif // NATIVE_ARDUINO_H
@@ -0,0 +1,228 @@
+/**
+ * @file HTTPClient.cpp
+ * @brief Servidor HTTP em processo e HTTPClient do host
+ */
+
+#include "HTTPClient.h"
+
+namespace native {
+
+FakeHttpServer& FakeHttpServer::instance() {
+    static FakeHttpServer server;
+    return server;
+}
+
+void FakeHttpServer::on(const String& method, const String& urlOrPath, int code, const String& body,
+                        const HttpHeaders& headers, uint32_t latencyMs) {
+    for (auto& route : routes) {
+        if (route.method == method && route.urlOrPath == urlOrPath) {
+            route.response.code = code;
+            route.response.body = body;
+            route.response.headers = headers;
+            route.response.latencyMs = latencyMs;
+            return;
+        }
+    }
+
+    Route route;
+    route.method = method;
+    route.urlOrPath = urlOrPath;
+    route.response.code = code;
+    route.response.body = body;
+    route.response.headers = headers;
+    route.response.latencyMs = latencyMs;
+    routes.push_back(route);
+}
+
+size_t FakeHttpServer::countRequests(const String& method, const String& urlOrPath) const {
+    size_t count = 0;
+    for (const auto& request : requests) {
+        Route probe;
+        probe.method = method;
+        probe.urlOrPath = urlOrPath;
+        if (routeMatches(probe, request.method, request.url)) count++;
+    }
+    return count;
+}
+
+void FakeHttpServer::reset() {
+    routes.clear();
+    requests.clear();
+    defaultCode = HTTPC_ERROR_CONNECTION_REFUSED;
+    connectLatencyMs = 0;
+    connections = 0;
+}
+
+void FakeHttpServer::connect() {
+    connections++;
+    if (connectLatencyMs) native::advanceClock(connectLatencyMs);
+}
+
+bool FakeHttpServer::routeMatches(const Route& route, const String& method, const String& url) {
+    if (route.method != method) return false;
+    if (route.urlOrPath == url) return true;
+
+    // Rota registrada só com o path: compara com o path da URL (sem query)
+    int scheme = url.indexOf("://");
+    int pathStart = url.indexOf('/', scheme >= 0 ? scheme + 3 : 0);
+    if (pathStart < 0) return false;
+    String path = url.substring(pathStart);
+    if (path == route.urlOrPath) return true;
+    int query = path.indexOf('?');
+    return query >= 0 && path.substring(0, query) == route.urlOrPath;
+}
+
+bool FakeHttpServer::notModified(const HttpResponse& response, const HttpRequest& request) {
+    // Como um servidor real: If-None-Match igual ao ETag da rota -> 304 sem corpo
+    if (response.code != HTTP_CODE_OK) return false;
+
+    String etag;
+    for (const auto& header : response.headers) {
+        if (header.first.equalsIgnoreCase("ETag")) etag = header.second;
+    }
+    if (etag.isEmpty()) return false;
+
+    for (const auto& header : request.headers) {
+        if (header.first.equalsIgnoreCase("If-None-Match") && header.second == etag) return true;
+    }
+    return false;
+}
+
+HttpResponse FakeHttpServer::handle(const HttpRequest& request) {
+    requests.push_back(request);
+
+    for (const auto& route : routes) {
+        if (routeMatches(route, request.method, request.url)) {
+            if (route.response.latencyMs) native::advanceClock(route.response.latencyMs);
+            if (notModified(route.response, request)) {
+                HttpResponse response;
+                response.code = HTTP_CODE_NOT_MODIFIED;
+                response.headers = route.response.headers;
+                return response;
+            }
+            return route.response;
+        }
+    }
+
+    HttpResponse notFound;
+    notFound.code = defaultCode;
+    return notFound;
+}
+
+size_t BodyStream::readBytes(char* buffer, size_t length) {
+    size_t n = 0;
+    while (n < length && position < data.length()) {
+        buffer[n++] = data.c_str()[position++];
+    }
+    return n;
+}
+
+} // namespace native
+
+bool HTTPClient::begin(WiFiClient& client, const String& url) {
+    if (!begin(url)) return false;
+    this->client = &client;
+    return true;
+}
+
+bool HTTPClient::begin(const String& url) {
+    if (!url.startsWith("http://") && !url.startsWith("https://")) return false;
+    this->url = url;
+    client = nullptr;
+    requestHeaders.clear();
+    response = native::HttpResponse();
+    return true;
+}
+
+void HTTPClient::end() {
+    if (client && !reuse) client->stop();
+    url = "";
+    requestHeaders.clear();
+}
+
+void HTTPClient::addHeader(const String& name, const String& value) {
+    for (auto& header : requestHeaders) {
+        if (header.first.equalsIgnoreCase(name)) {
+            header.second = value;
+            return;
+        }
+    }
+    requestHeaders.push_back(std::make_pair(name, value));
+}
+
+void HTTPClient::collectHeaders(const char* headerKeys[], const size_t headerKeysCount) {
+    collectKeys.clear();
+    for (size_t i = 0; i < headerKeysCount; i++) {
+        collectKeys.push_back(String(headerKeys[i]));
+    }
+}
+
+String HTTPClient::header(const char* name) {
+    for (const auto& key : collectKeys) {
+        if (!key.equalsIgnoreCase(name)) continue;
+        for (const auto& header : response.headers) {
+            if (header.first.equalsIgnoreCase(name)) return header.second;
+        }
+    }
+    return String();
+}
+
+bool HTTPClient::hasHeader(const char* name) {
+    return !header(name).isEmpty();
+}
+
+int HTTPClient::GET() {
+    return sendRequest("GET");
+}
+
+int HTTPClient::POST(const String& payload) {
+    return sendRequest("POST", payload);
+}
+
+int HTTPClient::PUT(const String& payload) {
+    return sendRequest("PUT", payload);
+}
+
+int HTTPClient::PATCH(const String& payload) {
+    return sendRequest("PATCH", payload);
+}
+
+int HTTPClient::sendRequest(const char* type, const String& payload) {
+    if (url.isEmpty()) return HTTPC_ERROR_NOT_CONNECTED;
+
+    native::HttpRequest request;
+    request.method = type;
+    request.url = url;
+    request.body = payload;
+    request.headers = requestHeaders;
+    if (!userAgent.isEmpty()) {
+        request.headers.push_back(std::make_pair(String("User-Agent"), userAgent));
+    }
+
+    native::FakeHttpServer& server = native::FakeHttpServer::instance();
+    if (!client || !client->connected()) {
+        server.connect();
+        if (client) client->connect("api", 80);
+    }
+
+    response = server.handle(request);
+    if (client && response.code <= 0) client->stop();
+    return response.code;
+}
+
+String HTTPClient::errorToString(int error) {
+    switch (error) {
+        case HTTPC_ERROR_CONNECTION_REFUSED: return "connection refused";
+        case HTTPC_ERROR_SEND_HEADER_FAILED: return "send header failed";
+        case HTTPC_ERROR_SEND_PAYLOAD_FAILED: return "send payload failed";
+        case HTTPC_ERROR_NOT_CONNECTED: return "not connected";
+        case HTTPC_ERROR_CONNECTION_LOST: return "connection lost";
+        case HTTPC_ERROR_NO_STREAM: return "no stream";
+        case HTTPC_ERROR_NO_HTTP_SERVER: return "no HTTP server";
+        case HTTPC_ERROR_TOO_LESS_RAM: return "too less ram";
+        case HTTPC_ERROR_ENCODING: return "Transfer-Encoding not supported";
+        case HTTPC_ERROR_STREAM_WRITE: return "Stream write error";
+        case HTTPC_ERROR_READ_TIMEOUT: return "read Timeout";
+        default: return String();
+    }
+}
@@ -0,0 +1,166 @@
+/**
+ * @file HTTPClient.h
+ * @brief HTTPClient do host com respostas injetáveis (env:native)
+ *
+ * native::FakeHttpServer responde às requisições do firmware a partir de
+ * rotas registradas pelos testes (URL completa ou só o path) e registra
+ * cada requisição feita, com método, corpo e cabeçalhos. Rotas com ETag
+ * respondem 304 a um If-None-Match igual. Conexões TCP novas são contadas
+ * (e podem custar tempo virtual); um WiFiClient reaproveitado com
+ * setReuse(true) não reconecta, como no keep-alive do HTTPClient real.
+ */
+
+#ifndef NATIVE_HTTPCLIENT_H
+#define NATIVE_HTTPCLIENT_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <vector>
+#include <utility>
+
+#define HTTPC_ERROR_CONNECTION_REFUSED  (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED  (-2)
+#define HTTPC_ERROR_SEND_PAYLOAD_FAILED (-3)
+#define HTTPC_ERROR_NOT_CONNECTED       (-4)
+#define HTTPC_ERROR_CONNECTION_LOST     (-5)
+#define HTTPC_ERROR_NO_STREAM           (-6)
+#define HTTPC_ERROR_NO_HTTP_SERVER      (-7)
+#define HTTPC_ERROR_TOO_LESS_RAM        (-8)
+#define HTTPC_ERROR_ENCODING            (-9)
+#define HTTPC_ERROR_STREAM_WRITE        (-10)
+#define HTTPC_ERROR_READ_TIMEOUT        (-11)
+
+typedef enum {
+    HTTP_CODE_OK = 200,
+    HTTP_CODE_CREATED = 201,
+    HTTP_CODE_NO_CONTENT = 204,
+    HTTP_CODE_NOT_MODIFIED = 304,
+    HTTP_CODE_BAD_REQUEST = 400,
+    HTTP_CODE_UNAUTHORIZED = 401,
+    HTTP_CODE_NOT_FOUND = 404,
+    HTTP_CODE_CONFLICT = 409,
+    HTTP_CODE_INTERNAL_SERVER_ERROR = 500,
+    HTTP_CODE_SERVICE_UNAVAILABLE = 503
+} t_http_codes;
+
+namespace native {
+
+typedef std::vector<std::pair<String, String>> HttpHeaders;
+
+struct HttpRequest {
+    String method;
+    String url;
+    String body;
+    HttpHeaders headers;
+};
+
+struct HttpResponse {
+    int code = HTTPC_ERROR_CONNECTION_REFUSED;
+    String body;
+    HttpHeaders headers;
+    uint32_t latencyMs = 0;   ///< Avança o relógio virtual ao responder
+};
+
+class FakeHttpServer {
+public:
+    static FakeHttpServer& instance();
+
+    /// Registra (ou substitui) a resposta para método + URL/path
+    void on(const String& method, const String& urlOrPath, int code, const String& body = String(),
+            const HttpHeaders& headers = HttpHeaders(), uint32_t latencyMs = 0);
+
+    /// Resposta para rotas não registradas (padrão: conexão recusada)
+    void setDefaultCode(int code) { defaultCode = code; }
+
+    /// Custo de abrir uma conexão TCP (handshake), em ms de relógio virtual
+    void setConnectLatency(uint32_t ms) { connectLatencyMs = ms; }
+    size_t getConnectionCount() const { return connections; }
+    void clearConnections() { connections = 0; }
+
+    // Usado pelo HTTPClient
+    void connect();
+
+    const std::vector<HttpRequest>& getRequests() const { return requests; }
+    size_t countRequests(const String& method, const String& urlOrPath) const;
+    void clearRequests() { requests.clear(); }
+    void reset();
+
+    // Usado pelo HTTPClient
+    HttpResponse handle(const HttpRequest& request);
+
+private:
+    struct Route {
+        String method;
+        String urlOrPath;
+        HttpResponse response;
+    };
+
+    static bool routeMatches(const Route& route, const String& method, const String& url);
+    static bool notModified(const HttpResponse& response, const HttpRequest& request);
+
+    std::vector<Route> routes;
+    std::vector<HttpRequest> requests;
+    int defaultCode = HTTPC_ERROR_CONNECTION_REFUSED;
+    uint32_t connectLatencyMs = 0;
+    size_t connections = 0;
+};
+
+/// Corpo da resposta lido como o WiFiClient de HTTPClient::getStream()
+class BodyStream {
+public:
+    void reset(const String& body) { data = body; position = 0; }
+    int available() const { return (int)(data.length() - position); }
+    int read() { return position < data.length() ? (uint8_t)data.c_str()[position++] : -1; }
+    size_t readBytes(char* buffer, size_t length);
+
+    /// Bytes já consumidos por quem leu o stream
+    size_t consumed() const { return position; }
+
+private:
+    String data;
+    size_t position = 0;
+};
+
+} // namespace native
+
+class HTTPClient {
+public:
+    bool begin(const String& url);
+    bool begin(WiFiClient& client, const String& url);
+    void end();
+
+    void setTimeout(uint16_t timeout) { this->timeout = timeout; }
+    void setConnectTimeout(int32_t) {}
+    void setReuse(bool reuse) { this->reuse = reuse; }
+    void setUserAgent(const String& userAgent) { this->userAgent = userAgent; }
+    void addHeader(const String& name, const String& value);
+    void collectHeaders(const char* headerKeys[], const size_t headerKeysCount);
+    String header(const char* name);
+    bool hasHeader(const char* name);
+
+    int GET();
+    int POST(const String& payload);
+    int PUT(const String& payload);
+    int PATCH(const String& payload);
+    int sendRequest(const char* type, const String& payload = String());
+
+    String getString() { return response.body; }
+    native::BodyStream& getStream() { stream.reset(response.body); return stream; }
+    int getSize() { return (int)response.body.length(); }
+    bool connected() { return !url.isEmpty(); }
+
+    static String errorToString(int error);
+
+private:
+    String url;
+    WiFiClient* client = nullptr;   ///< nullptr: API antiga, uma conexão por requisição
+    String userAgent;
+    uint16_t timeout = 5000;
+    bool reuse = true;
+    native::HttpHeaders requestHeaders;
+    std::vector<String> collectKeys;
+    native::HttpResponse response;
+    native::BodyStream stream;
+};
+
+#endif // NATIVE_HTTPCLIENT_H
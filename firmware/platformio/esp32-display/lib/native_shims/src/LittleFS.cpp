@@ -0,0 +1,118 @@
+/**
+ * @file LittleFS.cpp
+ * @brief Sistema de arquivos em memória para o build nativo
+ */
+
+#include "LittleFS.h"
+#include <map>
+#include <algorithm>
+
+fs::LittleFSFS LittleFS;
+
+namespace {
+    std::map<std::string, std::string>& storage() {
+        static std::map<std::string, std::string> files;
+        return files;
+    }
+}
+
+namespace fs {
+
+size_t File::write(const uint8_t* buf, size_t size) {
+    if (!open || !writing || !buf) return 0;
+    data.append((const char*)buf, size);
+    return size;
+}
+
+int File::read() {
+    if (!open || position >= data.size()) return -1;
+    return (uint8_t)data[position++];
+}
+
+size_t File::read(uint8_t* buf, size_t size) {
+    if (!open || !buf) return 0;
+    size_t n = std::min(size, data.size() - position);
+    memcpy(buf, data.data() + position, n);
+    position += n;
+    return n;
+}
+
+String File::readString() {
+    if (!open) return String();
+    String out(data.c_str() + position, (unsigned int)(data.size() - position));
+    position = data.size();
+    return out;
+}
+
+String File::readStringUntil(char terminator) {
+    if (!open) return String();
+    size_t end = data.find(terminator, position);
+    if (end == std::string::npos) end = data.size();
+    String out(data.c_str() + position, (unsigned int)(end - position));
+    position = std::min(end + 1, data.size());
+    return out;
+}
+
+void File::close() {
+    // Como no flash, o conteúdo escrito só aparece para outros ao fechar
+    if (open && writing) storage()[path.c_str()] = data;
+    open = false;
+}
+
+bool LittleFSFS::begin(bool formatOnFail, const char*, uint8_t, const char*) {
+    (void)formatOnFail;
+    mounted = true;
+    return true;
+}
+
+bool LittleFSFS::format() {
+    storage().clear();
+    return true;
+}
+
+File LittleFSFS::open(const char* path, const char* mode) {
+    if (!mounted || !path) return File();
+
+    bool writing = mode && (mode[0] == 'w' || mode[0] == 'a');
+    auto it = storage().find(path);
+    if (!writing && it == storage().end()) return File();
+
+    std::string initial;
+    if (mode && mode[0] == 'a' && it != storage().end()) initial = it->second;
+    if (!writing) initial = it->second;
+    return File(path, writing, initial);
+}
+
+bool LittleFSFS::exists(const char* path) {
+    return mounted && path && storage().count(path) > 0;
+}
+
+bool LittleFSFS::remove(const char* path) {
+    return mounted && path && storage().erase(path) > 0;
+}
+
+bool LittleFSFS::rename(const char* from, const char* to) {
+    if (!mounted || !from || !to) return false;
+    auto it = storage().find(from);
+    if (it == storage().end()) return false;
+    if (it->first == to) return true;
+
+    // Substitui o destino, como lfs_rename
+    storage()[to] = it->second;
+    storage().erase(from);
+    return true;
+}
+
+size_t LittleFSFS::usedBytes() const {
+    size_t used = 0;
+    for (const auto& entry : storage()) used += entry.second.size();
+    return used;
+}
+
+} // namespace fs
+
+namespace native {
+    void clearFilesystem() {
+        storage().clear();
+    }
+}
@@ -0,0 +1,81 @@
+/**
+ * @file LittleFS.h
+ * @brief Substituto host do LittleFS em memória (env:native)
+ *
+ * Arquivos sobrevivem entre aberturas durante o processo, como a partição
+ * sobrevive entre boots no dispositivo. native::clearFilesystem() simula
+ * um flash apagado.
+ */
+
+#ifndef NATIVE_LITTLEFS_H
+#define NATIVE_LITTLEFS_H
+
+#include <Arduino.h>
+#include <string>
+
+namespace fs {
+
+class File {
+public:
+    File() {}
+    File(const String& path, bool writing, const std::string& data)
+        : path(path), writing(writing), open(true), data(data) {}
+
+    explicit operator bool() const { return open; }
+
+    size_t write(const uint8_t* buf, size_t size);
+    size_t write(uint8_t c) { return write(&c, 1); }
+    size_t print(const String& str) { return write((const uint8_t*)str.c_str(), str.length()); }
+
+    int available() const { return open ? (int)(data.size() - position) : 0; }
+    int read();
+    size_t read(uint8_t* buf, size_t size);
+    size_t readBytes(char* buf, size_t size) { return read((uint8_t*)buf, size); }
+    String readString();
+    String readStringUntil(char terminator);
+
+    size_t size() const { return data.size(); }
+    const char* name() const { return path.c_str(); }
+    void close();
+
+private:
+    String path;
+    bool writing = false;
+    bool open = false;
+    std::string data;
+    size_t position = 0;
+};
+
+class LittleFSFS {
+public:
+    bool begin(bool formatOnFail = false, const char* basePath = "/littlefs",
+               uint8_t maxOpenFiles = 10, const char* partitionLabel = "spiffs");
+    void end() { mounted = false; }
+    bool format();
+
+    File open(const char* path, const char* mode = "r");
+    File open(const String& path, const char* mode = "r") { return open(path.c_str(), mode); }
+    bool exists(const char* path);
+    bool exists(const String& path) { return exists(path.c_str()); }
+    bool remove(const char* path);
+    bool remove(const String& path) { return remove(path.c_str()); }
+    bool rename(const char* from, const char* to);
+    bool rename(const String& from, const String& to) { return rename(from.c_str(), to.c_str()); }
+
+    size_t totalBytes() const { return 0x100000; }
+    size_t usedBytes() const;
+
+private:
+    bool mounted = false;
+};
+
+} // namespace fs
+
+using fs::File;
+extern fs::LittleFSFS LittleFS;
+
+namespace native {
+    void clearFilesystem();
+}
+
+#endif // NATIVE_LITTLEFS_H
@@ -0,0 +1,87 @@
+/**
+ * @file Preferences.cpp
+ * @brief NVS em memória para o build nativo
+ */
+
+#include "Preferences.h"
+#include <map>
+
+namespace {
+    struct Entry {
+        String text;
+        long long number = 0;
+        bool isText = false;
+    };
+
+    std::map<String, std::map<String, Entry>>& storage() {
+        static std::map<String, std::map<String, Entry>> nvs;
+        return nvs;
+    }
+}
+
+bool Preferences::begin(const char* name, bool ro, const char*) {
+    if (!name || !*name) return false;
+    ns = name;
+    readOnly = ro;
+    opened = true;
+    return true;
+}
+
+void Preferences::end() {
+    opened = false;
+}
+
+bool Preferences::clear() {
+    if (!opened || readOnly) return false;
+    storage()[ns].clear();
+    return true;
+}
+
+bool Preferences::remove(const char* key) {
+    if (!opened || readOnly) return false;
+    return storage()[ns].erase(key) > 0;
+}
+
+bool Preferences::isKey(const char* key) {
+    if (!opened) return false;
+    auto& space = storage()[ns];
+    return space.find(key) != space.end();
+}
+
+size_t Preferences::putString(const char* key, const String& value) {
+    if (!opened || readOnly) return 0;
+    Entry& e = storage()[ns][key];
+    e.text = value;
+    e.isText = true;
+    return value.length();
+}
+
+String Preferences::getString(const char* key, const String& defaultValue) {
+    if (!opened) return defaultValue;
+    auto& space = storage()[ns];
+    auto it = space.find(key);
+    if (it == space.end() || !it->second.isText) return defaultValue;
+    return it->second.text;
+}
+
+size_t Preferences::putNumber(const char* key, long long value, size_t size) {
+    if (!opened || readOnly) return 0;
+    Entry& e = storage()[ns][key];
+    e.number = value;
+    e.isText = false;
+    return size;
+}
+
+long long Preferences::getNumber(const char* key, long long defaultValue) {
+    if (!opened) return defaultValue;
+    auto& space = storage()[ns];
+    auto it = space.find(key);
+    if (it == space.end() || it->second.isText) return defaultValue;
+    return it->second.number;
+}
+
+namespace native {
+    void clearPreferences() {
+        storage().clear();
+    }
+}
@@ -0,0 +1,50 @@
+/**
+ * @file Preferences.h
+ * @brief Substituto host da NVS (Preferences) em memória (env:native)
+ *
+ * Os namespaces sobrevivem entre instâncias durante o processo, como a NVS
+ * sobrevive entre chamadas no dispositivo. native::clearPreferences()
+ * simula um flash apagado.
+ */
+
+#ifndef NATIVE_PREFERENCES_H
+#define NATIVE_PREFERENCES_H
+
+#include <Arduino.h>
+
+class Preferences {
+public:
+    bool begin(const char* name, bool readOnly = false, const char* partition = nullptr);
+    void end();
+
+    bool clear();
+    bool remove(const char* key);
+    bool isKey(const char* key);
+
+    size_t putString(const char* key, const String& value);
+    size_t putString(const char* key, const char* value) { return putString(key, String(value)); }
+    String getString(const char* key, const String& defaultValue = String());
+
+    size_t putULong(const char* key, uint32_t value) { return putNumber(key, value, sizeof(value)); }
+    uint32_t getULong(const char* key, uint32_t defaultValue = 0) { return (uint32_t)getNumber(key, defaultValue); }
+    size_t putUShort(const char* key, uint16_t value) { return putNumber(key, value, sizeof(value)); }
+    uint16_t getUShort(const char* key, uint16_t defaultValue = 0) { return (uint16_t)getNumber(key, defaultValue); }
+    size_t putInt(const char* key, int32_t value) { return putNumber(key, value, sizeof(value)); }
+    int32_t getInt(const char* key, int32_t defaultValue = 0) { return (int32_t)getNumber(key, defaultValue); }
+    size_t putBool(const char* key, bool value) { return putNumber(key, value ? 1 : 0, 1); }
+    bool getBool(const char* key, bool defaultValue = false) { return getNumber(key, defaultValue ? 1 : 0) != 0; }
+
+private:
+    size_t putNumber(const char* key, long long value, size_t size);
+    long long getNumber(const char* key, long long defaultValue);
+
+    String ns;
+    bool opened = false;
+    bool readOnly = false;
+};
+
+namespace native {
+    void clearPreferences();
+}
+
+#endif // NATIVE_PREFERENCES_H
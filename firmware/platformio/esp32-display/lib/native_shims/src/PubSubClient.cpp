@@ -0,0 +1,279 @@
+/**
+ * @file PubSubClient.cpp
+ * @brief Broker MQTT em processo e cliente PubSubClient do host
+ */
+
+#include "PubSubClient.h"
+#include <algorithm>
+
+namespace native {
+
+FakeBroker& FakeBroker::instance() {
+    static FakeBroker broker;
+    return broker;
+}
+
+bool FakeBroker::topicMatches(const String& filter, const String& topic) {
+    const char* f = filter.c_str();
+    const char* t = topic.c_str();
+
+    while (*f) {
+        if (*f == '#') {
+            return true;
+        }
+        if (*f == '+') {
+            while (*t && *t != '/') t++;
+            f++;
+            continue;
+        }
+        if (*f != *t) {
+            return false;
+        }
+        f++;
+        t++;
+    }
+    return *t == '\0';
+}
+
+void FakeBroker::inject(const String& topic, const String& payload, bool retain) {
+    MqttMessage message;
+    message.topic = topic;
+    message.payload = payload;
+    message.retained = retain;
+    route(message, nullptr);
+}
+
+std::vector<MqttMessage> FakeBroker::publishedTo(const String& topicFilter) const {
+    std::vector<MqttMessage> result;
+    for (const auto& message : published) {
+        if (topicMatches(topicFilter, message.topic)) {
+            result.push_back(message);
+        }
+    }
+    return result;
+}
+
+void FakeBroker::dropConnections() {
+    std::vector<PubSubClient*> current = clients;
+    for (PubSubClient* client : current) {
+        client->connectionDropped();
+    }
+}
+
+void FakeBroker::reset() {
+    published.clear();
+    retained.clear();
+    available = true;
+    failing = 0;
+}
+
+bool FakeBroker::takeFailure(const String& topic) {
+    if (failing == 0 || !topicMatches(failFilter, topic)) return false;
+    failing--;
+    return true;
+}
+
+void FakeBroker::attach(PubSubClient* client) {
+    if (std::find(clients.begin(), clients.end(), client) == clients.end()) {
+        clients.push_back(client);
+    }
+}
+
+void FakeBroker::detach(PubSubClient* client) {
+    clients.erase(std::remove(clients.begin(), clients.end(), client), clients.end());
+}
+
+void FakeBroker::route(const MqttMessage& message, PubSubClient* from) {
+    if (from) {
+        published.push_back(message);
+    }
+
+    if (message.retained) {
+        retained.erase(std::remove_if(retained.begin(), retained.end(),
+                                      [&](const MqttMessage& m) { return m.topic == message.topic; }),
+                       retained.end());
+        if (!message.payload.isEmpty()) {
+            retained.push_back(message);
+        }
+    }
+
+    // Entrega como o broker: inclusive de volta ao próprio remetente se inscrito
+    for (PubSubClient* client : clients) {
+        if (client->isSubscribed(message.topic)) {
+            client->enqueue(message);
+        }
+    }
+}
+
+void FakeBroker::deliverRetained(PubSubClient* client, const String& filter) {
+    for (const auto& message : retained) {
+        if (topicMatches(filter, message.topic)) {
+            client->enqueue(message);
+        }
+    }
+}
+
+} // namespace native
+
+using native::FakeBroker;
+using native::MqttMessage;
+
+PubSubClient::~PubSubClient() {
+    FakeBroker::instance().detach(this);
+}
+
+PubSubClient& PubSubClient::setServer(IPAddress, uint16_t) {
+    return *this;
+}
+
+PubSubClient& PubSubClient::setServer(const char*, uint16_t) {
+    return *this;
+}
+
+PubSubClient& PubSubClient::setCallback(MQTT_CALLBACK_SIGNATURE) {
+    this->callback = callback;
+    return *this;
+}
+
+bool PubSubClient::setBufferSize(uint16_t size) {
+    if (size == 0) return false;
+    bufferSize = size;
+    return true;
+}
+
+bool PubSubClient::connect(const char* id) {
+    return connect(id, nullptr, nullptr, nullptr, 0, false, nullptr, true);
+}
+
+bool PubSubClient::connect(const char* id, const char* user, const char* pass) {
+    return connect(id, user, pass, nullptr, 0, false, nullptr, true);
+}
+
+bool PubSubClient::connect(const char* id, const char* willTopic, uint8_t willQos, bool willRetain, const char* willMessage) {
+    return connect(id, nullptr, nullptr, willTopic, willQos, willRetain, willMessage, true);
+}
+
+bool PubSubClient::connect(const char* id, const char*, const char*,
+                           const char* willTopic, uint8_t, bool willRetain, const char* willMessage,
+                           bool cleanSession) {
+    FakeBroker& broker = FakeBroker::instance();
+    if (!broker.isAvailable()) {
+        isConnected = false;
+        connectionState = MQTT_CONNECT_UNAVAILABLE;
+        return false;
+    }
+
+    clientId = id ? id : "";
+    this->willTopic = willTopic ? willTopic : "";
+    this->willMessage = willMessage ? willMessage : "";
+    this->willRetain = willRetain;
+    if (cleanSession) {
+        subscriptions.clear();
+        inbox.clear();
+    }
+
+    isConnected = true;
+    connectionState = MQTT_CONNECTED;
+    broker.attach(this);
+    return true;
+}
+
+void PubSubClient::disconnect() {
+    // Desconexão limpa: o broker não publica o last will
+    FakeBroker::instance().detach(this);
+    isConnected = false;
+    connectionState = MQTT_DISCONNECTED;
+}
+
+void PubSubClient::connectionDropped() {
+    FakeBroker& broker = FakeBroker::instance();
+    broker.detach(this);
+    isConnected = false;
+    connectionState = MQTT_CONNECTION_LOST;
+
+    if (!willTopic.isEmpty()) {
+        MqttMessage will;
+        will.topic = willTopic;
+        will.payload = willMessage;
+        will.retained = willRetain;
+        broker.route(will, nullptr);
+    }
+}
+
+bool PubSubClient::publish(const char* topic, const char* payload) {
+    return publish(topic, (const uint8_t*)payload, payload ? strlen(payload) : 0, false);
+}
+
+bool PubSubClient::publish(const char* topic, const char* payload, bool retained) {
+    return publish(topic, (const uint8_t*)payload, payload ? strlen(payload) : 0, retained);
+}
+
+bool PubSubClient::publish(const char* topic, const uint8_t* payload, unsigned int length) {
+    return publish(topic, payload, length, false);
+}
+
+bool PubSubClient::publish(const char* topic, const uint8_t* payload, unsigned int length, bool retained) {
+    if (!isConnected || !topic) return false;
+    if (native::FakeBroker::instance().takeFailure(topic)) return false;
+
+    // Mesmo limite do PubSubClient: cabeçalho fixo (até 5) + tamanho do tópico (2) + tópico + payload
+    size_t packetSize = 5 + 2 + strlen(topic) + length;
+    if (packetSize > bufferSize) return false;
+
+    MqttMessage message;
+    message.topic = topic;
+    message.payload = String((const char*)payload, length);
+    message.retained = retained;
+    FakeBroker::instance().route(message, this);
+    return true;
+}
+
+bool PubSubClient::subscribe(const char* topic, uint8_t) {
+    if (!isConnected || !topic) return false;
+    String filter(topic);
+    if (std::find(subscriptions.begin(), subscriptions.end(), filter) == subscriptions.end()) {
+        subscriptions.push_back(filter);
+    }
+    FakeBroker::instance().deliverRetained(this, filter);
+    return true;
+}
+
+bool PubSubClient::unsubscribe(const char* topic) {
+    if (!isConnected || !topic) return false;
+    subscriptions.erase(std::remove(subscriptions.begin(), subscriptions.end(), String(topic)),
+                        subscriptions.end());
+    return true;
+}
+
+bool PubSubClient::isSubscribed(const String& topic) const {
+    for (const auto& filter : subscriptions) {
+        if (FakeBroker::topicMatches(filter, topic)) return true;
+    }
+    return false;
+}
+
+void PubSubClient::enqueue(const MqttMessage& message) {
+    inbox.push_back(message);
+}
+
+bool PubSubClient::loop() {
+    if (!isConnected) return false;
+
+    // Entrega apenas o que já estava na fila: callbacks que publicam
+    // não realimentam este mesmo loop indefinidamente
+    size_t pending = inbox.size();
+    while (pending-- > 0 && !inbox.empty()) {
+        MqttMessage message = inbox.front();
+        inbox.pop_front();
+
+        if (5 + 2 + message.topic.length() + message.payload.length() > bufferSize) {
+            continue;  // descartado, como o PubSubClient faz com pacotes maiores que o buffer
+        }
+        if (callback) {
+            String topic = message.topic;
+            std::vector<uint8_t> payload(message.payload.c_str(), message.payload.c_str() + message.payload.length() + 1);
+            callback((char*)topic.c_str(), payload.data(), message.payload.length());
+        }
+    }
+    return isConnected;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file PubSubClient.h
+ * @brief PubSubClient do host ligado a um broker MQTT em processo (env:native)
+ *
+ * native::FakeBroker substitui o Mosquitto: registra tudo que o firmware
+ * publica, guarda mensagens retidas e entrega mensagens injetadas pelos
+ * testes (ex.: um relé respondendo) no loop() do cliente, com o mesmo
+ * casamento de curingas +/# do broker real. O limite de buffer do
+ * PubSubClient é respeitado, então payloads grandes demais falham aqui
+ * como falhariam no dispositivo.
+ */
+
+#ifndef NATIVE_PUBSUBCLIENT_H
+#define NATIVE_PUBSUBCLIENT_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <functional>
+#include <vector>
+#include <deque>
+
+#define MQTT_CONNECTION_TIMEOUT     -4
+#define MQTT_CONNECTION_LOST        -3
+#define MQTT_CONNECT_FAILED         -2
+#define MQTT_DISCONNECTED           -1
+#define MQTT_CONNECTED               0
+#define MQTT_CONNECT_BAD_PROTOCOL    1
+#define MQTT_CONNECT_BAD_CLIENT_ID   2
+#define MQTT_CONNECT_UNAVAILABLE     3
+#define MQTT_CONNECT_BAD_CREDENTIALS 4
+#define MQTT_CONNECT_UNAUTHORIZED    5
+
+#ifndef MQTT_MAX_PACKET_SIZE
+#define MQTT_MAX_PACKET_SIZE 256
+#endif
+
+#define MQTT_CALLBACK_SIGNATURE std::function<void(char*, uint8_t*, unsigned int)> callback
+
+class PubSubClient;
+
+namespace native {
+
+struct MqttMessage {
+    String topic;
+    String payload;
+    bool retained = false;
+};
+
+class FakeBroker {
+public:
+    static FakeBroker& instance();
+
+    /// Publica no broker como se viesse de outro cliente (gateway, relé...)
+    void inject(const String& topic, const String& payload, bool retained = false);
+
+    /// Mensagens publicadas pelos clientes do host, em ordem
+    const std::vector<MqttMessage>& getPublished() const { return published; }
+    std::vector<MqttMessage> publishedTo(const String& topicFilter) const;
+    void clearPublished() { published.clear(); }
+
+    /// Recusa conexões novas (simula broker fora do ar)
+    void setAvailable(bool available) { this->available = available; }
+    bool isAvailable() const { return available; }
+
+    /// Próximos count publishes em tópicos do filtro falham (socket cheio/caído)
+    void failPublishes(const String& topicFilter, uint16_t count = 1) { failFilter = topicFilter; failing = count; }
+    bool takeFailure(const String& topic);
+
+    /// Derruba todos os clientes conectados
+    void dropConnections();
+
+    /// Limpa mensagens, retidas e estado de disponibilidade
+    void reset();
+
+    static bool topicMatches(const String& filter, const String& topic);
+
+    // Usado pelo PubSubClient
+    void attach(PubSubClient* client);
+    void detach(PubSubClient* client);
+    void route(const MqttMessage& message, PubSubClient* from);
+    void deliverRetained(PubSubClient* client, const String& filter);
+
+private:
+    std::vector<PubSubClient*> clients;
+    std::vector<MqttMessage> published;
+    std::vector<MqttMessage> retained;
+    bool available = true;
+    String failFilter;
+    uint16_t failing = 0;
+};
+
+} // namespace native
+
+class PubSubClient {
+public:
+    PubSubClient() {}
+    explicit PubSubClient(WiFiClient&) {}
+    ~PubSubClient();
+
+    PubSubClient& setServer(IPAddress ip, uint16_t port);
+    PubSubClient& setServer(const char* domain, uint16_t port);
+    PubSubClient& setCallback(MQTT_CALLBACK_SIGNATURE);
+    PubSubClient& setClient(WiFiClient&) { return *this; }
+    PubSubClient& setKeepAlive(uint16_t) { return *this; }
+    PubSubClient& setSocketTimeout(uint16_t) { return *this; }
+    bool setBufferSize(uint16_t size);
+    uint16_t getBufferSize() const { return bufferSize; }
+
+    bool connect(const char* id);
+    bool connect(const char* id, const char* user, const char* pass);
+    bool connect(const char* id, const char* willTopic, uint8_t willQos, bool willRetain, const char* willMessage);
+    bool connect(const char* id, const char* user, const char* pass,
+                 const char* willTopic, uint8_t willQos, bool willRetain, const char* willMessage,
+                 bool cleanSession = true);
+    void disconnect();
+
+    bool publish(const char* topic, const char* payload);
+    bool publish(const char* topic, const char* payload, bool retained);
+    bool publish(const char* topic, const uint8_t* payload, unsigned int length);
+    bool publish(const char* topic, const uint8_t* payload, unsigned int length, bool retained);
+
+    bool subscribe(const char* topic, uint8_t qos = 0);
+    bool unsubscribe(const char* topic);
+
+    bool loop();
+    bool connected() { return isConnected; }
+    int state() { return connectionState; }
+
+    // Usado pelo FakeBroker
+    void enqueue(const native::MqttMessage& message);
+    bool isSubscribed(const String& topic) const;
+    void connectionDropped();
+    const String& getClientId() const { return clientId; }
+    const String& getWillTopic() const { return willTopic; }
+
+private:
+    String clientId;
+    String willTopic;
+    String willMessage;
+    bool willRetain = false;
+
+    std::function<void(char*, uint8_t*, unsigned int)> callback;
+    std::vector<String> subscriptions;
+    std::deque<native::MqttMessage> inbox;
+    uint16_t bufferSize = MQTT_MAX_PACKET_SIZE;
+    bool isConnected = false;
+    int connectionState = MQTT_DISCONNECTED;
+};
+
+#endif // NATIVE_PUBSUBCLIENT_H
@@ -0,0 +1,8 @@
+/**
+ * @file WiFi.cpp
+ * @brief Instância global do WiFi do host (env:native)
+ */
+
+#include "WiFi.h"
+
+WiFiClass WiFi;
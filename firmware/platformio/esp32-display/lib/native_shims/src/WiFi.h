@@ -0,0 +1,103 @@
+/**
+ * @file WiFi.h
+ * @brief Substituto host de WiFi/IPAddress/WiFiClient (env:native)
+ *
+ * Sem rede real: o estado da conexão e os dados da interface são
+ * configuráveis pelos testes através do objeto global WiFi.
+ */
+
+#ifndef NATIVE_WIFI_H
+#define NATIVE_WIFI_H
+
+#include <Arduino.h>
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum {
+    WIFI_OFF = 0,
+    WIFI_STA = 1,
+    WIFI_AP = 2,
+    WIFI_AP_STA = 3
+} wifi_mode_t;
+
+class IPAddress {
+public:
+    IPAddress() : bytes{0, 0, 0, 0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : bytes{a, b, c, d} {}
+
+    bool fromString(const char* address) {
+        unsigned int a, b, c, d;
+        char tail;
+        if (!address || sscanf(address, "%u.%u.%u.%u%c", &a, &b, &c, &d, &tail) != 4) return false;
+        if (a > 255 || b > 255 || c > 255 || d > 255) return false;
+        bytes[0] = a; bytes[1] = b; bytes[2] = c; bytes[3] = d;
+        return true;
+    }
+    bool fromString(const String& address) { return fromString(address.c_str()); }
+
+    String toString() const {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%u.%u.%u.%u", bytes[0], bytes[1], bytes[2], bytes[3]);
+        return String(buf);
+    }
+
+    uint8_t operator[](int index) const { return bytes[index & 3]; }
+    bool operator==(const IPAddress& other) const { return memcmp(bytes, other.bytes, 4) == 0; }
+
+private:
+    uint8_t bytes[4];
+};
+
+// Cliente TCP inerte: PubSubClient/HTTPClient do host não abrem sockets.
+// Só lembra se está "conectado" para o HTTPClient simular keep-alive.
+class WiFiClient {
+public:
+    int connect(const char*, uint16_t) { open = true; return 1; }
+    int connect(IPAddress, uint16_t) { open = true; return 1; }
+    void stop() { open = false; }
+    uint8_t connected() { return open ? 1 : 0; }
+    int available() { return 0; }
+    int read() { return -1; }
+    size_t write(const uint8_t*, size_t size) { return size; }
+    void setTimeout(uint32_t) {}
+
+private:
+    bool open = false;
+};
+
+class WiFiClass {
+public:
+    wl_status_t begin(const char*, const char* = nullptr) { return status_; }
+    bool disconnect(bool = false) { status_ = WL_DISCONNECTED; return true; }
+    bool mode(wifi_mode_t) { return true; }
+    bool setAutoReconnect(bool) { return true; }
+    wl_status_t status() { return status_; }
+    bool isConnected() { return status_ == WL_CONNECTED; }
+
+    IPAddress localIP() { return ip; }
+    int8_t RSSI() { return rssi; }
+    uint8_t* macAddress(uint8_t* out) { memcpy(out, mac, 6); return out; }
+    String macAddress() {
+        char buf[18];
+        snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X",
+                 mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+        return String(buf);
+    }
+
+    // Estado injetável
+    wl_status_t status_ = WL_CONNECTED;
+    IPAddress ip = IPAddress(127, 0, 0, 1);
+    int8_t rssi = -50;
+    uint8_t mac[6] = {0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF};
+};
+
+extern WiFiClass WiFi;
+
+#endif // NATIVE_WIFI_H
@@ -0,0 +1,42 @@
+/**
+ * @file esp_system.h
+ * @brief Substituto host das funções de sistema do ESP-IDF (env:native)
+ */
+
+#ifndef NATIVE_ESP_SYSTEM_H
+#define NATIVE_ESP_SYSTEM_H
+
+#include <Arduino.h>
+
+#define CHIP_FEATURE_EMB_FLASH (1 << 0)
+#define CHIP_FEATURE_WIFI_BGN  (1 << 1)
+#define CHIP_FEATURE_BLE       (1 << 4)
+#define CHIP_FEATURE_BT        (1 << 5)
+
+typedef enum {
+    CHIP_ESP32 = 1
+} esp_chip_model_t;
+
+typedef struct {
+    esp_chip_model_t model;
+    uint32_t features;
+    uint16_t revision;
+    uint8_t cores;
+} esp_chip_info_t;
+
+inline void esp_chip_info(esp_chip_info_t* info) {
+    info->model = CHIP_ESP32;
+    info->features = CHIP_FEATURE_WIFI_BGN | CHIP_FEATURE_BT | CHIP_FEATURE_BLE;
+    info->revision = 3;
+    info->cores = 2;
+}
+
+inline uint32_t spi_flash_get_chip_size() {
+    return ESP.getFlashChipSize();
+}
+
+inline int64_t esp_timer_get_time() {
+    return (int64_t)micros();
+}
+
+#endif // NATIVE_ESP_SYSTEM_H
@@ -132,12 +132,8 @@ void Container::setPosition(int x, int y) {
 }
 
 void Container::applyTheme() {
-    lv_obj_set_style_bg_color(obj, COLOR_BACKGROUND, 0);
-    lv_obj_set_style_border_width(obj, 0, 0); // Sem borda
-    lv_obj_set_style_pad_top(obj, 2, 0);     // Margem superior mínima: 2px
-    lv_obj_set_style_pad_bottom(obj, 2, 0);  // Margem inferior mínima: 2px
-    lv_obj_set_style_pad_left(obj, 5, 0);    // Margem esquerda reduzida: 5px
-    lv_obj_set_style_pad_right(obj, 5, 0);   // Margem direita reduzida: 5px
+    // Estilo compartilhado: fundo, sem borda, margens 2px (vertical) / 5px (horizontal)
+    theme_add_style(obj, THEME_STYLE_CONTAINER);
     
     // GARANTIR QUE NÃO HÁ SCROLL EM NENHUMA SITUAÇÃO
     lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
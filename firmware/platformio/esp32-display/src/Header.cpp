@@ -60,25 +60,21 @@ void Header::createLayout() {
     lv_obj_align(container, LV_ALIGN_TOP_MID, 0, 0);
     
     // Aplicar tema
-    lv_obj_set_style_bg_color(container, COLOR_BACKGROUND, 0);
-    lv_obj_set_style_border_width(container, 0, 0);
-    lv_obj_set_style_pad_all(container, 10, 0);
+    theme_add_style(container, THEME_STYLE_HEADER);
     lv_obj_clear_flag(container, LV_OBJ_FLAG_SCROLLABLE);
     
     // Título
     titleLabel = lv_label_create(container);
     lv_label_set_text(titleLabel, "Menu Principal");
     lv_obj_align(titleLabel, LV_ALIGN_LEFT_MID, 0, 0);
-    lv_obj_set_style_text_color(titleLabel, COLOR_TEXT_ON, 0);
-    lv_obj_set_style_text_font(titleLabel, &lv_font_montserrat_16, 0);  // Reduzido de 20 para 16
+    theme_apply_title(titleLabel);
+    theme_apply_font(titleLabel, &lv_font_montserrat_16);  // Reduzido de 20 para 16
     
     // Container de ícones
     iconsContainer = lv_obj_create(container);
     lv_obj_set_size(iconsContainer, 60, 30);
     lv_obj_align(iconsContainer, LV_ALIGN_RIGHT_MID, 0, 0);
-    lv_obj_set_style_bg_opa(iconsContainer, LV_OPA_TRANSP, 0);
-    lv_obj_set_style_border_width(iconsContainer, 0, 0);
-    lv_obj_set_style_pad_all(iconsContainer, 0, 0);
+    theme_apply_transparent(iconsContainer);
     lv_obj_clear_flag(iconsContainer, LV_OBJ_FLAG_SCROLLABLE);
     
     // DEBUG REMOVIDO: Bordas coloridas desabilitadas
@@ -92,14 +88,13 @@ void Header::createLayout() {
     // WiFi Icon
     wifiIcon = lv_label_create(iconsContainer);
     lv_label_set_text(wifiIcon, LV_SYMBOL_WIFI);
-    lv_obj_set_style_text_color(wifiIcon, COLOR_TEXT_ON, 0);  // Mesma cor do título
-    lv_obj_set_style_text_font(wifiIcon, &lv_font_montserrat_14, 0);  // Reduzido de 16 para 14
+    theme_apply_title(wifiIcon);  // Mesma cor do título
+    theme_apply_font(wifiIcon, &lv_font_montserrat_14);  // Reduzido de 16 para 14
     
     // Espaço entre ícones
     lv_obj_t* spacer = lv_obj_create(iconsContainer);
     lv_obj_set_size(spacer, 10, 1);
-    lv_obj_set_style_bg_opa(spacer, LV_OPA_TRANSP, 0);
-    lv_obj_set_style_border_width(spacer, 0, 0);
+    theme_apply_transparent(spacer);
     
     // DEBUG REMOVIDO: Bordas coloridas desabilitadas
     // applyHeaderDebugBorder(spacer, HEADER_COLOR_IDX_SPACER, "Icon Spacer");
@@ -107,8 +102,8 @@ void Header::createLayout() {
     // MQTT Icon  
     mqttIcon = lv_label_create(iconsContainer);
     lv_label_set_text(mqttIcon, LV_SYMBOL_UPLOAD);
-    lv_obj_set_style_text_color(mqttIcon, COLOR_TEXT_ON, 0);  // Mesma cor do título
-    lv_obj_set_style_text_font(mqttIcon, &lv_font_montserrat_14, 0);  // Reduzido de 16 para 14
+    theme_apply_title(mqttIcon);  // Mesma cor do título
+    theme_apply_font(mqttIcon, &lv_font_montserrat_14);  // Reduzido de 16 para 14
 }
 
 void Header::setTitle(const String& title) {
@@ -126,17 +121,17 @@ void Header::setWiFiStatus(WiFiState state) {
     
     switch(state) {
         case WIFI_DISCONNECTED:
-            lv_obj_set_style_text_color(wifiIcon, COLOR_ERROR, 0);
+            theme_apply_status(wifiIcon, THEME_STYLE_STATUS_ERROR);
             stopBlinkAnimation(wifiIcon);
             break;
             
         case WIFI_CONNECTING:
-            lv_obj_set_style_text_color(wifiIcon, COLOR_WARNING, 0);
+            theme_apply_status(wifiIcon, THEME_STYLE_STATUS_WARNING);
             startBlinkAnimation(wifiIcon);
             break;
             
         case WIFI_CONNECTED:
-            lv_obj_set_style_text_color(wifiIcon, COLOR_BUTTON_ON, 0);
+            theme_apply_status(wifiIcon, THEME_STYLE_STATUS_OK);
             stopBlinkAnimation(wifiIcon);
             break;
     }
@@ -147,17 +142,17 @@ void Header::setMQTTStatus(MQTTState state) {
     
     switch(state) {
         case MQTT_STATE_DISCONNECTED:
-            lv_obj_set_style_text_color(mqttIcon, COLOR_ERROR, 0);
+            theme_apply_status(mqttIcon, THEME_STYLE_STATUS_ERROR);
             stopBlinkAnimation(mqttIcon);
             break;
             
         case MQTT_STATE_CONNECTING:
-            lv_obj_set_style_text_color(mqttIcon, COLOR_WARNING, 0);
+            theme_apply_status(mqttIcon, THEME_STYLE_STATUS_WARNING);
             startBlinkAnimation(mqttIcon);
             break;
             
         case MQTT_STATE_CONNECTED:
-            lv_obj_set_style_text_color(mqttIcon, COLOR_BUTTON_ON, 0);
+            theme_apply_status(mqttIcon, THEME_STYLE_STATUS_OK);
             stopBlinkAnimation(mqttIcon);
             break;
     }
@@ -3,9 +3,13 @@
 #include "ui/Icons.h"
 #include "utils/StringUtils.h"
 #include "core/Logger.h"
+#include "ui/DataBinder.h"
+#include "communication/ButtonStateManager.h"
 #include <Arduino.h>
 
 extern Logger* logger;
+extern DataBinder* dataBinder;
+extern ButtonStateManager* buttonStateManager;
 
 // Cores de debug para NavButtons
 lv_color_t NAVBUTTON_DEBUG_COLORS[] = {
@@ -51,8 +55,8 @@ void applyNavButtonDebugBorder(lv_obj_t* obj, NavButtonColorIndex colorIndex, co
     }
 }
 
-NavButton::NavButton(lv_obj_t* parent, const String& text, const String& iconId, const String& buttonId) 
-    : id(buttonId) {
+NavButton::NavButton(ScreenArena& arena, lv_obj_t* parent, const String& text, const String& iconId, const String& buttonId) 
+    : arena(arena), id(arena.copy(buttonId)) {
     button = lv_btn_create(parent);
     
     // Serial.printf("[NavButton] Creating button '%s' with id '%s'\n", text.c_str(), buttonId.c_str());
@@ -79,18 +83,18 @@ NavButton::NavButton(lv_obj_t* parent, const String& text, const String& iconId,
         // Log para debug - mas não logar CLICKED para momentâneos
         if (event == LV_EVENT_CLICKED || event == LV_EVENT_PRESSED || event == LV_EVENT_RELEASED) {
             // Pular log de CLICKED para botões momentâneos
-            if (navBtn && navBtn->functionType == "momentary" && event == LV_EVENT_CLICKED) {
+            if (navBtn && navBtn->isMomentary() && event == LV_EVENT_CLICKED) {
                 return;  // Ignorar completamente CLICKED para momentâneos
             }
             
             Serial.printf("[NavButton] Event received: %s for button: %s\n", 
                 event == LV_EVENT_CLICKED ? "CLICKED" :
                 event == LV_EVENT_PRESSED ? "PRESSED" : "RELEASED",
-                navBtn ? navBtn->id.c_str() : "NULL");
+                navBtn ? navBtn->id : "NULL");
                 
             if (navBtn) {
                 Serial.printf("[NavButton] Function type: %s, Has callback: %s\n", 
-                    navBtn->functionType.c_str(),
+                    navBtn->functionType,
                     navBtn->clickCallback ? "YES" : "NO");
             }
         }
@@ -100,7 +104,13 @@ NavButton::NavButton(lv_obj_t* parent, const String& text, const String& iconId,
             return;
         }
         
-        if (navBtn->functionType == "momentary") {
+        // Objeto LVGL apagado pelo container: não apagar de novo no destrutor
+        if (event == LV_EVENT_DELETE) {
+            navBtn->button = nullptr;
+            return;
+        }
+        
+        if (navBtn->isMomentary()) {
             // Para botões momentâneos: confiar no estado filtrado do TouchHandler
             if (event == LV_EVENT_PRESSED) {
                 if (!navBtn->getIsPressed()) {  // Só processar se não estava pressionado
@@ -119,16 +129,12 @@ NavButton::NavButton(lv_obj_t* parent, const String& text, const String& iconId,
             }
             // Ignorar LV_EVENT_CLICKED para momentâneos
         } else {
-            // Para botões toggle: apenas clicked com debounce
+            // Para botões toggle: apenas clicked com debounce do próprio botão.
+            // Toques rápidos de verdade passam e são coalescidos pelo CommandCoalescer
             if (event == LV_EVENT_CLICKED) {
-                static unsigned long lastClickTime = 0;
-                unsigned long now = millis();
-                
-                // Debounce - 500ms para evitar múltiplos comandos
-                if (now - lastClickTime < 500) {
+                if (!navBtn->canSendCommand()) {
                     return;
                 }
-                lastClickTime = now;
                 
                 if (navBtn->clickCallback) {
                     navBtn->clickCallback(navBtn);
@@ -139,8 +145,18 @@ NavButton::NavButton(lv_obj_t* parent, const String& text, const String& iconId,
 }
 
 NavButton::~NavButton() {
+    // Ninguém pode continuar apontando para a arena depois do reset
+    if (buttonStateManager) {
+        buttonStateManager->unregisterButton(this);
+    }
+    if (dataBinder) {
+        dataBinder->unbindWidget(this);
+    }
+    
     if (button) {
-        lv_obj_del(button);
+        lv_obj_t* obj = button;
+        button = nullptr;
+        lv_obj_del(obj);
     }
 }
 
@@ -153,7 +169,7 @@ void NavButton::createLayout(const String& text, const String& iconId) {
     icon = lv_label_create(button);
     const char* iconSymbol = Icons::getIcon(iconId.c_str());
     lv_label_set_text(icon, iconSymbol);
-    lv_obj_set_style_text_font(icon, &lv_font_montserrat_20, 0);  // Voltando para 20 (maior)
+    theme_apply_font(icon, &lv_font_montserrat_20);  // Voltando para 20 (maior)
     
     // DEBUG REMOVIDO: Bordas coloridas desabilitadas
     // applyNavButtonDebugBorder(icon, NAVBUTTON_COLOR_IDX_ICON, "Icon", "", text, iconId, "");
@@ -162,7 +178,7 @@ void NavButton::createLayout(const String& text, const String& iconId) {
     label = lv_label_create(button);
     String cleanText = StringUtils::removeAccents(text);
     lv_label_set_text(label, cleanText.c_str());
-    lv_obj_set_style_text_font(label, &lv_font_montserrat_10, 0);  // Fonte menor
+    theme_apply_font(label, &lv_font_montserrat_10);  // Fonte menor
     lv_label_set_long_mode(label, LV_LABEL_LONG_WRAP);
     lv_obj_set_width(label, lv_pct(90));
     lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
@@ -172,16 +188,13 @@ void NavButton::createLayout(const String& text, const String& iconId) {
 }
 
 void NavButton::applyTheme() {
-    // Estilo do botão
-    lv_obj_set_style_bg_color(button, COLOR_BUTTON_OFF, 0);
-    lv_obj_set_style_bg_color(button, COLOR_BUTTON_SEL, LV_STATE_PRESSED);
-    lv_obj_set_style_radius(button, BUTTON_RADIUS, 0);
-    lv_obj_set_style_border_width(button, 0, 0); // Sem borda
-    lv_obj_set_style_pad_all(button, 8, 0); // Padding normal
-    
-    // Estilo do texto
-    lv_obj_set_style_text_color(icon, COLOR_TEXT_OFF, 0);
-    lv_obj_set_style_text_color(label, COLOR_TEXT_OFF, 0);
+    // Estilos compartilhados: ícone e label herdam a cor do texto do botão.
+    // Estado ligado usa LV_STATE_CHECKED, então setState() não toca em estilos.
+    theme_add_style(button, THEME_STYLE_TILE);
+    theme_add_style(button, THEME_STYLE_TILE_PRESSED, LV_STATE_PRESSED);
+    theme_add_style(button, THEME_STYLE_TILE_ON, LV_STATE_CHECKED);
+    theme_add_style(button, THEME_STYLE_STATUS_ERROR, LV_STATE_USER_1);
+    theme_add_style(button, THEME_STYLE_STATUS_WARNING, LV_STATE_USER_2);
 }
 
 void NavButton::setState(bool on) {
@@ -189,14 +202,26 @@ void NavButton::setState(bool on) {
     updateStyle();
 }
 
+void NavButton::setCommandFailed(bool failed) {
+    if (failed) {
+        lv_obj_add_state(button, LV_STATE_USER_1);
+    } else {
+        lv_obj_clear_state(button, LV_STATE_USER_1);
+    }
+}
+
+void NavButton::setPending(bool pending) {
+    if (pending) {
+        lv_obj_add_state(button, LV_STATE_USER_2);
+    } else {
+        lv_obj_clear_state(button, LV_STATE_USER_2);
+    }
+}
+
 void NavButton::updateStyle() {
     if (isOn) {
-        lv_obj_set_style_bg_color(button, COLOR_BUTTON_ON, 0);
-        lv_obj_set_style_text_color(icon, COLOR_TEXT_ON, 0);
-        lv_obj_set_style_text_color(label, COLOR_TEXT_ON, 0);
+        lv_obj_add_state(button, LV_STATE_CHECKED);
     } else {
-        lv_obj_set_style_bg_color(button, COLOR_BUTTON_OFF, 0);
-        lv_obj_set_style_text_color(icon, COLOR_TEXT_OFF, 0);
-        lv_obj_set_style_text_color(label, COLOR_TEXT_OFF, 0);
+        lv_obj_clear_state(button, LV_STATE_CHECKED);
     }
 }
\ No newline at end of file
@@ -59,9 +59,7 @@ void NavigationBar::createLayout() {
     lv_obj_align(container, LV_ALIGN_BOTTOM_MID, 0, 0);
     
     // Aplicar tema
-    lv_obj_set_style_bg_color(container, COLOR_BACKGROUND, 0);
-    lv_obj_set_style_border_width(container, 0, 0);
-    lv_obj_set_style_pad_all(container, 5, 0);
+    theme_add_style(container, THEME_STYLE_NAVBAR);
     lv_obj_clear_flag(container, LV_OBJ_FLAG_SCROLLABLE);
     
     // Layout flexível
@@ -107,24 +105,22 @@ void NavigationBar::createButton(lv_obj_t*& btn, const char* label, NavigationDi
     
     lv_obj_set_user_data(btn, (void*)(intptr_t)dir);
     
+    // Estilos compartilhados; habilitado/desabilitado via LV_STATE_DISABLED
+    theme_add_style(btn, THEME_STYLE_NAVBAR_BUTTON);
+    theme_add_style(btn, THEME_STYLE_NAVBAR_BUTTON_PRESSED, LV_STATE_PRESSED);
+    theme_add_style(btn, THEME_STYLE_NAVBAR_BUTTON_DISABLED, LV_STATE_DISABLED);
+    
     applyButtonTheme(btn, true);
 }
 
 void NavigationBar::applyButtonTheme(lv_obj_t* btn, bool enabled) {
     if (enabled) {
-        // Usar mesma cor do botão quando pressionado (azul ciano)
-        lv_obj_set_style_bg_color(btn, COLOR_BUTTON_SEL, 0);
-        lv_obj_set_style_bg_color(btn, COLOR_BUTTON_ON, LV_STATE_PRESSED);
-        lv_obj_set_style_text_color(btn, COLOR_TEXT_ON, 0);
+        lv_obj_clear_state(btn, LV_STATE_DISABLED);
         lv_obj_add_flag(btn, LV_OBJ_FLAG_CLICKABLE);
     } else {
-        lv_obj_set_style_bg_color(btn, lv_color_hex(0x1a1a1a), 0);
-        lv_obj_set_style_text_color(btn, lv_color_hex(0x666666), 0);
+        lv_obj_add_state(btn, LV_STATE_DISABLED);
         lv_obj_clear_flag(btn, LV_OBJ_FLAG_CLICKABLE);
     }
-    
-    lv_obj_set_style_radius(btn, BUTTON_RADIUS, 0);
-    lv_obj_set_style_border_width(btn, 0, 0); // Sem borda
 }
 
 void NavigationBar::setPrevEnabled(bool enabled) {
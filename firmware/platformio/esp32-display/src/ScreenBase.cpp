@@ -4,6 +4,7 @@
 #include "ui/Theme.h"
 #include "core/Logger.h"
 #include "ui/ScreenManager.h"
+#include "config/DeviceConfig.h"
 
 extern Logger* logger;
 extern ScreenManager* screenManager;
@@ -57,12 +58,15 @@ void applyMainContainerDebugBorder(lv_obj_t* obj, MainContainerColorIndex colorI
     }
 }
 
-ScreenBase::ScreenBase() : header(nullptr), content(nullptr), navBar(nullptr) {
+ScreenBase::ScreenBase() : header(nullptr), content(nullptr), navBar(nullptr),
+                           arena(SCREEN_ARENA_CHUNK_SIZE) {
     screen = lv_obj_create(NULL);
     createLayout();
 }
 
 ScreenBase::~ScreenBase() {
+    releaseContent();
+    
     delete header;
     delete content;
     delete navBar;
@@ -74,7 +78,7 @@ ScreenBase::~ScreenBase() {
 
 void ScreenBase::createLayout() {
     // Configurar tela base
-    lv_obj_set_style_bg_color(screen, COLOR_BACKGROUND, 0);
+    theme_add_style(screen, THEME_STYLE_SCREEN);
     
     // DEBUG REMOVIDO: Bordas coloridas desabilitadas
     // applyMainContainerDebugBorder(screen, COLOR_IDX_ROOT, 4, "Container Principal/Root");
@@ -123,6 +127,14 @@ void ScreenBase::createLayout() {
     // }
 }
 
+void ScreenBase::releaseContent() {
+    // LVGL primeiro: os NavButtons recebem LV_EVENT_DELETE e não apagam de novo
+    if (content) {
+        content->clearChildren();
+    }
+    arena.reset();
+}
+
 void ScreenBase::build() {
     // Implementação padrão vazia - sobrescrever nas classes derivadas
 }
@@ -0,0 +1,211 @@
+/**
+ * @file CommandAckTracker.cpp
+ * @brief Confirmação, timeout e reenvio dos comandos de relé
+ */
+
+#include "commands/CommandAckTracker.h"
+#include "commands/CommandCoalescer.h"
+#include "communication/ButtonStateManager.h"
+#include "core/MQTTClient.h"
+#include "core/Logger.h"
+#include "config/DeviceConfig.h"
+#include "utils/StringPool.h"
+#include <string.h>
+
+extern Logger* logger;
+
+static const uint32_t ACK_MS_BOUNDS[] = {10, 20, 50, 100, 200, 500, 1000, 2000, 5000};
+
+#define BOUNDS(a) a, (uint8_t)(sizeof(a) / sizeof(a[0]))
+
+CommandAckTracker& CommandAckTracker::getInstance() {
+    static CommandAckTracker instance;
+    return instance;
+}
+
+CommandAckTracker::CommandAckTracker() : latencyMs(BOUNDS(ACK_MS_BOUNDS)) {
+    clear();
+}
+
+void CommandAckTracker::track(const String& requestId, const String& topic, const String& payload,
+                              const String& buttonKey) {
+    uint32_t now = millis();
+    const char* key = StringPool::getInstance().intern(buttonKey);
+
+    // Pedido novo do mesmo botão substitui o anterior: reenviar o antigo
+    // desfaria este (ON depois do OFF, pressionar depois do soltar)
+    for (uint8_t i = 0; i < MAX_PENDING && *key; i++) {
+        Pending& entry = pending[i];
+        if (!entry.active || entry.buttonKey != key) continue;
+        entry.active = false;
+        entry.topic = String();
+        entry.payload = String();
+        superseded++;
+    }
+
+    Pending* slot = nullptr;
+    for (uint8_t i = 0; i < MAX_PENDING && !slot; i++) {
+        if (!pending[i].active) slot = &pending[i];
+    }
+    if (!slot) {
+        // Tabela cheia: o mais antigo deixa de ser acompanhado
+        slot = &pending[0];
+        for (uint8_t i = 1; i < MAX_PENDING; i++) {
+            if (now - pending[i].firstSentAt > now - slot->firstSentAt) slot = &pending[i];
+        }
+        dropped++;
+        if (logger) logger->warning("CMD: Ack table full, dropping " + String(slot->id));
+    }
+
+    strncpy(slot->id, requestId.c_str(), ID_LENGTH - 1);
+    slot->id[ID_LENGTH - 1] = '\0';
+    slot->active = true;
+    slot->attempts = 1;
+    slot->firstSentAt = now;
+    slot->deadline = now + COMMAND_ACK_TIMEOUT;
+    slot->buttonKey = key;
+    slot->topic = topic;
+    slot->payload = payload;
+
+    // Job de confirmação fica pausado sem comandos em voo
+    Scheduler::ui().runWithin(ackJob, COMMAND_ACK_TIMEOUT);
+}
+
+bool CommandAckTracker::acknowledge(const char* requestId, bool success, const char* error) {
+    Pending* entry = find(requestId);
+    if (!entry) return false;
+
+    if (success) {
+        latencyMs.record(millis() - entry->firstSentAt);
+        acked++;
+    } else {
+        rejected++;
+        if (logger) logger->warning("CMD: " + String(entry->id) + " rejected: " + String(error ? error : "unknown"));
+    }
+
+    finish(*entry, success);
+    return true;
+}
+
+bool CommandAckTracker::abandon(const char* requestId) {
+    Pending* entry = find(requestId);
+    if (!entry) return false;
+
+    finish(*entry, false);
+    return true;
+}
+
+void CommandAckTracker::handleResponse(const JsonDocument& response) {
+    const char* requestId = response["request_id"];
+    if (!requestId) return;
+
+    bool success = response["success"] | false;
+    acknowledge(requestId, success, response["error"].as<const char*>());
+}
+
+uint32_t CommandAckTracker::process() {
+    uint32_t now = millis();
+    uint32_t next = NO_DEADLINE;
+
+    for (uint8_t i = 0; i < MAX_PENDING; i++) {
+        Pending& entry = pending[i];
+        if (!entry.active) continue;
+
+        if ((int32_t)(now - entry.deadline) >= 0) {
+            if (entry.attempts > COMMAND_ACK_RETRIES) {
+                timedOut++;
+                if (logger) {
+                    logger->warning("CMD: " + String(entry.id) + " not acknowledged after " +
+                                    String(entry.attempts) + " attempts");
+                }
+                finish(entry, false);
+                continue;
+            }
+
+            // Mesmo payload e mesmo id: a placa responde a qualquer uma das cópias
+            entry.attempts++;
+            retries++;
+            entry.deadline = now + COMMAND_ACK_TIMEOUT;
+            if (logger) logger->info("CMD: Retrying " + String(entry.id) + " (attempt " + String(entry.attempts) + ")");
+            if (mqttClient) {
+                CommandCoalescer::getInstance().charge();
+                mqttClient->publish(entry.topic, entry.payload);
+            }
+        }
+
+        uint32_t due = entry.deadline - now;
+        if (due < next) next = due;
+    }
+
+    return next;
+}
+
+void CommandAckTracker::finish(Pending& entry, bool success) {
+    entry.active = false;
+    entry.topic = String();
+    entry.payload = String();
+
+    // Botão pode ter saído da tela: o ButtonStateManager ignora chaves sem botão
+    ButtonStateManager* buttons = ButtonStateManager::getInstance();
+    if (buttons && entry.buttonKey && *entry.buttonKey) {
+        buttons->processCommandResult(entry.buttonKey, entry.id, success);
+    }
+}
+
+CommandAckTracker::Pending* CommandAckTracker::find(const char* requestId) {
+    if (!requestId || !*requestId) return nullptr;
+    for (uint8_t i = 0; i < MAX_PENDING; i++) {
+        if (pending[i].active && strcmp(pending[i].id, requestId) == 0) return &pending[i];
+    }
+    return nullptr;
+}
+
+bool CommandAckTracker::isPending(const char* requestId) const {
+    if (!requestId || !*requestId) return false;
+    for (uint8_t i = 0; i < MAX_PENDING; i++) {
+        if (pending[i].active && strcmp(pending[i].id, requestId) == 0) return true;
+    }
+    return false;
+}
+
+uint8_t CommandAckTracker::getPending() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < MAX_PENDING; i++) {
+        if (pending[i].active) count++;
+    }
+    return count;
+}
+
+void CommandAckTracker::toJson(JsonObject obj) const {
+    obj["pending"] = getPending();
+    obj["acked"] = acked;
+    obj["rejected"] = rejected;
+    obj["timed_out"] = timedOut;
+    obj["retries"] = retries;
+    obj["dropped"] = dropped;
+    obj["superseded"] = superseded;
+    latencyMs.toJson(obj["latency_ms"].to<JsonObject>());
+}
+
+void CommandAckTracker::reset() {
+    latencyMs.reset();
+    acked = 0;
+    rejected = 0;
+    timedOut = 0;
+    retries = 0;
+    dropped = 0;
+    superseded = 0;
+}
+
+void CommandAckTracker::clear() {
+    for (uint8_t i = 0; i < MAX_PENDING; i++) {
+        pending[i].id[0] = '\0';
+        pending[i].active = false;
+        pending[i].attempts = 0;
+        pending[i].firstSentAt = 0;
+        pending[i].deadline = 0;
+        pending[i].buttonKey = "";
+        pending[i].topic = String();
+        pending[i].payload = String();
+    }
+}
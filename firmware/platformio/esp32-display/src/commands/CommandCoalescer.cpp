@@ -0,0 +1,281 @@
+/**
+ * @file CommandCoalescer.cpp
+ * @brief Janela de coalescência por alvo e token bucket dos comandos
+ */
+
+#include "commands/CommandCoalescer.h"
+#include "commands/CommandAckTracker.h"
+#include "communication/ButtonStateManager.h"
+#include "core/MQTTClient.h"
+#include "core/MQTTProtocol.h"
+#include "core/Logger.h"
+#include "config/DeviceConfig.h"
+#include "utils/CommandTracer.h"
+#include "utils/StringPool.h"
+
+extern Logger* logger;
+
+// Tokens em milésimos: reposição de MAX_MESSAGES_PER_SECOND por ms
+static const uint32_t TOKEN = 1000;
+static const uint32_t TOKEN_CAPACITY = COMMAND_RATE_BURST * TOKEN;
+
+CommandCoalescer& CommandCoalescer::getInstance() {
+    static CommandCoalescer instance;
+    return instance;
+}
+
+CommandCoalescer::CommandCoalescer() {
+    clear();
+}
+
+CommandCoalescer::Result CommandCoalescer::submit(const Command& command, String& effectiveId) {
+    uint32_t now = millis();
+
+    // Pressionar/soltar: atrasar deixaria o relé ligado além do toque
+    if (command.urgent) {
+        charge();
+        Slot direct = Slot();
+        direct.command = command;
+        effectiveId = command.requestId;
+        return publish(direct, now) ? SENT : FAILED;
+    }
+
+    Slot* slot = findSlot(command.key, now);
+    if (!slot) {
+        if (logger) logger->error("CMD: Command queue full, dropping command to " + command.topic);
+        discard(command);
+        return FAILED;
+    }
+
+    bool inWindow = slot->sent && now - slot->sentAt < COMMAND_COALESCE_MS;
+
+    if (!command.key.isEmpty()) {
+        // Pedido mais novo para o mesmo alvo substitui o que esperava
+        if (slot->held) {
+            discard(slot->command);
+            slot->held = false;
+            superseded++;
+        }
+
+        // Mesmo estado do comando ainda em voo: ele já leva este pedido
+        bool inFlight = slot->sentRequestId.isEmpty() ||
+                        CommandAckTracker::getInstance().isPending(slot->sentRequestId.c_str());
+        if (inWindow && inFlight && slot->sentValue == command.value) {
+            discard(command);
+            merged++;
+            effectiveId = slot->sentRequestId;
+            return MERGED;
+        }
+    }
+
+    slot->key = command.key;
+    slot->held = true;
+    slot->order = nextOrder++;
+    slot->readyAt = inWindow ? slot->sentAt + COMMAND_COALESCE_MS : now;
+    slot->command = command;
+    effectiveId = command.requestId;
+
+    // Primeiro da rajada sai já, se não houver ninguém pronto na frente
+    bool ahead = false;
+    for (uint8_t i = 0; i < MAX_QUEUED && !ahead; i++) {
+        const Slot& other = slots[i];
+        ahead = &other != slot && other.held && (int32_t)(other.readyAt - now) <= 0;
+    }
+    bool ready = (int32_t)(slot->readyAt - now) <= 0;
+    if (ready && !ahead) {
+        if (takeToken(now)) {
+            return publish(*slot, now) ? SENT : FAILED;
+        }
+    }
+    if (ready) throttled++;
+
+    // Só agenda: falhas adiadas chegam ao botão depois do beginPending
+    Scheduler::ui().runWithin(queueJob, dueIn(now));
+    return QUEUED;
+}
+
+void CommandCoalescer::charge() {
+    refill(millis());
+    tokens = tokens >= TOKEN ? tokens - TOKEN : 0;
+}
+
+uint32_t CommandCoalescer::process() {
+    uint32_t now = millis();
+
+    while (true) {
+        Slot* next = nullptr;
+        for (uint8_t i = 0; i < MAX_QUEUED; i++) {
+            Slot& slot = slots[i];
+            if (!slot.held || (int32_t)(slot.readyAt - now) > 0) continue;
+            if (!next || (int32_t)(slot.order - next->order) < 0) next = &slot;
+        }
+        if (!next || !takeToken(now)) break;
+
+        String requestId = next->command.requestId;
+        String ackKey = next->command.ackKey;
+        if (!publish(*next, now) && !ackKey.isEmpty()) {
+            // Botão já mostrava o pedido como pendente: volta ao confirmado
+            ButtonStateManager* buttons = ButtonStateManager::getInstance();
+            if (buttons) {
+                buttons->processCommandResult(StringPool::getInstance().intern(ackKey), requestId.c_str(), false);
+            }
+        }
+    }
+
+    return dueIn(now);
+}
+
+CommandCoalescer::Slot* CommandCoalescer::findSlot(const String& key, uint32_t now) {
+    Slot* freeSlot = nullptr;
+    for (uint8_t i = 0; i < MAX_QUEUED; i++) {
+        Slot& slot = slots[i];
+        if (!key.isEmpty() && slot.key == key && (slot.held || slot.sent)) return &slot;
+
+        // Livre: nada esperando e janela do último envio já fechada
+        bool expired = !slot.sent || now - slot.sentAt >= COMMAND_COALESCE_MS;
+        if (!slot.held && expired && !freeSlot) freeSlot = &slot;
+    }
+
+    if (freeSlot) {
+        freeSlot->sent = false;
+        freeSlot->sentValue = String();
+        freeSlot->sentRequestId = String();
+    }
+    return freeSlot;
+}
+
+void CommandCoalescer::refill(uint32_t now) {
+    uint32_t elapsed = now - lastRefill;
+    lastRefill = now;
+    if (elapsed >= TOKEN_CAPACITY / MAX_MESSAGES_PER_SECOND) {
+        tokens = TOKEN_CAPACITY;
+    } else {
+        tokens = min<uint32_t>(TOKEN_CAPACITY, tokens + elapsed * MAX_MESSAGES_PER_SECOND);
+    }
+}
+
+bool CommandCoalescer::takeToken(uint32_t now) {
+    refill(now);
+    if (tokens < TOKEN) return false;
+    tokens -= TOKEN;
+    return true;
+}
+
+bool CommandCoalescer::publish(Slot& slot, uint32_t now) {
+    Command& command = slot.command;
+    slot.held = false;
+
+    // Resultado do socket chega depois, na tarefa de UI (onPublished)
+    String key = slot.key;
+    String requestId = command.requestId;
+    String ackKey = command.ackKey;
+    bool ok = mqttClient && mqttClient->publishAsync(command.topic, command.payload,
+        [key, requestId, ackKey](bool sent) {
+            CommandCoalescer::getInstance().onPublished(key, requestId, ackKey, sent);
+        });
+
+    if (ok) {
+        // Em voo até a placa responder; ackKey vazio (grupo) só não marca botão
+        if (!command.requestId.isEmpty()) {
+            CommandAckTracker::getInstance().track(command.requestId, command.topic, command.payload, command.ackKey);
+        }
+        if (!slot.key.isEmpty()) {
+            slot.sent = true;
+            slot.sentAt = now;
+            slot.sentValue = command.value;
+            slot.sentRequestId = command.requestId;
+        }
+    } else {
+        if (!command.requestId.isEmpty()) {
+            CommandTracer::getInstance().markSent(command.requestId, false);
+        }
+        if (logger) logger->error("CMD: Failed to publish command to " + command.topic);
+    }
+
+    slot.command = Command();
+    return ok;
+}
+
+void CommandCoalescer::onPublished(const String& key, const String& requestId, const String& ackKey, bool ok) {
+    if (!requestId.isEmpty()) {
+        CommandTracer::getInstance().markSent(requestId, ok);
+    }
+    if (ok) return;
+
+    if (logger) logger->error("CMD: Failed to publish command " + requestId);
+
+    // Pedido igual ao que não saiu não pode ser absorvido por ele
+    for (uint8_t i = 0; i < MAX_QUEUED && !key.isEmpty() && !requestId.isEmpty(); i++) {
+        Slot& slot = slots[i];
+        if (slot.key == key && slot.sent && slot.sentRequestId == requestId) slot.sent = false;
+    }
+
+    // Sem reenvio: o botão volta ao confirmado
+    if (CommandAckTracker::getInstance().abandon(requestId.c_str()) || ackKey.isEmpty()) return;
+    ButtonStateManager* buttons = ButtonStateManager::getInstance();
+    if (buttons) {
+        buttons->processCommandResult(StringPool::getInstance().intern(ackKey), requestId.c_str(), false);
+    }
+}
+
+void CommandCoalescer::discard(const Command& command) {
+    // Rastreio aberto no CommandSender não vai ter eco
+    if (!command.requestId.isEmpty()) {
+        CommandTracer::getInstance().markSent(command.requestId, false);
+    }
+}
+
+uint32_t CommandCoalescer::dueIn(uint32_t now) {
+    refill(now);
+    uint32_t tokenWait = tokens >= TOKEN ? 0 : (TOKEN - tokens + MAX_MESSAGES_PER_SECOND - 1) / MAX_MESSAGES_PER_SECOND;
+    uint32_t next = NO_DEADLINE;
+
+    for (uint8_t i = 0; i < MAX_QUEUED; i++) {
+        const Slot& slot = slots[i];
+        if (!slot.held) continue;
+        int32_t left = (int32_t)(slot.readyAt - now);
+        uint32_t due = left > 0 ? max<uint32_t>((uint32_t)left, tokenWait) : tokenWait;
+        if (due < next) next = due;
+    }
+
+    return next;
+}
+
+uint8_t CommandCoalescer::getQueued() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < MAX_QUEUED; i++) {
+        if (slots[i].held) count++;
+    }
+    return count;
+}
+
+void CommandCoalescer::toJson(JsonObject obj) const {
+    obj["queued"] = getQueued();
+    obj["superseded"] = superseded;
+    obj["merged"] = merged;
+    obj["throttled"] = throttled;
+    obj["tokens"] = tokens / TOKEN;
+}
+
+void CommandCoalescer::reset() {
+    superseded = 0;
+    merged = 0;
+    throttled = 0;
+}
+
+void CommandCoalescer::clear() {
+    for (uint8_t i = 0; i < MAX_QUEUED; i++) {
+        Slot& slot = slots[i];
+        slot.key = String();
+        slot.held = false;
+        slot.order = 0;
+        slot.readyAt = 0;
+        slot.command = Command();
+        slot.sent = false;
+        slot.sentAt = 0;
+        slot.sentValue = String();
+        slot.sentRequestId = String();
+    }
+    tokens = TOKEN_CAPACITY;
+    lastRefill = millis();
+}
@@ -8,18 +8,27 @@
 #include "core/Logger.h"
 #include "config/DeviceConfig.h"
 #include "utils/DeviceUtils.h"
+#include "utils/StringPool.h"
+#include "utils/CommandTracer.h"
+#include "commands/CommandAckTracker.h"
+#include "commands/CommandCoalescer.h"
+#include "communication/ButtonStateManager.h"
 
 extern Logger* logger;
 
 CommandSender::CommandSender(MQTTClient* mqtt, Logger* log, const String& devId) 
     : mqttClient(mqtt), logger(log), deviceId(devId), commandCounter(0) {
     
-    // Initialize heartbeat arrays
-    for (int i = 0; i < MAX_CHANNELS; i++) {
-        heartbeatSequence[i] = 0;
-        lastHeartbeat[i] = 0;
-        heartbeatActive[i] = false;
-        heartbeatTargetDevice[i] = "";
+    // Fila de comandos e reenvios sem confirmação saem pelo mesmo cliente
+    CommandAckTracker::getInstance().setClient(mqtt);
+    CommandCoalescer::getInstance().setClient(mqtt);
+    
+    // Initialize heartbeat targets
+    for (int i = 0; i < MAX_HEARTBEAT_TARGETS; i++) {
+        heartbeatTargets[i].device = nullptr;
+        heartbeatTargets[i].channels = 0;
+        heartbeatTargets[i].lastSent = 0;
+        memset(heartbeatTargets[i].sequence, 0, sizeof(heartbeatTargets[i].sequence));
     }
 }
 
@@ -40,19 +49,23 @@ bool CommandSender::sendCommand(NavButton* button) {
     
     switch (button->getButtonType()) {
         case NavButton::TYPE_RELAY:
-            // Para botões toggle, sempre aplicar debounce rigoroso
+            // Toggle: debounce no clique (NavButton); toques rápidos são coalescidos na fila
             if (button->getMode() == "toggle") {
-                if (!button->canSendCommand()) {
-                    logger->debug("Comando toggle ignorado devido ao debounce");
-                    return false;
-                }
                 // Toggle state: se está ON, enviar OFF e vice-versa
-                return sendRelayCommand(
+                bool target = !button->getState();
+                bool sent = sendRelayCommand(
                     button->getDeviceId(),
                     button->getChannel(),
-                    button->getState() ? "OFF" : "ON",  // Toggle
+                    target ? "ON" : "OFF",  // Toggle
                     "toggle"  // Function type
                 );
+                
+                // Estado pedido aparece já, pendente até o eco da placa
+                ButtonStateManager* buttons = ButtonStateManager::getInstance();
+                if (sent && buttons) {
+                    buttons->beginPending(button, target, lastRequestId);
+                }
+                return sent;
             } else {
                 // Para botões momentary, enviar ON quando pressionado, OFF quando liberado
                 return sendRelayCommand(
@@ -98,6 +111,11 @@ bool CommandSender::sendRelayCommand(const String& targetUuid, int channel,
         return false;
     }
     
+    // Rastreio ponta a ponta: o relé ecoa o trace_id no status do canal
+    CommandTracer& tracer = CommandTracer::getInstance();
+    String traceId = generateRequestId();
+    tracer.begin(traceId);
+    
     // V2.2.0: Comando para dispositivo usando UUID completo
     // Para placas de relé, usar tópico específico /relays/set
     String topic = "autocore/devices/" + targetUuid + "/relays/set";
@@ -112,6 +130,8 @@ bool CommandSender::sendRelayCommand(const String& targetUuid, int channel,
     doc["function_type"] = functionType;
     doc["user"] = "display_touch";
     doc["source_uuid"] = MQTTProtocol::getDeviceUUID();
+    doc["trace_id"] = traceId;
+    doc["request_id"] = traceId;
     
     logger->info("State boolean: " + String(boolState ? "true" : "false"));
     logger->info("Source UUID: " + String(MQTTProtocol::getDeviceUUID()));
@@ -120,13 +140,35 @@ bool CommandSender::sendRelayCommand(const String& targetUuid, int channel,
     serializeJson(doc, payload);
     logger->info("MQTT Payload: " + payload);
     
-    bool result = mqttClient->publish(topic, payload);
-    logger->info("Publish result: " + String(result ? "SUCCESS" : "FAILED"));
+    // Toggle coalesce por canal (estado absoluto); pressionar/soltar de
+    // momentâneo não pode atrasar nem sumir: sai na hora, só gasta token
+    CommandCoalescer::Command command;
+    String buttonKey = targetUuid + ":" + String(channel);
+    if (functionType == "momentary") {
+        command.urgent = true;
+    } else {
+        command.key = buttonKey;
+    }
+    command.value = boolState ? "ON" : "OFF";
+    command.topic = topic;
+    command.payload = payload;
+    command.requestId = traceId;
+    command.ackKey = buttonKey;
+    
+    String requestId;
+    CommandCoalescer::Result outcome = CommandCoalescer::getInstance().submit(command, requestId);
+    bool result = outcome != CommandCoalescer::FAILED;
+    logger->info("Publish result: " + String(outcome == CommandCoalescer::SENT ? "SUCCESS" :
+                                             outcome == CommandCoalescer::QUEUED ? "QUEUED" :
+                                             outcome == CommandCoalescer::MERGED ? "MERGED" : "FAILED"));
     
     if (result) {
         logger->info("CMD: Sent " + functionType + " command to " + 
                     targetUuid + " ch:" + String(channel) + " state:" + state);
         
+        // Pedido que leva este estado à placa (o já em voo, se coalescido)
+        lastRequestId = requestId;
+        
         // Gerenciar heartbeat para botões momentâneos
         if (functionType == "momentary") {
             if (state == "ON" || state == "on" || state == "true" || state == "1") {
@@ -134,7 +176,7 @@ bool CommandSender::sendRelayCommand(const String& targetUuid, int channel,
                 startHeartbeat(targetUuid, channel);
             } else {
                 // Parar heartbeat quando solto
-                stopHeartbeat(channel);
+                stopHeartbeat(targetUuid, channel);
             }
         }
     } else {
@@ -144,70 +186,177 @@ bool CommandSender::sendRelayCommand(const String& targetUuid, int channel,
     return result;
 }
 
+bool CommandSender::sendRelayGroupCommand(const String& targetUuid, uint32_t channelMask, uint32_t stateMask) {
+    if (!mqttClient || !mqttClient->isConnected()) {
+        logger->warning("MQTT not connected, group command not sent");
+        return false;
+    }
+    
+    if (channelMask == 0 || (MAX_CHANNELS < 32 && (channelMask >> MAX_CHANNELS))) {
+        logger->error("CMD: Invalid group channel mask: " + String(channelMask, HEX));
+        return false;
+    }
+    
+    String traceId = generateRequestId();
+    CommandTracer::getInstance().begin(traceId);
+    
+    String topic = "autocore/devices/" + targetUuid + "/relays/set";
+    
+    JsonDocument doc;
+    MQTTProtocol::addProtocolFields(doc);
+    
+    // Lista em vez de "channel"/"state": o relé aplica todos de uma vez
+    JsonArray channels = doc["channels"].to<JsonArray>();
+    for (int i = 0; i < MAX_CHANNELS; i++) {
+        if (!(channelMask & (1UL << i))) continue;
+        JsonObject entry = channels.add<JsonObject>();
+        entry["channel"] = i + 1;
+        entry["state"] = (stateMask & (1UL << i)) != 0;
+    }
+    doc["function_type"] = "group";
+    doc["user"] = "display_touch";
+    doc["source_uuid"] = MQTTProtocol::getDeviceUUID();
+    doc["trace_id"] = traceId;
+    doc["request_id"] = traceId;
+    
+    // Mesmo conjunto de canais na janela: só o último estado sai (chave só
+    // da fila; máscaras são livres, não vão para o StringPool)
+    CommandCoalescer::Command command;
+    command.key = targetUuid + ":group:" + String(channelMask, HEX);
+    command.value = String(stateMask & channelMask, HEX);
+    command.topic = topic;
+    serializeJson(doc, command.payload);
+    command.requestId = traceId;
+    
+    String requestId;
+    if (CommandCoalescer::getInstance().submit(command, requestId) == CommandCoalescer::FAILED) {
+        logger->error("CMD: Failed to send group command to " + targetUuid);
+        return false;
+    }
+    
+    lastRequestId = requestId;
+    logger->info("CMD: Sent group command to " + targetUuid + " channels:" + String(channels.size()) +
+                 " mask:" + String(channelMask, HEX) + " states:" + String(stateMask & channelMask, HEX));
+    return true;
+}
+
+CommandSender::HeartbeatTarget* CommandSender::findHeartbeatTarget(const String& targetUuid, bool create) {
+    // UUIDs vêm do StringPool: mesma placa => mesmo ponteiro
+    const char* device = StringPool::getInstance().intern(targetUuid);
+    HeartbeatTarget* slot = nullptr;
+    
+    for (int i = 0; i < MAX_HEARTBEAT_TARGETS; i++) {
+        HeartbeatTarget& target = heartbeatTargets[i];
+        if (target.device == device) return &target;
+        if (!target.device && !slot) slot = &target;
+    }
+    
+    if (!create || !slot) return nullptr;
+    slot->device = device;
+    slot->channels = 0;
+    return slot;
+}
+
 void CommandSender::startHeartbeat(const String& targetUuid, int channel) {
     if (channel < 1 || channel > MAX_CHANNELS) {
         logger->error("CMD: Invalid channel for heartbeat: " + String(channel));
         return;
     }
     
+    HeartbeatTarget* target = findHeartbeatTarget(targetUuid, true);
+    if (!target) {
+        logger->error("CMD: No heartbeat slot for " + targetUuid + " (max " + String(MAX_HEARTBEAT_TARGETS) + " boards)");
+        return;
+    }
+    
     int idx = channel - 1;
-    heartbeatActive[idx] = true;
-    heartbeatSequence[idx] = 0;
-    heartbeatTargetDevice[idx] = targetUuid;
-    lastHeartbeat[idx] = millis();
+    if (target->channels == 0) {
+        // Primeiro canal da placa abre o intervalo; os seguintes entram no próximo lote
+        target->lastSent = millis();
+    }
+    target->channels |= (1UL << idx);
+    target->sequence[idx] = 0;
+    
+    // Job de heartbeat fica pausado sem canais ativos
+    Scheduler::ui().runWithin(heartbeatJob, HEARTBEAT_INTERVAL_MS);
     
     logger->info("CMD: Started heartbeat for " + targetUuid + " channel " + String(channel));
 }
 
-void CommandSender::stopHeartbeat(int channel) {
+void CommandSender::stopHeartbeat(const String& targetUuid, int channel) {
     if (channel < 1 || channel > MAX_CHANNELS) return;
     
-    int idx = channel - 1;
-    heartbeatActive[idx] = false;
-    heartbeatTargetDevice[idx] = "";
+    HeartbeatTarget* target = findHeartbeatTarget(targetUuid, false);
+    if (!target) return;
+    
+    target->channels &= ~(1UL << (channel - 1));
+    if (target->channels == 0) {
+        target->device = nullptr;
+    }
     
-    logger->info("CMD: Stopped heartbeat for channel " + String(channel));
+    logger->info("CMD: Stopped heartbeat for " + targetUuid + " channel " + String(channel));
 }
 
-void CommandSender::sendHeartbeat(const String& targetUuid, int channel) {
-    if (channel < 1 || channel > MAX_CHANNELS) return;
-    
-    int idx = channel - 1;
-    if (!heartbeatActive[idx]) return;
+void CommandSender::sendHeartbeat(HeartbeatTarget& target) {
+    if (!target.device || target.channels == 0) return;
     
     // V2.2.0: Heartbeat usando UUID completo
     // Para placas de relé, usar tópico específico /relays/heartbeat
+    String targetUuid = target.device;
     String topic = "autocore/devices/" + targetUuid + "/relays/heartbeat";
     
     JsonDocument doc;
     MQTTProtocol::addProtocolFields(doc);
     
-    doc["channel"] = channel;
     doc["source_uuid"] = MQTTProtocol::getDeviceUUID();
     doc["target_uuid"] = targetUuid;
-    doc["sequence"] = ++heartbeatSequence[idx];
     
+    // Lote: cada canal leva a própria sequência
+    JsonArray channels = doc["channels"].to<JsonArray>();
+    for (int i = 0; i < MAX_CHANNELS; i++) {
+        if (!(target.channels & (1UL << i))) continue;
+        JsonObject entry = channels.add<JsonObject>();
+        entry["channel"] = i + 1;
+        entry["sequence"] = ++target.sequence[i];
+    }
+    
+    // Não espera na fila, mas conta no limite de mensagens
+    CommandCoalescer::getInstance().charge();
     mqttClient->publish(topic, doc, QOS_HEARTBEAT);
     
-    lastHeartbeat[idx] = millis();
+    target.lastSent = millis();
     
-    logger->debug("CMD: Heartbeat sent to " + targetUuid + " ch:" + String(channel) + 
-                 " seq:" + String(heartbeatSequence[idx]));
+    logger->debug("CMD: Heartbeat sent to " + targetUuid + " channels:" + String(channels.size()));
+}
+
+uint8_t CommandSender::getActiveHeartbeatCount() const {
+    uint8_t count = 0;
+    for (int i = 0; i < MAX_HEARTBEAT_TARGETS; i++) {
+        for (uint32_t bits = heartbeatTargets[i].channels; bits; bits &= bits - 1) {
+            count++;
+        }
+    }
+    return count;
 }
 
-void CommandSender::processHeartbeats() {
+uint32_t CommandSender::processHeartbeats() {
     unsigned long now = millis();
+    uint32_t next = NO_HEARTBEAT;
     
-    for (int i = 0; i < MAX_CHANNELS; i++) {
-        if (heartbeatActive[i]) {
-            unsigned long elapsed = now - lastHeartbeat[i];
-            if (elapsed >= HEARTBEAT_INTERVAL_MS) {
-                logger->debug("CMD: Sending heartbeat for channel " + String(i+1) + 
-                           " (elapsed: " + String(elapsed) + "ms)");
-                sendHeartbeat(heartbeatTargetDevice[i], i + 1);
-            }
+    for (int i = 0; i < MAX_HEARTBEAT_TARGETS; i++) {
+        HeartbeatTarget& target = heartbeatTargets[i];
+        if (!target.device) continue;
+        
+        unsigned long elapsed = now - target.lastSent;
+        if (elapsed >= HEARTBEAT_INTERVAL_MS) {
+            sendHeartbeat(target);
+            elapsed = 0;
         }
+        uint32_t due = HEARTBEAT_INTERVAL_MS - elapsed;
+        if (due < next) next = due;
     }
+    
+    return next;
 }
 
 void CommandSender::sendDisplayEvent(const String& eventType, const JsonObject& eventData) {
@@ -238,9 +387,12 @@ bool CommandSender::sendPresetCommand(const String& preset) {
     
     logger->info("CMD: Sending preset command: " + preset);
     
-    String payload;
-    serializeJson(doc, payload);
-    return mqttClient->publish(topic, payload);
+    // Presets não são coalescidos: cada execução conta
+    CommandCoalescer::Command command;
+    command.topic = topic;
+    serializeJson(doc, command.payload);
+    String requestId;
+    return CommandCoalescer::getInstance().submit(command, requestId) != CommandCoalescer::FAILED;
 }
 
 bool CommandSender::sendModeCommand(const String& mode) {
@@ -257,9 +409,14 @@ bool CommandSender::sendModeCommand(const String& mode) {
     
     logger->info("CMD: Sending mode command: " + mode);
     
-    String payload;
-    serializeJson(doc, payload);
-    return mqttClient->publish(topic, payload);
+    // Só o último modo pedido na janela importa
+    CommandCoalescer::Command command;
+    command.key = "mode";
+    command.value = mode;
+    command.topic = topic;
+    serializeJson(doc, command.payload);
+    String requestId;
+    return CommandCoalescer::getInstance().submit(command, requestId) != CommandCoalescer::FAILED;
 }
 
 bool CommandSender::sendActionCommand(const String& action, JsonObject& params) {
@@ -282,9 +439,11 @@ bool CommandSender::sendActionCommand(const String& action, JsonObject& params)
     
     logger->info("CMD: Sending action command: " + action);
     
-    String payload;
-    serializeJson(doc, payload);
-    return mqttClient->publish(topic, payload);
+    CommandCoalescer::Command command;
+    command.topic = topic;
+    serializeJson(doc, command.payload);
+    String requestId;
+    return CommandCoalescer::getInstance().submit(command, requestId) != CommandCoalescer::FAILED;
 }
 
 // sendDisplayStatus removed - status is now handled by MQTTClient
@@ -7,6 +7,10 @@
 #include "NavButton.h"
 #include "ui/ScreenManager.h"
 #include "core/Logger.h"
+#include "utils/StringPool.h"
+#include "utils/CommandTracer.h"
+#include "commands/CommandAckTracker.h"
+#include "models/DeviceModels.h"
 
 extern Logger* logger;
 
@@ -53,10 +57,17 @@ String ButtonStateManager::makeButtonId(NavButton* button) {
     String id = "";
     
     switch (button->getButtonType()) {
-        case NavButton::TYPE_RELAY:
-            // Para relés: board_id:channel
-            id = button->getDeviceId() + ":" + String(button->getChannel());
+        case NavButton::TYPE_RELAY: {
+            // Para relés: uuid:channel, a mesma chave do eco (autocore/devices/{uuid}/relays/status)
+            // e das confirmações de comando; "relay_board_N" da config é resolvido pelo registry
+            String device = button->getDeviceId();
+            if (device.startsWith("relay_board_")) {
+                const char* uuid = DeviceRegistry::getInstance()->resolveRelayBoardToUuid(device.substring(12).toInt());
+                if (uuid && *uuid) device = uuid;
+            }
+            id = device + ":" + String(button->getChannel());
             break;
+        }
             
         case NavButton::TYPE_MODE:
             // Para modos: mode:value
@@ -87,26 +98,39 @@ void ButtonStateManager::registerButton(NavButton* button) {
     String buttonId = makeButtonId(button);
     if (buttonId.isEmpty()) return;
     
-    buttonCallbacks[buttonId] = button;
+    const char* key = StringPool::getInstance().intern(buttonId);
+    buttonCallbacks[key] = button;
     logger->debug("Botão registrado: " + buttonId);
     
     // Se já temos estado para este botão, atualizar imediatamente
-    if (buttonStates.find(buttonId) != buttonStates.end()) {
-        notifyButton(buttonId);
+    if (buttonStates.find(key) != buttonStates.end()) {
+        notifyButton(key);
     }
 }
 
 void ButtonStateManager::unregisterButton(const String& buttonId) {
-    buttonCallbacks.erase(buttonId);
+    const char* key = StringPool::getInstance().find(buttonId);
+    if (key) buttonCallbacks.erase(key);
     logger->debug("Botão removido: " + buttonId);
 }
 
+void ButtonStateManager::unregisterButton(NavButton* button) {
+    for (auto it = buttonCallbacks.begin(); it != buttonCallbacks.end(); ) {
+        if (it->second == button) {
+            it = buttonCallbacks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 void ButtonStateManager::processRelayStatus(const String& boardId, int channel, 
-                                           const String& state, const String& source) {
+                                           const String& state, const String& source,
+                                           const StatusStamp& stamp) {
     String buttonId = boardId + ":" + String(channel);
     bool active = (state == "ON");
     
-    updateButtonState(buttonId, active, state, source);
+    updateButtonState(buttonId, active, state, source, stamp);
 }
 
 void ButtonStateManager::processModeStatus(const String& mode, bool active, const String& source) {
@@ -124,65 +148,152 @@ void ButtonStateManager::processGenericStatus(const String& buttonId, bool activ
     updateButtonState(buttonId, active, value, source);
 }
 
+void ButtonStateManager::beginPending(NavButton* button, bool active, const String& requestId) {
+    String buttonId = makeButtonId(button);
+    if (buttonId.isEmpty()) return;
+    
+    const char* key = StringPool::getInstance().intern(buttonId);
+    buttonCallbacks[key] = button;
+    
+    ButtonState& state = buttonStates[key];
+    if (state.lastUpdate == 0 && !state.pending) {
+        // Placa nunca reportou: o que estava na tela é a referência do rollback
+        state.isActive = button->getState();
+    }
+    
+    // Toggle repetido antes do eco: o pedido mais recente é o que vale
+    state.pending = true;
+    state.pendingActive = active;
+    state.pendingRequest = requestId;
+    
+    button->setCommandFailed(false);
+    notifyButton(key);
+}
+
+void ButtonStateManager::processCommandResult(const char* key, const char* requestId, bool success) {
+    auto stateIt = buttonStates.find(key);
+    bool ours = stateIt != buttonStates.end() && stateIt->second.pending && requestId &&
+                stateIt->second.pendingRequest == requestId;
+    
+    if (!ours) {
+        // Pedido já substituído ou resolvido pelo eco: a tela mostra outro
+        staleResults++;
+        logger->debug("Resultado antigo ignorado para " + String(key) + " (" + String(requestId ? requestId : "") + ")");
+        return;
+    }
+    
+    ButtonState& state = stateIt->second;
+    if (success) {
+        // Confirmação antes do eco: a placa executou o pedido
+        state.isActive = state.pendingActive;
+        state.lastUpdate = millis();
+    }
+    state.pending = false;
+    state.pendingRequest = String();
+    
+    auto it = buttonCallbacks.find(key);
+    if (it == buttonCallbacks.end() || !it->second) return;
+    
+    it->second->setCommandFailed(!success);
+    
+    if (!success) {
+        logger->warning("Comando do botão " + String(key) + " não confirmado pela placa");
+    }
+    
+    // Estado exibido passa a ser o confirmado (rollback em falha)
+    notifyButton(key);
+}
+
 void ButtonStateManager::updateButtonState(const String& buttonId, bool active, 
-                                          const String& value, const String& source) {
+                                          const String& value, const String& source,
+                                          const StatusStamp& stamp) {
+    StringPool& pool = StringPool::getInstance();
+    const char* key = pool.intern(buttonId);
+    const char* internedValue = pool.intern(value);
+    
     // Atualizar estado
-    ButtonState& state = buttonStates[buttonId];
+    ButtonState& state = buttonStates[key];
+    
+    // Eco repetido ou atrasado (mesmo boot da placa, seq já aplicada): descartar
+    if (stamp.sequence && state.sequence && stamp.boot == state.boot &&
+        (int32_t)(stamp.sequence - state.sequence) <= 0) {
+        logger->debug("Status antigo ignorado para " + buttonId + " (seq " + String(stamp.sequence) +
+                      " <= " + String(state.sequence) + ")");
+        return;
+    }
     
-    // Verificar se mudou
-    bool changed = (state.isActive != active) || (state.currentValue != value);
+    bool shownBefore = state.shownActive();
+    bool pendingBefore = state.pending;
+    
+    // Verificar se mudou (valores internados: igualdade de ponteiro)
+    bool valueChanged = (state.isActive != active) || (state.currentValue != internedValue);
     
     state.isActive = active;
-    state.currentValue = value;
+    state.currentValue = internedValue;
     state.lastUpdate = millis();
-    state.lastSource = source;
+    state.lastSource = pool.intern(source);
+    if (stamp.sequence) {
+        state.boot = stamp.boot;
+        state.sequence = stamp.sequence;
+    }
+    
+    // Eco do nosso comando pendente: o estado da placa passa a ser o exibido.
+    // Eco de outro display só muda o confirmado (base do rollback)
+    if (state.pending && stamp.requestId && state.pendingRequest == stamp.requestId) {
+        state.pending = false;
+        state.pendingRequest = String();
+    }
+    
+    bool changed = valueChanged || shownBefore != state.shownActive() || pendingBefore != state.pending;
     
     if (changed) {
         logger->info("Estado do botão " + buttonId + " atualizado: " + 
                     (active ? "ATIVO" : "INATIVO") + " (" + source + ")");
         
         // Notificar botão se registrado
-        notifyButton(buttonId);
+        notifyButton(key);
     }
 }
 
-void ButtonStateManager::notifyButton(const String& buttonId) {
-    auto it = buttonCallbacks.find(buttonId);
+void ButtonStateManager::notifyButton(const char* key) {
+    auto it = buttonCallbacks.find(key);
     if (it != buttonCallbacks.end() && it->second) {
         NavButton* button = it->second;
-        ButtonState& state = buttonStates[buttonId];
+        ButtonState& state = buttonStates[key];
         
-        // Atualizar estado visual do botão
-        button->setState(state.isActive);
+        // Atualizar estado visual do botão (pendente mostra o pedido)
+        button->setState(state.shownActive());
+        button->setPending(state.pending);
         
-        logger->debug("Botão " + buttonId + " notificado");
+        logger->debug("Botão " + String(key) + " notificado");
     }
 }
 
 ButtonState ButtonStateManager::getButtonState(const String& buttonId) {
-    auto it = buttonStates.find(buttonId);
+    // find() não insere: ids nunca vistos não crescem o pool
+    const char* key = StringPool::getInstance().find(buttonId);
+    auto it = key ? buttonStates.find(key) : buttonStates.end();
     if (it != buttonStates.end()) {
         return it->second;
     }
     
     // Retornar estado padrão
-    ButtonState defaultState;
-    defaultState.isActive = false;
-    defaultState.currentValue = "";
-    defaultState.lastUpdate = 0;
-    defaultState.lastSource = "";
-    return defaultState;
+    return ButtonState();
 }
 
 bool ButtonStateManager::isButtonActive(const String& buttonId) {
-    auto it = buttonStates.find(buttonId);
+    const char* key = StringPool::getInstance().find(buttonId);
+    auto it = key ? buttonStates.find(key) : buttonStates.end();
     if (it != buttonStates.end()) {
         return it->second.isActive;
     }
     return false;
 }
 
-void ButtonStateManager::handleMQTTMessage(const String& topic, JsonDocument& payload) {
+void ButtonStateManager::handleMQTTMessage(const String& topic, JsonDocument& payload, uint32_t receivedUs) {
+    // Passagem rede -> UI entra no estágio "ui" do rastreio
+    uint32_t echoUs = receivedUs ? receivedUs : micros();
+    
     // Parse do tópico para determinar tipo
     if (topic.indexOf("/relays/") > 0 && topic.endsWith("/status")) {
         // Status de relé específico: autocore/devices/{uuid}/relays/status
@@ -193,9 +304,23 @@ void ButtonStateManager::handleMQTTMessage(const String& topic, JsonDocument& pa
         // Extraír informações do payload (agora contém canal/relé)
         int channel = payload["channel"] | payload["relay_id"] | 0;
         String state = payload["state"].as<String>();
-        String source = payload["device_id"] | payload["source"] | "unknown";
+        String source = payload["source"] | payload["device_id"] | "unknown";
+        
+        const char* traceId = payload["trace_id"];
+        StatusStamp stamp;
+        stamp.requestId = traceId;
+        stamp.boot = payload["boot"] | 0u;
+        stamp.sequence = payload["seq"] | 0u;
+        processRelayStatus(deviceId, channel, state, source, stamp);
         
-        processRelayStatus(deviceId, channel, state, source);
+        // Eco de comando rastreado: fecha com o estado já aplicado no botão
+        if (traceId) {
+            CommandTracer::RelayTiming relay = {payload["relay_total_us"] | 0u, payload["relay_exec_us"] | 0u};
+            CommandTracer::getInstance().complete(traceId, echoUs, relay);
+            
+            // Eco também confirma o comando (placas sem /response)
+            CommandAckTracker::getInstance().acknowledge(traceId, true);
+        }
         
     } else if (topic.indexOf("/4x4_controller/status") > 0) {
         // Status de modo 4x4
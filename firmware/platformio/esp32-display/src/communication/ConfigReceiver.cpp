@@ -6,7 +6,7 @@
  * - Carregamento primário via API HTTP
  * - Fallback automático para MQTT se API falhar
  * - Hot-reload via MQTT mantido
- * - Cache e retry automáticos
+ * - Cache; retry e backoff ficam com o chamador (AsyncFetch)
  */
 
 #include "communication/ConfigReceiver.h"
@@ -20,7 +20,8 @@ ConfigReceiver* ConfigReceiver::instance = nullptr;
 
 ConfigReceiver::ConfigReceiver(MQTTClient* mqtt, ConfigManager* config, ScreenApiClient* api) 
     : mqttClient(mqtt), configManager(config), apiClient(api),
-      useApi(false), configReceived(false), onConfigUpdateCallback(nullptr) {
+      useApi(false), configReceived(false), mqttRequestedAt(0),
+      onConfigUpdateCallback(nullptr), onReloadRequested(nullptr) {
     
     instance = this;
     
@@ -81,48 +82,48 @@ bool ConfigReceiver::loadFromApi() {
     
     JsonDocument config;
     
-    // Tentar carregar da API com retries automáticos
-    for (int attempt = 1; attempt <= API_RETRY_COUNT; attempt++) {
-        if (apiClient->loadConfiguration(config)) {
-            // Converter para string para o ConfigManager
-            String configStr;
-            serializeJson(config, configStr);
-            
-            if (configManager->loadConfig(configStr)) {
-                if (logger) {
-                    logger->info("ConfigReceiver: Configuration loaded from API on attempt " + String(attempt));
-                }
-                configReceived = true;
-                
-                // Enviar acknowledgment via MQTT
-                sendConfigAck("api", "success");
-                return true;
-            } else {
-                if (logger) {
-                    logger->error("ConfigReceiver: ConfigManager rejected API config");
-                }
+    // Versão já em memória (ex.: boot pela última config boa): um 304 basta
+    ConfigSnapshot current = configManager->snapshot();
+    String activeVersion = current ? (current->doc["etag"] | "") : "";
+    apiClient->setActiveVersion(activeVersion);
+    
+    // Uma tentativa: nova tentativa e backoff são do chamador (AsyncFetch)
+    if (apiClient->loadConfiguration(config)) {
+        if (apiClient->wasNotModified() && config.isNull()) {
+            if (logger) {
+                logger->info("ConfigReceiver: Configuration unchanged (" + activeVersion + ")");
             }
+            configReceived = true;
+            sendConfigAck("api", "not_modified");
+            return true;
         }
         
-        if (logger) {
-            logger->warning("ConfigReceiver: API attempt " + String(attempt) + " failed: " + apiClient->getLastError());
+        // O documento parseado do stream vai direto para o ConfigManager
+        if (configManager->adoptConfig(config)) {
+            if (logger) {
+                logger->info("ConfigReceiver: Configuration loaded from API");
+            }
+            configReceived = true;
+            
+            // Enviar acknowledgment via MQTT
+            sendConfigAck("api", "success");
+            return true;
         }
         
-        if (attempt < API_RETRY_COUNT) {
-            delay(API_RETRY_DELAY * attempt); // Exponential backoff
+        if (logger) {
+            logger->error("ConfigReceiver: ConfigManager rejected API config");
         }
     }
     
-    // API falhou completamente
     if (logger) {
-        logger->error("ConfigReceiver: API failed after " + String(API_RETRY_COUNT) + " attempts");
+        logger->warning("ConfigReceiver: API request failed: " + apiClient->getLastError());
     }
     
     sendConfigAck("api", "failed");
     return false;
 }
 
-bool ConfigReceiver::loadFromMqtt() {
+void ConfigReceiver::beginMqttRequest() {
     if (logger) {
         logger->info("ConfigReceiver: Loading configuration from MQTT fallback...");
     }
@@ -130,46 +131,71 @@ bool ConfigReceiver::loadFromMqtt() {
     // Reset state
     configReceived = false;
     
-    // Subscribe to legacy MQTT config topics  
+    // Subscribe temporariamente (legacy MQTT config topics)
     String deviceId = mqttClient->getDeviceId();
-    String configTopic = "autocore/" + deviceId + "/config";
-    String requestTopic = "autocore/gateway/config/request";
-    String responseTopic = "autocore/gateway/config/response";
+    mqttClient->subscribe("autocore/" + deviceId + "/config", 0, onConfigReceived);
+    mqttClient->subscribe("autocore/gateway/config/response", 0, onConfigReceived);
     
-    // Subscribe temporariamente
-    mqttClient->subscribe(configTopic, 0, onConfigReceived);
-    mqttClient->subscribe(responseTopic, 0, onConfigReceived);
-    
-    // Enviar request
+    // Enviar request; a resposta chega pelo callback, loadStep() acompanha
     requestConfigMqtt();
+    mqttRequestedAt = millis();
+    if (mqttRequestedAt == 0) mqttRequestedAt = 1;
+}
+
+void ConfigReceiver::cancelLoad() {
+    if (mqttRequestedAt == 0) return;
+    mqttRequestedAt = 0;
     
-    // Aguardar resposta com timeout
-    unsigned long startTime = millis();
-    unsigned long timeout = CONFIG_REQUEST_INTERVAL;
-    
-    while (!configReceived && (millis() - startTime) < timeout) {
-        delay(100);
-        // Permitir processing de outros tasks
-        yield();
+    // Cleanup subscriptions
+    mqttClient->unsubscribe("autocore/" + mqttClient->getDeviceId() + "/config");
+    mqttClient->unsubscribe("autocore/gateway/config/response");
+}
+
+AsyncFetch::Step ConfigReceiver::loadStep() {
+    // Pedido MQTT pendente: só consulta, nunca espera
+    if (mqttRequestedAt != 0) {
+        if (configReceived) {
+            cancelLoad();
+            if (logger) {
+                logger->info("ConfigReceiver: Configuration loaded from MQTT successfully");
+            }
+            sendConfigAck("mqtt", "success");
+            return AsyncFetch::DONE;
+        }
+        
+        if (millis() - mqttRequestedAt < CONFIG_REQUEST_INTERVAL) {
+            return AsyncFetch::PENDING;
+        }
+        
+        cancelLoad();
+        if (logger) {
+            logger->error("ConfigReceiver: MQTT configuration timeout after " + String(CONFIG_REQUEST_INTERVAL) + "ms");
+        }
+        sendConfigAck("mqtt", "timeout");
+        return AsyncFetch::RETRY;
     }
     
-    // Cleanup subscriptions
-    mqttClient->unsubscribe(configTopic);
-    mqttClient->unsubscribe(responseTopic);
+    if (logger) {
+        logger->info("ConfigReceiver: Starting configuration load sequence...");
+    }
     
-    if (configReceived) {
-        if (logger) {
-            logger->info("ConfigReceiver: Configuration loaded from MQTT successfully");
+    // Tentar API primeiro se disponível
+    if (useApi && apiClient) {
+        if (loadFromApi()) {
+            return AsyncFetch::DONE;
         }
-        sendConfigAck("mqtt", "success");
-        return true;
-    } else {
+        
         if (logger) {
-            logger->error("ConfigReceiver: MQTT configuration timeout after " + String(timeout) + "ms");
+            logger->warning("ConfigReceiver: API failed, trying MQTT fallback...");
         }
-        sendConfigAck("mqtt", "timeout");
-        return false;
     }
+    
+    // Fallback para MQTT
+    if (!mqttClient->isConnected()) {
+        return AsyncFetch::RETRY;
+    }
+    beginMqttRequest();
+    return AsyncFetch::PENDING;
 }
 
 void ConfigReceiver::requestConfigMqtt() {
@@ -205,32 +231,7 @@ void ConfigReceiver::requestConfigMqtt() {
 }
 
 bool ConfigReceiver::loadConfiguration() {
-    if (logger) {
-        logger->info("ConfigReceiver: Starting configuration load sequence...");
-    }
-    
-    // Tentar API primeiro se disponível
-    if (useApi && apiClient) {
-        if (loadFromApi()) {
-            return true;
-        }
-        
-        if (logger) {
-            logger->warning("ConfigReceiver: API failed, trying MQTT fallback...");
-        }
-    }
-    
-    // Fallback para MQTT
-    if (loadFromMqtt()) {
-        return true;
-    }
-    
-    // Ambos falharam
-    if (logger) {
-        logger->error("ConfigReceiver: Both API and MQTT failed to load configuration");
-    }
-    
-    return false;
+    return loadStep() == AsyncFetch::DONE;
 }
 
 bool ConfigReceiver::testApiConnection() {
@@ -344,8 +345,10 @@ void ConfigReceiver::handleConfigUpdate(const String& payload) {
                 logger->info("ConfigReceiver: Reload command received, reloading from primary source...");
             }
             
-            // Use the combined method to try API first, then MQTT
-            if (loadConfiguration() && onConfigUpdateCallback) {
+            // Carga em segundo plano: o callback MQTT não pode esperar HTTP/resposta
+            if (onReloadRequested) {
+                onReloadRequested();
+            } else if (loadConfiguration() && onConfigUpdateCallback) {
                 onConfigUpdateCallback();
             }
             
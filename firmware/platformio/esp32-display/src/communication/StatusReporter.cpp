@@ -9,13 +9,27 @@
 #include "config/DeviceConfig.h"
 #include "utils/DeviceUtils.h"
 #include <ArduinoJson.h>
+#include "display/DisplayPipeline.h"
+#include "display/RenderProfiler.h"
+#include "utils/StringPool.h"
+#include "utils/MemoryMonitor.h"
+#include "utils/CommandTracer.h"
+#include "commands/CommandAckTracker.h"
+#include "commands/CommandCoalescer.h"
+#include "core/Scheduler.h"
+#include "core/TaskTopology.h"
+#include "network/HttpSession.h"
+#include "runtime_stats.h"
 #include <WiFi.h>
 
 extern Logger* logger;
+extern DisplayPipeline* displayPipeline;
+extern RenderProfiler* renderProfiler;
 
 StatusReporter::StatusReporter(MQTTClient* mqtt, const String& id) 
     : mqttClient(mqtt), deviceId(id), bootTime(millis()), 
-      lastHealthStatus(0), lastOperationalStatus(0), lastPerformanceTelemetry(0),
+      lastHealthStatus(0), lastOperationalStatus(0), lastPerformanceTelemetry(0), lastRenderProfile(0),
+      lastLatencyProfile(0),
       touchCounter(0), buttonPressCounter(0), screenViewCounter(0), errorCounter(0),
       currentScreen("home"), backlight(DEFAULT_BACKLIGHT) {
     
@@ -27,22 +41,30 @@ StatusReporter::StatusReporter(MQTTClient* mqtt, const String& id)
 // ============================================================================
 
 void StatusReporter::publishHealthStatus() {
-    // Health Status - Published every 30 seconds
+    // Health Status - janela do runtime_stats fechada pelo job "runtime_stats"
     unsigned long now = millis();
-    if (now - lastHealthStatus < 30000) return; // 30 seconds interval
+    if (now - lastHealthStatus < RUNTIME_STATS_INTERVAL) return;
     
     // V2.2.0: Usar UUID completo nos tópicos
     String topic = "autocore/devices/" + deviceId + "/status/health";
     
+    // Buffer fixo: o JSON do coletor entra cru no documento
+    static char runtimeJson[RUNTIME_STATS_JSON_SIZE];
+    
     StaticJsonDocument<512> doc;
     doc["status"] = "healthy";
     doc["uptime"] = (millis() - bootTime) / 1000;
     doc["free_heap"] = ESP.getFreeHeap();
     doc["min_free_heap"] = ESP.getMinFreeHeap();
-    doc["cpu_usage"] = getCpuUsage();
-    doc["temperature"] = 45.2; // TODO: Read from sensor if available
+    int cpu = runtime_stats_cpu_pct();
+    if (cpu != RUNTIME_STATS_UNKNOWN) {
+        doc["cpu_usage"] = cpu;     // Média dos cores na janela
+    }
     doc["wifi_rssi"] = WiFi.RSSI();
-    doc["mqtt_queue"] = 0; // TODO: Get from MQTT client
+    doc["mqtt_queue"] = Scheduler::network().getPendingMessages();  // Publishes esperando a tarefa de rede
+    if (runtime_stats_to_json(runtimeJson, sizeof(runtimeJson)) > 0) {
+        doc["runtime"] = serialized((const char*)runtimeJson);
+    }
     doc["last_config_update"] = lastConfigUpdate;
     doc["timestamp"] = MQTTProtocol::getTimestamp();
     doc["protocol_version"] = PROTOCOL_VERSION;
@@ -102,7 +124,7 @@ void StatusReporter::publishOperationalStatus() {
 void StatusReporter::publishPerformanceTelemetry() {
     // Performance Telemetry - Published every 60 seconds
     unsigned long now = millis();
-    if (now - lastPerformanceTelemetry < 60000) return; // 60 seconds interval
+    if (now - lastPerformanceTelemetry < PERFORMANCE_TELEMETRY_INTERVAL) return;
     
     // V2.2.0: Usar UUID completo nos tópicos
     String topic = "autocore/devices/" + deviceId + "/telemetry/performance";
@@ -127,10 +149,32 @@ void StatusReporter::publishPerformanceTelemetry() {
     config["last_reload"] = lastConfigUpdate;
     
     JsonObject memory = metrics.createNestedObject("memory");
-    memory["heap_fragmentation"] = 100 - (100 * ESP.getFreeHeap() / ESP.getHeapSize());
-    memory["max_block_size"] = ESP.getMaxAllocHeap();
+    MemoryMonitor::getInstance().toJson(memory);
+    memory["max_block_size"] = MemoryMonitor::getInstance().getSnapshot().largestBlock; // Compatibilidade
     memory["allocations_failed"] = 0; // TODO: Track failed allocations
     
+    if (displayPipeline) {
+        const DisplayStats& ds = displayPipeline->getStats();
+        JsonObject display = metrics.createNestedObject("display");
+        display["fps"] = ds.fps;
+        display["frames"] = ds.frames;
+        display["frame_ms"] = ds.lastFrameMs;
+        display["max_frame_ms"] = ds.maxFrameMs;
+        display["flushes"] = ds.flushes;
+        display["avg_flush_us"] = ds.avgFlushUs;
+        display["max_flush_us"] = ds.maxFlushUs;
+        display["render_stalls"] = ds.renderStalls;
+        display["lost_flushes"] = ds.lostFlushes;
+        display["transport"] = displayPipeline->getTransport()->getName();
+    }
+    
+    StringPool::getInstance().toJson(metrics.createNestedObject("string_pool"));
+    JsonObject scheduler = metrics.createNestedObject("scheduler");
+    Scheduler::ui().toJson(scheduler.createNestedObject("ui"));
+    Scheduler::network().toJson(scheduler.createNestedObject("network"));
+    TaskTopology::getInstance().toJson(metrics.createNestedArray("tasks"));
+    HttpSession::getInstance().toJson(metrics.createNestedObject("http"));
+    
     doc["timestamp"] = MQTTProtocol::getTimestamp();
     doc["protocol_version"] = PROTOCOL_VERSION;
     doc["device_id"] = deviceId;
@@ -244,38 +288,103 @@ void StatusReporter::reportScreenChange(const String& fromScreen, const String&
     screenViewCounter++;
 }
 
+void StatusReporter::publishRenderProfile() {
+    // Render Profile - Resumo da janela e reinício dos histogramas
+    unsigned long now = millis();
+    if (!renderProfiler || now - lastRenderProfile < RENDER_PROFILE_INTERVAL) return;
+    
+    String topic = "autocore/devices/" + deviceId + "/telemetry/render";
+    
+    JsonDocument doc;
+    renderProfiler->toJson(doc["render"].to<JsonObject>());
+    
+    doc["timestamp"] = MQTTProtocol::getTimestamp();
+    doc["protocol_version"] = PROTOCOL_VERSION;
+    doc["device_id"] = deviceId;
+    
+    String payload;
+    serializeJson(doc, payload);
+    
+    mqttClient->publish(topic, payload, false, 0); // QoS 0, no retain
+    
+    renderProfiler->reset();
+    lastRenderProfile = now;
+    logger->debug("Render profile published");
+}
+
+void StatusReporter::publishLatencyProfile() {
+    // Latency Profile - Histogramas por estágio dos comandos rastreados na janela
+    unsigned long now = millis();
+    if (now - lastLatencyProfile < LATENCY_PROFILE_INTERVAL) return;
+    lastLatencyProfile = now;
+    
+    CommandTracer& tracer = CommandTracer::getInstance();
+    CommandAckTracker& acks = CommandAckTracker::getInstance();
+    bool ackActivity = acks.getAcked() || acks.getRejected() || acks.getTimedOut();
+    if (tracer.getCompleted() == 0 && tracer.getLost() == 0 && !ackActivity) return;
+    
+    String topic = "autocore/devices/" + deviceId + "/telemetry/latency";
+    
+    JsonDocument doc;
+    tracer.toJson(doc["commands"].to<JsonObject>());
+    acks.toJson(doc["acks"].to<JsonObject>());
+    CommandCoalescer::getInstance().toJson(doc["queue"].to<JsonObject>());
+    
+    doc["timestamp"] = MQTTProtocol::getTimestamp();
+    doc["protocol_version"] = PROTOCOL_VERSION;
+    doc["device_id"] = deviceId;
+    
+    String payload;
+    serializeJson(doc, payload);
+    
+    mqttClient->publish(topic, payload, false, 0); // QoS 0, no retain
+    
+    tracer.reset();
+    acks.reset();
+    CommandCoalescer::getInstance().reset();
+    logger->debug("Latency profile published");
+}
+
+void StatusReporter::publishMemoryWarning(const MemoryMonitor::Snapshot& snapshot, uint8_t reasons) {
+    // Memory Warning - Publicado na hora, quando o MemoryMonitor detecta condição nova
+    String topic = "autocore/devices/" + deviceId + "/telemetry/memory";
+    
+    const MemoryMonitor& monitor = MemoryMonitor::getInstance();
+    
+    JsonDocument doc;
+    doc["event"] = "memory_warning";
+    monitor.reasonsToJson(doc["reasons"].to<JsonArray>(), reasons);
+    monitor.toJson(doc["memory"].to<JsonObject>());
+    
+    doc["timestamp"] = MQTTProtocol::getTimestamp();
+    doc["protocol_version"] = PROTOCOL_VERSION;
+    doc["device_id"] = deviceId;
+    
+    String payload;
+    serializeJson(doc, payload);
+    
+    mqttClient->publish(topic, payload, false, 0); // QoS 0, no retain
+    
+    logger->warning("Memory warning published (largest block: " + String(snapshot.largestBlock) + " bytes)");
+}
+
 // ============================================================================
 // PERIODIC UPDATE METHOD
 // ============================================================================
 
 void StatusReporter::update() {
     // This method should be called from main loop
-    publishHealthStatus();       // Every 30 seconds
+    publishHealthStatus();       // Every RUNTIME_STATS_INTERVAL
     publishOperationalStatus();  // Every 10 seconds
     publishPerformanceTelemetry(); // Every 60 seconds
+    publishRenderProfile();        // Every RENDER_PROFILE_INTERVAL
+    publishLatencyProfile();       // Every LATENCY_PROFILE_INTERVAL
 }
 
 // ============================================================================
 // HELPER METHODS
 // ============================================================================
 
-float StatusReporter::getCpuUsage() {
-    static unsigned long lastCheck = 0;
-    static unsigned long lastIdleTime = 0;
-    
-    unsigned long now = millis();
-    unsigned long elapsed = now - lastCheck;
-    
-    if (elapsed > 1000) {
-        float usage = 100.0 - ((float)lastIdleTime / elapsed * 100.0);
-        lastCheck = now;
-        lastIdleTime = 0;
-        return usage;
-    }
-    
-    return 25.5; // Default value
-}
-
 void StatusReporter::updateConfig(unsigned long timestamp) {
     lastConfigUpdate = timestamp;
     configReloadCount++;
@@ -0,0 +1,119 @@
+/**
+ * @file AsyncFetch.cpp
+ * @brief Tentativas e backoff como job da tarefa de rede
+ */
+
+#include "core/AsyncFetch.h"
+#include "core/Logger.h"
+
+extern Logger* logger;
+
+AsyncFetch::AsyncFetch(const char* name, uint8_t maxAttempts)
+    : name(name), maxAttempts(maxAttempts > 0 ? maxAttempts : 1) {
+}
+
+AsyncFetch::~AsyncFetch() {
+    if (job != Scheduler::INVALID_JOB) {
+        Scheduler::network().cancel(job);
+    }
+}
+
+void AsyncFetch::start(StepFunction fn, Completion cb) {
+    Scheduler::network().dispatch([this, fn, cb]() {
+        if (isActive()) return;
+
+        step = fn;
+        done = cb;
+        attempt = 1;
+        retryAt = 0;
+        state = RUNNING;
+
+        // Job criado na primeira vez, já na tarefa de rede; depois só reagendado
+        Scheduler& net = Scheduler::network();
+        if (job == Scheduler::INVALID_JOB) {
+            job = net.every(name, ASYNC_FETCH_POLL, [this]() { run(); });
+        } else {
+            net.reschedule(job, 0);
+        }
+    });
+}
+
+void AsyncFetch::cancel() {
+    Scheduler::network().dispatch([this]() {
+        if (!isActive()) return;
+        if (logger) logger->info("AsyncFetch " + String(name) + ": cancelled");
+        finish(CANCELLED);
+    });
+}
+
+uint32_t AsyncFetch::getRetryIn() const {
+    if (state != BACKOFF) return 0;
+    int32_t left = (int32_t)(retryAt - millis());
+    return left > 0 ? (uint32_t)left : 0;
+}
+
+uint32_t AsyncFetch::backoffDelay(uint8_t failedAttempt) {
+    uint32_t delayMs = API_RETRY_DELAY;
+    for (uint8_t i = 1; i < failedAttempt && delayMs < API_RETRY_MAX_DELAY; i++) {
+        delayMs *= 2;
+    }
+    return min<uint32_t>(delayMs, API_RETRY_MAX_DELAY);
+}
+
+void AsyncFetch::run() {
+    Scheduler& net = Scheduler::network();
+    if (!isActive() || !step) {
+        net.pause(job);
+        return;
+    }
+
+    state = RUNNING;
+    retryAt = 0;
+
+    // Cópia: o passo pode chamar cancel(), que limpa step
+    StepFunction current = step;
+    Step result = current();
+    if (!isActive()) return;
+
+    if (result == DONE) {
+        finish(SUCCEEDED);
+        return;
+    }
+    if (result == PENDING) {
+        net.reschedule(job, ASYNC_FETCH_POLL);
+        return;
+    }
+
+    if (attempt >= maxAttempts) {
+        if (logger) logger->warning("AsyncFetch " + String(name) + ": failed after " + String(attempt) + " attempts");
+        finish(FAILED);
+        return;
+    }
+
+    // Sem delay(): o job só volta a rodar no fim do backoff
+    uint32_t wait = backoffDelay(attempt);
+    if (logger) {
+        logger->warning("AsyncFetch " + String(name) + ": attempt " + String(attempt) + "/" + String(maxAttempts) +
+                        " failed, retrying in " + String(wait) + "ms");
+    }
+    attempt = attempt + 1;
+    retryAt = millis() + wait;
+    state = BACKOFF;
+    net.reschedule(job, wait);
+}
+
+void AsyncFetch::finish(State result) {
+    state = result;
+    retryAt = 0;
+    Scheduler::network().pause(job);
+
+    // Libera o que as lambdas capturaram até o próximo start()
+    step = nullptr;
+    Completion cb = done;
+    done = nullptr;
+
+    if (cb) {
+        bool ok = result == SUCCEEDED;
+        Scheduler::ui().dispatch([cb, ok]() { cb(ok); });
+    }
+}
@@ -5,24 +5,31 @@
 
 #include "core/ConfigManager.h"
 #include "core/Logger.h"
+#include "utils/MemoryMonitor.h"
+#include "utils/StringUtils.h"
 #include <vector>
 
 extern Logger* logger;
 
-ConfigManager::ConfigManager() : hasValidConfig(false), lastUpdate(0) {
-    // Initialize with empty config
-    config.clear();
+ConfigData::~ConfigData() {
+    // Último leitor soltou o snapshot: o documento sai da conta agora
+    if (trackedBytes) {
+        MemoryMonitor::onFree(MEM_CONFIG, trackedBytes);
+    }
+}
+
+ConfigManager::ConfigManager() : hasValidConfig(false), contentHash(0), lastUpdate(0) {
 }
 
 bool ConfigManager::loadConfig(const String& jsonStr) {
     logger->info("Loading new configuration...");
     logger->info("JSON string length: " + String(jsonStr.length()));
     
-    // Clear existing config
-    config.clear();
+    // Documento novo à parte: o snapshot atual segue válido para quem o lê
+    std::shared_ptr<ConfigData> next = std::make_shared<ConfigData>();
     
     // Parse JSON
-    DeserializationError error = deserializeJson(config, jsonStr);
+    DeserializationError error = deserializeJson(next->doc, jsonStr);
     
     if (error) {
         logger->error("Failed to parse config: " + String(error.c_str()));
@@ -30,67 +37,144 @@ bool ConfigManager::loadConfig(const String& jsonStr) {
         return false;
     }
     
-    logger->info("Config parsed successfully, document size: " + String(config.size()));
-    logger->info("Memory usage: " + String(config.memoryUsage()) + " bytes");
+    logger->info("Config parsed successfully, document size: " + String(next->doc.size()));
+    logger->info("Memory usage: " + String(next->doc.memoryUsage()) + " bytes");
     
     // Validate configuration
-    if (!validateConfig(config)) {
+    if (!validateConfig(next->doc)) {
         logger->error("Invalid configuration structure");
-        config.clear();
         return false;
     }
     
+    publish(next);
+    return true;
+}
+
+bool ConfigManager::adoptConfig(JsonDocument& doc) {
+    logger->info("Adopting new configuration...");
+    
+    if (!validateConfig(doc)) {
+        logger->error("Invalid configuration structure");
+        return false;
+    }
+    
+    // Move o pool do documento: nenhuma cópia da config é criada
+    std::shared_ptr<ConfigData> next = std::make_shared<ConfigData>();
+    next->doc = std::move(doc);
+    publish(next);
+    return true;
+}
+
+void ConfigManager::publish(std::shared_ptr<ConfigData> next) {
+    JsonDocument& config = next->doc;
+    normalizeConfig(config);
+    
     // Extract version
     if (config["version"].is<JsonVariant>()) {
-        configVersion = config["version"].as<String>();
+        next->version = config["version"].as<String>();
     } else {
-        configVersion = "1.0.0";
+        next->version = "1.0.0";
     }
     
+    // Forma canônica: mesma config => mesmo hash, venha de string, stream ou flash
+    HashWriter writer;
+    serializeJson(config, writer);
+    next->hash = writer.value();
+    
+    // Aproximação: o documento guarda cópias das strings do JSON
+    next->trackedBytes = writer.size();
+    MemoryMonitor::onAlloc(MEM_CONFIG, next->trackedBytes);
+    
+    // Troca atômica; o snapshot anterior morre com o último handle
+    std::atomic_store(&current, ConfigSnapshot(std::move(next)));
+    contentHash = writer.value();
     hasValidConfig = true;
     lastUpdate = millis();
     
-    logger->info("Configuration loaded successfully. Version: " + configVersion);
+    logger->info("Configuration loaded successfully. Version: " + getVersion());
     
     // Notify change
     if (onChangeCallback) {
         onChangeCallback();
     }
-    
-    return true;
 }
 
-JsonArray ConfigManager::getScreens() {
-    if (!hasValidConfig) {
-        return JsonArray();
+void ConfigManager::normalizeConfig(JsonDocument& config) {
+    // ADAPTADOR: itens no formato antigo (type=relay/navigation/action/preset)
+    // viram o formato da API aqui, uma vez, e não a cada render da página
+    for (JsonObject screen : config["screens"].as<JsonArray>()) {
+        JsonArray items = screen["items"].is<JsonArray>() ? screen["items"].as<JsonArray>()
+                                                          : screen["screen_items"].as<JsonArray>();
+        for (JsonObject item : items) {
+            if (!item["type"].is<JsonVariant>()) continue;
+            String oldType = item["type"].as<String>();
+            
+            if (oldType == "relay") {
+                item["item_type"] = "button";
+                item["action_type"] = "relay_control";
+                
+                // Converter device para relay_board_id (relay_board_1 → 1)
+                if (item["device"].is<JsonVariant>()) {
+                    String device = item["device"].as<String>();
+                    if (device.startsWith("relay_board_")) {
+                        item["relay_board_id"] = device.substring(12).toInt();
+                    }
+                }
+                
+                // Converter channel para relay_channel_id
+                if (item["channel"].is<JsonVariant>()) {
+                    item["relay_channel_id"] = item["channel"].as<int>();
+                }
+                
+                // Converter mode para action_payload
+                if (item["mode"].is<JsonVariant>()) {
+                    String mode = item["mode"].as<String>();
+                    JsonObject payload = item["action_payload"].to<JsonObject>();
+                    payload["momentary"] = (mode == "momentary");
+                }
+            } else if (oldType == "navigation") {
+                item["item_type"] = "button";
+                item["action_type"] = "navigation";
+            } else if (oldType == "action" || oldType == "preset") {
+                item["item_type"] = "button";
+                item["action_type"] = (oldType == "preset") ? "macro" : "command";
+            } else {
+                continue;
+            }
+            
+            // Converter id para name se necessário
+            if (item["id"].is<JsonVariant>() && !item["name"].is<JsonVariant>()) {
+                item["name"] = item["id"].as<String>();
+            }
+            
+            logger->info("[ADAPTER] Converted old " + oldType + " format to new API format for: " + item["label"].as<String>());
+        }
     }
-    
+}
+
+JsonArrayConst ConfigManager::getScreens(const JsonDocument& config) {
     // New hierarchical format: screens is already an array
-    if (config["screens"].is<JsonArray>()) {
-        return config["screens"].as<JsonArray>();
+    if (config["screens"].is<JsonArrayConst>()) {
+        return config["screens"].as<JsonArrayConst>();
     }
     
     // Legacy object format: convert to array
-    if (config["screens"].is<JsonObject>()) {
+    if (config["screens"].is<JsonObjectConst>()) {
         // This is the old format, we won't support it anymore
         logger->warning("Legacy screens object format detected");
     }
     
-    return JsonArray();
+    return JsonArrayConst();
 }
 
-JsonObject ConfigManager::getScreen(const String& screenId) {
-    if (!hasValidConfig || !config["screens"].is<JsonArray>()) {
-        return JsonObject();
-    }
-    
+JsonObjectConst ConfigManager::getScreen(const JsonDocument& config, const String& screenId) {
     // New format: screens is an array, match by id
-    JsonArray screens = config["screens"].as<JsonArray>();
+    JsonArrayConst screens = config["screens"].as<JsonArrayConst>();
     
     // If screenId is numeric, try to find by id
     int id = screenId.toInt();
     if (id > 0) {
-        for (JsonObject screen : screens) {
+        for (JsonObjectConst screen : screens) {
             if (screen["id"].as<int>() == id) {
                 return screen;
             }
@@ -99,31 +183,31 @@ JsonObject ConfigManager::getScreen(const String& screenId) {
     
     // If screenId is "home", return first screen (order_index = 0)
     if (screenId == "home") {
-        for (JsonObject screen : screens) {
+        for (JsonObjectConst screen : screens) {
             if (screen["order_index"].as<int>() == 0) {
                 return screen;
             }
         }
         // If no screen with order_index 0, return first screen
         if (screens.size() > 0) {
-            return screens[0].as<JsonObject>();
+            return screens[0].as<JsonObjectConst>();
         }
     }
     
-    return JsonObject(); // Return empty object if not found
+    return JsonObjectConst(); // Return empty object if not found
 }
 
 std::vector<String> ConfigManager::getScreenIds() {
     std::vector<String> ids;
     
-    if (!hasValidConfig || !config["screens"].is<JsonArray>()) {
+    ConfigSnapshot config = snapshot();
+    if (!config) {
         return ids;
     }
     
     // New format: screens is an array, collect ids as strings
-    JsonArray screens = config["screens"].as<JsonArray>();
-    for (JsonObject screen : screens) {
-        if (screen["id"].is<JsonVariant>()) {
+    for (JsonObjectConst screen : getScreens(config->doc)) {
+        if (screen["id"].is<JsonVariantConst>()) {
             ids.push_back(String(screen["id"].as<int>()));
         }
     }
@@ -132,14 +216,15 @@ std::vector<String> ConfigManager::getScreenIds() {
 }
 
 String ConfigManager::getFirstScreenId() {
-    if (!hasValidConfig || !config["screens"].is<JsonArray>()) {
+    ConfigSnapshot config = snapshot();
+    if (!config || !config->doc["screens"].is<JsonArrayConst>()) {
         return "2"; // Default to first screen id in our structure
     }
     
-    JsonArray screens = config["screens"].as<JsonArray>();
+    JsonArrayConst screens = config->doc["screens"].as<JsonArrayConst>();
     
     // Find screen with order_index = 0
-    for (JsonObject screen : screens) {
+    for (JsonObjectConst screen : screens) {
         if (screen["order_index"].as<int>() == 0) {
             return String(screen["id"].as<int>());
         }
@@ -153,32 +238,13 @@ String ConfigManager::getFirstScreenId() {
     return "2"; // Default
 }
 
-JsonObject ConfigManager::getTheme() {
-    if (!hasValidConfig || !config["theme"].is<JsonVariant>()) {
-        // Return default theme
-        JsonObject defaultTheme = config["theme"].to<JsonObject>();
-        defaultTheme["background"] = "#000000";
-        defaultTheme["text"] = "#FFFFFF";
-        defaultTheme["primary"] = "#0066CC";
-        defaultTheme["secondary"] = "#FF6600";
-        return defaultTheme;
-    }
-    
-    return config["theme"].as<JsonObject>();
+JsonObjectConst ConfigManager::getTheme(const JsonDocument& config) {
+    // Nulo se a config não trouxer tema: o chamador aplica o default (`| valor`)
+    return config["theme"].as<JsonObjectConst>();
 }
 
-JsonObject ConfigManager::getSettings() {
-    if (!hasValidConfig || !config["settings"].is<JsonVariant>()) {
-        // Return default settings
-        JsonObject defaultSettings = config["settings"].to<JsonObject>();
-        defaultSettings["language"] = "pt-BR";
-        defaultSettings["backlight"] = 100;
-        defaultSettings["auto_dim"] = true;
-        defaultSettings["button_sound"] = true;
-        return defaultSettings;
-    }
-    
-    return config["settings"].as<JsonObject>();
+JsonObjectConst ConfigManager::getSettings(const JsonDocument& config) {
+    return config["settings"].as<JsonObjectConst>();
 }
 
 bool ConfigManager::validateConfig(const JsonDocument& doc) {
@@ -193,12 +259,17 @@ bool ConfigManager::validateConfig(const JsonDocument& doc) {
     return true;
 }
 
+String ConfigManager::getVersion() const {
+    ConfigSnapshot config = snapshot();
+    return config ? config->version : String();
+}
+
 bool ConfigManager::isNewerVersion(const String& version) {
     // Simple version comparison (assumes format X.Y.Z)
     int currentMajor, currentMinor, currentPatch;
     int newMajor, newMinor, newPatch;
     
-    sscanf(configVersion.c_str(), "%d.%d.%d", &currentMajor, &currentMinor, &currentPatch);
+    sscanf(getVersion().c_str(), "%d.%d.%d", &currentMajor, &currentMinor, &currentPatch);
     sscanf(version.c_str(), "%d.%d.%d", &newMajor, &newMinor, &newPatch);
     
     if (newMajor > currentMajor) return true;
@@ -211,13 +282,14 @@ bool ConfigManager::isNewerVersion(const String& version) {
 }
 
 void ConfigManager::printConfig() {
-    if (!hasValidConfig) {
+    ConfigSnapshot config = snapshot();
+    if (!config) {
         logger->info("No valid configuration loaded");
         return;
     }
     
     String output;
-    serializeJsonPretty(config, output);
+    serializeJsonPretty(config->doc, output);
     
     logger->info("Current configuration:");
     
@@ -0,0 +1,76 @@
+/**
+ * @file ConfigStore.cpp
+ * @brief Persistência da última configuração boa no LittleFS
+ */
+
+#include "core/ConfigStore.h"
+#include "core/Logger.h"
+#include "config/DeviceConfig.h"
+#include "utils/StringUtils.h"
+#include <LittleFS.h>
+
+extern Logger* logger;
+
+ConfigStore& ConfigStore::getInstance() {
+    static ConfigStore instance;
+    return instance;
+}
+
+bool ConfigStore::begin() {
+    if (mounted) return true;
+
+    mounted = LittleFS.begin(true);
+    if (!mounted && logger) {
+        logger->error("ConfigStore: failed to mount LittleFS");
+    }
+    return mounted;
+}
+
+bool ConfigStore::load(String& json) {
+    if (!mounted || !LittleFS.exists(CONFIG_STORE_PATH)) return false;
+
+    File file = LittleFS.open(CONFIG_STORE_PATH, "r");
+    if (!file) return false;
+
+    json = file.readString();
+    file.close();
+
+    if (json.length() == 0) return false;
+    storedHash = StringUtils::hash(json);
+
+    if (logger) {
+        logger->info("ConfigStore: last-good config loaded (" + String(json.length()) + " bytes)");
+    }
+    return true;
+}
+
+bool ConfigStore::save(const String& json, uint32_t hash) {
+    if (!mounted || hash == storedHash) return false;
+
+    File file = LittleFS.open(CONFIG_STORE_TMP_PATH, "w");
+    if (!file) {
+        if (logger) logger->error("ConfigStore: cannot open " + String(CONFIG_STORE_TMP_PATH));
+        return false;
+    }
+
+    size_t written = file.write((const uint8_t*)json.c_str(), json.length());
+    file.close();
+
+    if (written != json.length() || !LittleFS.rename(CONFIG_STORE_TMP_PATH, CONFIG_STORE_PATH)) {
+        LittleFS.remove(CONFIG_STORE_TMP_PATH);
+        if (logger) logger->error("ConfigStore: failed to persist config (flash full?)");
+        return false;
+    }
+
+    storedHash = hash;
+    if (logger) {
+        logger->info("ConfigStore: config persisted (" + String(json.length()) + " bytes)");
+    }
+    return true;
+}
+
+void ConfigStore::clear() {
+    if (!mounted) return;
+    LittleFS.remove(CONFIG_STORE_PATH);
+    storedHash = 0;
+}
@@ -8,6 +8,10 @@
 #include "core/Logger.h"
 #include "config/DeviceConfig.h"
 #include "communication/ButtonStateManager.h"
+#include "commands/CommandAckTracker.h"
+#include "utils/MemoryMonitor.h"
+#include "core/Scheduler.h"
+#include <memory>
 #include <ArduinoJson.h>
 
 extern Logger* logger;
@@ -36,11 +40,13 @@ MQTTClient::MQTTClient(const String& deviceId, const String& broker, uint16_t po
     client->setCallback(messageReceived);
     client->setBufferSize(2048); // Increased buffer for v2.2.0 payloads
     logger->info("MQTT buffer size set to: 2048 bytes for v2.2.0 compliance");
+    MemoryMonitor::onAlloc(MEM_MQTT, 2048);
 }
 
 MQTTClient::~MQTTClient() {
     disconnect();
     delete client;
+    MemoryMonitor::onFree(MEM_MQTT, 2048);
     instance = nullptr;
 }
 
@@ -152,7 +158,11 @@ void MQTTClient::disconnect() {
 }
 
 bool MQTTClient::isConnected() {
-    return client->connected();
+    // Outras tarefas leem o último estado visto pela tarefa de rede
+    if (!Scheduler::network().isCurrentTask()) return connected;
+    
+    connected = client->connected();
+    return connected;
 }
 
 void MQTTClient::loop() {
@@ -189,6 +199,13 @@ bool MQTTClient::publish(const String& topic, const String& payload, bool retain
         return false;
     }
     
+    // Publicação da UI: o socket é da tarefa de rede
+    if (!Scheduler::network().isCurrentTask()) {
+        return Scheduler::network().dispatch([this, topic, payload, retained, qos]() {
+            publish(topic, payload, retained, qos);
+        });
+    }
+    
     logger->info("Publishing MQTT message:");
     logger->info("  Topic: " + topic);
     logger->info("  QoS: " + String(qos));
@@ -207,6 +224,26 @@ bool MQTTClient::publish(const String& topic, const String& payload, bool retain
     return result;
 }
 
+bool MQTTClient::publishAsync(const String& topic, const String& payload, PublishDone done) {
+    if (!isConnected()) {
+        logger->warning("Cannot publish, MQTT not connected");
+        return false;
+    }
+    
+    if (Scheduler::network().isCurrentTask()) {
+        if (!publish(topic, payload)) return false;
+        Scheduler::ui().dispatch([done]() { done(true); });
+        return true;
+    }
+    
+    // Resultado volta pela caixa da UI; perdido só se ela estiver cheia
+    // (o comando continua no CommandAckTracker e expira por timeout)
+    return Scheduler::network().dispatch([this, topic, payload, done]() {
+        bool ok = publish(topic, payload);
+        Scheduler::ui().dispatch([done, ok]() { done(ok); });
+    });
+}
+
 bool MQTTClient::publish(const String& topic, const JsonDocument& doc, uint8_t qos, bool retained) {
     String payload;
     serializeJson(doc, payload);
@@ -284,6 +321,9 @@ void MQTTClient::subscribeToTopics() {
 void MQTTClient::messageReceived(char* topic, byte* payload, unsigned int length) {
     if (!instance) return;
     
+    // Cópia do payload + documento parseado (aproximadamente 2x o tamanho)
+    MemoryCharge charge(MEM_MQTT, length * 2);
+    
     // Convert to String
     String topicStr = String(topic);
     String payloadStr;
@@ -320,16 +360,28 @@ void MQTTClient::messageReceived(char* topic, byte* payload, unsigned int length
         }
     }
     
+    // Confirmações de comandos: a tabela de comandos em voo é da tarefa de UI
+    if (!error && topicStr.endsWith("/response")) {
+        std::shared_ptr<JsonDocument> response = std::make_shared<JsonDocument>(std::move(doc));
+        Scheduler::ui().dispatch([response]() {
+            CommandAckTracker::getInstance().handleResponse(*response);
+        });
+        return;
+    }
+    
     // Processar mensagens de status para ButtonStateManager
+    // Parse fica na tarefa de rede; os widgets LVGL só mudam na tarefa de UI
     extern ButtonStateManager* buttonStateManager;
-    if (buttonStateManager && (topicStr.indexOf("/status") > 0 || topicStr.indexOf("/relays/state") > 0)) {
-        try {
-            if (!error) {
-                buttonStateManager->handleMQTTMessage(topicStr, doc);
+    if (buttonStateManager && !error && (topicStr.indexOf("/status") > 0 || topicStr.indexOf("/relays/state") > 0)) {
+        uint32_t receivedUs = micros();
+        std::shared_ptr<JsonDocument> status = std::make_shared<JsonDocument>(std::move(doc));
+        Scheduler::ui().dispatch([topicStr, status, receivedUs]() {
+            try {
+                buttonStateManager->handleMQTTMessage(topicStr, *status, receivedUs);
+            } catch (...) {
+                logger->error("Erro ao processar status para ButtonStateManager");
             }
-        } catch (...) {
-            logger->error("Erro ao processar status para ButtonStateManager");
-        }
+        });
     }
 }
 
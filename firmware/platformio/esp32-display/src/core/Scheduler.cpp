@@ -0,0 +1,400 @@
+/**
+ * @file Scheduler.cpp
+ * @brief Implementação do escalonador por deadline
+ */
+
+#include "core/Scheduler.h"
+#include "core/Logger.h"
+#include "config/DeviceConfig.h"
+
+#ifndef NATIVE_BUILD
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#else
+#include <deque>
+#endif
+
+extern Logger* logger;
+
+#ifdef NATIVE_BUILD
+typedef std::deque<Scheduler::JobFunction*> NativeInbox;
+
+// Tarefa emulada em execução no host (ver enterTask)
+static Scheduler* currentTask = nullptr;
+
+// runDue() roda como a dona e devolve a tarefa anterior ao sair
+struct NativeTaskScope {
+    Scheduler* previous;
+    explicit NativeTaskScope(Scheduler* task) : previous(currentTask) { currentTask = task; }
+    ~NativeTaskScope() { currentTask = previous; }
+};
+#endif
+
+Scheduler& Scheduler::ui() {
+    static Scheduler instance("ui");
+    return instance;
+}
+
+Scheduler& Scheduler::network() {
+    static Scheduler instance("network");
+    return instance;
+}
+
+Scheduler::Scheduler(const char* name) : name(name) {
+#ifndef NATIVE_BUILD
+    inbox = xQueueCreate(SCHEDULER_INBOX_SIZE, sizeof(JobFunction*));
+#else
+    inbox = new NativeInbox();
+#endif
+}
+
+void Scheduler::begin(void* task) {
+#ifndef NATIVE_BUILD
+    waitingTask = task ? task : xTaskGetCurrentTaskHandle();
+#else
+    // Sem handle de tarefa no host: qualquer valor não nulo marca o início
+    waitingTask = task ? task : this;
+#endif
+}
+
+#ifdef NATIVE_BUILD
+void Scheduler::enterTask() {
+    currentTask = this;
+}
+
+void Scheduler::end() {
+    NativeInbox& queue = *(NativeInbox*)inbox;
+    for (JobFunction* message : queue) delete message;
+    queue.clear();
+    waitingTask = nullptr;
+    if (currentTask == this) currentTask = nullptr;
+}
+#endif
+
+bool Scheduler::isCurrentTask() const {
+#ifdef NATIVE_BUILD
+    return !waitingTask || currentTask == this;
+#else
+    return waitingTask && xTaskGetCurrentTaskHandle() == (TaskHandle_t)waitingTask;
+#endif
+}
+
+bool Scheduler::dispatch(JobFunction fn) {
+    if (isCurrentTask()) {
+        fn();
+        return true;
+    }
+
+#ifndef NATIVE_BUILD
+    JobFunction* message = new JobFunction(std::move(fn));
+    if (!inbox || xQueueSend((QueueHandle_t)inbox, &message, 0) != pdTRUE) {
+        delete message;
+        droppedMessages++;
+        return false;
+    }
+    notify();
+#else
+    NativeInbox& queue = *(NativeInbox*)inbox;
+    if (queue.size() >= SCHEDULER_INBOX_SIZE) {
+        droppedMessages++;
+        return false;
+    }
+    queue.push_back(new JobFunction(std::move(fn)));
+#endif
+    return true;
+}
+
+uint8_t Scheduler::getPendingMessages() const {
+#ifdef NATIVE_BUILD
+    return (uint8_t)((NativeInbox*)inbox)->size();
+#else
+    return inbox ? (uint8_t)uxQueueMessagesWaiting((QueueHandle_t)inbox) : 0;
+#endif
+}
+
+void Scheduler::drainInbox() {
+#ifndef NATIVE_BUILD
+    JobFunction* message;
+    while (inbox && xQueueReceive((QueueHandle_t)inbox, &message, 0) == pdTRUE) {
+        (*message)();
+        delete message;
+        messages++;
+    }
+#else
+    NativeInbox& queue = *(NativeInbox*)inbox;
+    while (!queue.empty()) {
+        JobFunction* message = queue.front();
+        queue.pop_front();
+        (*message)();
+        delete message;
+        messages++;
+    }
+#endif
+}
+
+Scheduler::JobId Scheduler::every(const char* name, uint32_t periodMs, JobFunction fn, uint32_t firstDelayMs) {
+    return add(name, periodMs ? periodMs : 1, firstDelayMs, fn);
+}
+
+Scheduler::JobId Scheduler::everyAfter(const char* name, uint32_t gapMs, JobFunction fn, uint32_t firstDelayMs) {
+    return add(name, gapMs ? gapMs : 1, firstDelayMs, fn, true);
+}
+
+Scheduler::JobId Scheduler::after(const char* name, uint32_t delayMs, JobFunction fn) {
+    return add(name, 0, delayMs, fn);
+}
+
+Scheduler::JobId Scheduler::add(const char* name, uint32_t periodMs, uint32_t delayMs, JobFunction fn, bool fromEnd) {
+    for (JobId id = 0; id < MAX_JOBS; id++) {
+        Job& job = jobs[id];
+        if (job.used) continue;
+
+        job = Job();
+        job.used = true;
+        job.name = name;
+        job.fn = fn;
+        job.periodMs = periodMs;
+        job.fromEnd = fromEnd;
+        job.deadline = millis() + delayMs;
+        heapPush(id);
+        return id;
+    }
+
+    if (logger) logger->error("Scheduler " + String(this->name) + ": no free slot for job " + String(name));
+    return INVALID_JOB;
+}
+
+void Scheduler::reschedule(JobId id, uint32_t delayMs) {
+    if (id >= MAX_JOBS || !jobs[id].used) return;
+
+    if (id == running) {
+        runningRescheduled = true;
+        runningPaused = false;
+        jobs[id].deadline = millis() + delayMs;
+        return;
+    }
+    setDeadline(id, millis() + delayMs);
+}
+
+void Scheduler::runWithin(JobId id, uint32_t delayMs) {
+    if (id >= MAX_JOBS || !jobs[id].used) return;
+
+    uint32_t deadline = millis() + delayMs;
+    bool queued = jobs[id].heapIndex >= 0;
+    if (id != running && queued && !before(deadline, jobs[id].deadline)) return;
+    reschedule(id, delayMs);
+}
+
+void Scheduler::pause(JobId id) {
+    if (id >= MAX_JOBS || !jobs[id].used) return;
+
+    if (id == running) {
+        runningPaused = true;
+        runningRescheduled = false;
+        return;
+    }
+    heapRemove(id);
+}
+
+void Scheduler::cancel(JobId id) {
+    if (id >= MAX_JOBS || !jobs[id].used) return;
+
+    heapRemove(id);
+    if (id == running) {
+        // Liberado ao terminar a execução
+        runningPaused = true;
+        jobs[id].periodMs = 0;
+        return;
+    }
+    jobs[id] = Job();
+}
+
+uint32_t Scheduler::runDue(uint32_t maxSleepMs) {
+#ifdef NATIVE_BUILD
+    NativeTaskScope scope(this);
+#endif
+    drainInbox();
+    uint32_t now = millis();
+
+    // Só o que venceu até aqui: jobs que se reagendam para 0ms rodam na próxima volta
+    uint8_t budget = heapSize;
+    while (heapSize > 0 && budget-- > 0 && !before(now, jobs[heap[0]].deadline)) {
+        run(heap[0], now);
+        now = millis();
+    }
+
+    if (heapSize == 0) return maxSleepMs;
+    uint32_t next = jobs[heap[0]].deadline;
+    if (!before(now, next)) return 0;
+    return min(next - now, maxSleepMs);
+}
+
+void Scheduler::run(JobId id, uint32_t now) {
+    Job& job = jobs[id];
+    heapRemove(id);
+
+    uint32_t late = now - job.deadline;
+    if (late > job.stats.maxLateMs) job.stats.maxLateMs = late;
+
+    running = id;
+    runningRescheduled = false;
+    runningPaused = false;
+
+    uint32_t startUs = micros();
+    job.fn();
+    uint32_t elapsedUs = micros() - startUs;
+
+    running = INVALID_JOB;
+
+    job.stats.runs++;
+    job.stats.totalUs += elapsedUs;
+    if (elapsedUs > job.stats.maxUs) job.stats.maxUs = elapsedUs;
+
+    if (runningPaused) {
+        if (job.periodMs == 0) job = Job();  // Cancelado durante a execução
+        return;
+    }
+
+    if (runningRescheduled) {
+        heapPush(id);
+        return;
+    }
+
+    if (job.periodMs == 0) {
+        job = Job();
+        return;
+    }
+
+    uint32_t finished = millis();
+    if (job.fromEnd) {
+        job.deadline = finished + job.periodMs;
+        heapPush(id);
+        return;
+    }
+
+    // Mantém a fase; se perdeu períodos inteiros, pula para o próximo
+    job.deadline += job.periodMs;
+    if (before(job.deadline, finished)) {
+        job.deadline = finished + job.periodMs - (finished - job.deadline) % job.periodMs;
+    }
+    heapPush(id);
+}
+
+void Scheduler::waitNext(uint32_t timeoutMs) {
+    if (timeoutMs == 0) return;
+    wakeups++;
+#ifdef NATIVE_BUILD
+    delay(timeoutMs);
+#else
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeoutMs));
+#endif
+}
+
+void Scheduler::notify() {
+#ifndef NATIVE_BUILD
+    if (waitingTask) xTaskNotifyGive((TaskHandle_t)waitingTask);
+#endif
+}
+
+void IRAM_ATTR Scheduler::notifyFromISR() {
+#ifndef NATIVE_BUILD
+    if (!waitingTask) return;
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR((TaskHandle_t)waitingTask, &woken);
+    if (woken) portYIELD_FROM_ISR();
+#endif
+}
+
+const Scheduler::JobStats* Scheduler::getStats(JobId id) const {
+    if (id >= MAX_JOBS || !jobs[id].used) return nullptr;
+    return &jobs[id].stats;
+}
+
+uint8_t Scheduler::getJobCount() const {
+    uint8_t count = 0;
+    for (JobId id = 0; id < MAX_JOBS; id++) {
+        if (jobs[id].used) count++;
+    }
+    return count;
+}
+
+void Scheduler::toJson(JsonObject obj) const {
+    obj["wakeups"] = wakeups;
+    obj["messages"] = messages;
+    obj["dropped"] = droppedMessages;
+
+    JsonArray list = obj["jobs"].to<JsonArray>();
+    for (JobId id = 0; id < MAX_JOBS; id++) {
+        const Job& job = jobs[id];
+        if (!job.used) continue;
+
+        JsonObject entry = list.add<JsonObject>();
+        entry["name"] = job.name;
+        entry["runs"] = job.stats.runs;
+        entry["avg_us"] = job.stats.runs ? job.stats.totalUs / job.stats.runs : 0;
+        entry["max_us"] = job.stats.maxUs;
+        entry["max_late_ms"] = job.stats.maxLateMs;
+    }
+}
+
+// ============================================================================
+// Min-heap
+// ============================================================================
+
+void Scheduler::setDeadline(JobId id, uint32_t deadline) {
+    heapRemove(id);
+    jobs[id].deadline = deadline;
+    heapPush(id);
+}
+
+void Scheduler::heapPush(JobId id) {
+    if (jobs[id].heapIndex >= 0) return;
+    heap[heapSize] = id;
+    jobs[id].heapIndex = heapSize;
+    siftUp(heapSize++);
+}
+
+void Scheduler::heapRemove(JobId id) {
+    int8_t pos = jobs[id].heapIndex;
+    if (pos < 0) return;
+
+    jobs[id].heapIndex = -1;
+    heapSize--;
+    if (pos == heapSize) return;
+
+    heap[pos] = heap[heapSize];
+    jobs[heap[pos]].heapIndex = pos;
+    siftUp(pos);
+    siftDown(jobs[heap[pos]].heapIndex);
+}
+
+void Scheduler::siftUp(uint8_t pos) {
+    while (pos > 0) {
+        uint8_t parent = (pos - 1) / 2;
+        if (!before(jobs[heap[pos]].deadline, jobs[heap[parent]].deadline)) break;
+        heapSwap(pos, parent);
+        pos = parent;
+    }
+}
+
+void Scheduler::siftDown(uint8_t pos) {
+    while (true) {
+        uint8_t smallest = pos;
+        uint8_t left = pos * 2 + 1;
+        uint8_t right = left + 1;
+        if (left < heapSize && before(jobs[heap[left]].deadline, jobs[heap[smallest]].deadline)) smallest = left;
+        if (right < heapSize && before(jobs[heap[right]].deadline, jobs[heap[smallest]].deadline)) smallest = right;
+        if (smallest == pos) break;
+        heapSwap(pos, smallest);
+        pos = smallest;
+    }
+}
+
+void Scheduler::heapSwap(uint8_t a, uint8_t b) {
+    JobId tmp = heap[a];
+    heap[a] = heap[b];
+    heap[b] = tmp;
+    jobs[heap[a]].heapIndex = a;
+    jobs[heap[b]].heapIndex = b;
+}
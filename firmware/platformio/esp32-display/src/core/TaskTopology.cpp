@@ -0,0 +1,90 @@
+/**
+ * @file TaskTopology.cpp
+ * @brief Criação das tarefas e acompanhamento do high-water mark
+ */
+
+#include "core/TaskTopology.h"
+#include "core/Logger.h"
+#include "config/DeviceConfig.h"
+
+#ifndef NATIVE_BUILD
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+extern Logger* logger;
+
+TaskTopology& TaskTopology::getInstance() {
+    static TaskTopology instance;
+    return instance;
+}
+
+void* TaskTopology::spawn(const char* name, TaskEntry entry, uint32_t stackBytes,
+                          uint8_t priority, uint8_t core, void* arg) {
+    if (taskCount >= MAX_TASKS) {
+        if (logger) logger->error("TaskTopology: no slot for task " + String(name));
+        return nullptr;
+    }
+
+    void* handle = nullptr;
+#ifndef NATIVE_BUILD
+    // ESP-IDF: profundidade da pilha em bytes
+    TaskHandle_t created = nullptr;
+    if (xTaskCreatePinnedToCore(entry, name, stackBytes, arg, priority, &created, core) != pdPASS) {
+        if (logger) logger->error("TaskTopology: failed to create task " + String(name));
+        return nullptr;
+    }
+    handle = created;
+#else
+    (void)entry;
+    (void)arg;
+#endif
+
+    TaskInfo& info = tasks[taskCount++];
+    info.name = name;
+    info.handle = handle;
+    info.core = core;
+    info.priority = priority;
+    info.stackBytes = stackBytes;
+    info.minFreeBytes = stackBytes;
+    info.warned = false;
+
+    if (logger) {
+        logger->info("Task " + String(name) + " on core " + String(core) +
+                     " (stack " + String(stackBytes) + "B, prio " + String(priority) + ")");
+    }
+    return handle;
+}
+
+void TaskTopology::check() {
+#ifndef NATIVE_BUILD
+    for (uint8_t i = 0; i < taskCount; i++) {
+        TaskInfo& info = tasks[i];
+        if (!info.handle) continue;
+
+        // ESP-IDF: high-water mark em bytes
+        info.minFreeBytes = uxTaskGetStackHighWaterMark((TaskHandle_t)info.handle);
+
+        if (info.minFreeBytes < TASK_STACK_WARN_FREE && !info.warned) {
+            info.warned = true;
+            if (logger) {
+                logger->warning("Task " + String(info.name) + " stack low: " + String(info.minFreeBytes) +
+                                "B free of " + String(info.stackBytes) + "B");
+            }
+        }
+    }
+#endif
+}
+
+void TaskTopology::toJson(JsonArray list) const {
+    for (uint8_t i = 0; i < taskCount; i++) {
+        const TaskInfo& info = tasks[i];
+        JsonObject entry = list.add<JsonObject>();
+        entry["name"] = info.name;
+        entry["core"] = info.core;
+        entry["priority"] = info.priority;
+        entry["stack"] = info.stackBytes;
+        entry["free_min"] = info.minFreeBytes;
+        entry["used_pct"] = info.stackBytes ? (info.stackBytes - info.minFreeBytes) * 100 / info.stackBytes : 0;
+    }
+}
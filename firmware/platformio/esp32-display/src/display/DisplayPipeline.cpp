@@ -0,0 +1,203 @@
+/**
+ * @file DisplayPipeline.cpp
+ * @brief Implementação do pipeline de flush assíncrono com buffer duplo
+ */
+
+#include "display/DisplayPipeline.h"
+#include "display/RenderProfiler.h"
+#include "core/Logger.h"
+#include "config/DeviceConfig.h"
+#include "runtime_stats.h"
+#include <stdlib.h>
+
+#if defined(ESP32)
+#include <esp_heap_caps.h>
+#endif
+
+extern Logger* logger;
+
+DisplayPipeline::DisplayPipeline(DisplayTransport* t, uint16_t w, uint16_t h, uint16_t lines)
+    : transport(t), width(w), height(h), bufferLines(lines) {
+}
+
+DisplayPipeline::~DisplayPipeline() {
+    // Não liberar buffers com transferência em andamento: travada, os
+    // buffers vazam em vez de o DMA escrever em memória já reutilizada
+    bool idle = !transport || transport->waitIdle(DISPLAY_TRANSFER_TIMEOUT_MS);
+    if (display) {
+        lv_disp_remove(display);
+    }
+    if (!idle) {
+        if (logger) logger->error("DisplayPipeline: transfer still running, leaking draw buffers");
+        return;
+    }
+#if defined(ESP32)
+    heap_caps_free(buf1);
+    heap_caps_free(buf2);
+#else
+    free(buf1);
+    free(buf2);
+#endif
+}
+
+lv_color_t* DisplayPipeline::allocateBuffer(size_t pixels) {
+#if defined(ESP32)
+    // Buffers precisam ser acessíveis pelo DMA (RAM interna)
+    return (lv_color_t*)heap_caps_malloc(pixels * sizeof(lv_color_t), MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+#else
+    return (lv_color_t*)malloc(pixels * sizeof(lv_color_t));
+#endif
+}
+
+bool DisplayPipeline::begin() {
+    if (!transport || !transport->begin()) {
+        if (logger) logger->error("DisplayPipeline: transport initialization failed");
+        return false;
+    }
+
+    // Reduzir linhas até conseguir alocar os dois buffers
+    size_t pixels = 0;
+    while (bufferLines > 0) {
+        pixels = (size_t)width * bufferLines;
+        buf1 = allocateBuffer(pixels);
+        buf2 = buf1 ? allocateBuffer(pixels) : nullptr;
+        if (buf1 && buf2) break;
+
+#if defined(ESP32)
+        heap_caps_free(buf1);
+        heap_caps_free(buf2);
+#else
+        free(buf1);
+        free(buf2);
+#endif
+        buf1 = buf2 = nullptr;
+        bufferLines /= 2;
+    }
+
+    if (!buf1) {
+        if (logger) logger->error("DisplayPipeline: failed to allocate render buffers");
+        return false;
+    }
+
+    lv_disp_draw_buf_init(&drawBuf, buf1, buf2, pixels);
+
+    lv_disp_drv_init(&dispDrv);
+    dispDrv.hor_res = width;
+    dispDrv.ver_res = height;
+    dispDrv.flush_cb = flushCallback;
+    dispDrv.wait_cb = waitCallback;
+    dispDrv.monitor_cb = monitorCallback;
+    dispDrv.render_start_cb = renderStartCallback;
+    dispDrv.draw_buf = &drawBuf;
+    dispDrv.user_data = this;
+    display = lv_disp_drv_register(&dispDrv);
+
+    fpsWindowStart = millis();
+    frameTiming = runtime_stats_timing("lvgl_frame");
+
+    if (logger) {
+        logger->info("DisplayPipeline: 2 x " + String(bufferLines) + " lines (" +
+                     String((unsigned long)(pixels * sizeof(lv_color_t))) + " bytes each) via " +
+                     String(transport->getName()));
+    }
+    return display != nullptr;
+}
+
+void DisplayPipeline::flushCallback(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t* colors) {
+    DisplayPipeline* self = (DisplayPipeline*)drv->user_data;
+
+    uint32_t w = (area->x2 - area->x1 + 1);
+    uint32_t h = (area->y2 - area->y1 + 1);
+
+    self->flushing = true;
+    self->stalledThisFlush = false;
+    self->flushStartUs = micros();
+    if (self->profiler) {
+        self->profiler->onFlush(w, h);
+    }
+    if (!self->transport->startFlush(area->x1, area->y1, w, h, (uint16_t*)&colors->full)) {
+        // O LVGL já dá a faixa por desenhada: sem redesenho ela sumiria da
+        // tela até alguém invalidar aquela área. Durante o render não dá
+        // para invalidar; fica para o monitorCallback, no fim do frame
+        self->stats.lostFlushes++;
+        self->redrawPending = true;
+        if (logger) logger->warning("DisplayPipeline: flush lost, redrawing full screen");
+    }
+
+    // Transporte síncrono: liberar o buffer imediatamente
+    if (!self->transport->isBusy()) {
+        self->completeFlush();
+    }
+}
+
+void DisplayPipeline::waitCallback(lv_disp_drv_t* drv) {
+    // Chamado pelo LVGL quando precisa de um buffer ainda em envio
+    DisplayPipeline* self = (DisplayPipeline*)drv->user_data;
+    if (self->flushing && !self->stalledThisFlush) {
+        self->stalledThisFlush = true;
+        self->stats.renderStalls++;
+    }
+    self->poll();
+}
+
+void DisplayPipeline::renderStartCallback(lv_disp_drv_t* drv) {
+    // Chamado antes de renderizar as áreas invalidadas (já unidas) do frame
+    DisplayPipeline* self = (DisplayPipeline*)drv->user_data;
+    if (self->profiler) {
+        self->profiler->onRenderStart(_lv_refr_get_disp_refreshing());
+    }
+}
+
+void DisplayPipeline::monitorCallback(lv_disp_drv_t* drv, uint32_t timeMs, uint32_t pixels) {
+    DisplayPipeline* self = (DisplayPipeline*)drv->user_data;
+    DisplayStats& s = self->stats;
+
+    if (self->profiler) {
+        self->profiler->onFrameDone(pixels);
+    }
+
+    if (self->redrawPending) {
+        self->redrawPending = false;
+        lv_obj_invalidate(lv_disp_get_scr_act(self->display));
+    }
+
+    s.frames++;
+    s.lastFrameMs = timeMs;
+    if (timeMs > s.maxFrameMs) s.maxFrameMs = timeMs;
+    runtime_stats_record(self->frameTiming, timeMs * 1000);
+
+    self->fpsWindowFrames++;
+    unsigned long now = millis();
+    unsigned long elapsed = now - self->fpsWindowStart;
+    if (elapsed >= 1000) {
+        s.fps = self->fpsWindowFrames * 1000.0f / elapsed;
+        self->fpsWindowFrames = 0;
+        self->fpsWindowStart = now;
+    }
+}
+
+void DisplayPipeline::poll() {
+    if (flushing && !transport->isBusy()) {
+        completeFlush();
+    }
+}
+
+void DisplayPipeline::completeFlush() {
+    uint32_t elapsed = micros() - flushStartUs;
+    flushing = false;
+
+    stats.flushes++;
+    stats.lastFlushUs = elapsed;
+    if (elapsed > stats.maxFlushUs) stats.maxFlushUs = elapsed;
+    totalFlushUs += elapsed;
+    stats.avgFlushUs = (uint32_t)(totalFlushUs / stats.flushes);
+
+    lv_disp_flush_ready(&dispDrv);
+}
+
+void DisplayPipeline::resetStats() {
+    stats = DisplayStats();
+    totalFlushUs = 0;
+    fpsWindowFrames = 0;
+    fpsWindowStart = millis();
+}
@@ -0,0 +1,25 @@
+/**
+ * @file DisplayTransport.cpp
+ * @brief Espera limitada pelo fim de uma transferência
+ */
+
+#include "display/DisplayTransport.h"
+#include "core/Logger.h"
+#include <Arduino.h>
+
+extern Logger* logger;
+
+bool DisplayTransport::waitIdle(uint32_t timeoutMs) {
+    unsigned long start = millis();
+    while (isBusy()) {
+        if (millis() - start >= timeoutMs) {
+            if (logger) {
+                logger->error(String("Display transport ") + getName() + ": transfer stuck for " +
+                              String(timeoutMs) + " ms");
+            }
+            return false;
+        }
+        delay(1);   // vTaskDelay no ESP32: outras tarefas (e o IDLE do watchdog) rodam
+    }
+    return true;
+}
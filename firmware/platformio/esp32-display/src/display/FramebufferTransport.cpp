@@ -0,0 +1,86 @@
+/**
+ * @file FramebufferTransport.cpp
+ * @brief Implementação do transporte para framebuffer com latência simulada
+ */
+
+#include "display/FramebufferTransport.h"
+#include "config/DeviceConfig.h"
+#include <string.h>
+#include <stdlib.h>
+
+FramebufferTransport::FramebufferTransport(uint16_t w, uint16_t h, uint32_t bps, uint32_t setup)
+    : width(w), height(h), bytesPerSecond(bps), setupUs(setup) {
+}
+
+FramebufferTransport::~FramebufferTransport() {
+    free(framebuffer);
+}
+
+bool FramebufferTransport::begin() {
+    if (!framebuffer) {
+        framebuffer = (uint16_t*)calloc((size_t)width * height, sizeof(uint16_t));
+    }
+    return framebuffer != nullptr;
+}
+
+void FramebufferTransport::setLatency(uint32_t bps, uint32_t setup) {
+    bytesPerSecond = bps;
+    setupUs = setup;
+}
+
+bool FramebufferTransport::startFlush(int32_t x, int32_t y, uint32_t w, uint32_t h, uint16_t* pixels) {
+    // Um barramento real só aceita a próxima área após terminar a anterior;
+    // travado, a área pendente é descartada (waitIdle já logou)
+    bool delivered = waitIdle(DISPLAY_TRANSFER_TIMEOUT_MS);
+    if (!delivered) {
+        pending = false;
+    }
+
+    uint64_t bytes = (uint64_t)w * h * sizeof(uint16_t);
+    uint32_t transferUs = bytesPerSecond ? (uint32_t)(bytes * 1000000ULL / bytesPerSecond) : 0;
+
+    pendingX = x;
+    pendingY = y;
+    pendingW = w;
+    pendingH = h;
+    pendingPixels = pixels;
+    pending = true;
+    busyUntilUs = micros() + setupUs + transferUs;
+    flushCount++;
+
+    if (setupUs + transferUs == 0) {
+        commitPending();
+    }
+    return delivered;
+}
+
+bool FramebufferTransport::isBusy() {
+    if (!pending) return false;
+    if ((long)(micros() - busyUntilUs) < 0) return true;
+
+    commitPending();
+    return false;
+}
+
+void FramebufferTransport::commitPending() {
+    if (!pending) return;
+    pending = false;
+
+    if (!framebuffer || !pendingPixels) return;
+
+    for (uint32_t row = 0; row < pendingH; row++) {
+        int32_t dy = pendingY + (int32_t)row;
+        if (dy < 0 || dy >= height) continue;
+
+        for (uint32_t col = 0; col < pendingW; col++) {
+            int32_t dx = pendingX + (int32_t)col;
+            if (dx < 0 || dx >= width) continue;
+            framebuffer[(size_t)dy * width + dx] = pendingPixels[(size_t)row * pendingW + col];
+        }
+    }
+}
+
+uint16_t FramebufferTransport::getPixel(uint16_t x, uint16_t y) const {
+    if (!framebuffer || x >= width || y >= height) return 0;
+    return framebuffer[(size_t)y * width + x];
+}
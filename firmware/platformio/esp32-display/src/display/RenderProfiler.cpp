@@ -0,0 +1,193 @@
+/**
+ * @file RenderProfiler.cpp
+ * @brief Implementação do perfil de renderização/invalidação
+ */
+
+#include "display/RenderProfiler.h"
+#include <algorithm>
+
+// Limites dos histogramas (último bucket = acima do maior limite)
+static const uint32_t FRAME_US_BOUNDS[] = {1000, 2000, 4000, 8000, 16000, 33000, 50000, 100000};
+static const uint32_t FRAME_AREA_PCT_BOUNDS[] = {1, 5, 10, 25, 50, 75, 99};
+static const uint32_t INV_AREAS_BOUNDS[] = {1, 2, 4, 8, 16, 31};
+static const uint32_t FLUSH_PX_BOUNDS[] = {256, 1024, 2048, 4096, 6400, 12800};
+
+#define BOUNDS(a) a, (uint8_t)(sizeof(a) / sizeof(a[0]))
+
+RenderProfiler::RenderProfiler(uint16_t screenWidth, uint16_t screenHeight)
+    : screenPixels((uint32_t)screenWidth * screenHeight),
+      frameTimeUs(BOUNDS(FRAME_US_BOUNDS)),
+      framePixels(BOUNDS(FRAME_AREA_PCT_BOUNDS)),
+      invalidatedAreas(BOUNDS(INV_AREAS_BOUNDS)),
+      flushPixels(BOUNDS(FLUSH_PX_BOUNDS)) {
+    reset();
+}
+
+void RenderProfiler::onRenderStart(lv_disp_t* disp) {
+    frameStartUs = micros();
+    frameOpen = true;
+
+    if (!disp) return;
+
+    invalidatedAreas.record(disp->inv_p);
+
+    for (uint16_t i = 0; i < disp->inv_p; i++) {
+        if (!disp->inv_area_joined[i]) {
+            totalInvalidatedPixels += lv_area_get_size(&disp->inv_areas[i]);
+        }
+        if (objectTracking) {
+            trackArea(disp->inv_areas[i]);
+        }
+    }
+}
+
+void RenderProfiler::onFlush(uint32_t w, uint32_t h) {
+    uint32_t pixels = w * h;
+    flushPixels.record(pixels);
+    totalFlushedPixels += pixels;
+    totalFlushes++;
+}
+
+void RenderProfiler::onFrameDone(uint32_t pixels) {
+    if (!frameOpen) return;
+    frameOpen = false;
+
+    frameTimeUs.record(micros() - frameStartUs);
+
+    uint32_t pct = screenPixels ? (uint32_t)((uint64_t)pixels * 100 / screenPixels) : 0;
+    framePixels.record(pct);
+    if (pct >= 100) fullScreenFrames++;
+}
+
+void RenderProfiler::trackArea(const lv_area_t& area) {
+    lv_obj_t* screen = lv_scr_act();
+    if (!screen) return;
+
+    lv_obj_t* owner = findOwner(screen, area, lv_area_get_size(&area));
+    countObject(owner);
+}
+
+lv_obj_t* RenderProfiler::findOwner(lv_obj_t* obj, const lv_area_t& area, uint32_t areaSize) {
+    lv_point_t center;
+    center.x = (area.x1 + area.x2) / 2;
+    center.y = (area.y1 + area.y2) / 2;
+
+    // Filhos do topo para baixo: o último criado é desenhado por cima
+    uint32_t childCount = lv_obj_get_child_cnt(obj);
+    for (int32_t i = (int32_t)childCount - 1; i >= 0; i--) {
+        lv_obj_t* child = lv_obj_get_child(obj, i);
+        if (lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) continue;
+        if (!_lv_area_is_point_on(&child->coords, &center, 0)) continue;
+
+        // Filho pequeno demais para explicar a área: o dono é o pai
+        if (lv_area_get_size(&child->coords) * 2 < areaSize) break;
+
+        return findOwner(child, area, areaSize);
+    }
+    return obj;
+}
+
+void RenderProfiler::countObject(const lv_obj_t* obj) {
+    // Space-saving: a entrada menos frequente cede lugar, herdando sua contagem
+    ObjectEntry* slot = nullptr;
+    ObjectEntry* weakest = &topObjects[0];
+
+    for (uint8_t i = 0; i < TOP_OBJECTS; i++) {
+        ObjectEntry& e = topObjects[i];
+        if (e.obj == obj && e.count > 0) {
+            e.count++;
+            return;
+        }
+        if (!slot && e.count == 0) slot = &e;
+        if (e.count < weakest->count) weakest = &e;
+    }
+
+    uint32_t inherited = 0;
+    if (!slot) {
+        slot = weakest;
+        inherited = weakest->count;
+    }
+
+    slot->obj = obj;
+    slot->count = inherited + 1;
+    describe(obj, slot->name, sizeof(slot->name));
+}
+
+void RenderProfiler::describe(const lv_obj_t* obj, char* out, size_t len) {
+    const char* kind = "obj";
+    if (obj == lv_scr_act()) kind = "screen";
+    else if (lv_obj_check_type(obj, &lv_label_class)) kind = "label";
+    else if (lv_obj_check_type(obj, &lv_btn_class)) kind = "btn";
+    else if (lv_obj_check_type(obj, &lv_bar_class)) kind = "bar";
+    else if (lv_obj_check_type(obj, &lv_arc_class)) kind = "arc";
+    else if (lv_obj_check_type(obj, &lv_switch_class)) kind = "switch";
+
+    // Rótulo legível: o próprio texto do label ou o do primeiro label filho
+    const char* text = nullptr;
+    if (lv_obj_check_type(obj, &lv_label_class)) {
+        text = lv_label_get_text(obj);
+    } else {
+        uint32_t childCount = lv_obj_get_child_cnt(obj);
+        for (uint32_t i = 0; i < childCount && !text; i++) {
+            lv_obj_t* child = lv_obj_get_child(obj, i);
+            if (lv_obj_check_type(child, &lv_label_class)) {
+                text = lv_label_get_text(child);
+            }
+        }
+    }
+
+    if (text && *text) {
+        snprintf(out, len, "%s:%s", kind, text);
+    } else {
+        snprintf(out, len, "%s@%d,%d", kind, (int)obj->coords.x1, (int)obj->coords.y1);
+    }
+}
+
+void RenderProfiler::toJson(JsonObject obj) const {
+    obj["window_ms"] = millis() - windowStart;
+    obj["frames"] = frameTimeUs.getCount();
+    obj["flushes"] = totalFlushes;
+    obj["flushed_px"] = (uint32_t)totalFlushedPixels;
+    obj["invalidated_px"] = (uint32_t)totalInvalidatedPixels;
+    obj["full_screen_frames"] = fullScreenFrames;
+
+    frameTimeUs.toJson(obj["frame_us"].to<JsonObject>());
+    framePixels.toJson(obj["frame_area_pct"].to<JsonObject>());
+    invalidatedAreas.toJson(obj["inv_areas"].to<JsonObject>());
+    flushPixels.toJson(obj["flush_px"].to<JsonObject>());
+
+    // Top objetos em ordem decrescente
+    const ObjectEntry* sorted[TOP_OBJECTS];
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < TOP_OBJECTS; i++) {
+        if (topObjects[i].count > 0) sorted[n++] = &topObjects[i];
+    }
+    std::sort(sorted, sorted + n, [](const ObjectEntry* a, const ObjectEntry* b) {
+        return a->count > b->count;
+    });
+
+    JsonArray top = obj["top_objects"].to<JsonArray>();
+    for (uint8_t i = 0; i < n; i++) {
+        JsonObject entry = top.add<JsonObject>();
+        entry["name"] = sorted[i]->name;
+        entry["count"] = sorted[i]->count;
+    }
+}
+
+void RenderProfiler::reset() {
+    frameTimeUs.reset();
+    framePixels.reset();
+    invalidatedAreas.reset();
+    flushPixels.reset();
+
+    for (uint8_t i = 0; i < TOP_OBJECTS; i++) {
+        topObjects[i] = ObjectEntry();
+    }
+
+    frameOpen = false;
+    windowStart = millis();
+    totalFlushedPixels = 0;
+    totalInvalidatedPixels = 0;
+    totalFlushes = 0;
+    fullScreenFrames = 0;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file TftDmaTransport.cpp
+ * @brief Implementação do transporte TFT_eSPI com DMA
+ */
+
+#include "display/TftDmaTransport.h"
+#include "core/Logger.h"
+#include "config/DeviceConfig.h"
+
+extern Logger* logger;
+
+TftDmaTransport::~TftDmaTransport() {
+    if (dmaEnabled) {
+        waitIdle(DISPLAY_TRANSFER_TIMEOUT_MS);
+        if (writing) tft.endWrite();
+        tft.deInitDMA();
+    }
+}
+
+bool TftDmaTransport::begin() {
+    dmaEnabled = tft.initDMA();
+
+    if (logger) {
+        logger->info("TftDmaTransport: " + String(dmaEnabled ? "DMA enabled" : "DMA unavailable, using blocking writes"));
+    }
+    return true;
+}
+
+bool TftDmaTransport::startFlush(int32_t x, int32_t y, uint32_t w, uint32_t h, uint16_t* pixels) {
+    if (dmaEnabled) {
+        // pushImageDMA giraria esperando a anterior: espera limitada antes
+        if (!waitIdle(DISPLAY_TRANSFER_TIMEOUT_MS)) return false;
+
+        // LVGL gera RGB565 na ordem do host; o painel espera big-endian.
+        // pushImageDMA troca os bytes antes de disparar, então a flag global
+        // volta ao valor anterior logo depois
+        bool swap = tft.getSwapBytes();
+        tft.setSwapBytes(true);
+        tft.startWrite();
+        writing = true;
+        tft.pushImageDMA(x, y, w, h, pixels);
+        tft.setSwapBytes(swap);
+        return true;
+    }
+
+    tft.startWrite();
+    tft.setAddrWindow(x, y, w, h);
+    tft.pushColors(pixels, w * h, true);
+    tft.endWrite();
+    return true;
+}
+
+bool TftDmaTransport::isBusy() {
+    if (!writing) return false;
+    if (tft.dmaBusy()) return true;
+
+    // DMA terminou: solta o barramento até a próxima faixa
+    tft.endWrite();
+    writing = false;
+    return false;
+}
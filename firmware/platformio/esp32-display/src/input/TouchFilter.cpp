@@ -0,0 +1,107 @@
+/**
+ * @file TouchFilter.cpp
+ * @brief Implementação do filtro de amostras do touch
+ */
+
+#include "input/TouchFilter.h"
+#include "config/DeviceConfig.h"
+
+TouchFilter::TouchFilter()
+    : TouchFilter(Config{TOUCH_MIN_PRESSURE, TOUCH_RELEASE_PRESSURE, TOUCH_PRESS_SAMPLES,
+                         TOUCH_RELEASE_HOLD_MS, TOUCH_FAST_MOVE_DELTA}) {
+}
+
+TouchFilter::TouchFilter(const Config& config) : config(config) {
+    if (this->config.pressSamples == 0) this->config.pressSamples = 1;
+}
+
+bool TouchFilter::feed(const TouchSample& sample) {
+    bool strong = sample.z >= config.pressThreshold;
+    bool weak = sample.z < config.releaseThreshold;
+
+    if (!pressed) {
+        if (!strong) {
+            // Pico isolado: recomeça a contagem e descarta as amostras
+            strongCount = 0;
+            histCount = 0;
+            return false;
+        }
+
+        pushValid(sample);
+        if (++strongCount < config.pressSamples) {
+            return false;
+        }
+
+        // Confirmado: parte da amostra mais recente, sem atraso do IIR
+        pressed = true;
+        releasing = false;
+        pressTime = sample.timeMs;
+        filteredX = (int32_t)medianX() << FIXED_SHIFT;
+        filteredY = (int32_t)medianY() << FIXED_SHIFT;
+        return true;
+    }
+
+    if (weak) {
+        if (!releasing) {
+            releasing = true;
+            weakSince = sample.timeMs;
+        } else if (sample.timeMs - weakSince >= config.releaseHoldMs) {
+            reset();
+        }
+        // Coordenadas com pressão baixa não são confiáveis: mantém a última
+        return pressed;
+    }
+
+    // Zona de histerese ou pressão forte: toque continua
+    releasing = false;
+    pushValid(sample);
+    applyIir(medianX(), medianY());
+    return true;
+}
+
+void TouchFilter::reset() {
+    pressed = false;
+    releasing = false;
+    strongCount = 0;
+    histCount = 0;
+    histPos = 0;
+}
+
+void TouchFilter::pushValid(const TouchSample& sample) {
+    histX[histPos] = sample.x;
+    histY[histPos] = sample.y;
+    histPos = (histPos + 1) % 3;
+    if (histCount < 3) histCount++;
+}
+
+uint16_t TouchFilter::median3(uint16_t a, uint16_t b, uint16_t c) {
+    if (a > b) { uint16_t t = a; a = b; b = t; }
+    if (b > c) b = c;
+    return a > b ? a : b;
+}
+
+uint16_t TouchFilter::medianX() const {
+    if (histCount < 3) return histX[(histPos + 2) % 3];  // Mais recente
+    return median3(histX[0], histX[1], histX[2]);
+}
+
+uint16_t TouchFilter::medianY() const {
+    if (histCount < 3) return histY[(histPos + 2) % 3];
+    return median3(histY[0], histY[1], histY[2]);
+}
+
+void TouchFilter::applyIir(uint16_t x, uint16_t y) {
+    int32_t dx = ((int32_t)x << FIXED_SHIFT) - filteredX;
+    int32_t dy = ((int32_t)y << FIXED_SHIFT) - filteredY;
+    int32_t fast = (int32_t)config.fastMoveDelta << FIXED_SHIFT;
+
+    // Movimento grande: segue a mediana direto (o arrasto não atrasa);
+    // parado: alpha 1/4, o tremor do resistivo some
+    if (abs(dx) > fast || abs(dy) > fast) {
+        filteredX += dx;
+        filteredY += dy;
+    } else {
+        filteredX += dx / 4;
+        filteredY += dy / 4;
+    }
+}
@@ -6,6 +6,7 @@
 #include "input/TouchHandler.h"
 #include "config/DeviceConfig.h"
 #include "core/Logger.h"
+#include "utils/CommandTracer.h"
 
 extern Logger* logger;
 
@@ -63,6 +64,10 @@ bool TouchHandler::begin() {
     indev_drv.user_data = this;
     indev = lv_indev_drv_register(&indev_drv);
     
+    // Leitura mais frequente que o padrão do LVGL, mas só enquanto tocado
+    lv_timer_set_period(indev->driver->read_timer, TOUCH_SAMPLE_PERIOD);
+    stopSampling();
+    
     logger->info("Touch screen initialized successfully");
     logger->debug("Calibration: X[" + String(touchMinX) + "-" + String(touchMaxX) + 
                   "] Y[" + String(touchMinY) + "-" + String(touchMaxY) + "]");
@@ -70,77 +75,94 @@ bool TouchHandler::begin() {
     return true;
 }
 
+bool TouchHandler::update() {
+    if (sampling || !touchscreen || !indev) return false;
+    
+    // isrWake da biblioteca: setado pela borda de descida do IRQ
+    if (touchscreen->tirqTouched()) {
+        startSampling(millis());
+        return true;
+    }
+    return false;
+}
+
+void TouchHandler::startSampling(uint32_t now) {
+    sampling = true;
+    wakeTime = now;
+    released = false;
+    lastIrqTime = now;
+    lv_timer_resume(indev->driver->read_timer);
+    lv_timer_ready(indev->driver->read_timer);  // Primeira leitura no próximo lv_task_handler
+}
+
+void TouchHandler::stopSampling() {
+    sampling = false;
+    filter.reset();
+    lv_timer_pause(indev->driver->read_timer);
+}
+
 void TouchHandler::read(lv_indev_drv_t* indev_driver, lv_indev_data_t* data) {
-    if (!instance || !instance->touchscreen) {
+    TouchHandler* handler = (TouchHandler*)indev_driver->user_data;
+    if (!handler || !handler->touchscreen) {
         data->state = LV_INDEV_STATE_REL;
         return;
     }
     
-    TouchHandler* handler = (TouchHandler*)indev_driver->user_data;
     uint32_t now = millis();
+    TouchSample sample = {0, 0, 0, now};
     
-    // Ler estado raw do touch
-    bool rawPressed = false;
-    TS_Point p;
+    // Sem IRQ o painel está solto: amostra de pressão zero, sem SPI
+    if (handler->touchscreen->tirqTouched() && handler->touchscreen->touched()) {
+        TS_Point p = handler->touchscreen->getPoint();
+        sample.x = p.x;
+        sample.y = p.y;
+        sample.z = p.z;
+        handler->lastIrqTime = now;
+    }
     
-    if (handler->touchscreen->touched()) {
-        p = handler->touchscreen->getPoint();
-        
-        // Filtrar por pressão - threshold mais alto
-        if (p.z >= MIN_PRESSURE) {
-            rawPressed = true;
-        }
+    // Novo toque com a leitura ainda ativa (sem IRQ de acordar): latência
+    // conta da primeira amostra forte, não do IRQ do toque anterior
+    if (handler->released && sample.z >= TOUCH_MIN_PRESSURE) {
+        handler->released = false;
+        handler->wakeTime = now;
     }
     
-    // Filtro de estado para estabilização
-    if (rawPressed != handler->lastRawState) {
-        // Estado mudou, iniciar timer de confirmação
-        handler->lastRawState = rawPressed;
-        handler->stateChangeTime = now;
-        
-        // Debug raw values apenas na mudança
-        if (handler->debugEnabled && handler->logger) {
-            handler->logger->info("[TOUCH] State change detected: " + 
-                        String(rawPressed ? "PRESSED" : "RELEASED") + 
-                        " (pressure: " + String(p.z) + ")");
-        }
+    bool wasPressed = handler->filter.isPressed();
+    bool pressed = handler->filter.feed(sample);
+    if (wasPressed && !pressed) {
+        handler->released = true;
     }
     
-    // Confirmar mudança de estado após tempo de estabilização
-    if (handler->lastRawState != handler->touchState) {
-        if (now - handler->stateChangeTime >= STATE_CONFIRM_TIME) {
-            // Estado confirmado, aplicar mudança
-            handler->touchState = handler->lastRawState;
-            
+    if (pressed) {
+        int32_t x = map(handler->filter.getX(), handler->touchMinX, handler->touchMaxX, 0, SCREEN_WIDTH - 1);
+        int32_t y = map(handler->filter.getY(), handler->touchMinY, handler->touchMaxY, 0, SCREEN_HEIGHT - 1);
+        handler->lastPoint.x = constrain(x, 0, SCREEN_WIDTH - 1);
+        handler->lastPoint.y = constrain(y, 0, SCREEN_HEIGHT - 1);
+        
+        if (!wasPressed) {
+            handler->lastPressLatency = now - handler->wakeTime;
+            // Início do rastreio de latência do comando: o dedo no painel (IRQ)
+            CommandTracer::getInstance().markTouch(micros() - handler->lastPressLatency * 1000UL);
             if (handler->debugEnabled && handler->logger) {
-                handler->logger->info("[TOUCH] State confirmed: " + 
-                            String(handler->touchState ? "PRESSED" : "RELEASED"));
+                handler->logger->info("[TOUCH] PRESSED X=" + String(handler->lastPoint.x) +
+                                      ", Y=" + String(handler->lastPoint.y) +
+                                      " (" + String(handler->lastPressLatency) + "ms after IRQ)");
             }
+        } else if (handler->debugEnabled && handler->logger && now - handler->lastDebugTime > DEBUG_INTERVAL) {
+            handler->lastDebugTime = now;
+            handler->logger->info("[TOUCH] HOLD X=" + String(handler->lastPoint.x) +
+                                  ", Y=" + String(handler->lastPoint.y));
         }
+    } else if (wasPressed && handler->debugEnabled && handler->logger) {
+        handler->logger->info("[TOUCH] RELEASED");
     }
     
-    // Retornar estado estável
-    if (handler->touchState && rawPressed) {
-        // Mapear coordenadas apenas se realmente pressionado
-        data->point.x = map(p.x, handler->touchMinX, handler->touchMaxX, 0, SCREEN_WIDTH - 1);
-        data->point.y = map(p.y, handler->touchMinY, handler->touchMaxY, 0, SCREEN_HEIGHT - 1);
-        
-        // Constrain to screen bounds
-        data->point.x = constrain(data->point.x, 0, SCREEN_WIDTH - 1);
-        data->point.y = constrain(data->point.y, 0, SCREEN_HEIGHT - 1);
-        
-        data->state = LV_INDEV_STATE_PR;
-        
-        // Log apenas se debugEnabled
-        if (handler->debugEnabled && (now - handler->lastDebugTime > 1000)) {
-            handler->lastDebugTime = now;
-            if (handler->logger) {
-                handler->logger->info("[TOUCH] STABLE - X=" + String(data->point.x) + 
-                                    ", Y=" + String(data->point.y));
-            }
-        }
-    } else {
-        data->state = LV_INDEV_STATE_REL;
+    data->point = handler->lastPoint;
+    data->state = pressed ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
+    
+    // Solto e sem IRQ por um tempo: volta a dormir até a próxima borda
+    if (!pressed && now - handler->lastIrqTime >= TOUCH_IDLE_TIMEOUT) {
+        handler->stopSampling();
     }
 }
 
@@ -10,17 +10,29 @@
 #include <WiFi.h>
 #include <lvgl.h>
 #include <TFT_eSPI.h>
+#include <memory>
 
 // Core components
 #include "core/Logger.h"
 #include "core/MQTTClient.h"
 #include "core/ConfigManager.h"
+#include "core/ConfigStore.h"
+#include "core/Scheduler.h"
+#include "core/TaskTopology.h"
+#include "core/AsyncFetch.h"
 
 // UI components
 #include "ui/ScreenManager.h"
 #include "ui/ScreenFactory.h"
 #include "ui/IconManager.h"
 #include "ui/DataBinder.h"
+#include "ui/Theme.h"
+#include "ui/ProgressIndicator.h"
+
+// Display pipeline
+#include "display/DisplayPipeline.h"
+#include "display/TftDmaTransport.h"
+#include "display/RenderProfiler.h"
 
 // Navigation
 #include "navigation/Navigator.h"
@@ -40,6 +52,8 @@
 
 // Commands
 #include "commands/CommandSender.h"
+#include "commands/CommandAckTracker.h"
+#include "commands/CommandCoalescer.h"
 
 // Models
 #include "models/DeviceModels.h"
@@ -47,6 +61,8 @@
 // Include device configuration
 #include "config/DeviceConfig.h"
 #include "utils/DeviceUtils.h"
+#include "utils/MemoryMonitor.h"
+#include "runtime_stats.h"
 
 // Display
 static TFT_eSPI tft = TFT_eSPI();
@@ -54,11 +70,15 @@ static const uint16_t screenWidth = 320;   // 320 pixels após rotação
 static const uint16_t screenHeight = 240; // 240 pixels após rotação
 
 // LVGL
-static lv_disp_draw_buf_t draw_buf;
-static lv_color_t buf[screenWidth * 10];
-static lv_disp_drv_t disp_drv;
 static lv_indev_drv_t indev_drv;
 
+// Flush assíncrono com buffer duplo (DMA)
+static TftDmaTransport* tftTransport = nullptr;
+DisplayPipeline* displayPipeline = nullptr;
+
+// Perfil de render/invalidação (publicado em telemetry/render)
+RenderProfiler* renderProfiler = nullptr;
+
 // Global logger (used by all modules)
 Logger* logger = nullptr;
 
@@ -77,27 +97,32 @@ ScreenApiClient* screenApiClient = nullptr;
 IconManager* iconManager = nullptr;
 
 // State
-static bool configReceived = false;
-static unsigned long lastStatusReport = 0;
-static unsigned long lastConfigRequest = 0;
+static volatile uint32_t builtConfigHash = 0;   // Config com que a UI foi montada
+static bool networkConfigLoaded = false;        // Config já veio da API/MQTT neste boot
 
-/**
- * LVGL display flushing
- */
-void my_disp_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p) {
-    uint32_t w = (area->x2 - area->x1 + 1);
-    uint32_t h = (area->y2 - area->y1 + 1);
+// Subida da rede em segundo plano (job "bringup" da tarefa de rede)
+enum BringupStage : uint8_t { BRINGUP_WIFI, BRINGUP_REGISTER, BRINGUP_MQTT, BRINGUP_DONE };
+static volatile BringupStage bringupStage = BRINGUP_WIFI;
 
-    tft.startWrite();
-    tft.setAddrWindow(area->x1, area->y1, w, h);
-    tft.pushColors((uint16_t *)&color_p->full, w * h, true);
-    tft.endWrite();
+// Registro e carga da config: tentativas com backoff em jobs da rede
+static AsyncFetch registrationFetch("registration");
+static AsyncFetch configFetch("config_fetch");
 
-    lv_disp_flush_ready(disp);
-}
+// Faixa "Baixando configuracao..." sobre a tela (tarefa de UI)
+static ProgressIndicator networkProgress;
+
+void onConfigReceived();
+
+// Jobs das tarefas de UI e rede (ver setupScheduler)
+static Scheduler::JobId lvglJob = Scheduler::INVALID_JOB;
+static Scheduler::JobId configRetryJob = Scheduler::INVALID_JOB;
+static Scheduler::JobId heartbeatJob = Scheduler::INVALID_JOB;
+static Scheduler::JobId commandAckJob = Scheduler::INVALID_JOB;
+static Scheduler::JobId commandQueueJob = Scheduler::INVALID_JOB;
+static Scheduler::JobId bringupJob = Scheduler::INVALID_JOB;
 
 /**
- * Button input read for LVGL
+ * Button input read for LVGL (estado debounced do ButtonHandler, sem GPIO)
  */
 void button_read(lv_indev_drv_t * indev_drv, lv_indev_data_t * data) {
     static uint32_t last_key = 0;
@@ -115,13 +140,10 @@ void button_read(lv_indev_drv_t * indev_drv, lv_indev_data_t * data) {
 }
 
 /**
- * Callback executado após WiFi conectar com sucesso
+ * Registro terminou (sucesso ou tentativas esgotadas) (tarefa de rede)
  */
-void onWiFiConnected() {
-    logger->info("WiFi connected! Starting device registration...");
-    
-    // Executar smart registration
-    if (DeviceRegistration::performSmartRegistration()) {
+void onRegistrationDone(bool registered) {
+    if (registered) {
         logger->info("Device registration completed successfully");
         
         // Tentar carregar credenciais MQTT dinâmicas
@@ -136,61 +158,27 @@ void onWiFiConnected() {
 }
 
 /**
- * Setup WiFi connection
+ * Setup WiFi connection (não bloqueia: a tarefa de rede acompanha a conexão)
  */
 void setupWiFi() {
     logger->info("Connecting to WiFi: " + String(WIFI_SSID));
     
     WiFi.mode(WIFI_STA);
     WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-    
-    // Show connecting screen
-    lv_obj_t* scr = lv_scr_act();
-    lv_obj_t* label = lv_label_create(scr);
-    lv_label_set_text(label, "Conectando WiFi...");
-    lv_obj_center(label);
-    
-    while (WiFi.status() != WL_CONNECTED) {
-        delay(500);
-        logger->debug(".");
-        lv_task_handler();
-    }
-    
-    logger->info("WiFi connected! IP: " + WiFi.localIP().toString());
-    lv_label_set_text(label, ("WiFi OK\nIP: " + WiFi.localIP().toString()).c_str());
-    lv_task_handler();
-    delay(1000);
 }
 
 /**
- * Setup API client
+ * Setup API client (conectividade testada na subida da rede)
  */
 void setupApiClient() {
     logger->info("Setting up API client");
     logger->debug("API Server: " + String(API_PROTOCOL) + "://" + String(API_SERVER) + ":" + String(API_PORT) + String(API_BASE_PATH));
     
-    // Initialize API client
     screenApiClient = new ScreenApiClient();
-    
-    if (screenApiClient->begin()) {
-        logger->info("API client initialized successfully");
-        
-        // Initialize device registry singleton
-        DeviceRegistry::getInstance();
-        logger->info("Device registry initialized");
-        
-        return;
-    } else {
-        logger->warning("API client initialization failed, will use MQTT fallback");
-        logger->debug("API Error: " + screenApiClient->getLastError());
-        
-        // Don't delete the client - keep it for potential retry
-        // Just log the failure and continue
-    }
 }
 
 /**
- * Setup MQTT connection
+ * Setup MQTT client e componentes de comunicação (sem acesso à rede)
  */
 void setupMQTT() {
     logger->info("Setting up MQTT client");
@@ -202,96 +190,205 @@ void setupMQTT() {
     
     mqttClient = new MQTTClient(deviceUUID, MQTT_BROKER, MQTT_PORT);
     
-    // Executar device registration e carregar credenciais MQTT dinâmicas
-    onWiFiConnected();
-    
     configReceiver = new ConfigReceiver(mqttClient, configManager, screenApiClient);
     statusReporter = new StatusReporter(mqttClient, deviceUUID);
     commandSender = new CommandSender(mqttClient, logger, deviceUUID);
     buttonStateManager = new ButtonStateManager(mqttClient, screenManager);
     
-    // Show connecting screen
-    lv_obj_t* scr = lv_scr_act();
-    lv_obj_t* label = lv_label_create(scr);
-    lv_label_set_text(label, "Conectando MQTT...");
-    lv_obj_center(label);
-    lv_task_handler();
-    
-    if (mqttClient->connect()) {
-        logger->info("MQTT connected!");
-        lv_label_set_text(label, "MQTT Conectado!");
-        
-        // Setup config receiver
-        configReceiver->begin();
-        
-        // Setup button state manager
-        buttonStateManager->begin();
-        
-        // Enable hot reload with callback
-        configReceiver->enableHotReload([]() {
-            logger->info("Hot reload triggered! Rebuilding UI...");
-            
-            // Update icons from configuration if available
-            if (iconManager && configManager->hasConfig()) {
-                JsonDocument config = configManager->getConfig();
-                if (config["icons"].is<JsonObject>()) {
-                    iconManager->loadFromConfig(config["icons"].as<JsonObject>());
-                    logger->info("Icons updated during hot reload");
-                } else if (screenApiClient) {
-                    // Try to load icons from API if not in config
-                    iconManager->loadFromApi(screenApiClient);
-                }
-            }
-            
-            // Rebuild UI with new configuration
-            if (screenManager && configManager->hasConfig()) {
-                screenManager->buildFromConfig(configManager->getConfig());
-                
-                // Navigate back to home or current screen
-                if (navigator) {
-                    String currentScreen = navigator->getCurrentScreen();
-                    navigator->navigateToScreen(currentScreen);
-                }
-                
-                // Visual feedback - flash green LED
-                digitalWrite(LED_G_PIN, LOW);
-                delay(100);
-                digitalWrite(LED_G_PIN, HIGH);
-            }
+    // Avisos de fragmentação saem imediatamente por MQTT
+    MemoryMonitor::getInstance().setWarningCallback([](const MemoryMonitor::Snapshot& snapshot, uint8_t reasons) {
+        if (statusReporter) statusReporter->publishMemoryWarning(snapshot, reasons);
+    });
+}
+
+/**
+ * Ícones da configuração atual (ou da API, se a config não trouxer)
+ *
+ * Roda na tarefa de rede (HTTP da API aqui); o mapa de overrides do
+ * IconManager é lido pelos widgets, então a troca é feita na tarefa de UI,
+ * antes do rebuildUI que vem em seguida pela mesma caixa de entrada.
+ */
+void loadIcons() {
+    ConfigSnapshot config = configManager->snapshot();
+    if (!iconManager || !config) return;
+    
+    if (config->doc["icons"].is<JsonObjectConst>()) {
+        // O handle mantém o snapshot vivo até a UI aplicar
+        Scheduler::ui().dispatch([config]() {
+            iconManager->loadFromConfig(config->doc["icons"].as<JsonObjectConst>());
+            logger->info("Icons loaded from configuration");
         });
-        
-        // Load initial configuration using new combined method (API first, MQTT fallback)
-        logger->info("Loading initial configuration...");
-        if (configReceiver->loadConfiguration()) {
-            logger->info("Initial configuration loaded successfully");
-            
-            // Load icons after initial configuration
-            if (iconManager) {
-                JsonDocument config = configManager->getConfig();
-                if (config["icons"].is<JsonObject>()) {
-                    iconManager->loadFromConfig(config["icons"].as<JsonObject>());
-                    logger->info("Icons loaded from configuration");
-                } else if (screenApiClient) {
-                    // Try to load icons from API
-                    if (iconManager->loadFromApi(screenApiClient)) {
-                        logger->info("Icons loaded from API");
-                    } else {
-                        logger->warning("Failed to load icons from API, using defaults");
-                    }
+    } else if (screenApiClient && mqttClient->isConnected()) {
+        // Try to load icons from API
+        std::shared_ptr<JsonDocument> icons = std::make_shared<JsonDocument>();
+        if (screenApiClient->getIcons(*icons)) {
+            Scheduler::ui().dispatch([icons]() {
+                if (iconManager->loadFromConfig(icons->as<JsonObjectConst>())) {
+                    logger->info("Icons loaded from API");
+                } else {
+                    logger->warning("Invalid icons from API, using defaults");
                 }
-            }
+            });
         } else {
-            logger->warning("Failed to load initial configuration, will retry periodically");
+            logger->warning("Failed to load icons from API, using defaults");
         }
-        lastConfigRequest = millis();
-        
-    } else {
+    }
+}
+
+/**
+ * Grava a config aplicada como "última boa" (tarefa de UI)
+ */
+void persistAppliedConfig(const ConfigSnapshot& config) {
+    uint32_t hash = config->hash;
+    builtConfigHash = hash;
+    if (hash == ConfigStore::getInstance().getStoredHash()) return;
+    
+    // Serializa e grava na tarefa de rede (a UI não trava); o handle
+    // mantém o snapshot vivo mesmo que outro reload chegue antes
+    Scheduler::network().dispatch([config]() {
+        String json;
+        serializeJson(config->doc, json);
+        ConfigStore::getInstance().save(json, config->hash);
+    });
+}
+
+/**
+ * Reconstrói a UI com a configuração atual (tarefa de UI)
+ */
+void rebuildUI() {
+    ConfigSnapshot config = configManager->snapshot();
+    if (!screenManager || !config) return;
+    screenManager->buildFromConfig(config);
+    
+    // Navigate back to home or current screen
+    if (navigator) {
+        String currentScreen = navigator->getCurrentScreen();
+        navigator->navigateToScreen(currentScreen);
+    }
+    
+    persistAppliedConfig(config);
+    
+    // Visual feedback - flash green LED
+    digitalWrite(LED_G_PIN, LOW);
+    delay(100);
+    digitalWrite(LED_G_PIN, HIGH);
+}
+
+/**
+ * Hot reload: config nova já carregada pela tarefa de rede
+ */
+void onConfigHotReload() {
+    logger->info("Hot reload triggered! Rebuilding UI...");
+    
+    // Update icons from configuration if available
+    loadIcons();
+    
+    // Rebuild UI with new configuration (widgets só na tarefa de UI)
+    Scheduler::ui().dispatch(rebuildUI);
+}
+
+/**
+ * Um passo da carga da config (tarefa de rede): ícones da API ainda aqui,
+ * antes de a conclusão ir para a UI
+ */
+AsyncFetch::Step configFetchStep() {
+    AsyncFetch::Step step = configReceiver->loadStep();
+    if (step == AsyncFetch::DONE && configManager->getContentHash() != builtConfigHash) {
+        loadIcons();
+    }
+    return step;
+}
+
+/**
+ * Carga da config terminou (tarefa de UI)
+ */
+void onConfigFetched(bool ok) {
+    if (!ok) {
+        logger->warning("Failed to load configuration, will retry periodically");
+        return;
+    }
+    networkConfigLoaded = true;
+    logger->info("Configuration loaded successfully");
+    
+    if (builtConfigHash == 0) {
+        // Primeira config (nada no flash): monta a UI
+        onConfigReceived();
+    } else if (configManager->getContentHash() != builtConfigHash) {
+        // Diferente da cópia do flash com que a UI subiu: caminho do hot reload
+        logger->info("Hot reload triggered! Rebuilding UI...");
+        rebuildUI();
+    }
+}
+
+/**
+ * Busca a configuração (API, fallback MQTT) em segundo plano; qualquer tarefa
+ */
+void startConfigFetch() {
+    configFetch.start(configFetchStep, onConfigFetched);
+}
+
+/**
+ * Interrompe a carga em andamento (ex.: MQTT caiu) (tarefa de rede)
+ */
+void cancelConfigFetch() {
+    if (!configFetch.isActive()) return;
+    configFetch.cancel();
+    configReceiver->cancelLoad();
+}
+
+/**
+ * Conecta o MQTT e busca a configuração (tarefa de rede)
+ * @return false se o broker não respondeu (a subida tenta de novo)
+ */
+bool connectMQTT() {
+    if (!mqttClient->connect()) {
         logger->error("Failed to connect to MQTT!");
-        lv_label_set_text(label, "Erro MQTT!");
+        return false;
     }
+    logger->info("MQTT connected!");
+    
+    // Setup config receiver
+    configReceiver->begin();
+    
+    // Setup button state manager
+    buttonStateManager->begin();
+    
+    // Enable hot reload with callback
+    configReceiver->enableHotReload(onConfigHotReload);
+    configReceiver->setReloadHandler(startConfigFetch);
+    
+    // Load configuration using combined method (API first, MQTT fallback)
+    logger->info("Loading configuration...");
+    startConfigFetch();
+    return true;
+}
+
+/**
+ * Monta a UI com a última configuração boa do flash, sem esperar a rede
+ * @return false se não houver cópia válida (tela de espera)
+ */
+bool bootFromLastGood() {
+    ConfigStore& store = ConfigStore::getInstance();
+    String json;
+    if (!store.begin() || !store.load(json)) {
+        logger->info("No last-good configuration stored");
+        return false;
+    }
+    
+    if (!configManager->loadConfig(json)) {
+        logger->warning("Stored configuration is invalid, discarding");
+        store.clear();
+        return false;
+    }
+    
+    // Sem resposta da API: relay_board -> device vem da própria cópia.
+    // Setup, tarefas ainda paradas: troca direto, a UI é montada logo abaixo
+    DeviceRegistry::getInstance()->replace(ScreenApiClient::parseDevices(configManager->snapshot()->doc));
     
-    lv_task_handler();
-    delay(1000);
+    loadIcons();
+    onConfigReceived();
+    logger->info("UI ready from last-good configuration in " + String(millis()) + "ms");
+    return true;
 }
 
 /**
@@ -319,16 +416,20 @@ void setupDisplay() {
     // Initialize LVGL
     lv_init();
     
-    // Initialize display buffer
-    lv_disp_draw_buf_init(&draw_buf, buf, NULL, screenWidth * 10);
+    // Estilos compartilhados do tema (antes de criar qualquer widget)
+    theme_init();
     
-    // Initialize display driver
-    lv_disp_drv_init(&disp_drv);
-    disp_drv.hor_res = screenWidth;
-    disp_drv.ver_res = screenHeight;
-    disp_drv.flush_cb = my_disp_flush;
-    disp_drv.draw_buf = &draw_buf;
-    lv_disp_drv_register(&disp_drv);
+    // Initialize display driver (dois buffers, envio por DMA)
+    tftTransport = new TftDmaTransport(tft);
+    displayPipeline = new DisplayPipeline(tftTransport, screenWidth, screenHeight, LVGL_BUFFER_LINES);
+    if (!displayPipeline->begin()) {
+        logger->error("Failed to initialize display pipeline!");
+    }
+    
+#if RENDER_PROFILER_ENABLED
+    renderProfiler = new RenderProfiler(screenWidth, screenHeight);
+    displayPipeline->setProfiler(renderProfiler);
+#endif
     
     // Initialize input device driver for buttons
     lv_indev_drv_init(&indev_drv);
@@ -386,8 +487,10 @@ void showWaitingScreen() {
     lv_obj_align(spinner, LV_ALIGN_CENTER, 0, 40);
 }
 
-// Forward declaration
+// Forward declarations
 void lv_tick_task(void * pvParameters);
+void setupScheduler();
+void setupTasks();
 
 /**
  * Arduino setup
@@ -411,6 +514,9 @@ void setup() {
     logger = new Logger(logLevel);
     logger->info("=== AutoCore HMI Display v2 ===");
     
+    // CPU por core/tarefa, loops e frames: primeira janela já no boot
+    runtime_stats_init();
+    
     // Generate and log device info
     String deviceUUID = DeviceUtils::getDeviceUUID();
     String deviceInfo = DeviceUtils::getChipInfo();
@@ -428,9 +534,9 @@ void setup() {
     pinMode(LED_G_PIN, OUTPUT);
     pinMode(LED_B_PIN, OUTPUT);
     
-    // Status LED - Red (initializing)
+    // Status LED - Yellow (waiting for config)
     digitalWrite(LED_R_PIN, HIGH);
-    digitalWrite(LED_G_PIN, LOW);
+    digitalWrite(LED_G_PIN, HIGH);
     digitalWrite(LED_B_PIN, LOW);
     
     // Initialize display
@@ -439,35 +545,23 @@ void setup() {
     // Initialize UI components
     setupUI();
     
-    // Connect to WiFi
+    // WiFi, API e MQTT só são criados aqui; a conexão segue na tarefa de rede
     setupWiFi();
-    
-    // Setup API client
     setupApiClient();
-    
-    // Connect to MQTT
     setupMQTT();
     
-    // Show waiting screen
-    showWaitingScreen();
+    // Instant-on: UI da última config boa, ou tela de espera
+    if (!bootFromLastGood()) {
+        showWaitingScreen();
+    }
     
-    // Status LED - Yellow (waiting for config)
-    digitalWrite(LED_R_PIN, HIGH);
-    digitalWrite(LED_G_PIN, HIGH);
-    digitalWrite(LED_B_PIN, LOW);
+    // Jobs das tarefas de UI e rede (registrados antes de as tarefas subirem)
+    setupScheduler();
     
     logger->info("Setup complete, waiting for configuration...");
     
-    // Create LVGL tick task
-    xTaskCreatePinnedToCore(
-        lv_tick_task,   // Task function
-        "lv_tick",      // Name
-        1024,           // Stack size
-        NULL,           // Parameters
-        1,              // Priority
-        NULL,           // Task handle
-        0               // Core
-    );
+    // UI no UI_TASK_CORE, rede no NET_TASK_CORE
+    setupTasks();
 }
 
 /**
@@ -483,93 +577,350 @@ void lv_tick_task(void * pvParameters) {
 }
 
 /**
- * Arduino main loop
+ * Configuração recebida: monta a UI (tarefa de UI)
  */
-void loop() {
-    // Handle LVGL
-    lv_task_handler();
+void onConfigReceived() {
+    logger->info("Configuration received! Building UI...");
     
-    // Update dynamic widgets (gauges, displays) with fresh data
-    extern DataBinder* dataBinder;
-    if (dataBinder) {
-        dataBinder->updateAll();
+    // Build UI from configuration (as telas seguram o snapshot)
+    ConfigSnapshot config = configManager->snapshot();
+    screenManager->buildFromConfig(config);
+    
+    // Navigate to home screen
+    navigator->navigateToScreen("home");
+    
+    persistAppliedConfig(config);
+    
+    // Status LED - Green (operational)
+    digitalWrite(LED_R_PIN, LOW);
+    digitalWrite(LED_G_PIN, HIGH);
+    digitalWrite(LED_B_PIN, LOW);
+}
+
+/**
+ * Texto do indicador a partir do estado da rede (tarefa de UI)
+ */
+void updateNetworkProgress() {
+    const AsyncFetch* fetch = nullptr;
+    const char* what = nullptr;
+    
+    if (registrationFetch.isActive()) {
+        fetch = &registrationFetch;
+        what = "Registrando dispositivo";
+    } else if (configFetch.isActive()) {
+        fetch = &configFetch;
+        what = "Baixando configuracao";
+    } else if (bringupStage == BRINGUP_WIFI) {
+        what = "Conectando WiFi";
+    } else if (bringupStage == BRINGUP_MQTT || (bringupStage == BRINGUP_DONE && !mqttClient->isConnected())) {
+        what = "Conectando MQTT";
+    }
+    
+    if (!what) {
+        networkProgress.hide();
+        return;
     }
     
-    // Handle buttons
-    buttonHandler->update();
+    char text[64];
+    if (fetch && fetch->getState() == AsyncFetch::BACKOFF) {
+        snprintf(text, sizeof(text), "%s: nova tentativa em %lus (%u/%u)", what,
+                 (unsigned long)((fetch->getRetryIn() + 999) / 1000),
+                 (unsigned)fetch->getAttempt(), (unsigned)fetch->getMaxAttempts());
+    } else if (fetch && fetch->getAttempt() > 1) {
+        snprintf(text, sizeof(text), "%s (%u/%u)...", what,
+                 (unsigned)fetch->getAttempt(), (unsigned)fetch->getMaxAttempts());
+    } else {
+        snprintf(text, sizeof(text), "%s...", what);
+    }
+    networkProgress.show(text);
+}
+
+/**
+ * Job do setup sem slot no escalonador nunca rodaria (heartbeat, acks e fila
+ * de comandos parados em silêncio): para o boot aqui
+ */
+Scheduler::JobId requiredJob(Scheduler::JobId id) {
+    if (id != Scheduler::INVALID_JOB) return id;
+    logger->error("FATAL: scheduler full during setup, raise Scheduler::MAX_JOBS");
+    delay(100);     // Deixa o log sair pela serial
+    abort();
+}
+
+/**
+ * Registra os jobs das tarefas de UI e de rede
+ *
+ * Cada rotina roda no próprio deadline em vez de ser testada a cada 5ms;
+ * cada tarefa dorme até o próximo deadline ou até uma notificação.
+ * LVGL e tudo que mexe em widgets ficam na UI; socket MQTT, HTTP e parse
+ * das configurações ficam na rede. Entre elas só Scheduler::dispatch().
+ */
+void setupScheduler() {
+    Scheduler& ui = Scheduler::ui();
+    Scheduler& net = Scheduler::network();
     
-    // Handle MQTT
-    if (mqttClient && mqttClient->isConnected()) {
-        mqttClient->loop();
-        
-        // Process heartbeats for momentary buttons
-        if (commandSender) {
-            commandSender->processHeartbeats();
+    // ---- UI ----------------------------------------------------------------
+    
+    // LVGL: o próprio lv_task_handler diz quando precisa rodar de novo
+    lvglJob = requiredJob(ui.every("lvgl", LVGL_TICK_PERIOD, []() {
+        if (displayPipeline) {
+            displayPipeline->poll();
         }
+        uint32_t next = lv_task_handler();
         
-        // Check if we received configuration
-        if (!configReceived && configManager->hasConfig()) {
-            logger->info("Configuration received! Building UI...");
-            
-            // Build UI from configuration
-            screenManager->buildFromConfig(configManager->getConfig());
-            
-            // Navigate to home screen
-            navigator->navigateToScreen("home");
-            
-            configReceived = true;
-            
-            // Status LED - Green (operational)
-            digitalWrite(LED_R_PIN, LOW);
-            digitalWrite(LED_G_PIN, HIGH);
-            digitalWrite(LED_B_PIN, LOW);
+        // Flush DMA em andamento: liberar o buffer assim que terminar
+        if (displayPipeline && displayPipeline->isFlushing()) {
+            next = 1;
         }
-        
-        // Send periodic status reports
-        if (millis() - lastStatusReport > STATUS_REPORT_INTERVAL) {
-            statusReporter->sendStatus(
-                navigator->getCurrentScreen(),
-                100, // backlight
-                WiFi.RSSI()
-            );
-            lastStatusReport = millis();
+        Scheduler::ui().reschedule(lvglJob, min<uint32_t>(next, SCHEDULER_MAX_SLEEP));
+    }));
+    
+    // IRQ do touch é da biblioteca XPT2046 (sem callback): consulta periódica
+    // barata do flag; ao retomar a leitura o LVGL roda já
+    requiredJob(ui.every("input", TOUCH_SAMPLE_PERIOD, []() {
+        if (touchHandler && touchHandler->update()) {
+            Scheduler::ui().reschedule(lvglJob, 0);
         }
-        
-        // Request config if not received
-        if (!configReceived && millis() - lastConfigRequest > CONFIG_REQUEST_INTERVAL) {
-            logger->warning("No config received, trying to load again...");
-            if (configReceiver->loadConfiguration()) {
-                logger->info("Configuration loaded on retry");
-            } else {
-                logger->warning("Configuration retry failed, will try again later");
-            }
-            lastConfigRequest = millis();
+    }));
+    
+    // Rotinas com guarda de intervalo interna: contadas do fim da execução
+    requiredJob(ui.everyAfter("memory", MEMORY_MONITOR_INTERVAL, []() {
+        MemoryMonitor::getInstance().update();
+    }));
+    
+    // Update dynamic widgets (gauges, displays) with fresh data
+    requiredJob(ui.everyAfter("data_binder", DataBinder::GLOBAL_UPDATE_INTERVAL, []() {
+        extern DataBinder* dataBinder;
+        if (dataBinder) {
+            dataBinder->updateAll();
+        }
+    }));
+    
+    // Heartbeats dos botões momentâneos: pausado sem canal ativo
+    heartbeatJob = requiredJob(ui.every("heartbeat", HEARTBEAT_INTERVAL_MS, []() {
+        uint32_t next = commandSender ? commandSender->processHeartbeats() : CommandSender::NO_HEARTBEAT;
+        Scheduler& s = Scheduler::ui();
+        if (next == CommandSender::NO_HEARTBEAT) {
+            s.pause(heartbeatJob);
+        } else {
+            s.reschedule(heartbeatJob, next);
+        }
+    }));
+    ui.pause(heartbeatJob);
+    if (commandSender) {
+        commandSender->setHeartbeatJob(heartbeatJob);
+    }
+    
+    // Reenvio/timeout dos comandos sem confirmação: pausado sem comandos em voo
+    commandAckJob = requiredJob(ui.every("command_acks", COMMAND_ACK_TIMEOUT, []() {
+        uint32_t next = CommandAckTracker::getInstance().process();
+        Scheduler& s = Scheduler::ui();
+        if (next == CommandAckTracker::NO_DEADLINE) {
+            s.pause(commandAckJob);
+        } else {
+            s.reschedule(commandAckJob, next);
+        }
+    }));
+    ui.pause(commandAckJob);
+    CommandAckTracker::getInstance().setJob(commandAckJob);
+    
+    // Comandos coalescidos/limitados: pausado com a fila vazia
+    commandQueueJob = requiredJob(ui.every("command_queue", COMMAND_COALESCE_MS, []() {
+        uint32_t next = CommandCoalescer::getInstance().process();
+        Scheduler& s = Scheduler::ui();
+        if (next == CommandCoalescer::NO_DEADLINE) {
+            s.pause(commandQueueJob);
+        } else {
+            s.reschedule(commandQueueJob, next);
+        }
+    }));
+    ui.pause(commandQueueJob);
+    CommandCoalescer::getInstance().setJob(commandQueueJob);
+    
+    // Telemetria lê estado da UI; a publicação segue para a tarefa de rede
+    requiredJob(ui.every("status", STATUS_REPORT_INTERVAL, []() {
+        if (!mqttClient->isConnected()) return;
+        statusReporter->sendStatus(
+            navigator->getCurrentScreen(),
+            100, // backlight
+            WiFi.RSSI()
+        );
+    }));
+    
+    requiredJob(ui.everyAfter("render_profile", RENDER_PROFILE_INTERVAL, []() {
+        if (mqttClient->isConnected()) statusReporter->publishRenderProfile();
+    }, RENDER_PROFILE_INTERVAL));
+    
+    requiredJob(ui.everyAfter("latency_profile", LATENCY_PROFILE_INTERVAL, []() {
+        if (mqttClient->isConnected()) statusReporter->publishLatencyProfile();
+    }, LATENCY_PROFILE_INTERVAL));
+    
+    // Métricas (inclui escalonadores e pilhas das tarefas)
+    requiredJob(ui.everyAfter("performance", PERFORMANCE_TELEMETRY_INTERVAL, []() {
+        if (mqttClient->isConnected()) statusReporter->publishPerformanceTelemetry();
+    }, PERFORMANCE_TELEMETRY_INTERVAL));
+    
+    requiredJob(ui.every("tasks", TASK_MONITOR_INTERVAL, []() {
+        TaskTopology::getInstance().check();
+    }, TASK_MONITOR_INTERVAL));
+    
+    // Fecha a janela do runtime_stats (CPU, pilhas, loops, frames) e publica no health
+    requiredJob(ui.everyAfter("runtime_stats", RUNTIME_STATS_INTERVAL, []() {
+        runtime_stats_sample();
+        if (mqttClient->isConnected()) statusReporter->publishHealthStatus();
+    }, RUNTIME_STATS_INTERVAL));
+    
+    // Progresso da rede sobre a tela; a UI só lê o estado, nunca espera
+    requiredJob(ui.every("progress", PROGRESS_UPDATE_INTERVAL, updateNetworkProgress));
+    
+    // ---- Rede --------------------------------------------------------------
+    
+    // WiFi -> registro/API -> MQTT + config, sem bloquear a UI
+    bringupJob = requiredJob(net.every("bringup", NETWORK_BRINGUP_POLL, []() {
+        if (bringupStage == BRINGUP_WIFI) {
+            if (WiFi.status() != WL_CONNECTED) return;
+            logger->info("WiFi connected! IP: " + WiFi.localIP().toString());
+            
+            // Registro em segundo plano: backoff entre tentativas não segura a rede
+            logger->info("Starting device registration...");
+            registrationFetch.start([]() {
+                return DeviceRegistration::performSmartRegistration() ? AsyncFetch::DONE : AsyncFetch::RETRY;
+            });
+            bringupStage = BRINGUP_REGISTER;
+            return;
         }
         
-    } else {
-        // Try to reconnect
-        static unsigned long lastReconnect = 0;
-        if (millis() - lastReconnect > MQTT_RECONNECT_DELAY) {
-            logger->warning("MQTT disconnected, attempting reconnect...");
+        if (bringupStage == BRINGUP_REGISTER) {
+            if (registrationFetch.isActive()) return;
             
-            if (mqttClient->connect()) {
-                logger->info("MQTT reconnected!");
+            // Credenciais MQTT dinâmicas (ou estáticas, se o registro falhou)
+            onRegistrationDone(registrationFetch.getState() == AsyncFetch::SUCCEEDED);
+            
+            if (screenApiClient->begin()) {
+                logger->info("API client initialized successfully");
                 
-                // Re-load configuration if needed
-                if (!configReceived) {
-                    configReceiver->loadConfiguration();
-                    lastConfigRequest = millis();
-                }
+                // Initialize device registry singleton
+                DeviceRegistry::getInstance();
+            } else {
+                logger->warning("API client initialization failed, will use MQTT fallback");
+                logger->debug("API Error: " + screenApiClient->getLastError());
             }
-            
-            lastReconnect = millis();
+            bringupStage = BRINGUP_MQTT;
+        }
+        
+        if (!connectMQTT()) {
+            Scheduler::network().reschedule(bringupJob, MQTT_RECONNECT_DELAY);
+            return;
         }
+        bringupStage = BRINGUP_DONE;
+        Scheduler::network().pause(bringupJob);
+    }));
+    
+    requiredJob(net.every("mqtt", MQTT_POLL_INTERVAL, []() {
+        if (mqttClient->isConnected()) {
+            mqttClient->loop();
+        }
+    }));
+    
+    // Request config if not received (HTTP + parse nesta tarefa); com a UI
+    // do flash continua tentando até a rede confirmar a versão atual
+    configRetryJob = requiredJob(net.every("config_retry", CONFIG_REQUEST_INTERVAL, []() {
+        if (networkConfigLoaded) {
+            Scheduler::network().pause(configRetryJob);
+            return;
+        }
+        if (bringupStage != BRINGUP_DONE || !mqttClient->isConnected() || configFetch.isActive()) return;
+        logger->warning("No config received, trying to load again...");
+        startConfigFetch();
+    }, CONFIG_REQUEST_INTERVAL));
+    
+    requiredJob(net.every("mqtt_reconnect", MQTT_RECONNECT_DELAY, []() {
+        if (bringupStage != BRINGUP_DONE || mqttClient->isConnected()) return;
         
         // Status LED - Red (disconnected)
         digitalWrite(LED_R_PIN, HIGH);
         digitalWrite(LED_G_PIN, LOW);
         digitalWrite(LED_B_PIN, LOW);
+        
+        // Resposta MQTT da carga não chega mais: recomeça após reconectar
+        cancelConfigFetch();
+        
+        logger->warning("MQTT disconnected, attempting reconnect...");
+        if (mqttClient->connect()) {
+            logger->info("MQTT reconnected!");
+            
+            // Re-load configuration if needed
+            if (!networkConfigLoaded) {
+                startConfigFetch();
+                Scheduler::network().reschedule(configRetryJob, CONFIG_REQUEST_INTERVAL);
+            }
+        }
+    }, MQTT_RECONNECT_DELAY));
+}
+
+/**
+ * Tarefa de UI: LVGL, touch, botões e widgets
+ */
+void uiTask(void* pvParameters) {
+    (void) pvParameters;
+    Scheduler& scheduler = Scheduler::ui();
+    scheduler.begin();
+    int loopTiming = runtime_stats_timing("ui_loop");
+    
+    while (1) {
+        uint32_t start = micros();
+        
+        // Eventos dos botões (enfileirados pelas interrupções, sem ler GPIO)
+        buttonHandler->update();
+        
+        // Jobs vencidos e mensagens da rede; dorme até o próximo deadline
+        uint32_t idle = scheduler.runDue(SCHEDULER_MAX_SLEEP);
+        runtime_stats_record(loopTiming, micros() - start);
+        scheduler.waitNext(idle);
+    }
+}
+
+/**
+ * Tarefa de rede: MQTT, HTTP da API e parse das mensagens
+ */
+void networkTask(void* pvParameters) {
+    (void) pvParameters;
+    Scheduler& scheduler = Scheduler::network();
+    scheduler.begin();
+    int loopTiming = runtime_stats_timing("net_loop");
+    int queueGauge = runtime_stats_gauge("mqtt_queue");
+    
+    while (1) {
+        // Publishes da UI esperando na caixa de entrada ao acordar
+        runtime_stats_set(queueGauge, scheduler.getPendingMessages());
+        
+        uint32_t start = micros();
+        uint32_t idle = scheduler.runDue(SCHEDULER_MAX_SLEEP);
+        runtime_stats_record(loopTiming, micros() - start);
+        scheduler.waitNext(idle);
     }
+}
+
+/**
+ * Sobe as tarefas fixadas nos cores (pilhas do DeviceConfig)
+ */
+void setupTasks() {
+    TaskTopology& tasks = TaskTopology::getInstance();
+    
+    // Tick acima da UI e no mesmo core, para o relógio do LVGL não atrasar
+    tasks.spawn("lv_tick", lv_tick_task, LVGL_TICK_TASK_STACK, LVGL_TICK_TASK_PRIORITY, UI_TASK_CORE);
     
-    delay(5);
-}
\ No newline at end of file
+    // Cada tarefa faz begin() na primeira linha, antes do primeiro runDue():
+    // até lá o dispatch de qualquer origem só enfileira e ela drena ao começar
+    tasks.spawn("ui", uiTask, UI_TASK_STACK, UI_TASK_PRIORITY, UI_TASK_CORE);
+    tasks.spawn("network", networkTask, NET_TASK_STACK, NET_TASK_PRIORITY, NET_TASK_CORE);
+}
+
+/**
+ * Arduino main loop
+ *
+ * Todo o trabalho está nas tarefas de UI e rede; a loopTask se encerra
+ * para devolver a pilha.
+ */
+void loop() {
+    vTaskDelete(NULL);
+}
@@ -0,0 +1,267 @@
+/**
+ * @file NativeHarness.cpp
+ * @brief Pilha de UI/MQTT do display montada no host (env:native)
+ */
+
+#ifdef NATIVE_BUILD
+
+#include "native/NativeHarness.h"
+#include <HTTPClient.h>
+#include <PubSubClient.h>
+
+#include "core/Logger.h"
+#include "core/MQTTClient.h"
+#include "core/ConfigManager.h"
+#include "core/Scheduler.h"
+#include "ui/ScreenManager.h"
+#include "ui/IconManager.h"
+#include "ui/Theme.h"
+#include "navigation/Navigator.h"
+#include "communication/ConfigReceiver.h"
+#include "communication/StatusReporter.h"
+#include "communication/ButtonStateManager.h"
+#include "network/ScreenApiClient.h"
+#include "commands/CommandSender.h"
+#include "commands/CommandAckTracker.h"
+#include "commands/CommandCoalescer.h"
+#include "display/DisplayPipeline.h"
+#include "display/RenderProfiler.h"
+#include "config/DeviceConfig.h"
+#include "utils/DeviceUtils.h"
+#include "utils/MemoryMonitor.h"
+
+// Globais definidos em native/main.cpp, como no firmware
+extern Logger* logger;
+extern MQTTClient* mqttClient;
+extern ConfigManager* configManager;
+extern ScreenManager* screenManager;
+extern Navigator* navigator;
+extern ConfigReceiver* configReceiver;
+extern StatusReporter* statusReporter;
+extern CommandSender* commandSender;
+extern ButtonStateManager* buttonStateManager;
+extern ScreenApiClient* screenApiClient;
+extern IconManager* iconManager;
+extern DisplayPipeline* displayPipeline;
+extern RenderProfiler* renderProfiler;
+
+bool NativeHarness::pointerPressed = false;
+lv_point_t NativeHarness::pointerPoint = {0, 0};
+
+NativeHarness::NativeHarness(uint16_t w, uint16_t h) : width(w), height(h) {
+}
+
+bool NativeHarness::begin() {
+    if (!logger) {
+        logger = new Logger(DEBUG_LEVEL >= 3 ? LOG_DEBUG : LOG_WARNING);
+    }
+
+    lv_init();
+    theme_init();
+
+    // Latência zero: o host mede custo de render, não de barramento
+    transport = new FramebufferTransport(width, height, 0, 0);
+    displayPipeline = new DisplayPipeline(transport, width, height, LVGL_BUFFER_LINES);
+    if (!displayPipeline->begin()) {
+        logger->error("NativeHarness: display pipeline failed");
+        return false;
+    }
+
+    renderProfiler = new RenderProfiler(width, height);
+    displayPipeline->setProfiler(renderProfiler);
+
+    lv_indev_drv_init(&pointerDrv);
+    pointerDrv.type = LV_INDEV_TYPE_POINTER;
+    pointerDrv.read_cb = pointerRead;
+    lv_indev_drv_register(&pointerDrv);
+
+    // Mesma ordem do setup() do firmware
+    configManager = new ConfigManager();
+    screenManager = new ScreenManager();
+    navigator = new Navigator(screenManager);
+    iconManager = new IconManager();
+
+    // begin() testa a conexão em /screens
+    native::FakeHttpServer::instance().on("GET", String(API_BASE_PATH) + "/screens", HTTP_CODE_OK, "[]");
+    screenApiClient = new ScreenApiClient();
+    screenApiClient->begin();
+
+    String deviceUUID = DeviceUtils::getDeviceUUID();
+    mqttClient = new MQTTClient(deviceUUID, MQTT_BROKER, MQTT_PORT);
+    configReceiver = new ConfigReceiver(mqttClient, configManager, screenApiClient);
+    statusReporter = new StatusReporter(mqttClient, deviceUUID);
+    commandSender = new CommandSender(mqttClient, logger, deviceUUID);
+    buttonStateManager = new ButtonStateManager(mqttClient, screenManager);
+
+    MemoryMonitor::getInstance().setWarningCallback([](const MemoryMonitor::Snapshot& snapshot, uint8_t reasons) {
+        if (statusReporter) statusReporter->publishMemoryWarning(snapshot, reasons);
+    });
+
+    if (mqttClient->connect()) {
+        configReceiver->begin();
+        buttonStateManager->begin();
+    } else {
+        logger->warning("NativeHarness: MQTT broker unavailable");
+    }
+
+    return true;
+}
+
+bool NativeHarness::loadConfig(const String& unifiedResponse) {
+    native::FakeHttpServer::instance().on("GET", String(API_BASE_PATH) + "/config/full/" + DeviceUtils::getDeviceUUID(),
+                                          HTTP_CODE_OK, unifiedResponse);
+    screenApiClient->clearCache();
+
+    if (!configReceiver->loadConfiguration()) {
+        return false;
+    }
+
+    ConfigSnapshot config = configManager->snapshot();
+    if (config->doc["icons"].is<JsonObjectConst>()) {
+        iconManager->loadFromConfig(config->doc["icons"].as<JsonObjectConst>());
+    }
+    screenManager->buildFromConfig(config);
+    pump(LVGL_TICK_PERIOD * 4);
+    return true;
+}
+
+void NativeHarness::pump(uint32_t ms) {
+    uint32_t elapsed = 0;
+    do {
+        uint32_t step = min<uint32_t>(LVGL_TICK_PERIOD, ms - elapsed);
+        if (step == 0) step = LVGL_TICK_PERIOD;
+
+        native::advanceClock(step);
+        lv_tick_inc(step);
+
+        if (separateTasks) Scheduler::network().enterTask();
+        if (mqttClient && mqttClient->isConnected()) {
+            mqttClient->loop();
+        }
+        if (separateTasks) {
+            // Publishes da UI saem aqui; respostas e status vão para a caixa da UI
+            Scheduler::network().runDue(0);
+            Scheduler::ui().enterTask();
+            Scheduler::ui().runDue(0);
+        }
+        if (commandSender) {
+            commandSender->processHeartbeats();
+        }
+        CommandCoalescer::getInstance().process();
+        CommandAckTracker::getInstance().process();
+        if (displayPipeline) {
+            displayPipeline->poll();
+        }
+        lv_timer_handler();
+        MemoryMonitor::getInstance().update();
+
+        elapsed += step;
+    } while (elapsed < ms);
+}
+
+void NativeHarness::setSeparateTasks(bool enabled) {
+    if (enabled == separateTasks) return;
+    separateTasks = enabled;
+
+    if (enabled) {
+        Scheduler::network().begin();
+        Scheduler::ui().begin();
+        Scheduler::ui().enterTask();
+    } else {
+        Scheduler::network().end();
+        Scheduler::ui().end();
+    }
+}
+
+void NativeHarness::touch(int16_t x, int16_t y, uint32_t holdMs) {
+    pointerPoint.x = x;
+    pointerPoint.y = y;
+    pointerPressed = true;
+    pump(holdMs);
+    pointerPressed = false;
+    // Leitura do indev acontece a cada LV_INDEV_DEF_READ_PERIOD
+    pump(LV_INDEV_DEF_READ_PERIOD * 2);
+}
+
+bool NativeHarness::tap(lv_obj_t* obj) {
+    if (!obj || !lv_obj_is_visible(obj)) {
+        return false;
+    }
+    lv_area_t area;
+    lv_obj_get_coords(obj, &area);
+    touch((area.x1 + area.x2) / 2, (area.y1 + area.y2) / 2);
+    return true;
+}
+
+lv_obj_t* NativeHarness::findLabel(const char* text, lv_obj_t* root) {
+    if (!root) {
+        root = lv_scr_act();
+    }
+    if (lv_obj_check_type(root, &lv_label_class) && strcmp(lv_label_get_text(root), text) == 0) {
+        return root;
+    }
+    uint32_t count = lv_obj_get_child_cnt(root);
+    for (uint32_t i = 0; i < count; i++) {
+        lv_obj_t* found = findLabel(text, lv_obj_get_child(root, i));
+        if (found) return found;
+    }
+    return nullptr;
+}
+
+bool NativeHarness::dumpPpm(const char* path) const {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+
+    fprintf(f, "P6\n%u %u\n255\n", width, height);
+    for (uint16_t y = 0; y < height; y++) {
+        for (uint16_t x = 0; x < width; x++) {
+            uint16_t c = transport->getPixel(x, y);
+            uint8_t rgb[3] = {
+                (uint8_t)(((c >> 11) & 0x1F) << 3),
+                (uint8_t)(((c >> 5) & 0x3F) << 2),
+                (uint8_t)((c & 0x1F) << 3)
+            };
+            fwrite(rgb, 1, 3, f);
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+void NativeHarness::pointerRead(lv_indev_drv_t* drv, lv_indev_data_t* data) {
+    (void)drv;
+    data->point = pointerPoint;
+    data->state = pointerPressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+const char* NativeHarness::defaultFixture() {
+    return R"json({
+  "version": "2.2.0",
+  "protocol_version": "2.2.0",
+  "devices": [
+    {"id": 1, "uuid": "esp32-display-aabbccddeeff", "type": "esp32_display", "name": "Display"},
+    {"id": 2, "uuid": "esp32-relay-001122334455", "type": "esp32_relay", "name": "Placa de Relés"}
+  ],
+  "relay_boards": [
+    {"id": 1, "device_id": 2, "name": "Placa 1", "total_channels": 16}
+  ],
+  "screens": [
+    {"id": 1, "name": "home", "title": "Inicio", "icon": "home", "order_index": 0, "items": []},
+    {"id": 2, "name": "lights", "title": "Iluminacao", "icon": "light", "order_index": 1, "items": [
+      {"id": 10, "item_type": "button", "action_type": "relay_control", "name": "farol", "label": "Farol",
+       "icon": "light_high", "position": 1, "relay_board_id": 1, "relay_channel_id": 1,
+       "relay_channel": {"function_type": "toggle"}},
+      {"id": 11, "item_type": "button", "action_type": "relay_control", "name": "milha", "label": "Milha",
+       "icon": "fog_light", "position": 2, "relay_board_id": 1, "relay_channel_id": 2,
+       "relay_channel": {"function_type": "toggle"}},
+      {"id": 12, "item_type": "switch", "action_type": "relay_control", "name": "guincho", "label": "Guincho",
+       "icon": "winch", "position": 3, "relay_board_id": 1, "relay_channel_id": 3,
+       "relay_channel": {"function_type": "momentary"}},
+      {"id": 13, "item_type": "gauge", "name": "bateria", "label": "Bateria", "position": 4,
+       "data_source": "can", "data_path": "voltage", "data_unit": "V", "min": 10, "max": 15}
+    ]}
+  ]
+})json";
+}
+
+#endif // NATIVE_BUILD
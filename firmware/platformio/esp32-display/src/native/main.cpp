@@ -0,0 +1,144 @@
+/**
+ * @file main.cpp
+ * @brief Ponto de entrada do build nativo (host) do display
+ *
+ * Sobe a mesma pilha de UI/MQTT do firmware sem hardware, carrega uma
+ * configuração (fixture embutida ou arquivo JSON da API) e roda o loop
+ * do LVGL renderizando para um framebuffer em memória.
+ *
+ * Uso: program [config.json] [--ms N] [--dump tela.ppm] [--bench perfil.json]
+ *
+ * --bench grava o resumo do RenderProfiler (o mesmo publicado em
+ * telemetry/render) junto com as DisplayStats, para comparar execuções.
+ */
+
+#ifdef NATIVE_BUILD
+
+#include <Arduino.h>
+#include <string>
+#include <fstream>
+#include <sstream>
+
+#include "core/Logger.h"
+#include "core/MQTTClient.h"
+#include "core/ConfigManager.h"
+#include "ui/ScreenManager.h"
+#include "ui/IconManager.h"
+#include "navigation/Navigator.h"
+#include "communication/ConfigReceiver.h"
+#include "communication/StatusReporter.h"
+#include "communication/ButtonStateManager.h"
+#include "network/ScreenApiClient.h"
+#include "commands/CommandSender.h"
+#include "display/DisplayPipeline.h"
+#include "display/RenderProfiler.h"
+#include "native/NativeHarness.h"
+
+// Globais do firmware (mesmos nomes de src/main.cpp)
+DisplayPipeline* displayPipeline = nullptr;
+RenderProfiler* renderProfiler = nullptr;
+Logger* logger = nullptr;
+MQTTClient* mqttClient = nullptr;
+ConfigManager* configManager = nullptr;
+ScreenManager* screenManager = nullptr;
+Navigator* navigator = nullptr;
+ConfigReceiver* configReceiver = nullptr;
+StatusReporter* statusReporter = nullptr;
+CommandSender* commandSender = nullptr;
+ButtonStateManager* buttonStateManager = nullptr;
+ScreenApiClient* screenApiClient = nullptr;
+IconManager* iconManager = nullptr;
+
+// Os testes (pio test -e native) trazem o próprio main()
+#ifndef PIO_UNIT_TESTING
+
+static bool readFile(const char* path, String& out) {
+    std::ifstream file(path);
+    if (!file) return false;
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    out = buffer.str().c_str();
+    return true;
+}
+
+static bool writeBench(const char* path, uint32_t runMs) {
+    JsonDocument doc;
+    doc["run_ms"] = runMs;
+    doc["screens"] = (uint32_t)screenManager->getScreenIds().size();
+
+    const DisplayStats& stats = displayPipeline->getStats();
+    JsonObject display = doc["display"].to<JsonObject>();
+    display["frames"] = stats.frames;
+    display["flushes"] = stats.flushes;
+    display["avg_flush_us"] = stats.avgFlushUs;
+    display["max_frame_ms"] = stats.maxFrameMs;
+
+    if (renderProfiler) {
+        renderProfiler->toJson(doc["render"].to<JsonObject>());
+    }
+
+    std::ofstream file(path);
+    if (!file) return false;
+    std::string out;
+    serializeJsonPretty(doc, out);
+    file << out << "\n";
+    return (bool)file;
+}
+
+int main(int argc, char** argv) {
+    const char* configPath = nullptr;
+    const char* dumpPath = nullptr;
+    const char* benchPath = nullptr;
+    uint32_t runMs = 1000;
+
+    for (int i = 1; i < argc; i++) {
+        String arg = argv[i];
+        if (arg == "--ms" && i + 1 < argc) {
+            runMs = (uint32_t)atol(argv[++i]);
+        } else if (arg == "--dump" && i + 1 < argc) {
+            dumpPath = argv[++i];
+        } else if (arg == "--bench" && i + 1 < argc) {
+            benchPath = argv[++i];
+        } else {
+            configPath = argv[i];
+        }
+    }
+
+    String config = NativeHarness::defaultFixture();
+    if (configPath && !readFile(configPath, config)) {
+        fprintf(stderr, "Cannot read %s\n", configPath);
+        return 1;
+    }
+
+    NativeHarness harness;
+    if (!harness.begin()) {
+        return 1;
+    }
+    if (!harness.loadConfig(config)) {
+        fprintf(stderr, "Configuration rejected\n");
+        return 1;
+    }
+
+    displayPipeline->resetStats();
+    if (renderProfiler) renderProfiler->reset();
+    harness.pump(runMs);
+
+    const DisplayStats& stats = displayPipeline->getStats();
+    printf("screens=%u frames=%u flushes=%u avg_flush_us=%u max_frame_ms=%u\n",
+           (unsigned)screenManager->getScreenIds().size(), stats.frames, stats.flushes,
+           stats.avgFlushUs, stats.maxFrameMs);
+
+    if (benchPath && !writeBench(benchPath, runMs)) {
+        fprintf(stderr, "Cannot write %s\n", benchPath);
+        return 1;
+    }
+    if (dumpPath && !harness.dumpPpm(dumpPath)) {
+        fprintf(stderr, "Cannot write %s\n", dumpPath);
+        return 1;
+    }
+    return 0;
+}
+
+#endif // PIO_UNIT_TESTING
+
+#endif // NATIVE_BUILD
@@ -4,100 +4,154 @@
  */
 
 #include "navigation/ButtonHandler.h"
+#include "config/DeviceConfig.h"
 #include "core/Logger.h"
+#include "core/Scheduler.h"
 
 extern Logger* logger;
 
-ButtonHandler::ButtonHandler(uint8_t prevPin, uint8_t selectPin, uint8_t nextPin)
-    : pinPrev(prevPin), pinSelect(selectPin), pinNext(nextPin),
-      prevState(true), selectState(true), nextState(true),
-      prevDebounce(0), selectDebounce(0), nextDebounce(0),
-      prevPressTime(0), selectPressTime(0), nextPressTime(0),
-      prevLongPressed(false), selectLongPressed(false), nextLongPressed(false) {
-    
-    // Configure pins as input with pullup
-    pinMode(pinPrev, INPUT_PULLUP);
-    pinMode(pinSelect, INPUT_PULLUP);
-    pinMode(pinNext, INPUT_PULLUP);
-    
-    logger->info("ButtonHandler initialized - Prev:" + String(pinPrev) + 
-                " Select:" + String(pinSelect) + " Next:" + String(pinNext));
-}
+ButtonHandler::ButtonHandler(uint8_t prevPin, uint8_t selectPin, uint8_t nextPin) {
+    const uint8_t pins[BUTTON_COUNT] = {prevPin, selectPin, nextPin};
 
-void ButtonHandler::update() {
-    handleButton(pinPrev, prevState, prevDebounce, prevPressTime, prevLongPressed,
-                onPrevCallback, onLongPrevCallback, "Previous");
-    
-    handleButton(pinSelect, selectState, selectDebounce, selectPressTime, selectLongPressed,
-                onSelectCallback, onLongSelectCallback, "Select");
-    
-    handleButton(pinNext, nextState, nextDebounce, nextPressTime, nextLongPressed,
-                onNextCallback, onLongNextCallback, "Next");
+    events = xQueueCreate(BUTTON_EVENT_QUEUE_SIZE, sizeof(ButtonEvent));
+    debounceTimer = xTimerCreate("btn_debounce", pdMS_TO_TICKS(BUTTON_DEBOUNCE_DELAY),
+                                 pdFALSE, this, onDebounce);
+
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        Button& b = buttons[i];
+        b.pin = pins[i];
+        b.owner = this;
+        b.bouncing = false;
+        b.edgeTime = 0;
+        b.held = false;
+        b.longFired = false;
+        b.pressTime = 0;
+
+        // Configure pins as input with pullup (ativo em LOW)
+        pinMode(b.pin, INPUT_PULLUP);
+        b.stablePressed = digitalRead(b.pin) == LOW;
+        attachInterruptArg(digitalPinToInterrupt(b.pin), onEdge, &b, CHANGE);
+    }
+
+    if (!events || !debounceTimer) {
+        logger->error("ButtonHandler: failed to create event queue/debounce timer");
+    }
+
+    logger->info("ButtonHandler initialized - Prev:" + String(prevPin) +
+                " Select:" + String(selectPin) + " Next:" + String(nextPin));
 }
 
-bool ButtonHandler::readButton(uint8_t pin) {
-    return digitalRead(pin);
+ButtonHandler::~ButtonHandler() {
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        detachInterrupt(digitalPinToInterrupt(buttons[i].pin));
+    }
+    if (debounceTimer) xTimerDelete(debounceTimer, portMAX_DELAY);
+    if (events) vQueueDelete(events);
 }
 
-void ButtonHandler::handleButton(uint8_t pin, bool& state, unsigned long& debounce,
-                               unsigned long& pressTime, bool& longPressed,
-                               ButtonCallback shortCallback, ButtonCallback longCallback,
-                               const String& buttonName) {
-    
-    bool reading = readButton(pin);
-    
-    // Check if button state changed
-    if (reading != state) {
-        debounce = millis();
+void IRAM_ATTR ButtonHandler::onEdge(void* arg) {
+    Button* b = (Button*)arg;
+
+    // Só a primeira borda do ressalto marca o instante da transição
+    if (!b->bouncing) {
+        b->bouncing = true;
+        b->edgeTime = millis();
     }
-    
-    // Check if debounce time has passed
-    if ((millis() - debounce) > DEBOUNCE_DELAY) {
-        bool oldState = state;
-        state = reading;
-        
-        // Button just pressed (active low)
-        if (!state && oldState) {
-            pressTime = millis();
-            longPressed = false;
-            logger->debug(buttonName + " button pressed");
-        }
-        
-        // Button just released
-        else if (state && !oldState) {
-            unsigned long pressDuration = millis() - pressTime;
-            
-            // Only trigger short press if long press wasn't triggered
-            if (!longPressed && shortCallback && pressDuration < LONG_PRESS_TIME) {
-                logger->debug(buttonName + " button short press");
-                shortCallback();
-            }
-            
-            pressTime = 0;
-            longPressed = false;
+
+    // Cada borda adia a leitura: o timer só dispara com o contato parado
+    BaseType_t woken = pdFALSE;
+    xTimerResetFromISR(b->owner->debounceTimer, &woken);
+    if (woken) portYIELD_FROM_ISR();
+}
+
+void ButtonHandler::onDebounce(TimerHandle_t timer) {
+    ButtonHandler* handler = (ButtonHandler*)pvTimerGetTimerID(timer);
+
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        Button& b = handler->buttons[i];
+        if (!b.bouncing) continue;
+
+        // Limpa antes de ler: borda nova depois daqui rearma o timer
+        b.bouncing = false;
+        bool pressed = digitalRead(b.pin) == LOW;
+        if (pressed == b.stablePressed) continue;  // Ressalto sem mudança
+
+        b.stablePressed = pressed;
+        ButtonEvent event = {i, pressed, b.edgeTime};
+        if (xQueueSend(handler->events, &event, 0) != pdTRUE) {
+            handler->droppedEvents++;
         }
-        
-        // Button held down
-        else if (!state && pressTime > 0) {
-            unsigned long pressDuration = millis() - pressTime;
-            
-            // Check for long press
-            if (!longPressed && pressDuration >= LONG_PRESS_TIME) {
-                if (longCallback) {
-                    logger->debug(buttonName + " button long press");
-                    longCallback();
-                }
-                longPressed = true;
-            }
+    }
+
+    // Loop dorme até o próximo deadline: acorda para drenar a fila já
+    Scheduler::ui().notify();
+}
+
+void ButtonHandler::update() {
+    ButtonEvent event;
+    while (events && xQueueReceive(events, &event, 0) == pdTRUE) {
+        handleEvent(event);
+    }
+
+    // Long press dispara ainda segurando; só consulta o relógio se houver botão preso
+    if (heldCount == 0) return;
+
+    uint32_t now = millis();
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        Button& b = buttons[i];
+        if (b.held && !b.longFired && now - b.pressTime >= BUTTON_LONG_PRESS_TIME) {
+            b.longFired = true;
+            fire(b, true, i);
         }
     }
 }
 
+void ButtonHandler::handleEvent(const ButtonEvent& event) {
+    Button& b = buttons[event.button];
+
+    if (event.pressed) {
+        if (!b.held) heldCount++;
+        b.held = true;
+        b.longFired = false;
+        b.pressTime = event.timeMs;
+        return;
+    }
+
+    if (!b.held) return;  // Release sem press (fila cheia)
+    b.held = false;
+    heldCount--;
+
+    // Clique inteiro enfileirado durante operação longa: a duração vem dos
+    // timestamps, não de quando o loop viu o evento
+    if (!b.longFired) {
+        fire(b, event.timeMs - b.pressTime >= BUTTON_LONG_PRESS_TIME, event.button);
+    }
+}
+
+void ButtonHandler::fire(Button& button, bool longPress, uint8_t index) {
+    ButtonCallback& callback = longPress ? button.onLong : button.onShort;
+    if (!callback) return;
+
+    if (logger) {
+        logger->debug(String(buttonName(index)) + (longPress ? " button long press" : " button short press"));
+    }
+    callback();
+}
+
+const char* ButtonHandler::buttonName(uint8_t index) {
+    switch (index) {
+        case BUTTON_PREV:   return "Previous";
+        case BUTTON_SELECT: return "Select";
+        case BUTTON_NEXT:   return "Next";
+        default:            return "Unknown";
+    }
+}
+
 uint32_t ButtonHandler::getPressedButton() {
     // For LVGL keypad navigation
     if (isPrevPressed()) return 1;  // Previous button
-    if (isSelectPressed()) return 2; // Select button  
+    if (isSelectPressed()) return 2; // Select button
     if (isNextPressed()) return 3;   // Next button
-    
+
     return 0;
-}
\ No newline at end of file
+}
@@ -8,6 +8,7 @@
  */
 
 #include "network/DeviceRegistration.h"
+#include "network/HttpSession.h"
 #include "utils/DeviceUtils.h"
 #include "config/DeviceConfig.h"
 #include "core/Logger.h"
@@ -157,14 +158,15 @@ bool DeviceRegistration::loadMQTTCredentials(MQTTCredentials& creds) {
 
 bool DeviceRegistration::checkDeviceExists(const String& deviceId) {
     // Endpoint: GET /api/devices/{device_identifier}
-    String url = buildApiUrl("/devices/" + deviceId);
+    String endpoint = "/devices/" + deviceId;
+    String url = buildApiUrl(endpoint);
     String response;
     
     if (logger) {
         logger->debug("DeviceRegistration: Verificando existência do dispositivo: " + url);
     }
     
-    if (makeHttpRequest(url, "GET", "", response)) {
+    if (makeHttpRequest(endpoint, "GET", "", response)) {
         // Se retornou 200, dispositivo existe
         if (logger) {
             logger->debug("DeviceRegistration: Dispositivo encontrado na API");
@@ -180,7 +182,8 @@ bool DeviceRegistration::checkDeviceExists(const String& deviceId) {
 }
 
 bool DeviceRegistration::registerDevice(const String& deviceId) {
-    String url = buildApiUrl("/devices");
+    String endpoint = "/devices";
+    String url = buildApiUrl(endpoint);
     
     // Construir payload de registro
     StaticJsonDocument<1024> doc;
@@ -212,18 +215,19 @@ bool DeviceRegistration::registerDevice(const String& deviceId) {
     }
     
     String response;
-    return makeHttpRequest(url, "POST", payload, response);
+    return makeHttpRequest(endpoint, "POST", payload, response);
 }
 
 bool DeviceRegistration::fetchMQTTConfig(MQTTCredentials& credentials) {
-    String url = buildApiUrl("/mqtt/config");
+    String endpoint = "/mqtt/config";
+    String url = buildApiUrl(endpoint);
     String response;
     
     if (logger) {
         logger->debug("DeviceRegistration: Obtendo configuração MQTT: " + url);
     }
     
-    if (!makeHttpRequest(url, "GET", "", response)) {
+    if (!makeHttpRequest(endpoint, "GET", "", response)) {
         if (logger) {
             logger->error("DeviceRegistration: Falha na requisição de configuração MQTT");
         }
@@ -266,7 +270,8 @@ bool DeviceRegistration::fetchMQTTConfig(MQTTCredentials& credentials) {
 
 bool DeviceRegistration::updateDeviceNetworkInfo(const String& deviceId) {
     // Endpoint correto: /api/devices/{device_identifier} (sem /uuid/)
-    String url = buildApiUrl("/devices/" + deviceId);
+    String endpoint = "/devices/" + deviceId;
+    String url = buildApiUrl(endpoint);
     
     // Construir payload de atualização conforme documentação
     StaticJsonDocument<512> doc;
@@ -295,7 +300,7 @@ bool DeviceRegistration::updateDeviceNetworkInfo(const String& deviceId) {
     }
     
     String response;
-    return makeHttpRequest(url, "PATCH", payload, response);
+    return makeHttpRequest(endpoint, "PATCH", payload, response);
 }
 
 void DeviceRegistration::saveRegistrationTime() {
@@ -348,73 +353,37 @@ String DeviceRegistration::buildApiUrl(const String& endpoint) {
     return url;
 }
 
-bool DeviceRegistration::makeHttpRequest(const String& url, const String& method, const String& payload, String& response) {
-    HTTPClient http;
-    http.setTimeout(API_TIMEOUT);
+bool DeviceRegistration::makeHttpRequest(const String& endpoint, const String& method, const String& payload, String& response) {
+    // Conexão keep-alive compartilhada com o ScreenApiClient
+    HttpSession& session = HttpSession::getInstance();
     
-    for (int attempt = 1; attempt <= API_RETRY_COUNT; attempt++) {
+    // Uma tentativa: o registro inteiro é repetido com backoff pela AsyncFetch
+    if (logger) {
+        logger->debug("DeviceRegistration: " + method + " " + endpoint);
+    }
+    
+    int httpCode = session.request(method.c_str(), endpoint, response, payload);
+    
+    if (httpCode > 0) {
         if (logger) {
-            logger->debug("DeviceRegistration: Tentativa " + String(attempt) + "/" + String(API_RETRY_COUNT) + " - " + method + " " + url);
-        }
-        
-        http.begin(url);
-        http.addHeader("Content-Type", "application/json");
-        
-        #if API_USE_AUTH
-        if (strlen(API_AUTH_TOKEN) > 0) {
-            http.addHeader("Authorization", "Bearer " + String(API_AUTH_TOKEN));
-        }
-        #endif
-        
-        int httpCode = -1;
-        
-        if (method == "GET") {
-            httpCode = http.GET();
-        } else if (method == "POST") {
-            httpCode = http.POST(payload);
-        } else if (method == "PUT") {
-            httpCode = http.PUT(payload);
-        } else if (method == "PATCH") {
-            httpCode = http.PATCH(payload);
-        }
-        
-        if (httpCode > 0) {
-            response = http.getString();
-            
-            if (logger) {
-                logger->debug("DeviceRegistration: Resposta HTTP " + String(httpCode));
-                if (response.length() > 0) {
-                    logger->debug("DeviceRegistration: Resposta: " + response.substring(0, 200) + (response.length() > 200 ? "..." : ""));
-                }
-            }
-            
-            if (httpCode >= 200 && httpCode < 300) {
-                http.end();
-                return true;
-            } else if (httpCode == 404 && method == "GET") {
-                // 404 em GET é esperado quando dispositivo não existe
-                http.end();
-                return false;
-            }
-        } else {
-            if (logger) {
-                logger->error("DeviceRegistration: Erro HTTP: " + String(httpCode));
+            logger->debug("DeviceRegistration: Resposta HTTP " + String(httpCode));
+            if (response.length() > 0) {
+                logger->debug("DeviceRegistration: Resposta: " + response.substring(0, 200) + (response.length() > 200 ? "..." : ""));
             }
         }
         
-        http.end();
-        
-        // Se não é a última tentativa, aguardar antes de retry
-        if (attempt < API_RETRY_COUNT) {
+        if (httpCode >= 200 && httpCode < 300) {
+            return true;
+        }
+        // 404 em GET é esperado quando dispositivo não existe
+        if (httpCode != 404 || method != "GET") {
             if (logger) {
-                logger->warning("DeviceRegistration: Falha na tentativa " + String(attempt) + ", aguardando " + String(API_RETRY_DELAY) + "ms");
+                logger->warning("DeviceRegistration: " + method + " " + endpoint + " falhou: HTTP " + String(httpCode));
             }
-            delay(API_RETRY_DELAY);
         }
+    } else if (logger) {
+        logger->error("DeviceRegistration: Erro HTTP: " + String(httpCode) + " em " + method + " " + endpoint);
     }
     
-    if (logger) {
-        logger->error("DeviceRegistration: Todas as tentativas falharam para " + method + " " + url);
-    }
     return false;
 }
\ No newline at end of file
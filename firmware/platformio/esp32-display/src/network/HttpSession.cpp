@@ -0,0 +1,99 @@
+/**
+ * @file HttpSession.cpp
+ * @brief Conexão keep-alive única com o backend e tempos por requisição
+ */
+
+#include "network/HttpSession.h"
+#include "core/Logger.h"
+#include "config/DeviceConfig.h"
+
+extern Logger* logger;
+
+static const uint32_t LATENCY_MS_BOUNDS[] = {5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000};
+
+#define BOUNDS(a) a, (uint8_t)(sizeof(a) / sizeof(a[0]))
+
+HttpSession& HttpSession::getInstance() {
+    static HttpSession instance;
+    return instance;
+}
+
+HttpSession::HttpSession() : latencyMs(BOUNDS(LATENCY_MS_BOUNDS)) {
+    baseUrl = String(API_PROTOCOL) + "://" + String(API_SERVER) + ":" + String(API_PORT) + String(API_BASE_PATH);
+
+    http.setTimeout(API_TIMEOUT);
+    http.setReuse(true);
+    http.setUserAgent("AutoCore-HMI-v2.0.0");
+}
+
+HTTPClient& HttpSession::open(const String& path) {
+    if (active) close();
+
+    openedAt = millis();
+    active = true;
+
+    // Mesmo WiFiClient sempre: o HTTPClient só reconecta se o socket caiu
+    http.begin(tcp, baseUrl + path);
+    http.addHeader("Accept", "application/json");
+    if (API_USE_AUTH) {
+        http.addHeader("Authorization", "Bearer " + String(API_AUTH_TOKEN));
+    }
+    return http;
+}
+
+int HttpSession::send(const char* method, const String& payload) {
+    if (!tcp.connected()) {
+        connects++;
+    }
+
+    if (payload.length() > 0) {
+        http.addHeader("Content-Type", "application/json");
+    }
+
+    int code = http.sendRequest(method, payload);
+    requests++;
+
+    if (code <= 0) {
+        // Socket morto ou servidor sumiu: não reaproveitar
+        failures++;
+        tcp.stop();
+        if (logger) {
+            logger->debug("HttpSession: " + String(method) + " failed: " + HTTPClient::errorToString(code));
+        }
+    }
+    return code;
+}
+
+void HttpSession::close() {
+    if (!active) return;
+    active = false;
+
+    // end() com reuse mantém o socket se o servidor não pediu Connection: close
+    http.end();
+    latencyMs.record(millis() - openedAt);
+}
+
+int HttpSession::request(const char* method, const String& path, String& response, const String& payload) {
+    open(path);
+    int code = send(method, payload);
+    response = code > 0 ? http.getString() : String();
+    close();
+    return code;
+}
+
+void HttpSession::reset() {
+    if (active) close();
+    tcp.stop();
+}
+
+void HttpSession::setTimeout(uint16_t timeoutMs) {
+    http.setTimeout(timeoutMs);
+}
+
+void HttpSession::toJson(JsonObject obj) const {
+    obj["requests"] = requests;
+    obj["connects"] = connects;
+    obj["reused"] = requests > connects ? requests - connects : 0;
+    obj["failures"] = failures;
+    latencyMs.toJson(obj["latency_ms"].to<JsonObject>());
+}
@@ -8,9 +8,13 @@
  */
 
 #include "network/ScreenApiClient.h"
+#include "network/HttpSession.h"
 #include "core/Logger.h"
 #include "models/DeviceModels.h"
 #include "utils/DeviceUtils.h"
+#include "core/ConfigStore.h"
+#include "core/Scheduler.h"
+#include <LittleFS.h>
 
 // Logger global declarado em main.cpp
 extern Logger* logger;
@@ -25,6 +29,8 @@ ScreenApiClient::ScreenApiClient() {
     // Configurações de cache e timeout
     cacheTimeout = API_CACHE_TTL;
     cacheTimestamp = 0;
+    cacheETagLoaded = false;
+    notModified = false;
     lastHttpCode = 0;
     
     if (logger) {
@@ -33,20 +39,10 @@ ScreenApiClient::ScreenApiClient() {
 }
 
 ScreenApiClient::~ScreenApiClient() {
-    // Cleanup HTTP client
-    httpClient.end();
 }
 
 bool ScreenApiClient::begin() {
-    // Configurar HTTPClient
-    httpClient.setTimeout(API_TIMEOUT);
-    httpClient.setReuse(true);
-    httpClient.setUserAgent("AutoCore-HMI-v2.0.0");
-    
-    if (logger) {
-        logger->info("ScreenApiClient: HTTP client configured");
-    }
-    
+    // Conexão keep-alive compartilhada (HttpSession): já vem configurada
     // Testar conectividade inicial
     return testConnection();
 }
@@ -58,19 +54,10 @@ bool ScreenApiClient::testConnection() {
         logger->debug("ScreenApiClient: Testing connection to " + url);
     }
     
-    httpClient.begin(url);
-    
-    // Adicionar headers de autenticação se habilitado
-    if (API_USE_AUTH) {
-        httpClient.addHeader("Authorization", "Bearer " + String(API_AUTH_TOKEN));
-    }
-    
-    // Adicionar headers padrão
-    httpClient.addHeader("Accept", "application/json");
-    httpClient.addHeader("Content-Type", "application/json");
-    
-    lastHttpCode = httpClient.GET();
-    httpClient.end();
+    HttpSession& session = HttpSession::getInstance();
+    session.open("/screens");
+    lastHttpCode = session.send("GET");
+    session.close();
     
     if (lastHttpCode == 200) {
         if (logger) {
@@ -93,37 +80,31 @@ bool ScreenApiClient::loadConfiguration(JsonDocument& config) {
 bool ScreenApiClient::getScreens(JsonArray& screens) {
     String response;
     
-    for (int attempt = 1; attempt <= API_RETRY_COUNT; attempt++) {
-        if (makeHttpRequest("/screens", response)) {
-            // Parse JSON response
-            JsonDocument doc;
-            DeserializationError error = deserializeJson(doc, response);
-            
-            if (error == DeserializationError::Ok) {
-                // Verificar se é um array
-                if (doc.is<JsonArray>()) {
-                    // Copiar elementos para o array fornecido
-                    for (JsonVariant v : doc.as<JsonArray>()) {
-                        screens.add(v);
-                    }
-                    return true;
-                } else {
-                    lastError = "API response is not an array";
+    // Uma tentativa: retry com backoff fica com o chamador (AsyncFetch)
+    if (makeHttpRequest("/screens", response)) {
+        // Parse JSON response
+        JsonDocument doc;
+        DeserializationError error = deserializeJson(doc, response);
+        
+        if (error == DeserializationError::Ok) {
+            // Verificar se é um array
+            if (doc.is<JsonArray>()) {
+                // Copiar elementos para o array fornecido
+                for (JsonVariant v : doc.as<JsonArray>()) {
+                    screens.add(v);
                 }
+                return true;
             } else {
-                lastError = "JSON parse error: " + String(error.c_str());
+                lastError = "API response is not an array";
             }
-        }
-        
-        if (logger) {
-            logger->warning("ScreenApiClient: getScreens attempt " + String(attempt) + " failed: " + lastError);
-        }
-        
-        if (attempt < API_RETRY_COUNT) {
-            delay(API_RETRY_DELAY * attempt); // Exponential backoff
+        } else {
+            lastError = "JSON parse error: " + String(error.c_str());
         }
     }
     
+    if (logger) {
+        logger->warning("ScreenApiClient: getScreens failed: " + lastError);
+    }
     return false;
 }
 
@@ -195,30 +176,15 @@ bool ScreenApiClient::makeHttpRequest(const String& endpoint, String& response)
         logger->debug("ScreenApiClient: Making request to " + url);
     }
     
-    httpClient.begin(url);
-    
-    // Headers de autenticação se habilitado
-    if (API_USE_AUTH) {
-        httpClient.addHeader("Authorization", "Bearer " + String(API_AUTH_TOKEN));
-    }
-    
-    // Headers padrão
-    httpClient.addHeader("Accept", "application/json");
-    httpClient.addHeader("Content-Type", "application/json");
-    httpClient.addHeader("User-Agent", "AutoCore-HMI-v2.0.0");
-    
-    lastHttpCode = httpClient.GET();
+    // Mesma conexão TCP das requisições anteriores (keep-alive)
+    lastHttpCode = HttpSession::getInstance().request("GET", endpoint, response);
     
     if (lastHttpCode == 200) {
-        response = httpClient.getString();
-        httpClient.end();
-        
         if (logger) {
             logger->debug("ScreenApiClient: Request successful, response size: " + String(response.length()) + " bytes");
         }
         return true;
     } else {
-        httpClient.end();
         lastError = "HTTP error: " + String(lastHttpCode);
         
         // Logs mais detalhados para diferentes códigos de erro
@@ -251,7 +217,7 @@ bool ScreenApiClient::isCacheValid() {
 }
 
 void ScreenApiClient::clearCache() {
-    cachedConfig.clear();
+    // A cópia no flash fica: a próxima carga só a revalida
     cacheTimestamp = 0;
     if (logger) {
         logger->debug("ScreenApiClient: Cache cleared");
@@ -263,7 +229,7 @@ String ScreenApiClient::buildUrl(const String& endpoint) {
 }
 
 void ScreenApiClient::setTimeout(unsigned long timeout) {
-    httpClient.setTimeout(timeout);
+    HttpSession::getInstance().setTimeout(timeout);
     if (logger) {
         logger->debug("ScreenApiClient: Timeout set to " + String(timeout) + "ms");
     }
@@ -280,41 +246,22 @@ bool ScreenApiClient::getDevices(JsonArray& devices) {
     String url = buildUrl("/devices");
     Serial.printf("[API] Fetching devices from: %s\n", url.c_str());
     
-    for (int attempt = 1; attempt <= API_RETRY_COUNT; attempt++) {
-        httpClient.begin(url);
-        
-        if (API_USE_AUTH) {
-            httpClient.addHeader("Authorization", "Bearer " + String(API_AUTH_TOKEN));
-        }
-        
-        lastHttpCode = httpClient.GET();
+    String response;
+    if (makeHttpRequest("/devices", response)) {
+        JsonDocument doc;
+        DeserializationError error = deserializeJson(doc, response);
         
-        if (lastHttpCode == 200) {
-            String response = httpClient.getString();
-            httpClient.end();
-            
-            JsonDocument doc;
-            DeserializationError error = deserializeJson(doc, response);
+        if (error == DeserializationError::Ok) {
+            JsonArray responseArray = doc.as<JsonArray>();
+            Serial.printf("[API] Loaded %d devices\n", responseArray.size());
             
-            if (error == DeserializationError::Ok) {
-                JsonArray responseArray = doc.as<JsonArray>();
-                Serial.printf("[API] Loaded %d devices\n", responseArray.size());
-                
-                for (JsonVariant v : responseArray) {
-                    devices.add(v);
-                }
-                return true;
+            for (JsonVariant v : responseArray) {
+                devices.add(v);
             }
-            
-            lastError = "JSON parse error: " + String(error.c_str());
-        } else {
-            httpClient.end();
-            lastError = "HTTP error: " + String(lastHttpCode);
+            return true;
         }
         
-        if (attempt < API_RETRY_COUNT) {
-            delay(API_RETRY_DELAY * attempt);
-        }
+        lastError = "JSON parse error: " + String(error.c_str());
     }
     
     return false;
@@ -324,18 +271,8 @@ bool ScreenApiClient::getRelayBoards(JsonArray& boards) {
     String url = buildUrl("/relays/boards");
     Serial.printf("[API] Fetching relay boards from: %s\n", url.c_str());
     
-    httpClient.begin(url);
-    
-    if (API_USE_AUTH) {
-        httpClient.addHeader("Authorization", "Bearer " + String(API_AUTH_TOKEN));
-    }
-    
-    lastHttpCode = httpClient.GET();
-    
-    if (lastHttpCode == 200) {
-        String response = httpClient.getString();
-        httpClient.end();
-        
+    String response;
+    if (makeHttpRequest("/relays/boards", response)) {
         JsonDocument doc;
         DeserializationError error = deserializeJson(doc, response);
         
@@ -350,76 +287,73 @@ bool ScreenApiClient::getRelayBoards(JsonArray& boards) {
         }
         
         lastError = "JSON parse error: " + String(error.c_str());
-    } else {
-        httpClient.end();
-        lastError = "HTTP error: " + String(lastHttpCode);
     }
     
     return false;
 }
 
 bool ScreenApiClient::loadFullConfiguration(JsonDocument& config) {
-    // Check cache first
-    if (isCacheValid() && !cachedConfig.isEmpty()) {
-        DeserializationError error = deserializeJson(config, cachedConfig);
-        if (error == DeserializationError::Ok) {
-            if (logger) {
-                logger->info("ScreenApiClient: Using cached full configuration");
-            }
-            return true;
+    notModified = false;
+    loadCacheValidator();
+    
+    // Validada há menos de cacheTimeout: nem pergunta ao servidor
+    if (isCacheValid() && !cacheETag.isEmpty() && useCachedConfiguration(config, cacheETag)) {
+        if (logger) {
+            logger->info("ScreenApiClient: Using cached full configuration " + cacheETag);
         }
+        return true;
     }
     
-    // Clear device registry before loading new data
-    DeviceRegistry::getInstance()->clear();
-    
     // Use unified endpoint /api/config/full/{device_uuid} for single request
     String deviceUUID = DeviceUtils::getDeviceUUID();
     String endpoint = "/config/full/" + deviceUUID;
-    String response;
+    
+    // Revalida a versão que o chamador já tem; senão a do flash
+    String validator = activeVersion.isEmpty() ? cacheETag : activeVersion;
     
     if (logger) {
-        logger->info("ScreenApiClient: Loading full configuration from unified endpoint: " + endpoint);
+        logger->info("ScreenApiClient: Loading full configuration from unified endpoint: " + endpoint +
+                     (validator.isEmpty() ? "" : " (If-None-Match " + validator + ")"));
     }
     
-    for (int attempt = 1; attempt <= API_RETRY_COUNT; attempt++) {
-        if (makeHttpRequest(endpoint, response)) {
+    // Uma tentativa (mais o GET sem validador se a cópia local sumiu):
+    // retry com backoff fica com o chamador (AsyncFetch)
+    String etag;
+    int code = requestConfiguration(endpoint, validator, config, etag);
+    
+    if (code == HTTP_CODE_NOT_MODIFIED) {
+        // Nada baixado nem parseado
+        cacheTimestamp = millis();
+        if (useCachedConfiguration(config, validator)) {
             if (logger) {
-                logger->debug("ScreenApiClient: Received full config response (" + String(response.length()) + " bytes)");
-            }
-            
-            // Parse unified response
-            JsonDocument fullResponse;
-            DeserializationError error = deserializeJson(fullResponse, response);
-            
-            if (error == DeserializationError::Ok) {
-                // Process unified response structure
-                if (processUnifiedResponse(fullResponse, config)) {
-                    // Cache the result
-                    cachedConfig.clear();
-                    serializeJson(config, cachedConfig);
-                    cacheTimestamp = millis();
-                    
-                    if (logger) {
-                        logger->info("ScreenApiClient: Full configuration loaded successfully from unified endpoint");
-                        logger->info("ScreenApiClient: Performance improvement - Single request vs multiple requests");
-                    }
-                    return true;
-                }
-            } else {
-                lastError = "JSON parse error in unified response: " + String(error.c_str());
-                if (logger) {
-                    logger->error("ScreenApiClient: " + lastError);
-                }
+                logger->info("ScreenApiClient: Configuration not modified (" + validator + ")");
             }
+            return true;
         }
         
+        // Cópia local perdida: pede a config inteira
+        validator = "";
+        code = requestConfiguration(endpoint, validator, config, etag);
+    }
+    
+    if (code == HTTP_CODE_OK && !config.isNull()) {
         if (logger) {
-            logger->warning("ScreenApiClient: Unified endpoint attempt " + String(attempt) + " failed: " + lastError);
+            logger->debug("ScreenApiClient: Received full config (" + String(config.memoryUsage()) + " bytes in document)");
         }
         
-        if (attempt < API_RETRY_COUNT) {
-            delay(API_RETRY_DELAY * attempt); // Exponential backoff
+        // Process unified response structure (troca o registry na UI)
+        if (processUnifiedResponse(config)) {
+            // A versão viaja com a config (última config boa inclusive)
+            if (!etag.isEmpty()) {
+                config["etag"] = etag;
+            }
+            writeCachedConfiguration(config, etag);
+            cacheTimestamp = millis();
+            
+            if (logger) {
+                logger->info("ScreenApiClient: Full configuration loaded successfully from unified endpoint");
+            }
+            return true;
         }
     }
     
@@ -433,33 +367,85 @@ bool ScreenApiClient::loadFullConfiguration(JsonDocument& config) {
     
     // Retornar falha se o endpoint unificado falhar
     if (logger) {
-        logger->error("ScreenApiClient: Failed to load configuration from unified endpoint");
+        logger->error("ScreenApiClient: Failed to load configuration from unified endpoint: " + lastError);
     }
     return false;
 }
 
-bool ScreenApiClient::processUnifiedResponse(const JsonDocument& response, JsonDocument& config) {
+void ScreenApiClient::buildConfigFilter(JsonDocument& filter) {
+    // Campos da resposta unificada que o display lê; o resto (telemetria,
+    // veículo, device, relay_board expandido...) é descartado no parse
+    filter["version"] = true;
+    filter["protocol_version"] = true;
+    filter["theme"] = true;
+    filter["system"] = true;
+    filter["icons"] = true;
+    
+    JsonObject device = filter["devices"][0].to<JsonObject>();
+    for (const char* key : {"id", "uuid", "type", "name"}) {
+        device[key] = true;
+    }
+    
+    JsonObject board = filter["relay_boards"][0].to<JsonObject>();
+    for (const char* key : {"id", "device_id", "name", "total_channels"}) {
+        board[key] = true;
+    }
+    
+    JsonObject screen = filter["screens"][0].to<JsonObject>();
+    for (const char* key : {"id", "name", "title", "icon", "order_index", "position"}) {
+        screen[key] = true;
+    }
+    
+    // Campos de item lidos pelo ScreenFactory/DataBinder/CommandSender
+    JsonObject item = screen["items"][0].to<JsonObject>();
+    for (const char* key : {"id", "item_type", "type", "name", "label", "title", "icon", "position",
+                            "action_type", "action_target", "action_payload", "relay_board_id",
+                            "relay_channel_id", "device", "channel", "mode", "momentary",
+                            "data_source", "data_path", "data_unit", "data_format", "size",
+                            "size_display_small", "width", "height", "x", "y", "min", "max", "value",
+                            "options", "checked", "color", "bg_color", "background", "font_size",
+                            "align", "command_type", "preset_id", "parameters"}) {
+        item[key] = true;
+    }
+    
+    JsonObject channel = item["relay_channel"].to<JsonObject>();
+    for (const char* key : {"id", "name", "function_type", "icon"}) {
+        channel[key] = true;
+    }
+    
+    // Formato legado (screen_items) com os mesmos campos
+    screen["screen_items"][0] = item;
+}
+
+bool ScreenApiClient::processUnifiedResponse(JsonDocument& config) {
     if (logger) {
         logger->debug("ScreenApiClient: Processing unified API response");
     }
     
-    // Validate response structure
-    if (!response["version"].is<String>() || !response["protocol_version"].is<String>()) {
+    // Validate response structure (o filtro já deixou só os campos usados)
+    if (!config["version"].is<String>() || !config["protocol_version"].is<String>()) {
         lastError = "Invalid unified response structure - missing version fields";
         return false;
     }
     
-    // Simply copy the response elements to config for now
-    config["version"] = response["version"];
-    config["protocol_version"] = response["protocol_version"];
+    registerDevices(config);
     
-    // Process devices and populate DeviceRegistry
-    if (response["devices"]) {
-        config["devices"] = response["devices"];
-        
-        // Populate device registry
-        logger->info("=== DEVICE REGISTRY POPULATION (Unified) ===");
-        JsonArrayConst devices = response["devices"].as<JsonArrayConst>();
+    config["source"] = "api_unified";
+    config["timestamp"] = millis();
+    
+    if (logger) {
+        logger->info("ScreenApiClient: Successfully processed unified response");
+    }
+    
+    return true;
+}
+
+DeviceList ScreenApiClient::parseDevices(const JsonDocument& config) {
+    DeviceList list;
+    
+    if (config["devices"]) {
+        if (logger) logger->info("=== DEVICE REGISTRY POPULATION (Unified) ===");
+        JsonArrayConst devices = config["devices"].as<JsonArrayConst>();
         for (JsonVariantConst device : devices) {
             uint8_t id = device["id"] | 0;
             String uuid = device["uuid"] | "";
@@ -467,20 +453,16 @@ bool ScreenApiClient::processUnifiedResponse(const JsonDocument& response, JsonD
             String name = device["name"] | "";
             
             if (id > 0 && !uuid.isEmpty()) {
-                logger->info("Device: id=" + String(id) + " uuid=" + uuid + " type=" + type + " name=" + name);
-                DeviceInfo info(id, uuid, type, name);
-                DeviceRegistry::getInstance()->addDevice(info);
+                if (logger) logger->info("Device: id=" + String(id) + " uuid=" + uuid + " type=" + type + " name=" + name);
+                list.devices.push_back({id, uuid, type, name});
             }
         }
-        logger->info("Registered " + String(DeviceRegistry::getInstance()->getDeviceCount()) + " devices");
+        if (logger) logger->info("Registered " + String(list.devices.size()) + " devices");
     }
     
-    if (response["relay_boards"]) {
-        config["relay_boards"] = response["relay_boards"];
-        
-        // Populate relay board registry
-        logger->info("=== RELAY BOARDS REGISTRY (Unified) ===");
-        JsonArrayConst boards = response["relay_boards"].as<JsonArrayConst>();
+    if (config["relay_boards"]) {
+        if (logger) logger->info("=== RELAY BOARDS REGISTRY (Unified) ===");
+        JsonArrayConst boards = config["relay_boards"].as<JsonArrayConst>();
         for (JsonVariantConst board : boards) {
             uint8_t id = board["id"] | 0;
             uint8_t device_id = board["device_id"] | 0;
@@ -488,39 +470,143 @@ bool ScreenApiClient::processUnifiedResponse(const JsonDocument& response, JsonD
             uint8_t channels = board["total_channels"] | 16;
             
             if (id > 0) {
-                logger->info("RelayBoard: id=" + String(id) + " device_id=" + String(device_id) + 
-                            " name=" + name + " channels=" + String(channels));
-                RelayBoardInfo info(id, device_id, name, channels);
-                DeviceRegistry::getInstance()->addRelayBoard(info);
+                if (logger) {
+                    logger->info("RelayBoard: id=" + String(id) + " device_id=" + String(device_id) + 
+                                 " name=" + name + " channels=" + String(channels));
+                }
+                list.relayBoards.push_back(RelayBoardInfo(id, device_id, name, channels));
             }
         }
-        logger->info("Registered " + String(DeviceRegistry::getInstance()->getRelayBoardCount()) + " relay boards");
-        logger->info("===========================");
+        if (logger) {
+            logger->info("Registered " + String(list.relayBoards.size()) + " relay boards");
+            logger->info("===========================");
+        }
     }
     
-    if (response["screens"]) {
-        config["screens"] = response["screens"];
+    return list;
+}
+
+void ScreenApiClient::registerDevices(const JsonDocument& config) {
+    installDevices(std::make_shared<DeviceList>(parseDevices(config)));
+}
+
+void ScreenApiClient::installDevices(std::shared_ptr<DeviceList> list) {
+    // A UI resolve relay_board -> uuid a qualquer momento: ela troca, a
+    // mesma caixa de entrada entrega depois a conclusão da carga
+    if (!Scheduler::ui().dispatch([list]() { DeviceRegistry::getInstance()->replace(*list); })) {
+        if (logger) logger->error("ScreenApiClient: UI inbox full, device registry not updated");
     }
+}
+
+int ScreenApiClient::requestConfiguration(const String& endpoint, const String& validator,
+                                          JsonDocument& config, String& etag) {
+    HttpSession& session = HttpSession::getInstance();
+    HTTPClient& httpClient = session.open(endpoint);
     
-    if (response["theme"]) {
-        config["theme"] = response["theme"];
+    if (!validator.isEmpty()) {
+        httpClient.addHeader("If-None-Match", validator);
     }
     
-    if (response["system"]) {
-        config["system"] = response["system"];
+    const char* headerKeys[] = {"ETag"};
+    httpClient.collectHeaders(headerKeys, 1);
+    
+    lastHttpCode = session.send("GET");
+    
+    if (lastHttpCode == HTTP_CODE_OK) {
+        etag = httpClient.header("ETag");
+        
+        JsonDocument filter;
+        buildConfigFilter(filter);
+        
+        DeserializationError error;
+        if (httpClient.getSize() > 0) {
+            // Do socket direto para o documento final, sem String do corpo
+            error = deserializeJson(config, httpClient.getStream(), DeserializationOption::Filter(filter));
+        } else {
+            // Chunked: o stream cru traria os tamanhos dos blocos
+            error = deserializeJson(config, httpClient.getString(), DeserializationOption::Filter(filter));
+        }
+        
+        if (error != DeserializationError::Ok) {
+            config.clear();
+            lastError = "JSON parse error in unified response: " + String(error.c_str());
+            if (logger) {
+                logger->error("ScreenApiClient: " + lastError);
+            }
+        }
+    } else if (lastHttpCode != HTTP_CODE_NOT_MODIFIED) {
+        lastError = "HTTP error: " + String(lastHttpCode);
     }
     
-    if (response["icons"]) {
-        config["icons"] = response["icons"];
+    session.close();
+    return lastHttpCode;
+}
+
+void ScreenApiClient::loadCacheValidator() {
+    if (cacheETagLoaded) return;
+    cacheETagLoaded = true;
+    cacheETag = "";
+    
+    if (!ConfigStore::getInstance().begin() || !LittleFS.exists(API_CONFIG_CACHE_PATH)) return;
+    
+    // Primeira linha do arquivo: ETag; depois, a config processada
+    File file = LittleFS.open(API_CONFIG_CACHE_PATH, "r");
+    if (!file) return;
+    cacheETag = file.readStringUntil('\n');
+    file.close();
+}
+
+bool ScreenApiClient::readCachedConfiguration(JsonDocument& config) {
+    File file = LittleFS.open(API_CONFIG_CACHE_PATH, "r");
+    if (!file) return false;
+    
+    file.readStringUntil('\n');
+    DeserializationError error = deserializeJson(config, file);
+    file.close();
+    
+    if (error != DeserializationError::Ok) {
+        lastError = "Cached configuration unreadable: " + String(error.c_str());
+        if (logger) logger->warning("ScreenApiClient: " + lastError);
+        LittleFS.remove(API_CONFIG_CACHE_PATH);
+        cacheETag = "";
+        return false;
     }
     
-    config["source"] = "api_unified";
-    config["timestamp"] = millis();
+    // Sem processUnifiedResponse: o registry vem da própria config
+    registerDevices(config);
+    return true;
+}
+
+void ScreenApiClient::writeCachedConfiguration(const JsonDocument& config, const String& etag) {
+    // Sem validador não há como revalidar depois: não vale gravar
+    if (etag.isEmpty() || !ConfigStore::getInstance().begin()) return;
     
-    if (logger) {
-        logger->info("ScreenApiClient: Successfully processed unified response");
+    File file = LittleFS.open(API_CONFIG_CACHE_TMP_PATH, "w");
+    if (!file) return;
+    
+    file.print(etag + "\n");
+    size_t written = serializeJson(config, file);
+    file.close();
+    
+    if (written == 0 || !LittleFS.rename(API_CONFIG_CACHE_TMP_PATH, API_CONFIG_CACHE_PATH)) {
+        LittleFS.remove(API_CONFIG_CACHE_TMP_PATH);
+        if (logger) logger->warning("ScreenApiClient: Failed to cache configuration in flash");
+        return;
+    }
+    
+    cacheETag = etag;
+    cacheETagLoaded = true;
+}
+
+bool ScreenApiClient::useCachedConfiguration(JsonDocument& config, const String& validator) {
+    // Chamador já tem essa versão em memória: nada a parsear
+    if (!activeVersion.isEmpty() && validator == activeVersion) {
+        notModified = true;
+        return true;
     }
     
+    if (validator != cacheETag || !readCachedConfiguration(config)) return false;
+    notModified = true;
     return true;
 }
 
@@ -532,6 +618,7 @@ bool ScreenApiClient::loadLegacyConfiguration(JsonDocument& config) {
     // 1. Load devices
     JsonDocument devicesDoc;
     JsonArray devicesArray = devicesDoc.to<JsonArray>();
+    std::shared_ptr<DeviceList> list = std::make_shared<DeviceList>();
     if (getDevices(devicesArray)) {
         // Populate device registry
         logger->info("=== DEVICE REGISTRY POPULATION ===");
@@ -543,11 +630,10 @@ bool ScreenApiClient::loadLegacyConfiguration(JsonDocument& config) {
             
             logger->info("Device: id=" + String(id) + " uuid=" + uuid + " type=" + type + " name=" + name);
             
-            DeviceInfo info(id, uuid, type, name);
-            DeviceRegistry::getInstance()->addDevice(info);
+            list->devices.push_back({id, uuid, type, name});
         }
         if (logger) {
-            logger->info("ScreenApiClient: Registered " + String(DeviceRegistry::getInstance()->getDeviceCount()) + " devices");
+            logger->info("ScreenApiClient: Registered " + String(list->devices.size()) + " devices");
         }
     }
     
@@ -566,14 +652,14 @@ bool ScreenApiClient::loadLegacyConfiguration(JsonDocument& config) {
             logger->info("RelayBoard: id=" + String(id) + " device_id=" + String(device_id) + 
                         " name=" + name + " channels=" + String(channels));
             
-            RelayBoardInfo info(id, device_id, name, channels);
-            DeviceRegistry::getInstance()->addRelayBoard(info);
+            list->relayBoards.push_back(RelayBoardInfo(id, device_id, name, channels));
         }
         if (logger) {
-            logger->info("ScreenApiClient: Registered " + String(DeviceRegistry::getInstance()->getRelayBoardCount()) + " relay boards");
+            logger->info("ScreenApiClient: Registered " + String(list->relayBoards.size()) + " relay boards");
             logger->info("===========================");
         }
     }
+    installDevices(list);
     
     // 3. Load screens
     JsonDocument screensDoc;
@@ -612,11 +698,6 @@ bool ScreenApiClient::loadLegacyConfiguration(JsonDocument& config) {
     config["source"] = "api_legacy";
     config["timestamp"] = millis();
     
-    // Cache the result
-    cachedConfig.clear();
-    serializeJson(config, cachedConfig);
-    cacheTimestamp = millis();
-    
     if (logger) {
         logger->info("ScreenApiClient: Legacy configuration loaded successfully");
         logger->warning("ScreenApiClient: Consider upgrading backend to support unified endpoint for better performance");
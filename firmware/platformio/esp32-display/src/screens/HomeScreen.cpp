@@ -29,18 +29,19 @@ void HomeScreen::build() {
     header->setTitle("Menu Principal");
     
     // Clear existing content
-    content->clearChildren();
+    releaseContent();
     
     // Get screens from configuration to use as navigation items
-    if (configManager && configManager->hasConfig()) {
-        JsonArray screens = configManager->getScreens();
+    ConfigSnapshot config = configManager ? configManager->snapshot() : ConfigSnapshot();
+    if (config) {
+        JsonArrayConst screens = ConfigManager::getScreens(config->doc);
         menuDoc.clear();
         JsonArray menuItems = menuDoc.to<JsonArray>();
         
         logger->debug("Building navigation from " + String(screens.size()) + " screens");
         
         // Convert screens to navigation items
-        for (JsonObject screen : screens) {
+        for (JsonObjectConst screen : screens) {
             // Don't skip any screen - all screens should be navigation items
             
             JsonObject navItem = menuItems.createNestedObject();
@@ -61,8 +62,8 @@ void HomeScreen::build() {
 }
 
 void HomeScreen::rebuildForPage() {
-    // Clear content
-    content->clearChildren();
+    // Clear content (NavButtons da página anterior saem com a arena)
+    releaseContent();
     
     JsonArray menuItems = menuDoc.as<JsonArray>();
     
@@ -90,7 +91,8 @@ void HomeScreen::rebuildForPage() {
             
             logger->debug("Creating button: " + label + " (icon: " + icon + ", target: " + target + ")");
             
-            auto btn = new NavButton(content->getObject(), label, icon, id);
+            auto btn = arena.make<NavButton>(arena, content->getObject(), label, icon, id);
+            if (!btn) break;
             
             if (type == "navigation" && !target.isEmpty()) {
                 btn->setTarget(target);
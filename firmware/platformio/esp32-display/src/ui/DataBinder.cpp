@@ -11,7 +11,7 @@
 
 extern Logger* logger;
 
-void DataBinder::bindWidget(lv_obj_t* widget, NavButton* navBtn, JsonObject& config) {
+void DataBinder::bindWidget(lv_obj_t* widget, NavButton* navBtn, JsonObjectConst config) {
     if (!widget || !navBtn) {
         if (logger) {
             logger->warning("DataBinder: Cannot bind null widget or NavButton");
@@ -30,9 +30,10 @@ void DataBinder::bindWidget(lv_obj_t* widget, NavButton* navBtn, JsonObject& con
     BoundWidget binding;
     binding.widget = widget;
     binding.navButton = navBtn;
-    binding.dataSource = dataSource;
-    binding.dataPath = dataPath;
-    binding.dataUnit = config["data_unit"].as<String>();
+    StringPool& pool = StringPool::getInstance();
+    binding.dataSource = pool.intern(dataSource);
+    binding.dataPath = pool.intern(dataPath);
+    binding.dataUnit = pool.intern(config["data_unit"].as<String>());
     binding.config = config;
     binding.lastValue = 0.0f;
     binding.lastUpdate = 0;
@@ -164,7 +165,7 @@ void DataBinder::updateGaugeWidget(BoundWidget& binding, float value) {
 }
 
 void DataBinder::applyConditionalColors(BoundWidget& binding, float value) {
-    String dataPath = binding.dataPath;
+    const char* dataPath = binding.dataPath;
     lv_obj_t* valueLabel = binding.navButton->getValueLabel();
     
     if (!valueLabel) return;
@@ -172,18 +173,18 @@ void DataBinder::applyConditionalColors(BoundWidget& binding, float value) {
     lv_color_t color = COLOR_TEXT_OFF; // Padrão
     
     // Lógica específica por tipo de dado
-    if (dataPath == "coolant_temp" || dataPath == "engine_temp") {
+    if (strcmp(dataPath, "coolant_temp") == 0 || strcmp(dataPath, "engine_temp") == 0) {
         if (value > 90) color = COLOR_GAUGE_CRITICAL;      // Vermelho - muito quente
         else if (value > 80) color = COLOR_GAUGE_WARNING;  // Laranja - quente
         else color = COLOR_GAUGE_NORMAL;                   // Verde - normal
-    } else if (dataPath == "fuel_level") {
+    } else if (strcmp(dataPath, "fuel_level") == 0) {
         if (value < 20) color = COLOR_GAUGE_WARNING;       // Laranja - combustível baixo
         else color = COLOR_GAUGE_NORMAL;                   // Verde - OK
-    } else if (dataPath == "engine_rpm") {
+    } else if (strcmp(dataPath, "engine_rpm") == 0) {
         if (value > 4000) color = COLOR_GAUGE_WARNING;     // Laranja - RPM alto
         else if (value > 5000) color = COLOR_GAUGE_CRITICAL; // Vermelho - RPM muito alto
         else color = COLOR_GAUGE_NORMAL;                   // Verde - normal
-    } else if (dataPath == "oil_pressure") {
+    } else if (strcmp(dataPath, "oil_pressure") == 0) {
         if (value < 10) color = COLOR_GAUGE_CRITICAL;      // Vermelho - pressão baixa
         else if (value < 20) color = COLOR_GAUGE_WARNING;  // Laranja - pressão baixa
         else color = COLOR_GAUGE_NORMAL;                   // Verde - normal
@@ -209,12 +210,12 @@ void DataBinder::applyBarColors(BoundWidget& binding, lv_obj_t* bar, float value
     lv_obj_set_style_bg_color(bar, barColor, LV_PART_INDICATOR);
 }
 
-float DataBinder::getDataValue(const String& source, const String& path) {
+float DataBinder::getDataValue(const char* source, const char* path) {
     // TODO: Integrar com sistema MQTT real para obter dados reais
     // Por enquanto, gerar valores simulados realistas para demonstração
     
-    if (source == "can_signal") {
-        if (path == "engine_rpm") {
+    if (strcmp(source, "can_signal") == 0) {
+        if (strcmp(path, "engine_rpm") == 0) {
             // Simular RPM do motor (800-5500 RPM)
             static float rpmBase = 800;
             rpmBase += random(-50, 50);
@@ -222,7 +223,7 @@ float DataBinder::getDataValue(const String& source, const String& path) {
             if (rpmBase > 5500) rpmBase = 5500;
             return rpmBase;
         }
-        else if (path == "coolant_temp" || path == "engine_temp") {
+        else if (strcmp(path, "coolant_temp") == 0 || strcmp(path, "engine_temp") == 0) {
             // Simular temperatura do motor (70-95°C)
             static float tempBase = 82;
             tempBase += random(-1, 2) * 0.5f;
@@ -230,14 +231,14 @@ float DataBinder::getDataValue(const String& source, const String& path) {
             if (tempBase > 95) tempBase = 95;
             return tempBase;
         }
-        else if (path == "fuel_level") {
+        else if (strcmp(path, "fuel_level") == 0) {
             // Simular nível de combustível (diminuindo lentamente)
             static float fuelLevel = 85;
             fuelLevel -= 0.01f; // Diminui 0.01% por ciclo
             if (fuelLevel < 0) fuelLevel = 100; // Reset quando esvaziar
             return fuelLevel;
         }
-        else if (path == "oil_pressure") {
+        else if (strcmp(path, "oil_pressure") == 0) {
             // Simular pressão do óleo (15-45 PSI)
             static float pressureBase = 30;
             pressureBase += random(-2, 2);
@@ -245,7 +246,7 @@ float DataBinder::getDataValue(const String& source, const String& path) {
             if (pressureBase > 45) pressureBase = 45;
             return pressureBase;
         }
-        else if (path == "battery_voltage") {
+        else if (strcmp(path, "battery_voltage") == 0) {
             // Simular voltagem da bateria (11.8-14.4V)
             static float voltageBase = 12.6f;
             voltageBase += random(-10, 10) * 0.01f;
@@ -254,8 +255,8 @@ float DataBinder::getDataValue(const String& source, const String& path) {
             return voltageBase;
         }
     }
-    else if (source == "telemetry") {
-        if (path == "speed") {
+    else if (strcmp(source, "telemetry") == 0) {
+        if (strcmp(path, "speed") == 0) {
             // Simular velocidade (0-120 km/h)
             static float speedBase = 45;
             speedBase += random(-5, 5);
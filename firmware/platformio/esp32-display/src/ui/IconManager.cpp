@@ -8,20 +8,21 @@
  */
 
 #include "ui/IconManager.h"
+#include "ui/DefaultIcons.h"
 #include "network/ScreenApiClient.h"
 #include "core/Logger.h"
+#include "utils/MemoryMonitor.h"
 #include <vector>
 #include <map>
+#include <algorithm>
 
 // Logger global declarado em main.cpp
 extern Logger* logger;
 
-IconManager::IconManager() : iconsLoaded(false) {
-    // Carregar ícones padrão imediatamente
-    loadDefaultIcons();
-    
+IconManager::IconManager() : iconsLoaded(true), missCount(0) {
+    // Ícones padrão já estão na flash; nada a construir no boot
     if (logger) {
-        logger->info("IconManager: Initialized with default icons");
+        logger->info("IconManager: Initialized with " + String(DefaultIcons::ICON_COUNT) + " default icons");
     }
 }
 
@@ -29,86 +30,26 @@ IconManager::~IconManager() {
     clearCache();
 }
 
-void IconManager::loadDefaultIcons() {
-    // Limpar mapeamentos existentes
-    iconMappings.clear();
-    categorizedIcons.clear();
-    
-    // Ícones de iluminação
-    iconMappings["light"] = IconMapping(1, "light", "Luz", "lighting", 
-                                       LV_SYMBOL_CHARGE, "\uf0eb", "💡");
-    iconMappings["light_high"] = IconMapping(2, "light_high", "Farol Alto", "lighting", 
-                                           LV_SYMBOL_CHARGE, "\uf0eb", "💡");
-    iconMappings["light_low"] = IconMapping(3, "light_low", "Farol Baixo", "lighting", 
-                                          LV_SYMBOL_CHARGE, "\uf0eb", "💡");
-    iconMappings["fog_light"] = IconMapping(4, "fog_light", "Luz de Neblina", "lighting", 
-                                          LV_SYMBOL_CHARGE, "\uf0eb", "🌫️");
-    iconMappings["work_light"] = IconMapping(5, "work_light", "Luz de Trabalho", "lighting", 
-                                           LV_SYMBOL_CHARGE, "\uf0eb", "🔦");
-    
-    // Ícones de navegação
-    iconMappings["home"] = IconMapping(6, "home", "Início", "navigation", 
-                                     LV_SYMBOL_HOME, "\uf015", "🏠");
-    iconMappings["back"] = IconMapping(7, "back", "Voltar", "navigation", 
-                                     LV_SYMBOL_LEFT, "\uf060", "⬅️");
-    iconMappings["forward"] = IconMapping(8, "forward", "Avançar", "navigation", 
-                                        LV_SYMBOL_RIGHT, "\uf061", "➡️");
-    iconMappings["settings"] = IconMapping(9, "settings", "Configurações", "navigation", 
-                                         LV_SYMBOL_SETTINGS, "\uf013", "⚙️");
-    iconMappings["menu"] = IconMapping(10, "menu", "Menu", "navigation", 
-                                     LV_SYMBOL_LIST, "\uf0c9", "☰");
-    
-    // Ícones de controle
-    iconMappings["power"] = IconMapping(11, "power", "Liga/Desliga", "control", 
-                                      LV_SYMBOL_POWER, "\uf011", "⚡");
-    iconMappings["play"] = IconMapping(12, "play", "Reproduzir", "control", 
-                                     LV_SYMBOL_PLAY, "\uf04b", "▶️");
-    iconMappings["stop"] = IconMapping(13, "stop", "Parar", "control", 
-                                     LV_SYMBOL_STOP, "\uf04d", "⏹️");
-    iconMappings["pause"] = IconMapping(14, "pause", "Pausar", "control", 
-                                      LV_SYMBOL_PAUSE, "\uf04c", "⏸️");
-    iconMappings["winch_in"] = IconMapping(15, "winch_in", "Guincho Recolher", "control", 
-                                         LV_SYMBOL_UP, "\uf062", "⬆️");
-    iconMappings["winch_out"] = IconMapping(16, "winch_out", "Guincho Estender", "control", 
-                                          LV_SYMBOL_DOWN, "\uf063", "⬇️");
-    iconMappings["aux"] = IconMapping(17, "aux", "Auxiliar", "control", 
-                                    LV_SYMBOL_SETTINGS, "\uf013", "🔧");
-    iconMappings["compressor"] = IconMapping(18, "compressor", "Compressor", "control", 
-                                           LV_SYMBOL_SETTINGS, "\uf013", "🌪️");
-    iconMappings["4x4_mode"] = IconMapping(19, "4x4_mode", "Modo 4x4", "control", 
-                                         LV_SYMBOL_DRIVE, "\uf1b9", "🚜");
-    iconMappings["diff_lock"] = IconMapping(20, "diff_lock", "Trava Diferencial", "control", 
-                                          LV_SYMBOL_CLOSE, "\uf023", "🔒");
-    
-    // Ícones de status
-    iconMappings["ok"] = IconMapping(21, "ok", "OK", "status", 
-                                   LV_SYMBOL_OK, "\uf00c", "✅");
-    iconMappings["warning"] = IconMapping(22, "warning", "Atenção", "status", 
-                                        LV_SYMBOL_WARNING, "\uf071", "⚠️");
-    iconMappings["error"] = IconMapping(23, "error", "Erro", "status", 
-                                      LV_SYMBOL_CLOSE, "\uf00d", "❌");
-    iconMappings["wifi"] = IconMapping(24, "wifi", "WiFi", "status", 
-                                     LV_SYMBOL_WIFI, "\uf1eb", "📶");
-    iconMappings["battery"] = IconMapping(25, "battery", "Bateria", "status", 
-                                        LV_SYMBOL_BATTERY_FULL, "\uf240", "🔋");
-    iconMappings["bluetooth"] = IconMapping(26, "bluetooth", "Bluetooth", "status", 
-                                          LV_SYMBOL_BLUETOOTH, "\uf293", "📘");
-    
-    // Organizar por categorias
-    categorizedIcons["lighting"] = {"light", "light_high", "light_low", "fog_light", "work_light"};
-    categorizedIcons["navigation"] = {"home", "back", "forward", "settings", "menu"};
-    categorizedIcons["control"] = {"power", "play", "stop", "pause", "winch_in", "winch_out", 
-                                  "aux", "compressor", "4x4_mode", "diff_lock"};
-    categorizedIcons["status"] = {"ok", "warning", "error", "wifi", "battery", "bluetooth"};
-    
-    iconsLoaded = true;
-    
-    if (logger) {
-        logger->debug("IconManager: Loaded " + String(iconMappings.size()) + " default icons in " + 
-                     String(categorizedIcons.size()) + " categories");
+// Estimativa do heap ocupado por um override (nó do mapa + strings)
+static size_t footprint(const String& key, const IconMapping& m) {
+    return sizeof(IconMapping) + key.length() + m.name.length() + m.displayName.length() +
+           m.category.length() + m.lvglSymbol.length() + m.unicodeChar.length() +
+           m.emoji.length() + m.fallbackIcon.length();
+}
+
+void IconManager::dropOverrides() {
+    overrides.clear();
+    if (overrideBytes) {
+        MemoryMonitor::onFree(MEM_ICONS, overrideBytes);
+        overrideBytes = 0;
     }
 }
 
+IconMapping IconManager::fromEntry(const DefaultIcons::IconEntry& entry) {
+    return IconMapping(entry.id, entry.name, entry.displayName, entry.category,
+                       entry.lvglSymbol, entry.unicodeChar, entry.emoji, entry.fallbackIcon);
+}
+
 bool IconManager::loadFromApi(ScreenApiClient* apiClient) {
     if (!apiClient) {
         lastError = "API client is null";
@@ -121,7 +62,7 @@ bool IconManager::loadFromApi(ScreenApiClient* apiClient) {
     
     JsonDocument iconsDoc;
     if (apiClient->getIcons(iconsDoc)) {
-        return processIconsResponse(iconsDoc);
+        return processIconsResponse(iconsDoc["icons"].as<JsonObjectConst>());
     } else {
         lastError = "Failed to fetch icons from API: " + apiClient->getLastError();
         if (logger) {
@@ -131,25 +72,70 @@ bool IconManager::loadFromApi(ScreenApiClient* apiClient) {
     }
 }
 
-bool IconManager::loadFromConfig(const JsonObject& iconsConfig) {
+bool IconManager::loadFromConfig(JsonObjectConst iconsConfig) {
     if (logger) {
         logger->info("IconManager: Loading icons from configuration");
     }
     
-    JsonDocument doc;
-    doc.set(iconsConfig);
-    return processIconsResponse(doc);
+    // Aceita tanto {"icons": {...}} quanto o mapa de ícones direto
+    JsonObjectConst icons = iconsConfig["icons"].is<JsonObjectConst>()
+        ? iconsConfig["icons"].as<JsonObjectConst>()
+        : JsonObjectConst(iconsConfig);
+    return processIconsResponse(icons);
 }
 
-bool IconManager::processIconsResponse(const JsonDocument& response) {
-    if (!response["icons"].is<JsonObject>()) {
+bool IconManager::processIconsResponse(JsonObjectConst icons) {
+    if (icons.isNull()) {
         lastError = "Invalid icons response structure";
         return false;
     }
     
-    // Simplificado para evitar problemas de conversão do ArduinoJson v7
+    dropOverrides();
+    
+    for (JsonPairConst pair : icons) {
+        JsonObjectConst icon = pair.value().as<JsonObjectConst>();
+        if (icon.isNull()) continue;
+        
+        String name = pair.key().c_str();
+        const DefaultIcons::IconEntry* base = DefaultIcons::find(name.c_str());
+        
+        // Símbolo vem como nome da macro; desconhecido herda o glifo padrão
+        const char* glyph = convertLvglSymbol(icon["lvgl_symbol"] | "");
+        if (!glyph) glyph = base ? base->lvglSymbol : "";
+        
+        // Fallback da API é o id do ícone; aceitar também o nome
+        String fallback;
+        if (icon["fallback"].is<int>()) {
+            const DefaultIcons::IconEntry* target = DefaultIcons::findById(icon["fallback"].as<int>());
+            if (target) fallback = target->name;
+        } else {
+            fallback = icon["fallback"] | "";
+        }
+        
+        IconMapping mapping(icon["id"] | (base ? base->id : 0), name,
+                            icon["display_name"] | (base ? base->displayName : name.c_str()),
+                            icon["category"] | (base ? base->category : ""),
+                            glyph,
+                            icon["unicode_char"] | (base ? base->unicodeChar : ""),
+                            icon["emoji"] | (base ? base->emoji : ""),
+                            fallback);
+        
+        // Igual ao padrão: nada a guardar
+        if (base && mapping.displayName == base->displayName && mapping.category == base->category &&
+            mapping.lvglSymbol == base->lvglSymbol && mapping.unicodeChar == base->unicodeChar &&
+            mapping.emoji == base->emoji && mapping.fallbackIcon == base->fallbackIcon) {
+            continue;
+        }
+        
+        overrides[name] = mapping;
+        size_t bytes = footprint(name, mapping);
+        MemoryMonitor::onAlloc(MEM_ICONS, bytes);
+        overrideBytes += bytes;
+    }
+    
     if (logger) {
-        logger->info("IconManager: Using default icons - API icons processing simplified");
+        logger->info("IconManager: " + String(icons.size()) + " icons received, " +
+                     String(overrides.size()) + " differ from defaults");
     }
     
     iconsLoaded = true;
@@ -157,33 +143,54 @@ bool IconManager::processIconsResponse(const JsonDocument& response) {
 }
 
 String IconManager::getIconSymbol(const String& iconName, bool preferLvgl) {
-    auto it = iconMappings.find(iconName);
-    if (it == iconMappings.end()) {
-        // Ícone não encontrado, retornar fallback genérico
-        if (logger) {
-            logger->warning("IconManager: Icon '" + iconName + "' not found, using fallback");
+    return resolveSymbol(iconName, preferLvgl, 0);
+}
+
+String IconManager::resolveSymbol(const String& iconName, bool preferLvgl, uint8_t depth) {
+    const char* lvglSymbol;
+    const char* unicodeChar;
+    const char* emoji;
+    const char* fallbackIcon;
+    
+    auto it = overrides.find(iconName);
+    if (it != overrides.end()) {
+        const IconMapping& mapping = it->second;
+        lvglSymbol = mapping.lvglSymbol.c_str();
+        unicodeChar = mapping.unicodeChar.c_str();
+        emoji = mapping.emoji.c_str();
+        fallbackIcon = mapping.fallbackIcon.c_str();
+    } else {
+        const DefaultIcons::IconEntry* entry = DefaultIcons::find(iconName.c_str());
+        if (!entry) {
+            // Ícone não encontrado, retornar fallback genérico
+            missCount++;
+            if (logger) {
+                logger->debug("IconManager: Icon '" + iconName + "' not found, using fallback");
+            }
+            return preferLvgl ? LV_SYMBOL_DUMMY : "❓";
         }
-        return preferLvgl ? LV_SYMBOL_DUMMY : "❓";
+        lvglSymbol = entry->lvglSymbol;
+        unicodeChar = entry->unicodeChar;
+        emoji = entry->emoji;
+        fallbackIcon = entry->fallbackIcon;
     }
     
-    const IconMapping& mapping = it->second;
-    
     // Hierarquia de fallback: LVGL → Unicode → Emoji → Fallback Icon
-    if (preferLvgl && !mapping.lvglSymbol.isEmpty()) {
-        return convertLvglSymbol(mapping.lvglSymbol);
+    if (preferLvgl && *lvglSymbol) {
+        return lvglSymbol;
     }
     
-    if (!mapping.unicodeChar.isEmpty()) {
-        return mapping.unicodeChar;
+    if (*unicodeChar) {
+        return unicodeChar;
     }
     
-    if (!mapping.emoji.isEmpty()) {
-        return mapping.emoji;
+    if (*emoji) {
+        return emoji;
     }
     
-    if (!mapping.fallbackIcon.isEmpty()) {
-        // Recursão para buscar ícone fallback
-        return getIconSymbol(mapping.fallbackIcon, preferLvgl);
+    if (*fallbackIcon && depth < MAX_FALLBACK_DEPTH) {
+        // Recursão limitada: a API pode definir ciclos de fallback
+        return resolveSymbol(fallbackIcon, preferLvgl, depth + 1);
     }
     
     // Último recurso
@@ -191,44 +198,82 @@ String IconManager::getIconSymbol(const String& iconName, bool preferLvgl) {
 }
 
 IconMapping IconManager::getIconMapping(const String& iconName) {
-    auto it = iconMappings.find(iconName);
-    if (it != iconMappings.end()) {
+    auto it = overrides.find(iconName);
+    if (it != overrides.end()) {
         return it->second;
     }
+    
+    const DefaultIcons::IconEntry* entry = DefaultIcons::find(iconName.c_str());
+    if (entry) {
+        return fromEntry(*entry);
+    }
     return IconMapping(); // Retorna mapeamento vazio
 }
 
 bool IconManager::hasIcon(const String& iconName) {
-    return iconMappings.find(iconName) != iconMappings.end();
+    return DefaultIcons::find(iconName.c_str()) != nullptr ||
+           overrides.find(iconName) != overrides.end();
+}
+
+const char* IconManager::categoryOf(const String& iconName) const {
+    auto it = overrides.find(iconName);
+    if (it != overrides.end()) {
+        return it->second.category.c_str();
+    }
+    
+    const DefaultIcons::IconEntry* entry = DefaultIcons::find(iconName.c_str());
+    return entry ? entry->category : nullptr;
+}
+
+size_t IconManager::getIconCount() const {
+    size_t count = DefaultIcons::ICON_COUNT;
+    for (const auto& pair : overrides) {
+        if (!DefaultIcons::find(pair.first.c_str())) count++;
+    }
+    return count;
 }
 
 std::vector<String> IconManager::getIconsByCategory(const String& category) {
-    auto it = categorizedIcons.find(category);
-    if (it != categorizedIcons.end()) {
-        return it->second;
+    // Raro (só diagnóstico): montado sob demanda em vez de mantido em RAM
+    std::vector<String> icons;
+    for (uint8_t i = 0; i < DefaultIcons::ICON_COUNT; i++) {
+        const char* name = DefaultIcons::ICONS[i].name;
+        if (category == categoryOf(name)) {
+            icons.push_back(name);
+        }
+    }
+    for (const auto& pair : overrides) {
+        if (!DefaultIcons::find(pair.first.c_str()) && pair.second.category == category) {
+            icons.push_back(pair.first);
+        }
     }
-    return std::vector<String>();
+    return icons;
 }
 
 std::vector<String> IconManager::getCategories() {
     std::vector<String> categories;
-    for (const auto& pair : categorizedIcons) {
-        categories.push_back(pair.first);
+    for (uint8_t i = 0; i < DefaultIcons::CATEGORY_COUNT; i++) {
+        categories.push_back(DefaultIcons::CATEGORIES[i]);
+    }
+    for (const auto& pair : overrides) {
+        const String& category = pair.second.category;
+        if (!category.isEmpty() &&
+            std::find(categories.begin(), categories.end(), category) == categories.end()) {
+            categories.push_back(category);
+        }
     }
     return categories;
 }
 
 void IconManager::clearCache() {
-    iconMappings.clear();
-    categorizedIcons.clear();
-    iconsLoaded = false;
+    dropOverrides();
     
     if (logger) {
-        logger->debug("IconManager: Cache cleared");
+        logger->debug("IconManager: Overrides cleared, defaults remain");
     }
 }
 
-String IconManager::convertLvglSymbol(const String& lvglSymbol) {
+const char* IconManager::convertLvglSymbol(const String& lvglSymbol) {
     // Mapeamento dos símbolos LVGL mais comuns para caracteres Unicode
     if (lvglSymbol == "LV_SYMBOL_POWER") return LV_SYMBOL_POWER;
     if (lvglSymbol == "LV_SYMBOL_SETTINGS") return LV_SYMBOL_SETTINGS;
@@ -252,11 +297,8 @@ String IconManager::convertLvglSymbol(const String& lvglSymbol) {
     if (lvglSymbol == "LV_SYMBOL_DRIVE") return LV_SYMBOL_DRIVE;
     if (lvglSymbol == "LV_SYMBOL_DUMMY") return LV_SYMBOL_DUMMY;
     
-    // Se não encontrou mapeamento, retornar o símbolo original ou fallback
-    if (logger) {
-        logger->debug("IconManager: Unknown LVGL symbol '" + lvglSymbol + "', using fallback");
-    }
-    return LV_SYMBOL_DUMMY;
+    // Desconhecido: quem chama decide (glifo padrão ou próximo da hierarquia)
+    return nullptr;
 }
 
 String IconManager::createButtonSymbol(const String& iconName, const String& text, bool iconFirst) {
@@ -270,12 +312,12 @@ String IconManager::createButtonSymbol(const String& iconName, const String& tex
 }
 
 String IconManager::getSuggestedColor(const String& iconName) {
-    auto it = iconMappings.find(iconName);
-    if (it == iconMappings.end()) {
+    const char* found = categoryOf(iconName);
+    if (!found) {
         return "#808080"; // Cinza padrão
     }
     
-    const String& category = it->second.category;
+    String category = found;
     
     // Cores sugeridas por categoria
     if (category == "lighting") return "#FFA500"; // Laranja
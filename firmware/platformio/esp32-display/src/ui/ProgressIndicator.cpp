@@ -0,0 +1,60 @@
+/**
+ * @file ProgressIndicator.cpp
+ * @brief Indicador de progresso da rede na camada superior do LVGL
+ */
+
+#include "ui/ProgressIndicator.h"
+#include "ui/Theme.h"
+#include <string.h>
+
+static const lv_coord_t PROGRESS_HEIGHT = 24;
+static const lv_coord_t PROGRESS_SPINNER_SIZE = 16;
+
+void ProgressIndicator::create() {
+    box = lv_obj_create(lv_layer_top());
+    lv_obj_remove_style_all(box);
+    lv_obj_clear_flag(box, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_size(box, LV_SIZE_CONTENT, PROGRESS_HEIGHT);
+    lv_obj_align(box, LV_ALIGN_BOTTOM_MID, 0, -4);
+    lv_obj_set_style_bg_color(box, COLOR_CARD_BG, 0);
+    lv_obj_set_style_bg_opa(box, LV_OPA_90, 0);
+    lv_obj_set_style_radius(box, PROGRESS_HEIGHT / 2, 0);
+    lv_obj_set_style_border_color(box, COLOR_BORDER, 0);
+    lv_obj_set_style_border_width(box, 1, 0);
+    lv_obj_set_style_pad_hor(box, 10, 0);
+    lv_obj_set_style_pad_column(box, 6, 0);
+    lv_obj_set_flex_flow(box, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(box, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+
+    lv_obj_t* spinner = lv_spinner_create(box, 1000, 60);
+    lv_obj_clear_flag(spinner, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_set_size(spinner, PROGRESS_SPINNER_SIZE, PROGRESS_SPINNER_SIZE);
+    lv_obj_set_style_arc_width(spinner, 3, LV_PART_MAIN);
+    lv_obj_set_style_arc_width(spinner, 3, LV_PART_INDICATOR);
+    lv_obj_set_style_arc_color(spinner, COLOR_HIGHLIGHT, LV_PART_INDICATOR);
+
+    label = lv_label_create(box);
+    lv_obj_set_style_text_color(label, COLOR_TEXT_OFF, 0);
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_12, 0);
+    lv_label_set_text(label, "");
+}
+
+void ProgressIndicator::show(const char* text) {
+    if (!box) create();
+
+    if (strcmp(lv_label_get_text(label), text) != 0) {
+        lv_label_set_text(label, text);
+    }
+    if (!visible) {
+        lv_obj_clear_flag(box, LV_OBJ_FLAG_HIDDEN);
+        visible = true;
+    }
+}
+
+void ProgressIndicator::hide() {
+    if (!box || !visible) return;
+
+    // Escondido o spinner não anima: nada a redesenhar
+    lv_obj_add_flag(box, LV_OBJ_FLAG_HIDDEN);
+    visible = false;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file ScreenArena.cpp
+ * @brief Implementação da arena por tela
+ */
+
+#include "ui/ScreenArena.h"
+#include "core/Logger.h"
+#include "utils/MemoryMonitor.h"
+
+extern Logger* logger;
+
+ScreenArena::ScreenArena(size_t chunkSize) : chunkSize(chunkSize) {
+}
+
+ScreenArena::~ScreenArena() {
+    release();
+}
+
+ScreenArena::Chunk* ScreenArena::newChunk(size_t minSize) {
+    size_t size = minSize > chunkSize ? minSize : chunkSize;
+    void* mem = malloc(sizeof(Chunk) + size);
+    if (!mem) {
+        if (logger) {
+            logger->error("ScreenArena: out of memory (" + String((unsigned)size) + " bytes)");
+        }
+        return nullptr;
+    }
+
+    MemoryMonitor::onAlloc(MEM_SCREENS, sizeof(Chunk) + size);
+    
+    Chunk* chunk = static_cast<Chunk*>(mem);
+    chunk->next = nullptr;
+    chunk->size = size;
+    chunk->offset = 0;
+    return chunk;
+}
+
+// Offset dentro do bloco cujo endereço absoluto respeita o alinhamento
+static size_t alignedOffset(uint8_t* data, size_t offset, size_t align) {
+    uintptr_t base = reinterpret_cast<uintptr_t>(data);
+    uintptr_t aligned = (base + offset + align - 1) & ~(uintptr_t)(align - 1);
+    return aligned - base;
+}
+
+void* ScreenArena::allocate(size_t size, size_t align) {
+    if (size == 0) size = 1;
+
+    // Procura espaço no bloco atual e nos seguintes (mantidos após reset)
+    Chunk* chunk = current;
+    while (chunk) {
+        size_t start = alignedOffset(chunk->data(), chunk->offset, align);
+        if (start + size <= chunk->size) {
+            chunk->offset = start + size;
+            current = chunk;
+            used += size;
+            if (used > peak) peak = used;
+            return chunk->data() + start;
+        }
+        chunk = chunk->next;
+    }
+
+    // Sem espaço: novo bloco no fim da lista
+    Chunk* fresh = newChunk(size + align);
+    if (!fresh) return nullptr;
+
+    if (!head) {
+        head = fresh;
+    } else {
+        Chunk* tail = current ? current : head;
+        while (tail->next) tail = tail->next;
+        tail->next = fresh;
+    }
+    current = fresh;
+
+    size_t start = alignedOffset(fresh->data(), 0, align);
+    fresh->offset = start + size;
+    used += size;
+    if (used > peak) peak = used;
+    return fresh->data() + start;
+}
+
+const char* ScreenArena::copy(const char* str) {
+    if (!str || !*str) return "";
+
+    size_t len = strlen(str) + 1;
+    char* out = static_cast<char*>(allocate(len, 1));
+    if (!out) return "";
+    memcpy(out, str, len);
+    return out;
+}
+
+void ScreenArena::addDestructor(void* obj, void (*fn)(void*)) {
+    Destructor* entry = static_cast<Destructor*>(allocate(sizeof(Destructor), alignof(Destructor)));
+    if (!entry) return;
+    entry->fn = fn;
+    entry->obj = obj;
+    entry->next = destructors;
+    destructors = entry;
+    objectCount++;
+}
+
+void ScreenArena::runDestructors() {
+    // LIFO: objetos criados depois (que podem referenciar os anteriores) saem antes
+    Destructor* entry = destructors;
+    destructors = nullptr;
+    while (entry) {
+        Destructor* next = entry->next;
+        entry->fn(entry->obj);
+        entry = next;
+    }
+    objectCount = 0;
+}
+
+void ScreenArena::reset() {
+    runDestructors();
+
+    for (Chunk* chunk = head; chunk; chunk = chunk->next) {
+        chunk->offset = 0;
+    }
+    current = head;
+    used = 0;
+}
+
+void ScreenArena::release() {
+    runDestructors();
+
+    Chunk* chunk = head;
+    while (chunk) {
+        Chunk* next = chunk->next;
+        MemoryMonitor::onFree(MEM_SCREENS, sizeof(Chunk) + chunk->size);
+        free(chunk);
+        chunk = next;
+    }
+    head = nullptr;
+    current = nullptr;
+    used = 0;
+}
+
+size_t ScreenArena::getCapacity() const {
+    size_t total = 0;
+    for (Chunk* chunk = head; chunk; chunk = chunk->next) {
+        total += chunk->size;
+    }
+    return total;
+}
+
+uint16_t ScreenArena::getChunkCount() const {
+    uint16_t count = 0;
+    for (Chunk* chunk = head; chunk; chunk = chunk->next) {
+        count++;
+    }
+    return count;
+}
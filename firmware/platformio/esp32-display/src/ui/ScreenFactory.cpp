@@ -88,7 +88,7 @@ void applyComponentDebugBorder(lv_obj_t* obj, ComponentColorIndex colorIndex, co
 // Instância global do DataBinder para widgets dinâmicos
 DataBinder* dataBinder = nullptr;
 
-std::unique_ptr<ScreenBase> ScreenFactory::createScreen(JsonObject& config) {
+std::unique_ptr<ScreenBase> ScreenFactory::createScreen(JsonObjectConst config, const ConfigSnapshot& owner) {
     // Convert id to string if it's a number
     String screenId;
     if (config["id"].is<int>()) {
@@ -103,28 +103,26 @@ std::unique_ptr<ScreenBase> ScreenFactory::createScreen(JsonObject& config) {
     // Create custom screen class that stores items
     class CustomScreen : public ScreenBase {
     private:
-        JsonDocument itemsDoc;
-        JsonArray storedItems;
+        // Itens lidos direto do snapshot; o handle o mantém vivo (e os
+        // JsonObjectConst do DataBinder válidos) até a tela ser destruída
+        ConfigSnapshot owner;
+        JsonArrayConst storedItems;
         
     public:
         CustomScreen() : ScreenBase() {}
         
-        void setItems(JsonArray items) {
-            // Copiar items para armazenamento interno
-            itemsDoc.clear();
-            for (JsonVariant item : items) {
-                itemsDoc.add(item);
-            }
-            storedItems = itemsDoc.as<JsonArray>();
+        void setItems(JsonArrayConst items, const ConfigSnapshot& snapshot) {
+            owner = snapshot;
+            storedItems = items;
         }
         
         void rebuildContent() override {
-            // Limpar conteúdo atual
-            content->clearChildren();
+            // Limpar conteúdo atual (widgets + NavButtons da página anterior)
+            releaseContent();
             
             // Sort items by order_index before displaying
             struct ItemWithOrder {
-                JsonObject item;
+                JsonObjectConst item;
                 int order;
             };
             
@@ -133,7 +131,7 @@ std::unique_ptr<ScreenBase> ScreenFactory::createScreen(JsonObject& config) {
             logger->debug("Processing " + String(storedItems.size()) + " items for screen");
             
             // Sort by position (API usa 'position' não 'order_index')
-            for (JsonObject item : storedItems) {
+            for (JsonObjectConst item : storedItems) {
                 ItemWithOrder iwo;
                 iwo.item = item;
                 iwo.order = item["position"] | 999;
@@ -157,17 +155,17 @@ std::unique_ptr<ScreenBase> ScreenFactory::createScreen(JsonObject& config) {
                 int pageCount = 0;
                 
                 for (int j = 0; j < (int)sortedItems.size(); j++) {
-                    JsonObject item = sortedItems[j].item;
+                    JsonObjectConst item = sortedItems[j].item;
                     // CORREÇÃO: Verificar múltiplos campos de size em ordem de prioridade
                     String sizeStr = "";
                     
                     // 1. Tentar campo "size" (backend já corrigido retorna o correto)
-                    if (item["size"].is<JsonVariant>()) {
+                    if (item["size"].is<JsonVariantConst>()) {
                         sizeStr = item["size"].as<String>();
                     }
                     
                     // 2. Se não encontrou, tentar "size_display_small" (campo específico)
-                    if (sizeStr.isEmpty() && item["size_display_small"].is<JsonVariant>()) {
+                    if (sizeStr.isEmpty() && item["size_display_small"].is<JsonVariantConst>()) {
                         sizeStr = item["size_display_small"].as<String>();
                     }
                     
@@ -196,82 +194,19 @@ std::unique_ptr<ScreenBase> ScreenFactory::createScreen(JsonObject& config) {
             
             // Adicionar itens à página atual até atingir limite de slots
             for (int i = startIdx; i < (int)sortedItems.size(); i++) {
-                JsonObject item = sortedItems[i].item;
-                
-                // ADAPTADOR: Converter formato antigo para novo formato da API
-                // Detectar formato antigo (type="relay" com device/channel)
-                if (item["type"].is<JsonVariant>()) {
-                    String oldType = item["type"].as<String>();
-                    logger->info("[ADAPTER] Detected old format with type: " + oldType);
-                    
-                    if (oldType == "relay") {
-                        // Converter formato antigo para novo
-                        item["item_type"] = "button";
-                        item["action_type"] = "relay_control";
-                        
-                        // Converter device para relay_board_id
-                        if (item["device"].is<JsonVariant>()) {
-                            String device = item["device"].as<String>();
-                            // Extrair número do device (relay_board_1 → 1)
-                            if (device.startsWith("relay_board_")) {
-                                int boardId = device.substring(12).toInt();
-                                item["relay_board_id"] = boardId;
-                            }
-                        }
-                        
-                        // Converter channel para relay_channel_id
-                        if (item["channel"].is<JsonVariant>()) {
-                            item["relay_channel_id"] = item["channel"].as<int>();
-                        }
-                        
-                        // Converter mode para action_payload
-                        if (item["mode"].is<JsonVariant>()) {
-                            String mode = item["mode"].as<String>();
-                            JsonObject payload = item["action_payload"].to<JsonObject>();
-                            payload["momentary"] = (mode == "momentary");
-                        }
-                        
-                        // Converter id para name se necessário
-                        if (item["id"].is<JsonVariant>() && !item["name"].is<JsonVariant>()) {
-                            item["name"] = item["id"].as<String>();
-                        }
-                        
-                        logger->info("[ADAPTER] Converted old relay format to new API format for: " + item["label"].as<String>());
-                    } else if (oldType == "navigation") {
-                        // Converter navegação
-                        item["item_type"] = "button";
-                        item["action_type"] = "navigation";
-                        
-                        // Converter id para name
-                        if (item["id"].is<JsonVariant>() && !item["name"].is<JsonVariant>()) {
-                            item["name"] = item["id"].as<String>();
-                        }
-                        
-                        logger->info("[ADAPTER] Converted old navigation format to new API format for: " + item["label"].as<String>());
-                    } else if (oldType == "action" || oldType == "preset") {
-                        // Converter action/preset
-                        item["item_type"] = "button";
-                        item["action_type"] = (oldType == "preset") ? "macro" : "command";
-                        
-                        // Converter id para name
-                        if (item["id"].is<JsonVariant>() && !item["name"].is<JsonVariant>()) {
-                            item["name"] = item["id"].as<String>();
-                        }
-                        
-                        logger->info("[ADAPTER] Converted old " + oldType + " format to new API format for: " + item["label"].as<String>());
-                    }
-                }
+                // Formato antigo já adaptado pelo ConfigManager ao publicar
+                JsonObjectConst item = sortedItems[i].item;
                 
                 // CORREÇÃO: Verificar múltiplos campos de size em ordem de prioridade  
                 String sizeStr = "";
                 
                 // 1. Tentar campo "size" (backend já corrigido retorna o correto)
-                if (item["size"].is<JsonVariant>()) {
+                if (item["size"].is<JsonVariantConst>()) {
                     sizeStr = item["size"].as<String>();
                 }
                 
                 // 2. Se não encontrou, tentar "size_display_small" (campo específico)
-                if (sizeStr.isEmpty() && item["size_display_small"].is<JsonVariant>()) {
+                if (sizeStr.isEmpty() && item["size_display_small"].is<JsonVariantConst>()) {
                     sizeStr = item["size_display_small"].as<String>();
                 }
                 
@@ -328,21 +263,21 @@ std::unique_ptr<ScreenBase> ScreenFactory::createScreen(JsonObject& config) {
                 // Mapear tipos da API para tipos internos (NOVOS ENUMS LOWERCASE)
                 if (itemType == "button" && actionType == "relay_control") {
                     logger->info("[CREATE] RelayItem - name:'" + itemName + "', label:'" + itemLabel + "', icon:'" + itemIcon + "', size:'" + sizeStr + "'");
-                    navBtn = ScreenFactory::createRelayItem(content->getObject(), item);
+                    navBtn = ScreenFactory::createRelayItem(content->getObject(), item, arena);
                     if (navBtn && navBtn->getObject()) {
                         // DEBUG REMOVIDO: Bordas coloridas desabilitadas
                         // applyNavButtonDebugBorder(navBtn->getObject(), NAVBUTTON_COLOR_IDX_BUTTON, "RelayItem", itemName, itemLabel, itemIcon, sizeStr);
                     }
                 } else if (itemType == "button" && actionType == "navigation") {
                     logger->info("[CREATE] NavigationItem - name:'" + itemName + "', label:'" + itemLabel + "', icon:'" + itemIcon + "', size:'" + sizeStr + "'");
-                    navBtn = ScreenFactory::createNavigationItem(content->getObject(), item);
+                    navBtn = ScreenFactory::createNavigationItem(content->getObject(), item, arena);
                     if (navBtn && navBtn->getObject()) {
                         // DEBUG REMOVIDO: Bordas coloridas desabilitadas
                         // applyNavButtonDebugBorder(navBtn->getObject(), NAVBUTTON_COLOR_IDX_BUTTON, "NavigationItem", itemName, itemLabel, itemIcon, sizeStr);
                     }
                 } else if (itemType == "button" && (actionType == "command" || actionType == "macro")) {
                     logger->info("[CREATE] ActionItem - name:'" + itemName + "', label:'" + itemLabel + "', icon:'" + itemIcon + "', size:'" + sizeStr + "'");
-                    navBtn = ScreenFactory::createActionItem(content->getObject(), item);
+                    navBtn = ScreenFactory::createActionItem(content->getObject(), item, arena);
                     if (navBtn && navBtn->getObject()) {
                         // DEBUG REMOVIDO: Bordas coloridas desabilitadas
                         // applyNavButtonDebugBorder(navBtn->getObject(), NAVBUTTON_COLOR_IDX_BUTTON, "ActionItem", itemName, itemLabel, itemIcon, sizeStr);
@@ -350,7 +285,7 @@ std::unique_ptr<ScreenBase> ScreenFactory::createScreen(JsonObject& config) {
                 } else if (itemType == "switch" && actionType == "relay_control") {
                     logger->info("[CREATE] SwitchItem - name:'" + itemName + "', label:'" + itemLabel + "', icon:'" + itemIcon + "', size:'" + sizeStr + "'");
                     // CORREÇÃO: Switches são tratados como objetos diretos, não NavButtons
-                    lv_obj_t* switchObj = ScreenFactory::createSwitchDirectly(content->getObject(), item);
+                    lv_obj_t* switchObj = ScreenFactory::createSwitchDirectly(content->getObject(), item, arena);
                     if (switchObj) {
                         // Armazenar ComponentSize no user_data
                         ComponentSize compSize = Layout::parseComponentSize(sizeStr);
@@ -402,7 +337,7 @@ std::unique_ptr<ScreenBase> ScreenFactory::createScreen(JsonObject& config) {
                         continue; // Pular o resto do loop, gauge já foi adicionado
                     } else {
                         logger->info("[CREATE] DisplayItem - name:'" + itemName + "', label:'" + itemLabel + "', icon:'" + itemIcon + "', size:'" + sizeStr + "'");
-                        navBtn = ScreenFactory::createDisplayItem(content->getObject(), item);
+                        navBtn = ScreenFactory::createDisplayItem(content->getObject(), item, arena);
                         if (navBtn && navBtn->getObject()) {
                             // DEBUG REMOVIDO: Bordas coloridas desabilitadas
                             // applyNavButtonDebugBorder(navBtn->getObject(), NAVBUTTON_COLOR_IDX_BUTTON, "DisplayItem", itemName, itemLabel, itemIcon, sizeStr);
@@ -416,7 +351,7 @@ std::unique_ptr<ScreenBase> ScreenFactory::createScreen(JsonObject& config) {
                     
                     // Fallback: Tentar criar pelo menos um botão simples
                     logger->info("[CREATE] FallbackItem - name:'" + itemName + "', label:'" + itemLabel + "', icon:'" + itemIcon + "', size:'" + sizeStr + "'");
-                    navBtn = ScreenFactory::createActionItem(content->getObject(), item);
+                    navBtn = ScreenFactory::createActionItem(content->getObject(), item, arena);
                     if (navBtn && navBtn->getObject()) {
                         // DEBUG REMOVIDO: Bordas coloridas desabilitadas
                         // applyNavButtonDebugBorder(navBtn->getObject(), NAVBUTTON_COLOR_IDX_BUTTON, "FallbackItem", itemName, itemLabel, itemIcon, sizeStr);
@@ -483,29 +418,29 @@ std::unique_ptr<ScreenBase> ScreenFactory::createScreen(JsonObject& config) {
     // Add debug logs to verify API structure
     if (logger) {
         logger->debug("ScreenFactory: Processing screen config");
-        if (config["items"].is<JsonArray>()) {
-            logger->debug("ScreenFactory: Found items array with " + String(config["items"].as<JsonArray>().size()) + " items");
+        if (config["items"].is<JsonArrayConst>()) {
+            logger->debug("ScreenFactory: Found items array with " + String(config["items"].as<JsonArrayConst>().size()) + " items");
         }
-        if (config["screen_items"].is<JsonArray>()) {
+        if (config["screen_items"].is<JsonArrayConst>()) {
             logger->warning("ScreenFactory: Found deprecated screen_items field - should use 'items' instead");
         }
     }
     
     // Process items from API structure (items) with backwards compatibility
-    JsonArray items;
-    if (config["items"].is<JsonArray>()) {
+    JsonArrayConst items;
+    if (config["items"].is<JsonArrayConst>()) {
         // New API format uses 'items'
-        items = config["items"].as<JsonArray>();
-    } else if (config["screen_items"].is<JsonArray>()) {
+        items = config["items"].as<JsonArrayConst>();
+    } else if (config["screen_items"].is<JsonArrayConst>()) {
         // Legacy format uses 'screen_items' 
-        items = config["screen_items"].as<JsonArray>();
+        items = config["screen_items"].as<JsonArrayConst>();
         if (logger) {
             logger->warning("ScreenFactory: Using deprecated 'screen_items' field");
         }
     }
     
     if (!items.isNull()) {
-        screen->setItems(items); // Armazenar todos os items
+        screen->setItems(items, owner); // Referência aos itens, sem cópia
         
         // Update navigation state using slot-based pagination
         NavigationState& navState = const_cast<NavigationState&>(screen->navState);
@@ -513,7 +448,7 @@ std::unique_ptr<ScreenBase> ScreenFactory::createScreen(JsonObject& config) {
         
         // Calcular totalPages baseado em slots ocupados
         int totalSlots = 0;
-        for (JsonObject item : items) {
+        for (JsonObjectConst item : items) {
             // CORREÇÃO: Usar campo "size" primeiro, depois "size_display_small"
             String sizeStr = item["size"].as<String>();
             if (sizeStr.isEmpty()) {
@@ -539,7 +474,7 @@ std::unique_ptr<ScreenBase> ScreenFactory::createScreen(JsonObject& config) {
     return screen;
 }
 
-NavButton* ScreenFactory::createNavigationItem(lv_obj_t* parent, JsonObject& config) {
+NavButton* ScreenFactory::createNavigationItem(lv_obj_t* parent, JsonObjectConst config, ScreenArena& arena) {
     String label = config["label"].as<String>();
     String icon = config["icon"].as<String>();
     String target = config["action_target"].as<String>();
@@ -547,10 +482,10 @@ NavButton* ScreenFactory::createNavigationItem(lv_obj_t* parent, JsonObject& con
     
     // IMPORTANTE: Ler o tamanho configurado
     String sizeStr = "";
-    if (config["size"].is<JsonVariant>()) {
+    if (config["size"].is<JsonVariantConst>()) {
         sizeStr = config["size"].as<String>();
     }
-    if (sizeStr.isEmpty() && config["size_display_small"].is<JsonVariant>()) {
+    if (sizeStr.isEmpty() && config["size_display_small"].is<JsonVariantConst>()) {
         sizeStr = config["size_display_small"].as<String>();
     }
     if (sizeStr.isEmpty()) {
@@ -559,7 +494,8 @@ NavButton* ScreenFactory::createNavigationItem(lv_obj_t* parent, JsonObject& con
     
     // For navigation items in new structure, target is the screen ID
     // which might be numeric now
-    auto btn = new NavButton(parent, label, icon, id);
+    auto btn = arena.make<NavButton>(arena, parent, label, icon, id);
+    if (!btn) return nullptr;
     btn->setTarget(target);
     
     // IMPORTANTE: Armazenar ComponentSize no user_data do objeto LVGL interno
@@ -587,13 +523,13 @@ NavButton* ScreenFactory::createNavigationItem(lv_obj_t* parent, JsonObject& con
     return btn;
 }
 
-NavButton* ScreenFactory::createRelayItem(lv_obj_t* parent, JsonObject& config) {
+NavButton* ScreenFactory::createRelayItem(lv_obj_t* parent, JsonObjectConst config, ScreenArena& arena) {
     String label = config["label"].as<String>();
     String icon = config["icon"].as<String>();
     String id = config["name"].as<String>(); // API usa 'name' não 'id'
     
     // Se name estiver vazio, tentar id
-    if (id.isEmpty() && config["id"].is<JsonVariant>()) {
+    if (id.isEmpty() && config["id"].is<JsonVariantConst>()) {
         id = config["id"].as<String>();
     }
     
@@ -601,10 +537,10 @@ NavButton* ScreenFactory::createRelayItem(lv_obj_t* parent, JsonObject& config)
     
     // IMPORTANTE: Ler o tamanho configurado
     String sizeStr = "";
-    if (config["size"].is<JsonVariant>()) {
+    if (config["size"].is<JsonVariantConst>()) {
         sizeStr = config["size"].as<String>();
     }
-    if (sizeStr.isEmpty() && config["size_display_small"].is<JsonVariant>()) {
+    if (sizeStr.isEmpty() && config["size_display_small"].is<JsonVariantConst>()) {
         sizeStr = config["size_display_small"].as<String>();
     }
     if (sizeStr.isEmpty()) {
@@ -614,7 +550,7 @@ NavButton* ScreenFactory::createRelayItem(lv_obj_t* parent, JsonObject& config)
     // Extrair informações do relay
     uint8_t relay_board_id = config["relay_board_id"] | 0;
     uint8_t relay_channel_id = config["relay_channel_id"] | 0;
-    JsonObject action_payload = config["action_payload"];
+    JsonObjectConst action_payload = config["action_payload"];
     
     logger->info("[createRelayItem] relay_board_id=" + String(relay_board_id) + 
                 " relay_channel_id=" + String(relay_channel_id));
@@ -623,8 +559,8 @@ NavButton* ScreenFactory::createRelayItem(lv_obj_t* parent, JsonObject& config)
     String function_type = "toggle"; // default
     
     // Primeiro verificar se tem relay_channel.function_type (novo formato)
-    if (config["relay_channel"].is<JsonObject>()) {
-        JsonObject relay_channel = config["relay_channel"];
+    if (config["relay_channel"].is<JsonObjectConst>()) {
+        JsonObjectConst relay_channel = config["relay_channel"];
         if (relay_channel["function_type"].is<const char*>()) {
             function_type = relay_channel["function_type"].as<String>();
             logger->info("[createRelayItem] Found function_type in relay_channel: " + function_type);
@@ -637,7 +573,8 @@ NavButton* ScreenFactory::createRelayItem(lv_obj_t* parent, JsonObject& config)
     
     logger->info("[createRelayItem] function_type=" + function_type);
     
-    auto btn = new NavButton(parent, label, icon, id);
+    auto btn = arena.make<NavButton>(arena, parent, label, icon, id);
+    if (!btn) return nullptr;
     btn->setButtonType(NavButton::TYPE_RELAY);
     
     // IMPORTANTE: Armazenar ComponentSize no user_data do objeto LVGL interno
@@ -740,14 +677,14 @@ NavButton* ScreenFactory::createRelayItem(lv_obj_t* parent, JsonObject& config)
         }
         logger->info("========================");
         
-        // Para toggle, atualizar estado visual imediatamente
-        if (function_type == "toggle") {
-            b->setState(newState);
-        }
-        
         // Registrar botão para receber atualizações MQTT se ainda não estiver
         if (buttonStateManager) {
             buttonStateManager->registerButton(b);
+            
+            // Toggle: estado novo aparece já, pendente até o eco ou a confirmação
+            if (function_type == "toggle" && sent) {
+                buttonStateManager->beginPending(b, newState, commandSender->getLastRequestId());
+            }
         }
     });
     
@@ -756,7 +693,7 @@ NavButton* ScreenFactory::createRelayItem(lv_obj_t* parent, JsonObject& config)
     return btn;
 }
 
-NavButton* ScreenFactory::createActionItem(lv_obj_t* parent, JsonObject& config) {
+NavButton* ScreenFactory::createActionItem(lv_obj_t* parent, JsonObjectConst config, ScreenArena& arena) {
     String label = config["label"].as<String>();
     String icon = config["icon"].as<String>();
     String id = config["name"].as<String>(); // API usa 'name' não 'id'
@@ -765,17 +702,18 @@ NavButton* ScreenFactory::createActionItem(lv_obj_t* parent, JsonObject& config)
     
     // IMPORTANTE: Ler o tamanho configurado
     String sizeStr = "";
-    if (config["size"].is<JsonVariant>()) {
+    if (config["size"].is<JsonVariantConst>()) {
         sizeStr = config["size"].as<String>();
     }
-    if (sizeStr.isEmpty() && config["size_display_small"].is<JsonVariant>()) {
+    if (sizeStr.isEmpty() && config["size_display_small"].is<JsonVariantConst>()) {
         sizeStr = config["size_display_small"].as<String>();
     }
     if (sizeStr.isEmpty()) {
         sizeStr = "normal";
     }
     
-    auto btn = new NavButton(parent, label, icon, id);
+    auto btn = arena.make<NavButton>(arena, parent, label, icon, id);
+    if (!btn) return nullptr;
     btn->setButtonType(NavButton::TYPE_ACTION);
     btn->setActionConfig(actionType, preset);
     
@@ -809,7 +747,7 @@ NavButton* ScreenFactory::createActionItem(lv_obj_t* parent, JsonObject& config)
     return btn;
 }
 
-NavButton* ScreenFactory::createModeItem(lv_obj_t* parent, JsonObject& config) {
+NavButton* ScreenFactory::createModeItem(lv_obj_t* parent, JsonObjectConst config, ScreenArena& arena) {
     String label = config["label"].as<String>();
     String icon = config["icon"].as<String>();
     String id = config["name"].as<String>(); // API usa 'name' não 'id'
@@ -817,17 +755,18 @@ NavButton* ScreenFactory::createModeItem(lv_obj_t* parent, JsonObject& config) {
     
     // IMPORTANTE: Ler o tamanho configurado
     String sizeStr = "";
-    if (config["size"].is<JsonVariant>()) {
+    if (config["size"].is<JsonVariantConst>()) {
         sizeStr = config["size"].as<String>();
     }
-    if (sizeStr.isEmpty() && config["size_display_small"].is<JsonVariant>()) {
+    if (sizeStr.isEmpty() && config["size_display_small"].is<JsonVariantConst>()) {
         sizeStr = config["size_display_small"].as<String>();
     }
     if (sizeStr.isEmpty()) {
         sizeStr = "normal";
     }
     
-    auto btn = new NavButton(parent, label, icon, id);
+    auto btn = arena.make<NavButton>(arena, parent, label, icon, id);
+    if (!btn) return nullptr;
     btn->setButtonType(NavButton::TYPE_MODE);
     btn->setModeConfig(mode);
     
@@ -861,7 +800,7 @@ NavButton* ScreenFactory::createModeItem(lv_obj_t* parent, JsonObject& config) {
     return btn;
 }
 
-NavButton* ScreenFactory::createDisplayItem(lv_obj_t* parent, JsonObject& config) {
+NavButton* ScreenFactory::createDisplayItem(lv_obj_t* parent, JsonObjectConst config, ScreenArena& arena) {
     String label = config["label"].as<String>();
     String icon = config["icon"].as<String>();
     String id = config["name"].as<String>();
@@ -890,7 +829,7 @@ NavButton* ScreenFactory::createDisplayItem(lv_obj_t* parent, JsonObject& config
     
     // Fonte ainda menor para títulos em displays pequenos
     if (itemSize == "small") {
-        lv_obj_set_style_text_font(titleLabel, &lv_font_montserrat_10, 0);
+        theme_apply_font(titleLabel, &lv_font_montserrat_10);
     }
     
     // Ícone (canto superior direito)
@@ -903,7 +842,7 @@ NavButton* ScreenFactory::createDisplayItem(lv_obj_t* parent, JsonObject& config
         
         // Ícone menor para displays pequenos
         if (itemSize == "small") {
-            lv_obj_set_style_text_font(iconLabel, &lv_font_montserrat_12, 0);
+            theme_apply_font(iconLabel, &lv_font_montserrat_12);
         }
     }
     
@@ -915,15 +854,19 @@ NavButton* ScreenFactory::createDisplayItem(lv_obj_t* parent, JsonObject& config
     
     // Fonte do valor baseada no tamanho do display
     if (itemSize == "large") {
-        lv_obj_set_style_text_font(valueLabel, &lv_font_montserrat_20, 0); // Maior fonte disponível
+        theme_apply_font(valueLabel, &lv_font_montserrat_20); // Maior fonte disponível
     } else if (itemSize == "small") {
-        lv_obj_set_style_text_font(valueLabel, &lv_font_montserrat_14, 0);
+        theme_apply_font(valueLabel, &lv_font_montserrat_14);
     } else {
-        lv_obj_set_style_text_font(valueLabel, &lv_font_montserrat_16, 0);
+        theme_apply_font(valueLabel, &lv_font_montserrat_16);
     }
     
     // Criar NavButton wrapper
-    auto navBtn = new NavButton(container, label, icon, id);
+    auto navBtn = arena.make<NavButton>(arena, container, label, icon, id);
+    if (!navBtn) {
+        lv_obj_del(container);
+        return nullptr;
+    }
     navBtn->setButtonType(NavButton::TYPE_DISPLAY);
     navBtn->setDisplayConfig(dataSource, dataPath, dataUnit);
     navBtn->setValueLabel(valueLabel);
@@ -953,7 +896,7 @@ NavButton* ScreenFactory::createDisplayItem(lv_obj_t* parent, JsonObject& config
 }
 
 // Legacy implementation - rename original to Legacy
-lv_obj_t* ScreenFactory::createScreenLegacy(JsonObject& config) {
+lv_obj_t* ScreenFactory::createScreenLegacy(JsonObjectConst config) {
     String screenId = config["id"].as<String>();
     String title = config["title"].as<String>();
     
@@ -964,7 +907,7 @@ lv_obj_t* ScreenFactory::createScreenLegacy(JsonObject& config) {
     theme_apply_screen(screen);
     
     // Override background color if specified
-    if (config["background"].is<JsonVariant>()) {
+    if (config["background"].is<JsonVariantConst>()) {
         lv_obj_set_style_bg_color(screen, parseColor(config["background"]), 0);
     }
     
@@ -979,13 +922,13 @@ lv_obj_t* ScreenFactory::createScreenLegacy(JsonObject& config) {
     }
     
     // Create items
-    if (config["items"].is<JsonVariant>() && config["items"].is<JsonArray>()) {
-        JsonArray items = config["items"].as<JsonArray>();
+    if (config["items"].is<JsonVariantConst>() && config["items"].is<JsonArrayConst>()) {
+        JsonArrayConst items = config["items"].as<JsonArrayConst>();
         int yOffset = 50; // Start below title
         
         logger->info("Found " + String(items.size()) + " items to create");
         
-        for (JsonObject item : items) {
+        for (JsonObjectConst item : items) {
             String type = item["type"].as<String>();
             String label = item["label"].as<String>();
             lv_obj_t* element = nullptr;
@@ -1013,7 +956,7 @@ lv_obj_t* ScreenFactory::createScreenLegacy(JsonObject& config) {
             
             if (element != nullptr) {
                 // Position element
-                if (!item["x"].is<JsonVariant>() && !item["y"].is<JsonVariant>()) {
+                if (!item["x"].is<JsonVariantConst>() && !item["y"].is<JsonVariantConst>()) {
                     // Auto position vertically
                     lv_obj_align(element, LV_ALIGN_TOP_MID, 0, yOffset);
                     yOffset += lv_obj_get_height(element) + 10;
@@ -1029,7 +972,7 @@ lv_obj_t* ScreenFactory::createScreenLegacy(JsonObject& config) {
     return screen;
 }
 
-lv_obj_t* ScreenFactory::createButton(lv_obj_t* parent, JsonObject& config) {
+lv_obj_t* ScreenFactory::createButton(lv_obj_t* parent, JsonObjectConst config) {
     lv_obj_t* btn = lv_btn_create(parent);
     
     // Set size
@@ -1082,20 +1025,20 @@ lv_obj_t* ScreenFactory::createButton(lv_obj_t* parent, JsonObject& config) {
     applyCommonStyles(btn, config);
     
     // Add action data if present
-    if (config["action"].is<JsonVariant>()) {
+    if (config["action"].is<JsonVariantConst>()) {
         // TODO: Store action data for later handling
     }
     
     return btn;
 }
 
-lv_obj_t* ScreenFactory::createLabel(lv_obj_t* parent, JsonObject& config) {
+lv_obj_t* ScreenFactory::createLabel(lv_obj_t* parent, JsonObjectConst config) {
     lv_obj_t* label = lv_label_create(parent);
     
     lv_label_set_text(label, config["label"].as<String>().c_str());
     
     // Text alignment
-    if (config["align"].is<JsonVariant>()) {
+    if (config["align"].is<JsonVariantConst>()) {
         String align = config["align"].as<String>();
         if (align == "center") {
             lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
@@ -1113,16 +1056,16 @@ lv_obj_t* ScreenFactory::createLabel(lv_obj_t* parent, JsonObject& config) {
     return label;
 }
 
-lv_obj_t* ScreenFactory::createSwitch(lv_obj_t* parent, JsonObject& config) {
+lv_obj_t* ScreenFactory::createSwitch(lv_obj_t* parent, JsonObjectConst config) {
     lv_obj_t* sw = lv_switch_create(parent);
     
     // Set initial state
-    if (config["checked"].is<JsonVariant>() && config["checked"].as<bool>()) {
+    if (config["checked"].is<JsonVariantConst>() && config["checked"].as<bool>()) {
         lv_obj_add_state(sw, LV_STATE_CHECKED);
     }
     
     // Create label if present
-    if (config["label"].is<JsonVariant>()) {
+    if (config["label"].is<JsonVariantConst>()) {
         lv_obj_t* label = lv_label_create(parent);
         lv_label_set_text(label, config["label"].as<String>().c_str());
         lv_obj_align_to(label, sw, LV_ALIGN_OUT_LEFT_MID, -10, 0);
@@ -1135,28 +1078,28 @@ lv_obj_t* ScreenFactory::createSwitch(lv_obj_t* parent, JsonObject& config) {
     return sw;
 }
 
-lv_obj_t* ScreenFactory::createSlider(lv_obj_t* parent, JsonObject& config) {
+lv_obj_t* ScreenFactory::createSlider(lv_obj_t* parent, JsonObjectConst config) {
     lv_obj_t* slider = lv_slider_create(parent);
     
     // Set range
-    if (config["min"].is<JsonVariant>() && config["max"].is<JsonVariant>()) {
+    if (config["min"].is<JsonVariantConst>() && config["max"].is<JsonVariantConst>()) {
         lv_slider_set_range(slider, config["min"], config["max"]);
     }
     
     // Set value
-    if (config["value"].is<JsonVariant>()) {
+    if (config["value"].is<JsonVariantConst>()) {
         lv_slider_set_value(slider, config["value"], LV_ANIM_OFF);
     }
     
     // Set size
-    if (config["width"].is<JsonVariant>()) {
+    if (config["width"].is<JsonVariantConst>()) {
         lv_obj_set_width(slider, config["width"]);
     } else {
         lv_obj_set_width(slider, 200);
     }
     
     // Create label if present
-    if (config["label"].is<JsonVariant>()) {
+    if (config["label"].is<JsonVariantConst>()) {
         lv_obj_t* label = lv_label_create(parent);
         lv_label_set_text(label, config["label"].as<String>().c_str());
         lv_obj_align_to(label, slider, LV_ALIGN_OUT_TOP_MID, 0, -5);
@@ -1169,11 +1112,11 @@ lv_obj_t* ScreenFactory::createSlider(lv_obj_t* parent, JsonObject& config) {
     return slider;
 }
 
-lv_obj_t* ScreenFactory::createGauge(lv_obj_t* parent, JsonObject& config) {
+lv_obj_t* ScreenFactory::createGauge(lv_obj_t* parent, JsonObjectConst config) {
     lv_obj_t* meter = lv_meter_create(parent);
     
     // Set size
-    if (config["size"].is<JsonVariant>()) {
+    if (config["size"].is<JsonVariantConst>()) {
         lv_obj_set_size(meter, config["size"], config["size"]);
     } else {
         lv_obj_set_size(meter, 150, 150);
@@ -1189,12 +1132,12 @@ lv_obj_t* ScreenFactory::createGauge(lv_obj_t* parent, JsonObject& config) {
                                     COLOR_BUTTON_ON, -10);
     
     // Set value
-    if (config["value"].is<JsonVariant>()) {
+    if (config["value"].is<JsonVariantConst>()) {
         lv_meter_set_indicator_value(meter, indic, config["value"]);
     }
     
     // Create label if present
-    if (config["label"].is<JsonVariant>()) {
+    if (config["label"].is<JsonVariantConst>()) {
         lv_obj_t* label = lv_label_create(parent);
         lv_label_set_text(label, config["label"].as<String>().c_str());
         lv_obj_align_to(label, meter, LV_ALIGN_OUT_BOTTOM_MID, 0, 5);
@@ -1204,63 +1147,59 @@ lv_obj_t* ScreenFactory::createGauge(lv_obj_t* parent, JsonObject& config) {
     return meter;
 }
 
-lv_obj_t* ScreenFactory::createList(lv_obj_t* parent, JsonObject& config) {
+lv_obj_t* ScreenFactory::createList(lv_obj_t* parent, JsonObjectConst config) {
     lv_obj_t* list = lv_list_create(parent);
     
     // Set size
-    if (config["width"].is<JsonVariant>() && config["height"].is<JsonVariant>()) {
+    if (config["width"].is<JsonVariantConst>() && config["height"].is<JsonVariantConst>()) {
         lv_obj_set_size(list, config["width"], config["height"]);
     } else {
         lv_obj_set_size(list, 280, 150);
     }
     
     // Apply theme styles to list
-    lv_obj_set_style_bg_color(list, COLOR_BUTTON_OFF, 0);
-    lv_obj_set_style_border_color(list, COLOR_BORDER, 0);
-    lv_obj_set_style_border_width(list, 1, 0);
-    lv_obj_set_style_radius(list, BUTTON_RADIUS, 0);
+    theme_add_style(list, THEME_STYLE_LIST);
     
     // Add items
-    if (config["options"].is<JsonVariant>() && config["options"].is<JsonArray>()) {
-        JsonArray options = config["options"].as<JsonArray>();
+    if (config["options"].is<JsonVariantConst>() && config["options"].is<JsonArrayConst>()) {
+        JsonArrayConst options = config["options"].as<JsonArrayConst>();
         
-        for (JsonVariant option : options) {
+        for (JsonVariantConst option : options) {
             String text = option.as<String>();
             lv_obj_t* btn = lv_list_add_btn(list, NULL, text.c_str());
-            lv_obj_set_style_bg_color(btn, COLOR_BUTTON_OFF, 0);
-            lv_obj_set_style_text_color(btn, COLOR_TEXT_OFF, 0);
+            theme_add_style(btn, THEME_STYLE_LIST_BUTTON);
         }
     }
     
     return list;
 }
 
-void ScreenFactory::applyCommonStyles(lv_obj_t* obj, JsonObject& config) {
+void ScreenFactory::applyCommonStyles(lv_obj_t* obj, JsonObjectConst config) {
     // Text color
-    if (config["color"].is<JsonVariant>()) {
+    if (config["color"].is<JsonVariantConst>()) {
         lv_obj_set_style_text_color(obj, parseColor(config["color"]), 0);
     }
     
     // Background color
-    if (config["bg_color"].is<JsonVariant>()) {
+    if (config["bg_color"].is<JsonVariantConst>()) {
         lv_obj_set_style_bg_color(obj, parseColor(config["bg_color"]), 0);
     }
     
     // Font size
-    if (config["font_size"].is<JsonVariant>()) {
+    if (config["font_size"].is<JsonVariantConst>()) {
         int size = config["font_size"];
         if (size <= 12) {
-            lv_obj_set_style_text_font(obj, &lv_font_montserrat_12, 0);
+            theme_apply_font(obj, &lv_font_montserrat_12);
         } else if (size <= 16) {
-            lv_obj_set_style_text_font(obj, &lv_font_montserrat_16, 0);
+            theme_apply_font(obj, &lv_font_montserrat_16);
         } else {
-            lv_obj_set_style_text_font(obj, &lv_font_montserrat_20, 0);
+            theme_apply_font(obj, &lv_font_montserrat_20);
         }
     }
 }
 
-void ScreenFactory::positionElement(lv_obj_t* obj, JsonObject& config) {
-    if (config["x"].is<JsonVariant>() && config["y"].is<JsonVariant>()) {
+void ScreenFactory::positionElement(lv_obj_t* obj, JsonObjectConst config) {
+    if (config["x"].is<JsonVariantConst>() && config["y"].is<JsonVariantConst>()) {
         lv_obj_set_pos(obj, config["x"], config["y"]);
     }
 }
@@ -1279,7 +1218,7 @@ lv_color_t ScreenFactory::parseColor(const String& colorStr) {
     return COLOR_TEXT_OFF;
 }
 
-float ScreenFactory::parseActionPayload(JsonObject& config, const String& key, float defaultValue) {
+float ScreenFactory::parseActionPayload(JsonObjectConst config, const String& key, float defaultValue) {
     if (!config["action_payload"].is<String>()) {
         return defaultValue;
     }
@@ -1304,7 +1243,7 @@ float ScreenFactory::parseActionPayload(JsonObject& config, const String& key, f
 }
 
 // Nova função para criar display digital ao invés de gauge analógico
-lv_obj_t* ScreenFactory::createGaugeDirectly(lv_obj_t* parent, JsonObject& config) {
+lv_obj_t* ScreenFactory::createGaugeDirectly(lv_obj_t* parent, JsonObjectConst config) {
     String label = config["label"].as<String>();
     String icon = config["icon"].as<String>();
     String id = config["name"].as<String>();
@@ -1367,8 +1306,7 @@ lv_obj_t* ScreenFactory::createGaugeDirectly(lv_obj_t* parent, JsonObject& confi
         // Valor grande centralizado
         lv_obj_t* valueLabel = lv_label_create(container);
         lv_label_set_text(valueLabel, "---");
-        lv_obj_set_style_text_font(valueLabel, &lv_font_montserrat_20, 0);
-        lv_obj_set_style_text_color(valueLabel, COLOR_GAUGE_NORMAL, 0);
+        theme_add_style(valueLabel, THEME_STYLE_GAUGE_VALUE);
         
         // Armazenar referência do valueLabel
         lv_obj_set_user_data(container, valueLabel);
@@ -1381,21 +1319,20 @@ lv_obj_t* ScreenFactory::createGaugeDirectly(lv_obj_t* parent, JsonObject& confi
         // Valor no centro
         lv_obj_t* valueLabel = lv_label_create(container);
         lv_label_set_text(valueLabel, "---");
-        lv_obj_set_style_text_font(valueLabel, &lv_font_montserrat_20, 0);
-        lv_obj_set_style_text_color(valueLabel, COLOR_GAUGE_NORMAL, 0);
+        theme_add_style(valueLabel, THEME_STYLE_GAUGE_VALUE);
         
         // Unidade pequena (se houver)
         if (!dataUnit.isEmpty()) {
             lv_obj_t* unitLabel = lv_label_create(container);
             lv_label_set_text(unitLabel, dataUnit.c_str());
-            lv_obj_set_style_text_font(unitLabel, &lv_font_montserrat_10, 0);
+            theme_apply_font(unitLabel, &lv_font_montserrat_10);
             theme_apply_label_small(unitLabel);
         }
         
         // Label embaixo
         lv_obj_t* titleLabel = lv_label_create(container);
         lv_label_set_text(titleLabel, label.c_str());
-        lv_obj_set_style_text_font(titleLabel, &lv_font_montserrat_10, 0);
+        theme_apply_font(titleLabel, &lv_font_montserrat_10);
         theme_apply_label_small(titleLabel);
         
         // Armazenar referência do valueLabel
@@ -1411,9 +1348,7 @@ lv_obj_t* ScreenFactory::createGaugeDirectly(lv_obj_t* parent, JsonObject& confi
         // Container esquerdo para label e ícone
         lv_obj_t* leftContainer = lv_obj_create(container);
         lv_obj_set_size(leftContainer, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
-        lv_obj_set_style_bg_opa(leftContainer, LV_OPA_TRANSP, 0);
-        lv_obj_set_style_border_width(leftContainer, 0, 0);
-        lv_obj_set_style_pad_all(leftContainer, 0, 0);
+        theme_apply_transparent(leftContainer);
         lv_obj_set_flex_flow(leftContainer, LV_FLEX_FLOW_ROW);
         lv_obj_set_flex_align(leftContainer, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
         
@@ -1422,7 +1357,7 @@ lv_obj_t* ScreenFactory::createGaugeDirectly(lv_obj_t* parent, JsonObject& confi
             lv_obj_t* iconLabel = lv_label_create(leftContainer);
             String iconSymbol = iconManager->getIconSymbol(icon);
             lv_label_set_text(iconLabel, iconSymbol.c_str());
-            lv_obj_set_style_text_font(iconLabel, &lv_font_montserrat_16, 0);
+            theme_apply_font(iconLabel, &lv_font_montserrat_16);
             theme_apply_label_small(iconLabel);
             lv_obj_set_style_pad_right(iconLabel, 5, 0);
         }
@@ -1430,29 +1365,26 @@ lv_obj_t* ScreenFactory::createGaugeDirectly(lv_obj_t* parent, JsonObject& confi
         // Label/título
         lv_obj_t* titleLabel = lv_label_create(leftContainer);
         lv_label_set_text(titleLabel, label.c_str());
-        lv_obj_set_style_text_font(titleLabel, &lv_font_montserrat_14, 0);
+        theme_apply_font(titleLabel, &lv_font_montserrat_14);
         theme_apply_label_small(titleLabel);
         
         // Container direito para valor e unidade
         lv_obj_t* rightContainer = lv_obj_create(container);
         lv_obj_set_size(rightContainer, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
-        lv_obj_set_style_bg_opa(rightContainer, LV_OPA_TRANSP, 0);
-        lv_obj_set_style_border_width(rightContainer, 0, 0);
-        lv_obj_set_style_pad_all(rightContainer, 0, 0);
+        theme_apply_transparent(rightContainer);
         lv_obj_set_flex_flow(rightContainer, LV_FLEX_FLOW_ROW);
         lv_obj_set_flex_align(rightContainer, LV_FLEX_ALIGN_END, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
         
         // Valor grande
         lv_obj_t* valueLabel = lv_label_create(rightContainer);
         lv_label_set_text(valueLabel, "---");
-        lv_obj_set_style_text_font(valueLabel, &lv_font_montserrat_20, 0);
-        lv_obj_set_style_text_color(valueLabel, COLOR_GAUGE_NORMAL, 0);
+        theme_add_style(valueLabel, THEME_STYLE_GAUGE_VALUE);
         
         // Unidade (se houver)
         if (!dataUnit.isEmpty()) {
             lv_obj_t* unitLabel = lv_label_create(rightContainer);
             lv_label_set_text(unitLabel, (" " + dataUnit).c_str());
-            lv_obj_set_style_text_font(unitLabel, &lv_font_montserrat_12, 0);
+            theme_apply_font(unitLabel, &lv_font_montserrat_12);
             theme_apply_label_small(unitLabel);
         }
         
@@ -1482,13 +1414,13 @@ lv_obj_t* ScreenFactory::createGaugeDirectly(lv_obj_t* parent, JsonObject& confi
 }
 
 // Função original createGaugeItem - mantida para compatibilidade
-NavButton* ScreenFactory::createGaugeItem(lv_obj_t* parent, JsonObject& config) {
+NavButton* ScreenFactory::createGaugeItem(lv_obj_t* parent, JsonObjectConst config) {
     // Por compatibilidade, criar o gauge e retornar nullptr
     lv_obj_t* gauge = createGaugeDirectly(parent, config);
     return nullptr; // Não criar NavButton wrapper
 }
 
-lv_obj_t* ScreenFactory::createCircularGauge(lv_obj_t* parent, JsonObject& config, float minVal, float maxVal) {
+lv_obj_t* ScreenFactory::createCircularGauge(lv_obj_t* parent, JsonObjectConst config, float minVal, float maxVal) {
     // Criar container principal
     lv_obj_t* container = lv_obj_create(parent);
     theme_apply_card(container);
@@ -1514,8 +1446,8 @@ lv_obj_t* ScreenFactory::createCircularGauge(lv_obj_t* parent, JsonObject& confi
     lv_meter_set_scale_range(meter, scale, minVal, maxVal, 240, 150);
     
     // Calcular thresholds para zonas de cores
-    float warningStart = parseActionPayload(const_cast<JsonObject&>(config), "warning_threshold", maxVal * 0.8f);
-    float criticalStart = parseActionPayload(const_cast<JsonObject&>(config), "critical_threshold", maxVal * 0.95f);
+    float warningStart = parseActionPayload(config, "warning_threshold", maxVal * 0.8f);
+    float criticalStart = parseActionPayload(config, "critical_threshold", maxVal * 0.95f);
     
     // Zona normal (verde)
     lv_meter_indicator_t* indic_normal = lv_meter_add_arc(meter, scale, 3, COLOR_GAUGE_NORMAL, 0);
@@ -1551,11 +1483,11 @@ lv_obj_t* ScreenFactory::createCircularGauge(lv_obj_t* parent, JsonObject& confi
     
     // Fonte maior para o valor se gauge for grande
     if (meterSize >= GAUGE_SIZE_LARGE) {
-        lv_obj_set_style_text_font(valueLabel, &lv_font_montserrat_20, 0);
+        theme_apply_font(valueLabel, &lv_font_montserrat_20);
     } else if (meterSize >= GAUGE_SIZE_NORMAL) {
-        lv_obj_set_style_text_font(valueLabel, &lv_font_montserrat_16, 0);
+        theme_apply_font(valueLabel, &lv_font_montserrat_16);
     } else {
-        lv_obj_set_style_text_font(valueLabel, &lv_font_montserrat_14, 0);
+        theme_apply_font(valueLabel, &lv_font_montserrat_14);
     }
     
     // Label do título (pequeno, abaixo do valor)
@@ -1576,7 +1508,7 @@ lv_obj_t* ScreenFactory::createCircularGauge(lv_obj_t* parent, JsonObject& confi
     return container; // Retorna container, não o meter diretamente
 }
 
-lv_obj_t* ScreenFactory::createLinearGauge(lv_obj_t* parent, JsonObject& config, float minVal, float maxVal) {
+lv_obj_t* ScreenFactory::createLinearGauge(lv_obj_t* parent, JsonObjectConst config, float minVal, float maxVal) {
     // Criar container principal
     lv_obj_t* container = lv_obj_create(parent);
     theme_apply_card(container);
@@ -1618,14 +1550,10 @@ lv_obj_t* ScreenFactory::createLinearGauge(lv_obj_t* parent, JsonObject& config,
     lv_bar_set_value(bar, minVal, LV_ANIM_OFF);
     
     // Estilo da barra de fundo
-    lv_obj_set_style_bg_color(bar, COLOR_BUTTON_OFF, 0);
-    lv_obj_set_style_border_color(bar, COLOR_BORDER, 0);
-    lv_obj_set_style_border_width(bar, 1, 0);
-    lv_obj_set_style_radius(bar, 5, 0);
+    theme_add_style(bar, THEME_STYLE_BAR);
     
     // Estilo do indicador (parte preenchida) - com cores condicionais
-    lv_obj_set_style_bg_color(bar, COLOR_GAUGE_NORMAL, LV_PART_INDICATOR);
-    lv_obj_set_style_radius(bar, 3, LV_PART_INDICATOR);
+    theme_add_style(bar, THEME_STYLE_BAR_INDICATOR, LV_PART_INDICATOR);
     
     // Armazenar referência da barra no user_data para atualizações
     lv_obj_set_user_data(container, bar);
@@ -1649,17 +1577,17 @@ lv_obj_t* ScreenFactory::createLinearGauge(lv_obj_t* parent, JsonObject& config,
     
     // Fonte baseada no tamanho
     if (itemSize == "large") {
-        lv_obj_set_style_text_font(valueLabel, &lv_font_montserrat_16, 0);
+        theme_apply_font(valueLabel, &lv_font_montserrat_16);
     } else if (itemSize == "small") {
-        lv_obj_set_style_text_font(valueLabel, &lv_font_montserrat_12, 0);
+        theme_apply_font(valueLabel, &lv_font_montserrat_12);
     } else {
-        lv_obj_set_style_text_font(valueLabel, &lv_font_montserrat_14, 0);
+        theme_apply_font(valueLabel, &lv_font_montserrat_14);
     }
     
     return container;
 }
 
-String ScreenFactory::formatDisplayValue(float value, JsonObject& config) {
+String ScreenFactory::formatDisplayValue(float value, JsonObjectConst config) {
     String format = config["data_format"].as<String>();
     String unit = config["data_unit"].as<String>();
     
@@ -1709,7 +1637,7 @@ String ScreenFactory::formatDisplayValue(float value, JsonObject& config) {
     return String(buffer);
 }
 
-void ScreenFactory::applyDynamicColors(lv_obj_t* obj, JsonObject& config, float value) {
+void ScreenFactory::applyDynamicColors(lv_obj_t* obj, JsonObjectConst config, float value) {
     String dataPath = config["data_path"].as<String>();
     
     lv_color_t color = COLOR_TEXT_OFF; // Padrão
@@ -1770,7 +1698,7 @@ lv_coord_t ScreenFactory::calculateItemSize(const String& size, bool isWidth) {
     }
 }
 
-lv_obj_t* ScreenFactory::createSwitchDirectly(lv_obj_t* parent, JsonObject& config) {
+lv_obj_t* ScreenFactory::createSwitchDirectly(lv_obj_t* parent, JsonObjectConst config, ScreenArena& arena) {
     String label = config["label"].as<String>();
     String icon = config["icon"].as<String>();
     String id = config["name"].as<String>();
@@ -1844,31 +1772,34 @@ lv_obj_t* ScreenFactory::createSwitchDirectly(lv_obj_t* parent, JsonObject& conf
     lv_obj_align(lvSwitch, LV_ALIGN_RIGHT_MID, -8, 0);
     
     // Aplicar cores do tema ao switch
-    lv_obj_set_style_bg_color(lvSwitch, COLOR_BUTTON_OFF, 0);
-    lv_obj_set_style_bg_color(lvSwitch, COLOR_GAUGE_NORMAL, LV_STATE_CHECKED);
-    lv_obj_set_style_border_color(lvSwitch, COLOR_BORDER, 0);
-    lv_obj_set_style_border_width(lvSwitch, 1, 0);
+    theme_add_style(lvSwitch, THEME_STYLE_SWITCH);
+    theme_add_style(lvSwitch, THEME_STYLE_SWITCH_ON, LV_STATE_CHECKED);
     
     // Knob do switch
-    lv_obj_set_style_bg_color(lvSwitch, COLOR_TEXT_OFF, LV_PART_KNOB);
-    lv_obj_set_style_bg_color(lvSwitch, COLOR_TEXT_ON, LV_PART_KNOB | LV_STATE_CHECKED);
+    theme_add_style(lvSwitch, THEME_STYLE_SWITCH_KNOB, LV_PART_KNOB);
+    theme_add_style(lvSwitch, THEME_STYLE_SWITCH_KNOB_ON, LV_PART_KNOB | LV_STATE_CHECKED);
     
     // CORREÇÃO: Retornar container diretamente como um pseudo-NavButton
     // Para switches, não usamos NavButton wrapper - criamos pseudo-objeto
     
     // Armazenar informações necessárias no user_data do container para compatibilidade
+    // (na arena da tela: liberado junto com a página)
     struct SwitchInfo {
         uint8_t relay_board_id;
         uint8_t relay_channel_id;
-        String label;
-        String id;
+        const char* label;
+        const char* id;
     };
     
-    SwitchInfo* switchInfo = new SwitchInfo();
+    SwitchInfo* switchInfo = arena.make<SwitchInfo>();
+    if (!switchInfo) {
+        lv_obj_del(container);
+        return nullptr;
+    }
     switchInfo->relay_board_id = relay_board_id;
     switchInfo->relay_channel_id = relay_channel_id;
-    switchInfo->label = label;
-    switchInfo->id = id;
+    switchInfo->label = arena.copy(label);
+    switchInfo->id = arena.copy(id);
     
     lv_obj_set_user_data(container, switchInfo);
     
@@ -98,23 +98,24 @@ void ScreenManager::clearAllScreens() {
     currentScreenId = "";
 }
 
-void ScreenManager::buildFromConfig(JsonDocument& config) {
+void ScreenManager::buildFromConfig(const ConfigSnapshot& snapshot) {
     logger->info("Building screens from configuration...");
     
     clearAllScreens();
     
-    if (!config["screens"].is<JsonArray>()) {
+    const JsonDocument& config = snapshot->doc;
+    if (!config["screens"].is<JsonArrayConst>()) {
         logger->error("No screens array found in configuration");
         return;
     }
     
     // New format: screens is always an array
     logger->info("Processing screens in new hierarchical format");
-    JsonArray screensArray = config["screens"].as<JsonArray>();
+    JsonArrayConst screensArray = config["screens"].as<JsonArrayConst>();
     
     // First, check if we need to create a Home screen
     bool hasHomeScreen = false;
-    for (JsonObject screenConfig : screensArray) {
+    for (JsonObjectConst screenConfig : screensArray) {
         if (screenConfig["order_index"].as<int>() == 0) {
             // This is meant to be the home screen
             // Create a special HomeScreen instance instead
@@ -130,8 +131,8 @@ void ScreenManager::buildFromConfig(JsonDocument& config) {
     }
     
     // Now create all screens (including the one with order_index = 0)
-    for (JsonObject screenConfig : screensArray) {
-        createScreen(screenConfig);
+    for (JsonObjectConst screenConfig : screensArray) {
+        createScreen(screenConfig, snapshot);
     }
     
     logger->info("Created " + String(screens.size()) + " screens");
@@ -160,7 +161,7 @@ void ScreenManager::handleSelect(const String& screenId) {
     logger->debug("Handling select on screen: " + screenId);
 }
 
-void ScreenManager::createScreen(JsonObject& screenConfig) {
+void ScreenManager::createScreen(JsonObjectConst screenConfig, const ConfigSnapshot& owner) {
     // Convert id to string if it's a number
     String screenId;
     if (screenConfig["id"].is<int>()) {
@@ -177,7 +178,7 @@ void ScreenManager::createScreen(JsonObject& screenConfig) {
     useNewSystem = true;
     
     // Create screen with new layout system
-    auto screen = ScreenFactory::createScreen(screenConfig);
+    auto screen = ScreenFactory::createScreen(screenConfig, owner);
     
     if (screen) {
         addScreen(screenId, std::move(screen));
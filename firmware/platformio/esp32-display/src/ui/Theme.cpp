@@ -0,0 +1,296 @@
+/**
+ * @file Theme.cpp
+ * @brief Estilos compartilhados do tema AutoCore
+ *
+ * Os estilos são alocados uma única vez e referenciados por todos os
+ * widgets. Trocar o tema apenas reescreve as propriedades destes estilos.
+ */
+
+#include "ui/Theme.h"
+
+static lv_style_t themeStyles[THEME_STYLE_COUNT];
+static ThemePalette currentPalette;
+static bool themeInitialized = false;
+
+// Estilos de fonte compartilhados (independentes da paleta)
+struct ThemeFontStyle {
+    const lv_font_t* font;
+    lv_style_t style;
+};
+
+static ThemeFontStyle fontStyles[] = {
+    { &lv_font_montserrat_10, {} },
+    { &lv_font_montserrat_12, {} },
+    { &lv_font_montserrat_14, {} },
+    { &lv_font_montserrat_16, {} },
+    { &lv_font_montserrat_20, {} },
+};
+
+ThemePalette theme_default_palette() {
+    ThemePalette palette;
+    palette.background = COLOR_BACKGROUND;
+    palette.buttonOff = COLOR_BUTTON_OFF;
+    palette.buttonOn = COLOR_BUTTON_ON;
+    palette.buttonSelected = COLOR_BUTTON_SEL;
+    palette.textOff = COLOR_TEXT_OFF;
+    palette.textOn = COLOR_TEXT_ON;
+    palette.navBg = COLOR_NAV_BG;
+    palette.border = COLOR_BORDER;
+    palette.warning = COLOR_WARNING;
+    palette.error = COLOR_ERROR;
+    palette.cardBg = COLOR_CARD_BG;
+    palette.textMuted = COLOR_TEXT_MUTED;
+    palette.gaugeNormal = COLOR_GAUGE_NORMAL;
+    palette.disabledBg = lv_color_hex(0x1a1a1a);
+    palette.disabledText = lv_color_hex(0x666666);
+    return palette;
+}
+
+/**
+ * Propriedades que não dependem da paleta (tamanhos, fontes, opacidades)
+ */
+static void buildStaticProperties() {
+    lv_style_t* s;
+
+    s = &themeStyles[THEME_STYLE_SCREEN];
+    lv_style_set_bg_opa(s, LV_OPA_COVER);
+    lv_style_set_border_width(s, 0);
+    lv_style_set_pad_all(s, 0);
+
+    s = &themeStyles[THEME_STYLE_CONTAINER];
+    lv_style_set_border_width(s, 0);
+    lv_style_set_pad_top(s, 2);
+    lv_style_set_pad_bottom(s, 2);
+    lv_style_set_pad_left(s, 5);
+    lv_style_set_pad_right(s, 5);
+
+    s = &themeStyles[THEME_STYLE_HEADER];
+    lv_style_set_border_width(s, 0);
+    lv_style_set_pad_all(s, 10);
+
+    s = &themeStyles[THEME_STYLE_NAVBAR];
+    lv_style_set_border_width(s, 0);
+    lv_style_set_pad_all(s, 5);
+
+    s = &themeStyles[THEME_STYLE_TRANSPARENT];
+    lv_style_set_bg_opa(s, LV_OPA_TRANSP);
+    lv_style_set_border_width(s, 0);
+    lv_style_set_pad_all(s, 0);
+
+    s = &themeStyles[THEME_STYLE_BUTTON_OFF];
+    lv_style_set_bg_opa(s, LV_OPA_COVER);
+    lv_style_set_border_width(s, BUTTON_BORDER);
+    lv_style_set_border_opa(s, LV_OPA_50);
+    lv_style_set_radius(s, BUTTON_RADIUS);
+
+    s = &themeStyles[THEME_STYLE_BUTTON_ON];
+    lv_style_set_bg_opa(s, LV_OPA_COVER);
+    lv_style_set_border_width(s, BUTTON_BORDER);
+    lv_style_set_border_opa(s, LV_OPA_COVER);
+    lv_style_set_radius(s, BUTTON_RADIUS);
+
+    s = &themeStyles[THEME_STYLE_BUTTON_SELECTED];
+    lv_style_set_bg_opa(s, LV_OPA_COVER);
+    lv_style_set_border_width(s, BUTTON_BORDER + 1);
+    lv_style_set_border_opa(s, LV_OPA_COVER);
+    lv_style_set_radius(s, BUTTON_RADIUS);
+
+    s = &themeStyles[THEME_STYLE_NAV_BUTTON];
+    lv_style_set_bg_opa(s, LV_OPA_COVER);
+    lv_style_set_border_width(s, 0);
+    lv_style_set_radius(s, BUTTON_RADIUS);
+
+    s = &themeStyles[THEME_STYLE_TILE];
+    lv_style_set_radius(s, BUTTON_RADIUS);
+    lv_style_set_border_width(s, 0);
+    lv_style_set_pad_all(s, 8);
+
+    s = &themeStyles[THEME_STYLE_NAVBAR_BUTTON];
+    lv_style_set_radius(s, BUTTON_RADIUS);
+    lv_style_set_border_width(s, 0);
+
+    s = &themeStyles[THEME_STYLE_TITLE];
+    lv_style_set_text_font(s, FONT_TITLE);
+
+    s = &themeStyles[THEME_STYLE_LABEL];
+    lv_style_set_text_font(s, FONT_LABEL);
+
+    s = &themeStyles[THEME_STYLE_LABEL_SMALL];
+    lv_style_set_text_font(s, FONT_SMALL);
+
+    s = &themeStyles[THEME_STYLE_ICON];
+    lv_style_set_text_font(s, FONT_LABEL);
+
+    s = &themeStyles[THEME_STYLE_CARD];
+    lv_style_set_bg_opa(s, LV_OPA_COVER);
+    lv_style_set_border_width(s, 1);
+    lv_style_set_radius(s, CARD_RADIUS);
+    lv_style_set_pad_all(s, CARD_PADDING);
+
+    s = &themeStyles[THEME_STYLE_GAUGE_VALUE];
+    lv_style_set_text_font(s, &lv_font_montserrat_20);
+
+    s = &themeStyles[THEME_STYLE_SWITCH];
+    lv_style_set_border_width(s, 1);
+
+    s = &themeStyles[THEME_STYLE_BAR];
+    lv_style_set_border_width(s, 1);
+    lv_style_set_radius(s, 5);
+
+    s = &themeStyles[THEME_STYLE_BAR_INDICATOR];
+    lv_style_set_radius(s, 3);
+
+    s = &themeStyles[THEME_STYLE_LIST];
+    lv_style_set_border_width(s, 1);
+    lv_style_set_radius(s, BUTTON_RADIUS);
+}
+
+/**
+ * Propriedades de cor, reescritas a cada troca de tema
+ */
+static void applyPaletteProperties(const ThemePalette& p) {
+    lv_style_t* s;
+
+    lv_style_set_bg_color(&themeStyles[THEME_STYLE_SCREEN], p.background);
+    lv_style_set_bg_color(&themeStyles[THEME_STYLE_CONTAINER], p.background);
+    lv_style_set_bg_color(&themeStyles[THEME_STYLE_HEADER], p.background);
+    lv_style_set_bg_color(&themeStyles[THEME_STYLE_NAVBAR], p.background);
+
+    s = &themeStyles[THEME_STYLE_BUTTON_OFF];
+    lv_style_set_bg_color(s, p.buttonOff);
+    lv_style_set_border_color(s, p.buttonOff);
+    lv_style_set_text_color(s, p.textOff);
+
+    s = &themeStyles[THEME_STYLE_BUTTON_ON];
+    lv_style_set_bg_color(s, p.buttonOn);
+    lv_style_set_border_color(s, p.buttonOn);
+    lv_style_set_text_color(s, p.textOn);
+
+    s = &themeStyles[THEME_STYLE_BUTTON_SELECTED];
+    lv_style_set_bg_color(s, p.buttonOff);
+    lv_style_set_border_color(s, p.buttonSelected);
+    lv_style_set_text_color(s, p.textOn);
+
+    s = &themeStyles[THEME_STYLE_NAV_BUTTON];
+    lv_style_set_bg_color(s, p.navBg);
+    lv_style_set_text_color(s, p.textOn);
+
+    // NavButton: ícone e label herdam text_color do botão
+    s = &themeStyles[THEME_STYLE_TILE];
+    lv_style_set_bg_color(s, p.buttonOff);
+    lv_style_set_text_color(s, p.textOff);
+
+    lv_style_set_bg_color(&themeStyles[THEME_STYLE_TILE_PRESSED], p.buttonSelected);
+
+    s = &themeStyles[THEME_STYLE_TILE_ON];
+    lv_style_set_bg_color(s, p.buttonOn);
+    lv_style_set_text_color(s, p.textOn);
+
+    s = &themeStyles[THEME_STYLE_NAVBAR_BUTTON];
+    lv_style_set_bg_color(s, p.buttonSelected);
+    lv_style_set_text_color(s, p.textOn);
+
+    lv_style_set_bg_color(&themeStyles[THEME_STYLE_NAVBAR_BUTTON_PRESSED], p.buttonOn);
+
+    s = &themeStyles[THEME_STYLE_NAVBAR_BUTTON_DISABLED];
+    lv_style_set_bg_color(s, p.disabledBg);
+    lv_style_set_text_color(s, p.disabledText);
+
+    lv_style_set_text_color(&themeStyles[THEME_STYLE_TITLE], p.textOn);
+    lv_style_set_text_color(&themeStyles[THEME_STYLE_LABEL], p.textOff);
+    lv_style_set_text_color(&themeStyles[THEME_STYLE_LABEL_SMALL], p.textMuted);
+    lv_style_set_text_color(&themeStyles[THEME_STYLE_ICON], p.textOff);
+
+    s = &themeStyles[THEME_STYLE_CARD];
+    lv_style_set_bg_color(s, p.cardBg);
+    lv_style_set_border_color(s, p.border);
+
+    lv_style_set_text_color(&themeStyles[THEME_STYLE_STATUS_OK], p.buttonOn);
+    lv_style_set_text_color(&themeStyles[THEME_STYLE_STATUS_WARNING], p.warning);
+    lv_style_set_text_color(&themeStyles[THEME_STYLE_STATUS_ERROR], p.error);
+
+    lv_style_set_text_color(&themeStyles[THEME_STYLE_GAUGE_VALUE], p.gaugeNormal);
+
+    s = &themeStyles[THEME_STYLE_SWITCH];
+    lv_style_set_bg_color(s, p.buttonOff);
+    lv_style_set_border_color(s, p.border);
+
+    lv_style_set_bg_color(&themeStyles[THEME_STYLE_SWITCH_ON], p.gaugeNormal);
+    lv_style_set_bg_color(&themeStyles[THEME_STYLE_SWITCH_KNOB], p.textOff);
+    lv_style_set_bg_color(&themeStyles[THEME_STYLE_SWITCH_KNOB_ON], p.textOn);
+
+    s = &themeStyles[THEME_STYLE_BAR];
+    lv_style_set_bg_color(s, p.buttonOff);
+    lv_style_set_border_color(s, p.border);
+
+    lv_style_set_bg_color(&themeStyles[THEME_STYLE_BAR_INDICATOR], p.gaugeNormal);
+
+    s = &themeStyles[THEME_STYLE_LIST];
+    lv_style_set_bg_color(s, p.buttonOff);
+    lv_style_set_border_color(s, p.border);
+
+    s = &themeStyles[THEME_STYLE_LIST_BUTTON];
+    lv_style_set_bg_color(s, p.buttonOff);
+    lv_style_set_text_color(s, p.textOff);
+}
+
+void theme_init() {
+    if (themeInitialized) return;
+
+    for (int i = 0; i < THEME_STYLE_COUNT; i++) {
+        lv_style_init(&themeStyles[i]);
+    }
+    for (auto& entry : fontStyles) {
+        lv_style_init(&entry.style);
+        lv_style_set_text_font(&entry.style, entry.font);
+    }
+
+    buildStaticProperties();
+    currentPalette = theme_default_palette();
+    applyPaletteProperties(currentPalette);
+
+    themeInitialized = true;
+}
+
+lv_style_t* theme_get_style(ThemeStyleRole role) {
+    if (!themeInitialized) {
+        theme_init();
+    }
+    if (role < 0 || role >= THEME_STYLE_COUNT) {
+        role = THEME_STYLE_LABEL;
+    }
+    return &themeStyles[role];
+}
+
+lv_style_t* theme_get_font_style(const lv_font_t* font) {
+    if (!themeInitialized) {
+        theme_init();
+    }
+    for (auto& entry : fontStyles) {
+        if (entry.font == font) {
+            return &entry.style;
+        }
+    }
+    return nullptr;
+}
+
+const ThemePalette& theme_get_palette() {
+    if (!themeInitialized) {
+        theme_init();
+    }
+    return currentPalette;
+}
+
+void theme_set_palette(const ThemePalette& palette) {
+    if (!themeInitialized) {
+        theme_init();
+    }
+
+    currentPalette = palette;
+    applyPaletteProperties(currentPalette);
+
+    // Notificar todos os objetos que usam os estilos (NULL = qualquer objeto)
+    for (int i = 0; i < THEME_STYLE_COUNT; i++) {
+        lv_obj_report_style_change(&themeStyles[i]);
+    }
+}
@@ -0,0 +1,157 @@
+/**
+ * @file CommandTracer.cpp
+ * @brief Implementação do rastreio de latência dos comandos
+ */
+
+#include "utils/CommandTracer.h"
+#include "config/DeviceConfig.h"
+#include <string.h>
+
+// Limites dos histogramas em us (último bucket = acima do maior limite)
+static const uint32_t LOCAL_US_BOUNDS[] = {250, 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000};
+static const uint32_t NETWORK_US_BOUNDS[] = {2000, 5000, 10000, 20000, 50000, 100000, 200000, 500000, 1000000};
+static const uint32_t RELAY_US_BOUNDS[] = {100, 250, 500, 1000, 2000, 5000, 10000, 20000};
+
+#define BOUNDS(a) a, (uint8_t)(sizeof(a) / sizeof(a[0]))
+
+CommandTracer& CommandTracer::getInstance() {
+    static CommandTracer instance;
+    return instance;
+}
+
+CommandTracer::CommandTracer()
+    : stages{Histogram(BOUNDS(NETWORK_US_BOUNDS)),   // input (inclui o clique do LVGL)
+             Histogram(BOUNDS(LOCAL_US_BOUNDS)),     // publish
+             Histogram(BOUNDS(NETWORK_US_BOUNDS)),   // network
+             Histogram(BOUNDS(RELAY_US_BOUNDS)),     // relay
+             Histogram(BOUNDS(RELAY_US_BOUNDS)),     // relay_exec
+             Histogram(BOUNDS(LOCAL_US_BOUNDS)),     // ui
+             Histogram(BOUNDS(NETWORK_US_BOUNDS))} { // total
+    memset(traces, 0, sizeof(traces));
+}
+
+void CommandTracer::markTouch(uint32_t touchUs) {
+    pendingTouchUs = touchUs;
+    touchPending = true;
+}
+
+void CommandTracer::begin(const String& traceId) {
+    uint32_t now = micros();
+    expire(now);
+
+    Trace* slot = nullptr;
+    for (uint8_t i = 0; i < MAX_IN_FLIGHT && !slot; i++) {
+        if (!traces[i].active) slot = &traces[i];
+    }
+    if (!slot) {
+        // Tabela cheia: descarta o mais antigo
+        slot = &traces[0];
+        for (uint8_t i = 1; i < MAX_IN_FLIGHT; i++) {
+            if (now - traces[i].startUs > now - slot->startUs) slot = &traces[i];
+        }
+        lost++;
+    }
+
+    strncpy(slot->id, traceId.c_str(), ID_LENGTH - 1);
+    slot->id[ID_LENGTH - 1] = '\0';
+    slot->active = true;
+    slot->sent = false;
+    slot->startUs = now;
+    slot->sentUs = 0;
+
+    // O toque vale para um único comando, e só se for recente (o clique do
+    // LVGL chega depois da soltura; comandos sem toque não medem input)
+    slot->touchUs = 0;
+    if (touchPending && now - pendingTouchUs <= (uint32_t)COMMAND_TRACE_TOUCH_WINDOW * 1000UL) {
+        slot->touchUs = pendingTouchUs;
+        stages[STAGE_INPUT].record(now - pendingTouchUs);
+    }
+    touchPending = false;
+}
+
+void CommandTracer::markSent(const String& traceId, bool ok) {
+    Trace* trace = find(traceId.c_str());
+    if (!trace) return;
+
+    if (!ok) {
+        trace->active = false;
+        return;
+    }
+
+    trace->sent = true;
+    trace->sentUs = micros();
+    stages[STAGE_PUBLISH].record(trace->sentUs - trace->startUs);
+}
+
+bool CommandTracer::complete(const char* traceId, uint32_t echoUs, const RelayTiming& relay) {
+    Trace* trace = find(traceId);
+    if (!trace || !trace->sent) return false;
+
+    uint32_t now = micros();
+    uint32_t roundTrip = echoUs - trace->sentUs;
+
+    stages[STAGE_NETWORK].record(roundTrip > relay.totalUs ? roundTrip - relay.totalUs : 0);
+    if (relay.totalUs) stages[STAGE_RELAY].record(relay.totalUs);
+    if (relay.execUs) stages[STAGE_RELAY_EXEC].record(relay.execUs);
+    stages[STAGE_UI].record(now - echoUs);
+    stages[STAGE_TOTAL].record(now - (trace->touchUs ? trace->touchUs : trace->startUs));
+
+    trace->active = false;
+    return true;
+}
+
+CommandTracer::Trace* CommandTracer::find(const char* traceId) {
+    if (!traceId || !*traceId) return nullptr;
+    for (uint8_t i = 0; i < MAX_IN_FLIGHT; i++) {
+        if (traces[i].active && strcmp(traces[i].id, traceId) == 0) return &traces[i];
+    }
+    return nullptr;
+}
+
+void CommandTracer::expire(uint32_t nowUs) {
+    for (uint8_t i = 0; i < MAX_IN_FLIGHT; i++) {
+        if (traces[i].active && nowUs - traces[i].startUs > (uint32_t)COMMAND_TRACE_TIMEOUT * 1000UL) {
+            traces[i].active = false;
+            lost++;
+        }
+    }
+}
+
+uint8_t CommandTracer::getInFlight() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < MAX_IN_FLIGHT; i++) {
+        if (traces[i].active) count++;
+    }
+    return count;
+}
+
+const char* CommandTracer::stageName(Stage stage) {
+    switch (stage) {
+        case STAGE_INPUT:      return "input";
+        case STAGE_PUBLISH:    return "publish";
+        case STAGE_NETWORK:    return "network";
+        case STAGE_RELAY:      return "relay";
+        case STAGE_RELAY_EXEC: return "relay_exec";
+        case STAGE_UI:         return "ui";
+        case STAGE_TOTAL:      return "total";
+        default:               return "unknown";
+    }
+}
+
+void CommandTracer::toJson(JsonObject obj) const {
+    obj["completed"] = getCompleted();
+    obj["lost"] = lost;
+    obj["in_flight"] = getInFlight();
+
+    JsonObject stagesObj = obj["stages"].to<JsonObject>();
+    for (uint8_t i = 0; i < STAGE_COUNT; i++) {
+        stages[i].toJson(stagesObj[stageName((Stage)i)].to<JsonObject>());
+    }
+}
+
+void CommandTracer::reset() {
+    for (uint8_t i = 0; i < STAGE_COUNT; i++) {
+        stages[i].reset();
+    }
+    lost = 0;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file Histogram.cpp
+ * @brief Implementação do histograma de limites fixos
+ */
+
+#include "utils/Histogram.h"
+
+Histogram::Histogram(const uint32_t* upperBounds, uint8_t count)
+    : bounds(upperBounds), boundCount(count < MAX_BUCKETS ? count : MAX_BUCKETS - 1) {
+    reset();
+}
+
+void Histogram::record(uint32_t value) {
+    uint8_t i = 0;
+    while (i < boundCount && value > bounds[i]) {
+        i++;
+    }
+    buckets[i]++;
+
+    if (count == 0 || value < minValue) minValue = value;
+    if (value > maxValue) maxValue = value;
+    sum += value;
+    count++;
+}
+
+void Histogram::reset() {
+    memset(buckets, 0, sizeof(buckets));
+    count = 0;
+    minValue = 0;
+    maxValue = 0;
+    sum = 0;
+}
+
+uint32_t Histogram::percentile(uint8_t p) const {
+    if (count == 0) return 0;
+    if (p > 100) p = 100;
+
+    // Posição (1-based) da amostra do percentil
+    uint32_t rank = (uint32_t)(((uint64_t)count * p + 99) / 100);
+    if (rank == 0) rank = 1;
+
+    uint32_t seen = 0;
+    for (uint8_t i = 0; i <= boundCount; i++) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            if (i == boundCount) return maxValue;
+            return bounds[i] < maxValue ? bounds[i] : maxValue;
+        }
+    }
+    return maxValue;
+}
+
+void Histogram::toJson(JsonObject obj) const {
+    obj["count"] = count;
+    obj["min"] = getMin();
+    obj["max"] = maxValue;
+    obj["mean"] = getMean();
+    obj["p50"] = percentile(50);
+    obj["p95"] = percentile(95);
+    obj["p99"] = percentile(99);
+
+    JsonArray le = obj["le"].to<JsonArray>();
+    for (uint8_t i = 0; i < boundCount; i++) {
+        le.add(bounds[i]);
+    }
+
+    JsonArray counts = obj["counts"].to<JsonArray>();
+    for (uint8_t i = 0; i <= boundCount; i++) {
+        counts.add(buckets[i]);
+    }
+}
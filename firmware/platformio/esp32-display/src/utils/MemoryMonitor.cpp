@@ -0,0 +1,156 @@
+/**
+ * @file MemoryMonitor.cpp
+ * @brief Implementação do monitor de memória
+ */
+
+#include "utils/MemoryMonitor.h"
+#include "config/DeviceConfig.h"
+#include "core/Logger.h"
+#include <lvgl.h>
+
+extern Logger* logger;
+
+MemoryMonitor& MemoryMonitor::getInstance() {
+    static MemoryMonitor instance;
+    return instance;
+}
+
+void MemoryMonitor::onAlloc(MemSubsystem subsystem, size_t bytes) {
+    AtomicCounters& c = getInstance().counters[subsystem];
+    c.allocs.fetch_add(1, std::memory_order_relaxed);
+    uint32_t live = c.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+    // Pico só sobe; outra tarefa pode ter registrado um maior no meio
+    uint32_t peak = c.peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !c.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+void MemoryMonitor::onFree(MemSubsystem subsystem, size_t bytes) {
+    AtomicCounters& c = getInstance().counters[subsystem];
+    c.frees.fetch_add(1, std::memory_order_relaxed);
+
+    // Satura em zero (free sem alloc contado não dá a volta)
+    uint32_t live = c.liveBytes.load(std::memory_order_relaxed);
+    while (!c.liveBytes.compare_exchange_weak(live, bytes < live ? live - bytes : 0, std::memory_order_relaxed)) {
+    }
+}
+
+MemoryMonitor::Counters MemoryMonitor::getCounters(MemSubsystem subsystem) const {
+    const AtomicCounters& c = counters[subsystem];
+    return {
+        c.allocs.load(std::memory_order_relaxed),
+        c.frees.load(std::memory_order_relaxed),
+        c.liveBytes.load(std::memory_order_relaxed),
+        c.peakBytes.load(std::memory_order_relaxed)
+    };
+}
+
+void MemoryMonitor::update() {
+    unsigned long now = millis();
+    if (lastSample != 0 && now - lastSample < MEMORY_MONITOR_INTERVAL) return;
+    sample();
+}
+
+bool MemoryMonitor::sample() {
+    lastSample = millis();
+
+    snapshot.freeHeap = ESP.getFreeHeap();
+    snapshot.minFreeHeap = ESP.getMinFreeHeap();
+    snapshot.largestBlock = ESP.getMaxAllocHeap();
+    snapshot.heapFragPct = snapshot.freeHeap
+        ? (uint8_t)(100 - (uint64_t)snapshot.largestBlock * 100 / snapshot.freeHeap)
+        : 100;
+
+#if LV_MEM_CUSTOM == 0
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    snapshot.lvglFree = mon.free_size;
+    snapshot.lvglLargest = mon.free_biggest_size;
+    snapshot.lvglFragPct = mon.frag_pct;
+    snapshot.lvglUsedPct = mon.used_pct;
+#endif
+
+    uint8_t reasons = evaluate();
+    uint8_t fresh = reasons & ~activeWarnings;
+    activeWarnings = reasons;
+
+    // Só dispara em condição nova; reaparece depois de uma amostra saudável
+    if (!fresh) return false;
+
+    warningCount++;
+    if (logger) {
+        logger->warning("Memory warning: free=" + String(snapshot.freeHeap) +
+                        " largest=" + String(snapshot.largestBlock) +
+                        " frag=" + String(snapshot.heapFragPct) + "%" +
+                        " lvgl_frag=" + String(snapshot.lvglFragPct) + "%" +
+                        " lvgl_used=" + String(snapshot.lvglUsedPct) + "%");
+    }
+    if (onWarning) {
+        onWarning(snapshot, reasons);
+    }
+    return true;
+}
+
+uint8_t MemoryMonitor::evaluate() const {
+    uint8_t reasons = 0;
+    if (snapshot.largestBlock < MEMORY_WARN_MIN_BLOCK) reasons |= WARN_HEAP_BLOCK;
+    if (snapshot.heapFragPct > MEMORY_WARN_HEAP_FRAG_PCT) reasons |= WARN_HEAP_FRAG;
+#if LV_MEM_CUSTOM == 0
+    if (snapshot.lvglFragPct > MEMORY_WARN_LVGL_FRAG_PCT) reasons |= WARN_LVGL_FRAG;
+    if (snapshot.lvglUsedPct > MEMORY_WARN_LVGL_USED_PCT) reasons |= WARN_LVGL_USED;
+#endif
+    return reasons;
+}
+
+const char* MemoryMonitor::subsystemName(MemSubsystem subsystem) {
+    switch (subsystem) {
+        case MEM_MQTT:    return "mqtt";
+        case MEM_CONFIG:  return "config";
+        case MEM_SCREENS: return "screens";
+        case MEM_ICONS:   return "icons";
+        default:          return "unknown";
+    }
+}
+
+const char* MemoryMonitor::reasonName(WarningReason reason) {
+    switch (reason) {
+        case WARN_HEAP_BLOCK: return "heap_largest_block";
+        case WARN_HEAP_FRAG:  return "heap_fragmentation";
+        case WARN_LVGL_FRAG:  return "lvgl_fragmentation";
+        case WARN_LVGL_USED:  return "lvgl_usage";
+        default:              return "unknown";
+    }
+}
+
+void MemoryMonitor::reasonsToJson(JsonArray arr, uint8_t reasons) const {
+    for (uint8_t bit = WARN_HEAP_BLOCK; bit <= WARN_LVGL_USED; bit <<= 1) {
+        if (reasons & bit) arr.add(reasonName((WarningReason)bit));
+    }
+}
+
+void MemoryMonitor::toJson(JsonObject obj) const {
+    obj["free_heap"] = snapshot.freeHeap;
+    obj["min_free_heap"] = snapshot.minFreeHeap;
+    obj["largest_block"] = snapshot.largestBlock;
+    obj["heap_fragmentation"] = snapshot.heapFragPct;
+
+    JsonObject lvgl = obj["lvgl"].to<JsonObject>();
+    lvgl["free"] = snapshot.lvglFree;
+    lvgl["largest_block"] = snapshot.lvglLargest;
+    lvgl["fragmentation"] = snapshot.lvglFragPct;
+    lvgl["used_pct"] = snapshot.lvglUsedPct;
+
+    JsonObject subsystems = obj["subsystems"].to<JsonObject>();
+    for (uint8_t i = 0; i < MEM_SUBSYSTEM_COUNT; i++) {
+        Counters c = getCounters((MemSubsystem)i);
+        JsonObject sub = subsystems[subsystemName((MemSubsystem)i)].to<JsonObject>();
+        sub["allocs"] = c.allocs;
+        sub["frees"] = c.frees;
+        sub["live"] = c.liveBytes;
+        sub["peak"] = c.peakBytes;
+    }
+
+    obj["warnings"] = warningCount;
+    reasonsToJson(obj["active"].to<JsonArray>(), activeWarnings);
+}
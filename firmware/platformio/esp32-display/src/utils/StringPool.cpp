@@ -0,0 +1,143 @@
+/**
+ * @file StringPool.cpp
+ * @brief Implementação do pool de strings internadas
+ */
+
+#include "utils/StringPool.h"
+#include "core/Logger.h"
+#include "utils/MemoryMonitor.h"
+
+extern Logger* logger;
+
+StringPool& StringPool::getInstance() {
+    static StringPool instance;
+    return instance;
+}
+
+uint32_t StringPool::hashOf(const char* str, size_t& len) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    len = 0;
+    while (str[len]) {
+        hash ^= (uint8_t)str[len++];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+StringPool::Slot* StringPool::findSlot(const char* str, uint32_t hash) {
+    // Sondagem linear; capacidade é potência de 2 e nunca fica cheia
+    uint32_t mask = capacity - 1;
+    for (uint32_t i = hash & mask; ; i = (i + 1) & mask) {
+        Slot& slot = slots[i];
+        if (!slot.str || (slot.hash == hash && strcmp(slot.str, str) == 0)) {
+            return &slot;
+        }
+    }
+}
+
+bool StringPool::grow() {
+    uint32_t newCapacity = capacity ? capacity * 2 : INITIAL_SLOTS;
+    Slot* newSlots = static_cast<Slot*>(calloc(newCapacity, sizeof(Slot)));
+    if (!newSlots) return false;
+    MemoryMonitor::onAlloc(MEM_CONFIG, newCapacity * sizeof(Slot));
+
+    Slot* oldSlots = slots;
+    uint32_t oldCapacity = capacity;
+    slots = newSlots;
+    capacity = newCapacity;
+
+    // Só a tabela é realocada: as strings ficam onde estão
+    for (uint32_t i = 0; i < oldCapacity; i++) {
+        if (oldSlots[i].str) {
+            *findSlot(oldSlots[i].str, oldSlots[i].hash) = oldSlots[i];
+        }
+    }
+    free(oldSlots);
+    if (oldSlots) MemoryMonitor::onFree(MEM_CONFIG, oldCapacity * sizeof(Slot));
+    return true;
+}
+
+char* StringPool::store(const char* str, size_t len) {
+    size_t needed = len + 1;
+
+    if (!block || blockUsed + needed > blockSize) {
+        // Strings maiores que o bloco ganham bloco próprio
+        size_t size = needed > BLOCK_SIZE ? needed : BLOCK_SIZE;
+        char* fresh = static_cast<char*>(malloc(size));
+        if (!fresh) return nullptr;
+        MemoryMonitor::onAlloc(MEM_CONFIG, size);
+        block = fresh;
+        blockSize = size;
+        blockUsed = 0;
+    }
+
+    char* out = block + blockUsed;
+    memcpy(out, str, needed);
+    blockUsed += needed;
+    return out;
+}
+
+const char* StringPool::intern(const char* str) {
+    if (!str || !*str) return "";
+
+    std::lock_guard<std::mutex> guard(lock);
+    stats.lookups++;
+
+    size_t len;
+    uint32_t hash = hashOf(str, len);
+
+    // Carga máxima de 75%
+    if (!slots || (uint32_t)(stats.entries + 1) * 4 > capacity * 3) {
+        if (!grow() && !slots) return "";
+    }
+
+    Slot* slot = findSlot(str, hash);
+    if (slot->str) {
+        stats.hits++;
+        stats.bytesSaved += len + 1;
+        return slot->str;
+    }
+
+    char* copy = store(str, len);
+    if (!copy) {
+        if (logger) logger->error("StringPool: out of memory");
+        return "";
+    }
+
+    slot->str = copy;
+    slot->hash = hash;
+    stats.entries++;
+    stats.bytesStored += len + 1;
+    return copy;
+}
+
+const char* StringPool::find(const char* str) {
+    if (!str || !*str) return "";
+
+    std::lock_guard<std::mutex> guard(lock);
+    stats.lookups++;
+    if (!slots) return nullptr;
+
+    size_t len;
+    uint32_t hash = hashOf(str, len);
+    Slot* slot = findSlot(str, hash);
+    if (!slot->str) return nullptr;
+
+    stats.hits++;
+    return slot->str;
+}
+
+StringPool::Stats StringPool::getStats() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return stats;
+}
+
+void StringPool::toJson(JsonObject obj) const {
+    Stats snapshot = getStats();
+    obj["entries"] = snapshot.entries;
+    obj["bytes_stored"] = snapshot.bytesStored;
+    obj["bytes_saved"] = snapshot.bytesSaved;
+    obj["lookups"] = snapshot.lookups;
+    obj["hits"] = snapshot.hits;
+}
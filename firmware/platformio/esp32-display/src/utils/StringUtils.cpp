@@ -59,4 +59,13 @@ String StringUtils::removeAccents(const String& text) {
     }
     
     return result;
-}
\ No newline at end of file
+}
+
+uint32_t StringUtils::hash(const char* data, size_t length) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        h ^= (uint8_t)data[i];
+        h *= 16777619u;
+    }
+    return h;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file test_main.cpp
+ * @brief Testes do TouchFilter no host com traces gravados do XPT2046
+ *
+ * Cada trace é uma sequência {x, y, z, ms} como lida pelo TouchHandler a
+ * cada TOUCH_SAMPLE_PERIOD depois do IRQ (z = 0: IRQ inativo / solto).
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include "input/TouchFilter.h"
+#include "config/DeviceConfig.h"
+
+// Toque limpo num botão: rampa de pressão, ~80ms pressionado, soltura
+static const TouchSample TAP[] = {
+    {1850, 2010, 310, 0}, {1846, 2004, 520, 10}, {1852, 2012, 610, 20}, {1849, 2008, 640, 30},
+    {1851, 2006, 655, 40}, {1848, 2011, 650, 50}, {1850, 2009, 630, 60}, {1853, 2007, 580, 70},
+    {1860, 2020, 240, 80}, {0, 0, 0, 90}, {0, 0, 0, 100}, {0, 0, 0, 110}, {0, 0, 0, 120},
+};
+
+// Ruído do resistivo: leituras isoladas acima do threshold sem toque real
+static const TouchSample NOISE[] = {
+    {0, 0, 0, 0}, {3020, 410, 720, 10}, {0, 0, 0, 20}, {0, 0, 0, 30},
+    {1200, 3300, 450, 40}, {0, 0, 120, 50}, {2500, 900, 530, 60}, {0, 0, 0, 70},
+};
+
+// Dedo parado com tremor e um pico espúrio em X (amostra 5)
+static const TouchSample HOLD_WITH_SPIKE[] = {
+    {2000, 1500, 600, 0}, {2006, 1497, 610, 10}, {1995, 1503, 605, 20}, {2003, 1499, 612, 30},
+    {2001, 1502, 608, 40}, {3600, 1500, 590, 50}, {1998, 1498, 604, 60}, {2004, 1501, 611, 70},
+    {1997, 1500, 607, 80}, {2002, 1499, 609, 90},
+};
+
+// Arrasto horizontal rápido com queda curta de pressão no meio (t=40)
+static const TouchSample DRAG[] = {
+    {1000, 2000, 600, 0}, {1004, 2002, 610, 10}, {1200, 2001, 620, 20}, {1400, 1999, 600, 30},
+    {1600, 2003, 180, 40}, {1800, 2000, 590, 50}, {2000, 2001, 600, 60}, {2200, 1998, 615, 70},
+    {2400, 2002, 605, 80}, {2600, 2000, 610, 90}, {2600, 2001, 612, 100}, {2600, 1999, 608, 110},
+};
+
+template <size_t N>
+static int pressIndex(TouchFilter& filter, const TouchSample (&trace)[N]) {
+    for (size_t i = 0; i < N; i++) {
+        if (filter.feed(trace[i])) return (int)i;
+    }
+    return -1;
+}
+
+void test_tap_confirms_well_under_old_window(void) {
+    TouchFilter filter;
+    int index = pressIndex(filter, TAP);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, index);
+
+    // Antes: leitura a cada 50ms + 150ms de confirmação; alvo < 40ms do IRQ
+    TEST_ASSERT_LESS_THAN(40, filter.getPressTime() - TAP[0].timeMs);
+    TEST_ASSERT_INT_WITHIN(10, 1850, filter.getX());
+    TEST_ASSERT_INT_WITHIN(10, 2008, filter.getY());
+
+    // Solta depois de TOUCH_RELEASE_HOLD_MS com pressão baixa
+    bool pressed = true;
+    uint32_t releasedAt = 0;
+    for (size_t i = index + 1; i < sizeof(TAP) / sizeof(TAP[0]) && pressed; i++) {
+        pressed = filter.feed(TAP[i]);
+        if (!pressed) releasedAt = TAP[i].timeMs;
+    }
+    TEST_ASSERT_FALSE(pressed);
+    TEST_ASSERT_EQUAL(80 + TOUCH_RELEASE_HOLD_MS, releasedAt);
+}
+
+void test_isolated_noise_never_presses(void) {
+    TouchFilter filter;
+    TEST_ASSERT_EQUAL(-1, pressIndex(filter, NOISE));
+}
+
+void test_median_rejects_spike_and_iir_smooths_jitter(void) {
+    TouchFilter filter;
+    filter.feed(HOLD_WITH_SPIKE[0]);
+    TEST_ASSERT_TRUE(filter.feed(HOLD_WITH_SPIKE[1]));
+
+    for (size_t i = 2; i < sizeof(HOLD_WITH_SPIKE) / sizeof(HOLD_WITH_SPIKE[0]); i++) {
+        TEST_ASSERT_TRUE(filter.feed(HOLD_WITH_SPIKE[i]));
+        TEST_ASSERT_INT_WITHIN(8, 2000, filter.getX());
+        TEST_ASSERT_INT_WITHIN(8, 1500, filter.getY());
+    }
+}
+
+void test_drag_tracks_and_survives_pressure_dip(void) {
+    TouchFilter filter;
+    for (const TouchSample& s : DRAG) {
+        bool pressed = filter.feed(s);
+        if (s.timeMs >= 10) TEST_ASSERT_TRUE(pressed);
+    }
+    // Três amostras paradas no fim: filtro alcança o dedo
+    TEST_ASSERT_INT_WITHIN(60, 2600, filter.getX());
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_tap_confirms_well_under_old_window);
+    RUN_TEST(test_isolated_noise_never_presses);
+    RUN_TEST(test_median_rejects_spike_and_iir_smooths_jitter);
+    RUN_TEST(test_drag_tracks_and_survives_pressure_dip);
+    return UNITY_END();
+}
@@ -0,0 +1,868 @@
+/**
+ * @file test_main.cpp
+ * @brief Testes da pilha de UI/MQTT no host (pio test -e native)
+ *
+ * A configuração chega pelo ScreenApiClient real (FakeHttpServer), a UI é
+ * construída pelo ScreenManager/ScreenFactory reais e renderizada no
+ * FramebufferTransport; comandos saem pelo MQTTClient real (FakeBroker).
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include <ArduinoJson.h>
+#include <PubSubClient.h>
+#include "native/NativeHarness.h"
+#include "ui/ScreenManager.h"
+#include "ui/IconManager.h"
+#include "display/DisplayPipeline.h"
+#include "display/RenderProfiler.h"
+#include "utils/StringPool.h"
+#include "utils/MemoryMonitor.h"
+#include "utils/CommandTracer.h"
+#include "core/Scheduler.h"
+#include "core/AsyncFetch.h"
+#include "core/ConfigStore.h"
+#include "core/ConfigManager.h"
+#include "network/ScreenApiClient.h"
+#include "network/HttpSession.h"
+#include <LittleFS.h>
+#include "core/MQTTProtocol.h"
+#include "commands/CommandSender.h"
+#include "commands/CommandAckTracker.h"
+#include "commands/CommandCoalescer.h"
+#include "communication/ButtonStateManager.h"
+#include "utils/DeviceUtils.h"
+#include "config/DeviceConfig.h"
+#include "runtime_stats.h"
+
+extern ScreenManager* screenManager;
+extern IconManager* iconManager;
+extern DisplayPipeline* displayPipeline;
+extern RenderProfiler* renderProfiler;
+extern ConfigManager* configManager;
+extern ScreenApiClient* screenApiClient;
+extern CommandSender* commandSender;
+
+static NativeHarness harness;
+static const char* RELAY_SET_TOPIC = "autocore/devices/esp32-relay-001122334455/relays/set";
+
+void setUp(void) {
+    native::FakeBroker::instance().clearPublished();
+    CommandAckTracker::getInstance().clear();  // Nenhum teste herda reenvios do anterior
+    CommandCoalescer::getInstance().clear();
+}
+
+void tearDown(void) {
+    harness.setSeparateTasks(false);
+}
+
+void test_builds_screens_from_api_config(void) {
+    // Home + as duas telas da fixture
+    TEST_ASSERT_EQUAL(3, screenManager->getScreenIds().size());
+}
+
+void test_renders_to_framebuffer(void) {
+    displayPipeline->resetStats();
+    renderProfiler->reset();
+    screenManager->navigateTo("2");
+    harness.pump(100);
+
+    const DisplayStats& stats = displayPipeline->getStats();
+    TEST_ASSERT_GREATER_THAN(0, stats.frames);
+    TEST_ASSERT_GREATER_THAN(0, stats.flushes);
+    TEST_ASSERT_GREATER_THAN(0, harness.getTransport()->getFlushCount());
+
+    // Troca de tela invalida a tela inteira pelo menos uma vez
+    TEST_ASSERT_GREATER_THAN(0, renderProfiler->getFrames());
+    TEST_ASSERT_GREATER_THAN(0, renderProfiler->getFlushPixels().getCount());
+    TEST_ASSERT_GREATER_THAN(0, renderProfiler->getInvalidatedAreas().getMax());
+}
+
+void test_relay_button_publishes_command(void) {
+    screenManager->navigateTo("2");
+    harness.pump(50);
+
+    lv_obj_t* label = harness.findLabel("Farol");
+    TEST_ASSERT_NOT_NULL(label);
+    TEST_ASSERT_TRUE(harness.tap(label));
+
+    auto sent = native::FakeBroker::instance().publishedTo(RELAY_SET_TOPIC);
+    TEST_ASSERT_EQUAL(1, sent.size());
+
+    JsonDocument doc;
+    TEST_ASSERT_FALSE(deserializeJson(doc, sent[0].payload));
+    TEST_ASSERT_EQUAL(1, doc["channel"].as<int>());
+    TEST_ASSERT_EQUAL_STRING("toggle", doc["function_type"].as<const char*>());
+}
+
+void test_relay_echo_closes_command_trace(void) {
+    CommandTracer& tracer = CommandTracer::getInstance();
+    tracer.reset();
+
+    screenManager->navigateTo("2");
+    harness.pump(1000);  // Passa o debounce de clique do teste anterior
+    TEST_ASSERT_TRUE(harness.tap(harness.findLabel("Farol")));
+
+    auto sent = native::FakeBroker::instance().publishedTo(RELAY_SET_TOPIC);
+    TEST_ASSERT_EQUAL(1, sent.size());
+    JsonDocument command;
+    TEST_ASSERT_FALSE(deserializeJson(command, sent[0].payload));
+    const char* traceId = command["trace_id"];
+    TEST_ASSERT_NOT_NULL(traceId);
+
+    // Eco do relé no status do canal, com o tempo gasto do lado dele
+    JsonDocument echo;
+    echo["protocol_version"] = PROTOCOL_VERSION;
+    echo["channel"] = command["channel"];
+    echo["state"] = command["state"].as<bool>() ? "ON" : "OFF";
+    echo["trace_id"] = traceId;
+    echo["relay_total_us"] = 1500;
+    echo["relay_exec_us"] = 200;
+    String payload;
+    serializeJson(echo, payload);
+    uint8_t inFlight = tracer.getInFlight();
+    native::FakeBroker::instance().inject("autocore/devices/esp32-relay-001122334455/relays/status", payload);
+    harness.pump(20);
+
+    TEST_ASSERT_EQUAL(1, tracer.getCompleted());
+    TEST_ASSERT_EQUAL(inFlight - 1, tracer.getInFlight());
+    TEST_ASSERT_EQUAL(1500, tracer.getStage(CommandTracer::STAGE_RELAY).getMax());
+    TEST_ASSERT_EQUAL(1, tracer.getStage(CommandTracer::STAGE_PUBLISH).getCount());
+}
+
+// Estado LVGL do botão que contém o label (USER_1 = falha, USER_2 = pendente)
+static bool buttonHasState(lv_obj_t* label, lv_state_t state) {
+    for (lv_obj_t* obj = label; obj; obj = lv_obj_get_parent(obj)) {
+        if (lv_obj_has_state(obj, state)) return true;
+    }
+    return false;
+}
+
+static bool commandFailedShown(lv_obj_t* label) {
+    return buttonHasState(label, LV_STATE_USER_1);
+}
+
+static void injectRelayEcho(bool on, uint32_t seq, const char* traceId) {
+    JsonDocument echo;
+    echo["protocol_version"] = PROTOCOL_VERSION;
+    echo["channel"] = 1;
+    echo["state"] = on ? "ON" : "OFF";
+    echo["boot"] = 7;
+    echo["seq"] = seq;
+    if (traceId) echo["trace_id"] = traceId;
+    String payload;
+    serializeJson(echo, payload);
+    native::FakeBroker::instance().inject("autocore/devices/esp32-relay-001122334455/relays/status", payload);
+    harness.pump(20);
+}
+
+void test_unacked_command_retries_then_fails_button(void) {
+    CommandAckTracker& acks = CommandAckTracker::getInstance();
+    acks.reset();
+
+    screenManager->navigateTo("2");
+    harness.pump(1000);  // Passa o debounce de clique dos testes anteriores
+    lv_obj_t* label = harness.findLabel("Farol");
+    TEST_ASSERT_TRUE(harness.tap(label));
+    TEST_ASSERT_EQUAL(1, acks.getPending());
+
+    // Sem resposta: mesmo payload (mesmo request_id) a cada timeout
+    harness.pump(COMMAND_ACK_TIMEOUT);
+    auto sent = native::FakeBroker::instance().publishedTo(RELAY_SET_TOPIC);
+    TEST_ASSERT_EQUAL(2, sent.size());
+    TEST_ASSERT_EQUAL_STRING(sent[0].payload.c_str(), sent[1].payload.c_str());
+    TEST_ASSERT_FALSE(commandFailedShown(label));
+
+    harness.pump(COMMAND_ACK_TIMEOUT * COMMAND_ACK_RETRIES);
+    TEST_ASSERT_EQUAL(1 + COMMAND_ACK_RETRIES, native::FakeBroker::instance().publishedTo(RELAY_SET_TOPIC).size());
+    TEST_ASSERT_EQUAL(1, acks.getTimedOut());
+    TEST_ASSERT_EQUAL(0, acks.getPending());
+    TEST_ASSERT_TRUE(commandFailedShown(label));
+
+    // Próximo comando confirmado em /response limpa a falha e mede a latência
+    native::FakeBroker::instance().clearPublished();
+    TEST_ASSERT_TRUE(harness.tap(label));
+    sent = native::FakeBroker::instance().publishedTo(RELAY_SET_TOPIC);
+    TEST_ASSERT_EQUAL(1, sent.size());
+    JsonDocument command;
+    TEST_ASSERT_FALSE(deserializeJson(command, sent[0].payload));
+
+    JsonDocument response;
+    response["protocol_version"] = PROTOCOL_VERSION;
+    response["request_id"] = command["request_id"];
+    response["success"] = true;
+    String payload;
+    serializeJson(response, payload);
+    harness.pump(40);
+    native::FakeBroker::instance().inject("autocore/devices/esp32-relay-001122334455/response", payload);
+    harness.pump(20);
+
+    TEST_ASSERT_EQUAL(1, acks.getAcked());
+    TEST_ASSERT_EQUAL(1, acks.getLatency().getCount());
+    TEST_ASSERT_GREATER_OR_EQUAL(40, acks.getLatency().getMax());
+    TEST_ASSERT_FALSE(commandFailedShown(label));
+}
+
+void test_publish_result_returns_from_network_task(void) {
+    CommandAckTracker& acks = CommandAckTracker::getInstance();
+    native::FakeBroker& broker = native::FakeBroker::instance();
+
+    screenManager->navigateTo("2");
+    harness.pump(1000);
+    lv_obj_t* label = harness.findLabel("Farol");
+
+    // Publish da UI vai pela caixa da tarefa de rede, como no dispositivo
+    harness.setSeparateTasks(true);
+    TEST_ASSERT_TRUE(harness.tap(label));
+    auto sent = broker.publishedTo(RELAY_SET_TOPIC);
+    TEST_ASSERT_EQUAL(1, sent.size());
+    TEST_ASSERT_EQUAL(1, acks.getPending());
+    TEST_ASSERT_TRUE(buttonHasState(label, LV_STATE_USER_2));
+
+    JsonDocument command;
+    TEST_ASSERT_FALSE(deserializeJson(command, sent[0].payload));
+    JsonDocument response;
+    response["protocol_version"] = PROTOCOL_VERSION;
+    response["request_id"] = command["request_id"];
+    response["success"] = true;
+    String payload;
+    serializeJson(response, payload);
+    broker.inject("autocore/devices/esp32-relay-001122334455/response", payload);
+    harness.pump(20);
+    TEST_ASSERT_EQUAL(0, acks.getPending());
+    bool confirmed = buttonHasState(label, LV_STATE_CHECKED);
+
+    // Socket recusa na tarefa de rede: o resultado volta e desfaz o pedido
+    broker.clearPublished();
+    harness.pump(1000);
+    broker.failPublishes(RELAY_SET_TOPIC);
+    TEST_ASSERT_TRUE(harness.tap(label));
+    TEST_ASSERT_EQUAL(0, broker.publishedTo(RELAY_SET_TOPIC).size());
+    TEST_ASSERT_EQUAL(0, acks.getPending());
+    TEST_ASSERT_FALSE(buttonHasState(label, LV_STATE_USER_2));
+    TEST_ASSERT_EQUAL(confirmed, buttonHasState(label, LV_STATE_CHECKED));
+    TEST_ASSERT_TRUE(commandFailedShown(label));
+}
+
+void test_toggle_is_optimistic_and_reconciles(void) {
+    extern ButtonStateManager* buttonStateManager;
+    const char* key = "esp32-relay-001122334455:1";
+
+    screenManager->navigateTo("2");
+    harness.pump(1000);
+    lv_obj_t* label = harness.findLabel("Farol");
+    bool before = buttonHasState(label, LV_STATE_CHECKED);
+
+    // Pedido aparece na hora, marcado como pendente
+    TEST_ASSERT_TRUE(harness.tap(label));
+    TEST_ASSERT_EQUAL(!before, buttonHasState(label, LV_STATE_CHECKED));
+    TEST_ASSERT_TRUE(buttonHasState(label, LV_STATE_USER_2));
+    JsonDocument command;
+    TEST_ASSERT_FALSE(deserializeJson(command, native::FakeBroker::instance().publishedTo(RELAY_SET_TOPIC)[0].payload));
+    String requestId = command["request_id"].as<String>();
+
+    // Eco de outro display: muda o confirmado, o pendente continua na tela
+    injectRelayEcho(before, 5, "other-display_1_1");
+    TEST_ASSERT_EQUAL(!before, buttonHasState(label, LV_STATE_CHECKED));
+    TEST_ASSERT_TRUE(buttonHasState(label, LV_STATE_USER_2));
+    TEST_ASSERT_EQUAL(before, buttonStateManager->getButtonState(key).isActive);
+
+    // Eco atrasado (seq já vista) é descartado
+    injectRelayEcho(!before, 4, nullptr);
+    TEST_ASSERT_EQUAL(before, buttonStateManager->getButtonState(key).isActive);
+    TEST_ASSERT_EQUAL_UINT32(5, buttonStateManager->getButtonState(key).sequence);
+
+    // Eco do nosso pedido confirma
+    injectRelayEcho(!before, 6, requestId.c_str());
+    TEST_ASSERT_FALSE(buttonHasState(label, LV_STATE_USER_2));
+    TEST_ASSERT_EQUAL(!before, buttonHasState(label, LV_STATE_CHECKED));
+
+    // Sem eco nem resposta: volta ao confirmado quando as tentativas acabam
+    harness.pump(1000);
+    TEST_ASSERT_TRUE(harness.tap(label));
+    TEST_ASSERT_EQUAL(before, buttonHasState(label, LV_STATE_CHECKED));
+    harness.pump(COMMAND_ACK_TIMEOUT * (COMMAND_ACK_RETRIES + 1));
+    TEST_ASSERT_FALSE(buttonHasState(label, LV_STATE_USER_2));
+    TEST_ASSERT_TRUE(commandFailedShown(label));
+    TEST_ASSERT_EQUAL(!before, buttonHasState(label, LV_STATE_CHECKED));
+}
+
+void test_stale_command_result_leaves_button_alone(void) {
+    extern ButtonStateManager* buttonStateManager;
+    const char* key = StringPool::getInstance().intern("esp32-relay-001122334455:1");
+
+    screenManager->navigateTo("2");
+    harness.pump(1000);
+    lv_obj_t* label = harness.findLabel("Farol");
+    TEST_ASSERT_TRUE(harness.tap(label));
+    bool requested = buttonHasState(label, LV_STATE_CHECKED);
+    TEST_ASSERT_FALSE(commandFailedShown(label));
+
+    // Falha de um pedido anterior não desfaz nem marca o pedido atual
+    uint32_t stale = buttonStateManager->getStaleResults();
+    buttonStateManager->processCommandResult(key, "display_0_0", false);
+    TEST_ASSERT_EQUAL_UINT32(stale + 1, buttonStateManager->getStaleResults());
+    TEST_ASSERT_FALSE(commandFailedShown(label));
+    TEST_ASSERT_TRUE(buttonHasState(label, LV_STATE_USER_2));
+    TEST_ASSERT_EQUAL(requested, buttonHasState(label, LV_STATE_CHECKED));
+
+    // O pedido atual continua valendo
+    JsonDocument command;
+    TEST_ASSERT_FALSE(deserializeJson(command, native::FakeBroker::instance().publishedTo(RELAY_SET_TOPIC).back().payload));
+    TEST_ASSERT_TRUE(CommandAckTracker::getInstance().acknowledge(command["request_id"].as<const char*>(), true));
+    TEST_ASSERT_FALSE(buttonHasState(label, LV_STATE_USER_2));
+    TEST_ASSERT_EQUAL(requested, buttonHasState(label, LV_STATE_CHECKED));
+}
+
+void test_rapid_toggles_coalesce_into_net_command(void) {
+    CommandCoalescer& queue = CommandCoalescer::getInstance();
+    queue.reset();
+
+    screenManager->navigateTo("2");
+    harness.pump(1000);
+    lv_obj_t* label = harness.findLabel("Farol");
+    bool before = buttonHasState(label, LV_STATE_CHECKED);
+
+    // Três toques na janela: o primeiro sai, o segundo espera e o terceiro
+    // volta ao estado já em voo, então nada mais é publicado
+    TEST_ASSERT_TRUE(harness.tap(label));
+    TEST_ASSERT_TRUE(harness.tap(label));
+    TEST_ASSERT_TRUE(harness.tap(label));
+    harness.pump(COMMAND_COALESCE_MS);
+    auto sent = native::FakeBroker::instance().publishedTo(RELAY_SET_TOPIC);
+    TEST_ASSERT_EQUAL(1, sent.size());
+    TEST_ASSERT_EQUAL(1, queue.getSuperseded());
+    TEST_ASSERT_EQUAL(1, queue.getMerged());
+    TEST_ASSERT_EQUAL(!before, buttonHasState(label, LV_STATE_CHECKED));
+    TEST_ASSERT_TRUE(buttonHasState(label, LV_STATE_USER_2));
+
+    // A confirmação do comando em voo vale para o toque absorvido
+    JsonDocument command;
+    TEST_ASSERT_FALSE(deserializeJson(command, sent[0].payload));
+    JsonDocument response;
+    response["protocol_version"] = PROTOCOL_VERSION;
+    response["request_id"] = command["request_id"];
+    response["success"] = true;
+    String payload;
+    serializeJson(response, payload);
+    native::FakeBroker::instance().inject("autocore/devices/esp32-relay-001122334455/response", payload);
+    harness.pump(20);
+    TEST_ASSERT_FALSE(buttonHasState(label, LV_STATE_USER_2));
+    TEST_ASSERT_EQUAL(!before, buttonHasState(label, LV_STATE_CHECKED));
+
+    // Rajada acima do limite: nada é descartado, o excedente sai com os tokens
+    // e do alvo que esperava só o último estado pedido
+    harness.pump(1000);
+    native::FakeBroker::instance().clearPublished();
+    for (int i = 0; i < COMMAND_RATE_BURST + 3; i++) {
+        TEST_ASSERT_TRUE(commandSender->sendPresetCommand("sweep_" + String(i)));
+    }
+    TEST_ASSERT_TRUE(commandSender->sendModeCommand("night"));
+    TEST_ASSERT_TRUE(commandSender->sendModeCommand("day"));
+    TEST_ASSERT_EQUAL(COMMAND_RATE_BURST, native::FakeBroker::instance().publishedTo("autocore/preset/execute").size());
+    TEST_ASSERT_EQUAL(4, queue.getQueued());
+
+    harness.pump(100);
+    auto presets = native::FakeBroker::instance().publishedTo("autocore/preset/execute");
+    TEST_ASSERT_EQUAL(COMMAND_RATE_BURST + 3, presets.size());
+    TEST_ASSERT_TRUE(presets.back().payload.indexOf("sweep_" + String(COMMAND_RATE_BURST + 2)) >= 0);
+    auto modes = native::FakeBroker::instance().publishedTo("autocore/system/control");
+    TEST_ASSERT_EQUAL(1, modes.size());
+    TEST_ASSERT_TRUE(modes[0].payload.indexOf("\"day\"") >= 0);
+    TEST_ASSERT_EQUAL(0, queue.getQueued());
+}
+
+void test_group_command_sends_channels_in_one_message(void) {
+    // Canais 1 e 3 ligados, 2 desligado, numa única mensagem
+    TEST_ASSERT_TRUE(commandSender->sendRelayGroupCommand("esp32-relay-001122334455", 0b111, 0b101));
+    auto sent = native::FakeBroker::instance().publishedTo(RELAY_SET_TOPIC);
+    TEST_ASSERT_EQUAL(1, sent.size());
+
+    JsonDocument doc;
+    TEST_ASSERT_FALSE(deserializeJson(doc, sent[0].payload));
+    JsonArray channels = doc["channels"];
+    TEST_ASSERT_EQUAL(3, channels.size());
+    TEST_ASSERT_EQUAL(1, channels[0]["channel"].as<int>());
+    TEST_ASSERT_TRUE(channels[0]["state"].as<bool>());
+    TEST_ASSERT_FALSE(channels[1]["state"].as<bool>());
+    TEST_ASSERT_TRUE(channels[2]["state"].as<bool>());
+    TEST_ASSERT_TRUE(doc["channel"].isNull());
+
+    // Confirmado pelo mesmo request_id, sem botão associado
+    TEST_ASSERT_EQUAL(1, CommandAckTracker::getInstance().getPending());
+    TEST_ASSERT_TRUE(CommandAckTracker::getInstance().isPending(doc["request_id"].as<const char*>()));
+}
+
+void test_new_command_supersedes_pending_retry(void) {
+    CommandAckTracker& acks = CommandAckTracker::getInstance();
+    acks.reset();
+    const char* board = "esp32-relay-001122334455";
+
+    // Soltar sai antes da confirmação do pressionar: só ele segue em voo
+    TEST_ASSERT_TRUE(commandSender->sendRelayCommand(board, 2, "ON", "momentary"));
+    TEST_ASSERT_TRUE(commandSender->sendRelayCommand(board, 2, "OFF", "momentary"));
+    TEST_ASSERT_EQUAL(1, acks.getPending());
+    TEST_ASSERT_EQUAL(1, acks.getSuperseded());
+
+    // Reenvio leva o soltar, nunca o pressionar de volta ao relé
+    native::FakeBroker::instance().clearPublished();
+    harness.pump(COMMAND_ACK_TIMEOUT);
+    auto sent = native::FakeBroker::instance().publishedTo(RELAY_SET_TOPIC);
+    TEST_ASSERT_EQUAL(1, sent.size());
+    JsonDocument doc;
+    TEST_ASSERT_FALSE(deserializeJson(doc, sent[0].payload));
+    TEST_ASSERT_FALSE(doc["state"].as<bool>());
+}
+
+void test_momentary_skips_exhausted_rate_limit(void) {
+    CommandCoalescer& queue = CommandCoalescer::getInstance();
+    queue.reset();
+    const char* board = "esp32-relay-001122334455";
+
+    // Bucket vazio (heartbeats/reenvios gastaram tudo): toggle espera...
+    for (uint8_t i = 0; i < COMMAND_RATE_BURST; i++) queue.charge();
+    TEST_ASSERT_TRUE(commandSender->sendRelayCommand(board, 4, "ON", "toggle"));
+    TEST_ASSERT_EQUAL(1, queue.getQueued());
+    TEST_ASSERT_EQUAL(0, native::FakeBroker::instance().publishedTo(RELAY_SET_TOPIC).size());
+
+    // ...pressionar e soltar saem na hora, sem passar pela fila
+    TEST_ASSERT_TRUE(commandSender->sendRelayCommand(board, 2, "ON", "momentary"));
+    TEST_ASSERT_TRUE(commandSender->sendRelayCommand(board, 2, "OFF", "momentary"));
+    auto sent = native::FakeBroker::instance().publishedTo(RELAY_SET_TOPIC);
+    TEST_ASSERT_EQUAL(2, sent.size());
+    TEST_ASSERT_TRUE(sent[0].payload.indexOf("\"momentary\"") >= 0);
+    TEST_ASSERT_EQUAL(1, queue.getQueued());
+
+    // Toggle sai quando o token volta
+    harness.pump(1000);
+    TEST_ASSERT_EQUAL(0, queue.getQueued());
+    TEST_ASSERT_EQUAL(3, native::FakeBroker::instance().publishedTo(RELAY_SET_TOPIC).size());
+}
+
+void test_momentary_heartbeats_batch_per_board(void) {
+    const char* boardA = "esp32-relay-001122334455";
+    const char* boardB = "esp32-relay-66778899aabb";
+    String topicA = String("autocore/devices/") + boardA + "/relays/heartbeat";
+    String topicB = String("autocore/devices/") + boardB + "/relays/heartbeat";
+
+    // Canal 3 nas duas placas não colide; A segura também o canal 5
+    commandSender->startHeartbeat(boardA, 3);
+    commandSender->startHeartbeat(boardB, 3);
+    commandSender->startHeartbeat(boardA, 5);
+    TEST_ASSERT_EQUAL(3, commandSender->getActiveHeartbeatCount());
+
+    harness.pump(HEARTBEAT_INTERVAL_MS);
+    auto sentA = native::FakeBroker::instance().publishedTo(topicA);
+    TEST_ASSERT_EQUAL(1, sentA.size());
+    TEST_ASSERT_EQUAL(1, native::FakeBroker::instance().publishedTo(topicB).size());
+
+    JsonDocument batch;
+    TEST_ASSERT_FALSE(deserializeJson(batch, sentA[0].payload));
+    TEST_ASSERT_EQUAL(2, batch["channels"].size());
+    TEST_ASSERT_EQUAL(3, batch["channels"][0]["channel"].as<int>());
+    TEST_ASSERT_EQUAL(5, batch["channels"][1]["channel"].as<int>());
+    TEST_ASSERT_EQUAL(1, batch["channels"][1]["sequence"].as<int>());
+
+    // Soltar o canal 3 da placa B não afeta a placa A
+    commandSender->stopHeartbeat(boardB, 3);
+    commandSender->stopHeartbeat(boardA, 5);
+    native::FakeBroker::instance().clearPublished();
+    harness.pump(HEARTBEAT_INTERVAL_MS);
+    TEST_ASSERT_EQUAL(0, native::FakeBroker::instance().publishedTo(topicB).size());
+    sentA = native::FakeBroker::instance().publishedTo(topicA);
+    TEST_ASSERT_EQUAL(1, sentA.size());
+    TEST_ASSERT_FALSE(deserializeJson(batch, sentA[0].payload));
+    TEST_ASSERT_EQUAL(1, batch["channels"].size());
+    TEST_ASSERT_EQUAL(2, batch["channels"][0]["sequence"].as<int>());
+
+    commandSender->stopHeartbeat(boardA, 3);
+    TEST_ASSERT_EQUAL(0, commandSender->getActiveHeartbeatCount());
+}
+
+void test_page_rebuild_reuses_arena(void) {
+    screenManager->navigateTo("2");
+    harness.pump(20);
+
+    ScreenBase* screen = screenManager->getCurrentScreen();
+    TEST_ASSERT_NOT_NULL(screen);
+    TEST_ASSERT_GREATER_THAN(0, screen->getArena().getObjectCount());
+
+    // Hot reload repetido da página: mesmos blocos, mesma quantidade de objetos
+    size_t capacity = screen->getArena().getCapacity();
+    uint16_t objects = screen->getArena().getObjectCount();
+    uint32_t pooled = StringPool::getInstance().getStats().entries;
+    for (int i = 0; i < 10; i++) {
+        screen->rebuildContent();
+    }
+    TEST_ASSERT_EQUAL(capacity, screen->getArena().getCapacity());
+    TEST_ASSERT_EQUAL(objects, screen->getArena().getObjectCount());
+
+    // Identificadores já internados são reaproveitados, o pool não cresce
+    TEST_ASSERT_EQUAL(pooled, StringPool::getInstance().getStats().entries);
+
+    // Botões da página reconstruída continuam funcionando
+    native::FakeBroker::instance().clearPublished();
+    harness.pump(1000);  // Passa o debounce de clique do teste anterior
+    TEST_ASSERT_TRUE(harness.tap(harness.findLabel("Farol")));
+    TEST_ASSERT_EQUAL(1, native::FakeBroker::instance().publishedTo(RELAY_SET_TOPIC).size());
+}
+
+void test_icon_defaults_and_overrides(void) {
+    // Padrões da flash resolvem direto para o glifo
+    TEST_ASSERT_TRUE(iconManager->hasIcon("power"));
+    TEST_ASSERT_EQUAL_STRING(LV_SYMBOL_POWER, iconManager->getIconSymbol("power").c_str());
+    TEST_ASSERT_FALSE(iconManager->hasIcon("no_such_icon"));
+
+    // Só o que difere do padrão vira override
+    JsonDocument doc;
+    deserializeJson(doc, R"({"icons":{
+        "power":{"display_name":"Liga/Desliga","category":"control","lvgl_symbol":"LV_SYMBOL_POWER"},
+        "horn":{"display_name":"Buzina","category":"control","lvgl_symbol":"LV_SYMBOL_BELL","fallback":11}}})");
+    TEST_ASSERT_TRUE(iconManager->loadFromConfig(doc.as<JsonObject>()));
+    TEST_ASSERT_EQUAL(1, iconManager->getOverrideCount());
+    TEST_ASSERT_EQUAL_STRING(LV_SYMBOL_POWER, iconManager->getIconSymbol("horn").c_str());
+
+    iconManager->clearCache();
+    TEST_ASSERT_FALSE(iconManager->hasIcon("horn"));
+}
+
+void test_memory_monitor_warns_before_exhaustion(void) {
+    MemoryMonitor& monitor = MemoryMonitor::getInstance();
+
+    // Contadores por subsistema alimentados pelos donos da memória
+    TEST_ASSERT_GREATER_THAN(0, monitor.getCounters(MEM_SCREENS).liveBytes);
+    TEST_ASSERT_GREATER_THAN(0, monitor.getCounters(MEM_MQTT).liveBytes);
+    TEST_ASSERT_GREATER_THAN(0, monitor.getCounters(MEM_CONFIG).liveBytes);
+
+    // Maior bloco encolhe com o heap ainda "livre": aviso uma única vez
+    monitor.sample();
+    uint32_t warnings = monitor.getWarningCount();
+    uint32_t largest = ESP.maxAllocHeap;
+    ESP.maxAllocHeap = MEMORY_WARN_MIN_BLOCK / 2;
+    TEST_ASSERT_TRUE(monitor.sample());
+    TEST_ASSERT_FALSE(monitor.sample());
+    ESP.maxAllocHeap = largest;
+    monitor.sample();
+    TEST_ASSERT_EQUAL(warnings + 1, monitor.getWarningCount());
+
+    String topic = "autocore/devices/" + DeviceUtils::getDeviceUUID() + "/telemetry/memory";
+    TEST_ASSERT_EQUAL(1, native::FakeBroker::instance().publishedTo(topic).size());
+}
+
+void test_scheduler_runs_jobs_by_deadline(void) {
+    Scheduler& scheduler = Scheduler::ui();
+    String order;
+
+    Scheduler::JobId fast = scheduler.every("fast", 10, [&order]() { order += "f"; });
+    Scheduler::JobId slow = scheduler.every("slow", 25, [&order]() { order += "s"; }, 25);
+    scheduler.after("once", 15, [&order]() { order += "o"; });
+
+    // Dorme exatamente até o próximo deadline em vez de testar a cada tick
+    for (int i = 0; i < 6; i++) {
+        uint32_t idle = scheduler.runDue(1000);
+        if (idle) native::advanceClock(idle);
+    }
+    TEST_ASSERT_EQUAL_STRING("ffofsf", order.c_str());
+
+    // Job pausado sai do heap; periódico atrasado roda uma vez só (pula os períodos perdidos)
+    scheduler.pause(slow);
+    order = "";
+    native::advanceClock(30);
+    scheduler.runDue(1000);
+    TEST_ASSERT_EQUAL_STRING("f", order.c_str());
+    TEST_ASSERT_EQUAL(5, scheduler.getStats(fast)->runs);
+
+    scheduler.cancel(fast);
+    scheduler.cancel(slow);
+}
+
+void test_runtime_stats_windows_frames_and_loops(void) {
+    runtime_stats_sample();     // Janela só com este teste
+
+    int loop = runtime_stats_timing("test_loop");
+    TEST_ASSERT_EQUAL(loop, runtime_stats_timing("test_loop"));
+    runtime_stats_record(loop, 100);
+    runtime_stats_record(loop, 300);
+    int queue = runtime_stats_gauge("test_queue");
+    runtime_stats_set(queue, 4);
+    runtime_stats_set(queue, 1);
+
+    // Frames do LVGL chegam pelo monitor do DisplayPipeline
+    lv_obj_invalidate(lv_scr_act());
+    harness.pump(100);
+    runtime_stats_sample();
+
+    static char json[RUNTIME_STATS_JSON_SIZE];
+    TEST_ASSERT_TRUE(runtime_stats_to_json(json, sizeof(json)) > 0);
+    JsonDocument doc;
+    TEST_ASSERT_FALSE(deserializeJson(doc, json));
+    TEST_ASSERT_TRUE(doc["timings"]["lvgl_frame"]["count"].as<uint32_t>() > 0);
+    TEST_ASSERT_EQUAL(2, doc["timings"]["test_loop"]["count"].as<uint32_t>());
+    TEST_ASSERT_EQUAL(200, doc["timings"]["test_loop"]["avg_us"].as<uint32_t>());
+    TEST_ASSERT_EQUAL(300, doc["timings"]["test_loop"]["max_us"].as<uint32_t>());
+    TEST_ASSERT_EQUAL(1, doc["gauges"]["test_queue"]["value"].as<uint32_t>());
+    TEST_ASSERT_EQUAL(4, doc["gauges"]["test_queue"]["max"].as<uint32_t>());
+
+    // Sem FreeRTOS no host: CPU desconhecida, nunca inventada
+    TEST_ASSERT_EQUAL(RUNTIME_STATS_UNKNOWN, runtime_stats_cpu_pct());
+
+    // Próxima janela recomeça tempos e picos
+    runtime_stats_sample();
+    TEST_ASSERT_EQUAL(0, runtime_stats_get()->timings[loop].count);
+    TEST_ASSERT_EQUAL(1, runtime_stats_get()->gauges[queue].max);
+
+    // Buffer pequeno: falha sem JSON pela metade
+    char small[16];
+    TEST_ASSERT_EQUAL(-1, runtime_stats_to_json(small, sizeof(small)));
+}
+
+void test_async_fetch_backs_off_without_blocking(void) {
+    Scheduler& net = Scheduler::network();
+    AsyncFetch fetch("test_fetch", 3);
+    int calls = 0;
+    int completed = -1;
+
+    fetch.start([&calls]() { return ++calls < 3 ? AsyncFetch::RETRY : AsyncFetch::DONE; },
+                [&completed](bool ok) { completed = ok ? 1 : 0; });
+    net.runDue(1000);
+    TEST_ASSERT_EQUAL(1, calls);
+    TEST_ASSERT_EQUAL(AsyncFetch::BACKOFF, fetch.getState());
+
+    // Backoff é só o deadline do job: nada roda (nem espera) antes dele
+    TEST_ASSERT_UINT32_WITHIN(50, API_RETRY_DELAY, fetch.getRetryIn());
+    net.runDue(1000);
+    TEST_ASSERT_EQUAL(1, calls);
+
+    native::advanceClock(AsyncFetch::backoffDelay(1));
+    net.runDue(1000);
+    TEST_ASSERT_EQUAL(2, calls);
+    TEST_ASSERT_EQUAL(3, fetch.getAttempt());
+    TEST_ASSERT_UINT32_WITHIN(50, 2 * API_RETRY_DELAY, fetch.getRetryIn());
+
+    native::advanceClock(AsyncFetch::backoffDelay(2));
+    net.runDue(1000);
+    TEST_ASSERT_EQUAL(3, calls);
+    TEST_ASSERT_EQUAL(AsyncFetch::SUCCEEDED, fetch.getState());
+    TEST_ASSERT_EQUAL(1, completed);
+    TEST_ASSERT_EQUAL_UINT32(API_RETRY_MAX_DELAY, AsyncFetch::backoffDelay(20));
+
+    // Resposta pendente não gasta tentativa; cancel encerra com done(false)
+    calls = 0;
+    fetch.start([&calls]() { calls++; return AsyncFetch::PENDING; },
+                [&completed](bool ok) { completed = ok ? 1 : 0; });
+    for (int i = 0; i < 5; i++) {
+        net.runDue(1000);
+        native::advanceClock(ASYNC_FETCH_POLL);
+    }
+    TEST_ASSERT_EQUAL(5, calls);
+    TEST_ASSERT_EQUAL(1, fetch.getAttempt());
+
+    fetch.cancel();
+    TEST_ASSERT_EQUAL(AsyncFetch::CANCELLED, fetch.getState());
+    TEST_ASSERT_EQUAL(0, completed);
+    native::advanceClock(ASYNC_FETCH_POLL);
+    net.runDue(1000);
+    TEST_ASSERT_EQUAL(5, calls);
+}
+
+void test_last_good_config_round_trip(void) {
+    native::clearFilesystem();
+    ConfigStore& store = ConfigStore::getInstance();
+    TEST_ASSERT_TRUE(store.begin());
+    store.clear();
+
+    // Como persistAppliedConfig: grava a config com que a UI foi montada
+    String json;
+    serializeJson(configManager->snapshot()->doc, json);
+    uint32_t hash = configManager->getContentHash();
+    TEST_ASSERT_TRUE(store.save(json, hash));
+    TEST_ASSERT_FALSE(store.save(json, hash));      // Mesmo conteúdo não regrava
+    TEST_ASSERT_FALSE(LittleFS.exists(CONFIG_STORE_TMP_PATH));
+
+    // "Reboot": a cópia monta a mesma config, e a mesma config vinda da
+    // API depois tem o mesmo hash (não reconstrói a UI)
+    ConfigManager rebooted;
+    String stored;
+    TEST_ASSERT_TRUE(store.load(stored));
+    TEST_ASSERT_TRUE(rebooted.loadConfig(stored));
+    TEST_ASSERT_EQUAL_UINT32(hash, rebooted.getContentHash());
+    TEST_ASSERT_EQUAL_UINT32(hash, store.getStoredHash());
+}
+
+void test_config_snapshot_outlives_reload(void) {
+    MemoryMonitor& monitor = MemoryMonitor::getInstance();
+    ConfigManager manager;
+    TEST_ASSERT_TRUE(manager.loadConfig(NativeHarness::defaultFixture()));
+
+    // Leitor (ex.: tela montada) segura a versão antiga durante o reload
+    ConfigSnapshot held = manager.snapshot();
+    uint32_t liveWithOne = monitor.getCounters(MEM_CONFIG).liveBytes;
+
+    JsonDocument changed;
+    deserializeJson(changed, NativeHarness::defaultFixture());
+    changed["version"] = "2.0.0";
+    String json;
+    serializeJson(changed, json);
+    TEST_ASSERT_TRUE(manager.loadConfig(json));
+
+    ConfigSnapshot fresh = manager.snapshot();
+    TEST_ASSERT_TRUE(held != fresh);
+    TEST_ASSERT_EQUAL_STRING("2.0.0", fresh->version.c_str());
+    TEST_ASSERT_NOT_EQUAL(0, ConfigManager::getScreens(held->doc).size());
+    TEST_ASSERT_TRUE(monitor.getCounters(MEM_CONFIG).liveBytes > liveWithOne);
+
+    // Último leitor solta: a versão antiga é liberada
+    held.reset();
+    TEST_ASSERT_EQUAL_UINT32(liveWithOne, monitor.getCounters(MEM_CONFIG).liveBytes);
+}
+
+void test_config_stream_keeps_only_display_fields(void) {
+    JsonDocument response;
+    deserializeJson(response, NativeHarness::defaultFixture());
+    response["telemetry"]["voltage"] = 12.6;
+    response["device"]["ip_address"] = "10.0.10.50";
+    response["screens"][1]["items"][0]["size_web"] = "large";
+    response["screens"][1]["items"][0]["relay_board"]["board_model"] = "ESP32_16CH";
+    String body;
+    serializeJson(response, body);
+
+    String path = String(API_BASE_PATH) + "/config/full/" + DeviceUtils::getDeviceUUID();
+    native::FakeHttpServer::instance().on("GET", path, HTTP_CODE_OK, body);
+    screenApiClient->clearCache();
+    screenApiClient->setActiveVersion("");
+
+    // Parse direto do stream com o filtro: só o que o display lê entra no documento
+    JsonDocument config;
+    TEST_ASSERT_TRUE(screenApiClient->loadFullConfiguration(config));
+    TEST_ASSERT_TRUE(config["telemetry"].isNull());
+    TEST_ASSERT_TRUE(config["device"].isNull());
+
+    JsonObject item = config["screens"][1]["items"][0];
+    TEST_ASSERT_EQUAL_STRING("Farol", item["label"] | "");
+    TEST_ASSERT_EQUAL_STRING("toggle", item["relay_channel"]["function_type"] | "");
+    TEST_ASSERT_TRUE(item["size_web"].isNull());
+    TEST_ASSERT_TRUE(item["relay_board"].isNull());
+}
+
+void test_config_fetch_revalidates_with_etag(void) {
+    native::FakeHttpServer& server = native::FakeHttpServer::instance();
+    String path = String(API_BASE_PATH) + "/config/full/" + DeviceUtils::getDeviceUUID();
+    native::HttpHeaders headers;
+    headers.push_back(std::make_pair(String("ETag"), String("\"v1\"")));
+    server.on("GET", path, HTTP_CODE_OK, NativeHarness::defaultFixture(), headers);
+
+    native::clearFilesystem();
+    screenApiClient->clearCache();
+    screenApiClient->setActiveVersion("");
+    server.clearRequests();
+
+    // Download completo: a config processada vai para o flash com o ETag
+    JsonDocument fresh;
+    TEST_ASSERT_TRUE(screenApiClient->loadFullConfiguration(fresh));
+    TEST_ASSERT_FALSE(screenApiClient->wasNotModified());
+    TEST_ASSERT_EQUAL_STRING("\"v1\"", fresh["etag"] | "");
+    TEST_ASSERT_EQUAL_STRING("\"v1\"", screenApiClient->getCachedVersion().c_str());
+
+    // TTL expirado: revalida, 304 e a config sai do flash
+    screenApiClient->clearCache();
+    JsonDocument cached;
+    TEST_ASSERT_TRUE(screenApiClient->loadFullConfiguration(cached));
+    TEST_ASSERT_TRUE(screenApiClient->wasNotModified());
+    TEST_ASSERT_EQUAL(fresh["screens"].size(), cached["screens"].size());
+
+    bool sentValidator = false;
+    for (const auto& header : server.getRequests().back().headers) {
+        if (header.first == "If-None-Match" && header.second == "\"v1\"") sentValidator = true;
+    }
+    TEST_ASSERT_TRUE(sentValidator);
+
+    // Dentro do TTL nem pergunta ao servidor
+    JsonDocument withinTtl;
+    TEST_ASSERT_TRUE(screenApiClient->loadFullConfiguration(withinTtl));
+    TEST_ASSERT_EQUAL(2, server.countRequests("GET", path));
+
+    // Quem já tem a versão em memória não recebe nada para parsear
+    screenApiClient->clearCache();
+    screenApiClient->setActiveVersion("\"v1\"");
+    JsonDocument untouched;
+    TEST_ASSERT_TRUE(screenApiClient->loadFullConfiguration(untouched));
+    TEST_ASSERT_TRUE(screenApiClient->wasNotModified());
+    TEST_ASSERT_TRUE(untouched.isNull());
+    screenApiClient->setActiveVersion("");
+}
+
+void test_api_requests_share_keep_alive_connection(void) {
+    native::FakeHttpServer& server = native::FakeHttpServer::instance();
+    server.on("GET", String(API_BASE_PATH) + "/screens", HTTP_CODE_OK, "[{\"id\":1},{\"id\":2},{\"id\":3}]",
+              native::HttpHeaders(), 5);
+    for (int id = 1; id <= 3; id++) {
+        server.on("GET", String(API_BASE_PATH) + "/screens/" + String(id) + "/items", HTTP_CODE_OK, "[]",
+                  native::HttpHeaders(), 5);
+    }
+
+    // Handshake caro (WiFi), como no carro: cada conexão nova custa 30ms
+    HttpSession& session = HttpSession::getInstance();
+    session.reset();
+    server.setConnectLatency(30);
+    server.clearConnections();
+    uint32_t requestsBefore = session.getRequestCount();
+    uint32_t start = millis();
+
+    // Caminho legado: lista de telas + itens de cada uma
+    JsonDocument screensDoc;
+    JsonArray screens = screensDoc.to<JsonArray>();
+    TEST_ASSERT_TRUE(screenApiClient->getScreens(screens));
+    for (JsonObject screen : screens) {
+        JsonDocument itemsDoc;
+        JsonArray items = itemsDoc.to<JsonArray>();
+        TEST_ASSERT_TRUE(screenApiClient->getScreenItems(screen["id"] | 0, items));
+    }
+
+    // Quatro requisições, um handshake
+    TEST_ASSERT_EQUAL_UINT32(4, session.getRequestCount() - requestsBefore);
+    TEST_ASSERT_EQUAL(1, server.getConnectionCount());
+    // Uma conexão por requisição levaria 4 * (30 + 5)ms
+    uint32_t elapsed = millis() - start;
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(30 + 4 * 5, elapsed);
+    TEST_ASSERT_LESS_THAN_UINT32(4 * (30 + 5), elapsed);
+
+    server.setConnectLatency(0);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+
+    if (!harness.begin() || !harness.loadConfig(NativeHarness::defaultFixture())) {
+        return 1;
+    }
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_builds_screens_from_api_config);
+    RUN_TEST(test_renders_to_framebuffer);
+    RUN_TEST(test_relay_button_publishes_command);
+    RUN_TEST(test_relay_echo_closes_command_trace);
+    RUN_TEST(test_unacked_command_retries_then_fails_button);
+    RUN_TEST(test_publish_result_returns_from_network_task);
+    RUN_TEST(test_toggle_is_optimistic_and_reconciles);
+    RUN_TEST(test_stale_command_result_leaves_button_alone);
+    RUN_TEST(test_rapid_toggles_coalesce_into_net_command);
+    RUN_TEST(test_group_command_sends_channels_in_one_message);
+    RUN_TEST(test_new_command_supersedes_pending_retry);
+    RUN_TEST(test_momentary_skips_exhausted_rate_limit);
+    RUN_TEST(test_momentary_heartbeats_batch_per_board);
+    RUN_TEST(test_page_rebuild_reuses_arena);
+    RUN_TEST(test_icon_defaults_and_overrides);
+    RUN_TEST(test_memory_monitor_warns_before_exhaustion);
+    RUN_TEST(test_scheduler_runs_jobs_by_deadline);
+    RUN_TEST(test_runtime_stats_windows_frames_and_loops);
+    RUN_TEST(test_async_fetch_backs_off_without_blocking);
+    RUN_TEST(test_last_good_config_round_trip);
+    RUN_TEST(test_config_snapshot_outlives_reload);
+    RUN_TEST(test_config_stream_keeps_only_display_fields);
+    RUN_TEST(test_config_fetch_revalidates_with_etag);
+    RUN_TEST(test_api_requests_share_keep_alive_connection);
+
+    return UNITY_END();
+}